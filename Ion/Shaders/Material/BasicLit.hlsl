@@ -5,6 +5,27 @@
 
 // Vertex Shader ---------------------------------------------------------------------------------------
 
+#if ION_SHADER_INSTANCED
+
+ENTRY Pixel VSMain(Vertex vertex, InstanceData instance)
+{
+	Pixel pixel;
+
+	float4x4 transformMatrix = MatrixFromColumns(instance.Transform0, instance.Transform1, instance.Transform2, instance.Transform3);
+	float4x4 inverseTransposeMatrix = MatrixFromColumns(instance.InverseTranspose0, instance.InverseTranspose1, instance.InverseTranspose2, instance.InverseTranspose3);
+
+	pixel.LocationWS = mul(transformMatrix, vertex.Location);
+	pixel.NormalWS = mul(inverseTransposeMatrix, vertex.Normal);
+
+	pixel.Location = mul(ViewProjectionMatrix, pixel.LocationWS);
+	pixel.Normal = vertex.Normal;
+	pixel.TexCoord = vertex.TexCoord;
+
+	return pixel;
+}
+
+#else
+
 ENTRY Pixel VSMain(Vertex vertex)
 {
 	Pixel pixel;
@@ -19,6 +40,8 @@ ENTRY Pixel VSMain(Vertex vertex)
 	return pixel;
 }
 
+#endif
+
 // Pixel Shader ----------------------------------------------------------------------------------------
 
 static float4 s_LocationWS;
@@ -51,6 +51,27 @@ struct Vertex
 	float4 TexCoord : TEXCOORD;
 };
 
+// Per-instance data of the instanced draws (see EShaderUsage::StaticMeshInstanced).
+// The matrices are passed as columns.
+struct InstanceData
+{
+	float4 Transform0 : INSTANCE_TRANSFORM0;
+	float4 Transform1 : INSTANCE_TRANSFORM1;
+	float4 Transform2 : INSTANCE_TRANSFORM2;
+	float4 Transform3 : INSTANCE_TRANSFORM3;
+
+	float4 InverseTranspose0 : INSTANCE_INVTRANSPOSE0;
+	float4 InverseTranspose1 : INSTANCE_INVTRANSPOSE1;
+	float4 InverseTranspose2 : INSTANCE_INVTRANSPOSE2;
+	float4 InverseTranspose3 : INSTANCE_INVTRANSPOSE3;
+};
+
+float4x4 MatrixFromColumns(float4 c0, float4 c1, float4 c2, float4 c3)
+{
+	// The float4x4 constructor takes rows
+	return transpose(float4x4(c0, c1, c2, c3));
+}
+
 struct Pixel
 {
 	float4 Location : SV_POSITION;
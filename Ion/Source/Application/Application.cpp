@@ -15,6 +15,8 @@
 
 #include "RHI/RHI.h"
 #include "Renderer/Renderer.h"
+#include "Renderer/RenderThread.h"
+#include "Resource/TextureStreamer.h"
 
 #include "UserInterface/ImGui.h"
 
@@ -40,6 +42,11 @@ namespace Ion
 	Application::Application() :
 		m_EventDispatcher(this),
 		m_LayerStack(std::make_unique<LayerStack>()),
+		m_MaxFramesInFlight(DefaultMaxFramesInFlight),
+		m_RendererDataIndex(0),
+		m_RenderFrameLag(DefaultRenderFrameLag),
+		m_bUseRenderThread(false),
+		m_RHI(ERHI::DX11),
 		m_MainThreadId(std::this_thread::get_id()),
 		m_bRunning(true),
 		m_Fonts(),
@@ -84,7 +91,7 @@ namespace Ion
 		g_Engine->Init();
 
 		// Current thread will render graphics in this window.
-		RHI::Create(ERHI::DX11);
+		RHI::Create(m_RHI);
 		RHI::SetEngineShadersPath(EnginePath::GetShadersPath());
 		RHI::Get()->Init(m_Window->GetRHIData()).Unwrap();
 
@@ -92,6 +99,12 @@ namespace Ion
 		renderer->Init();
 		renderer->SetVSyncEnabled(false);
 
+		if (m_bUseRenderThread && !RHI::Get()->SupportsRenderThread())
+		{
+			ApplicationLogger.Warn("The current RHI does not support the render thread. The frames will be rendered on the main thread.");
+			m_bUseRenderThread = false;
+		}
+
 		AssetRegistry::RegisterEngineVirtualRoots(EnginePath::GetEngineContentPath(), EnginePath::GetShadersPath());
 		AssetRegistry::RegisterEngineAssets();
 
@@ -110,34 +123,152 @@ namespace Ion
 			TRACE_SCOPE("Application - Client::OnInit");
 			g_pClientApplication->OnInit();
 		}
+
+		SetupFrameGraph();
+
+		if (m_bUseRenderThread)
+		{
+			m_ImGuiDrawData = std::make_unique<ImGuiDrawDataSnapshot[]>(RenderThread::FrameDataBufferCount);
+			RenderThread::Start(m_RenderFrameLag);
+		}
 	}
 
-	void Application::RunLoop()
+	void Application::SetupFrameGraph()
 	{
 		TRACE_FUNCTION();
 
-		ApplicationLogger.Trace("Starting application loop.");
+		using EThread = ETaskGraphThread;
 
-		// Application loop
-		while (m_bRunning)
+		m_FrameGraph = std::make_unique<TaskGraph>(EngineTaskQueue::Get(), m_MaxFramesInFlight);
+
+		TaskGraph::StageIndex pollEvents = m_FrameGraph->AddStage("Frame - PollEvents", EThread::Main, [this]
 		{
-			TRACE_SCOPE("Application Loop");
+			// The previous frame's BuildRendererData has finished, nothing else allocates
+			// the frame memory (the render thread doesn't use it).
+			FrameAllocator::BeginFrame();
 
 			PollEvents();
-
 			m_GlobalDeltaTime = CalculateFrameTime();
+		});
+
+		TaskGraph::StageIndex update = m_FrameGraph->AddStage("Frame - Update", EThread::Main, [this]
+		{
 			Update(m_GlobalDeltaTime);
 			g_pClientApplication->PostUpdate();
-			// This will eventually need to be called after Update,
-			// but during the time the render thread is rendering
-			g_Engine->BuildRendererData(m_GlobalDeltaTime);
 
-			Render();
+			// The render data built in this frame is submitted by the next Render stage,
+			// after the one of this frame advances the game frame index.
+			// The worker stage can't tell which frame it builds from its thread.
+			m_RendererDataIndex = RenderThread::GetFrameDataIndex(RenderThread::GetGameFrameIndex() + 1);
+		}, { pollEvents });
+
+		// The worlds are not modified until the next Update, and the Scene render data
+		// is not used until the next Render, so this runs next to the rest of the frame
+		// (the ImGui draw data build and the submission of the previous frame's render data).
+		TaskGraph::StageIndex buildRendererData = m_FrameGraph->AddStage("Frame - BuildRendererData", EThread::Worker, [this]
+		{
+			g_Engine->BuildRendererData(m_GlobalDeltaTime, m_RendererDataIndex);
+		}, { update });
+
+		TaskGraph::StageIndex buildImGui = m_FrameGraph->AddStage("Frame - BuildImGui", EThread::Main, [this]
+		{
+			ImGui::Render();
+
+			// The next ImGui frame would overwrite the draw data, while it's being rendered.
+			if (RenderThread::IsRunning())
+			{
+				m_ImGuiDrawData[RenderThread::GetCurrentFrameDataIndex()].Capture(ImGui::GetDrawData());
+			}
+		}, { update });
+
+		// Only waits for the render thread if it's more than the frame lag behind.
+		// Draws the Scene render data built in the previous frame (the first frame draws an empty one).
+		TaskGraph::StageIndex render = m_FrameGraph->AddStage("Frame - Render", EThread::Main, [this]
+		{
+			RenderThread::SubmitFrame([this]
+			{
+				Render();
+			});
+		}, { buildImGui }, { buildRendererData });
 
+		m_FrameGraph->AddStage("Frame - ProcessEvents", EThread::Main, [this]
+		{
 			m_EventQueue.ProcessEvents([this](const Event& e)
 			{
 				DispatchEvent(e);
 			});
+		}, { render });
+
+		// The next Update can't modify the worlds while the render data is being built.
+		m_FrameGraph->AddPreviousFrameDependency(update, buildRendererData);
+		// The render data is allocated from the frame memory, which BeginFrame reuses.
+		// This also keeps the next frame from overwriting the delta time it reads.
+		m_FrameGraph->AddPreviousFrameDependency(pollEvents, buildRendererData);
+	}
+
+	void Application::SetRenderThreadEnabled(bool bEnabled)
+	{
+		if (m_FrameGraph)
+		{
+			ApplicationLogger.Error("The render thread can only be enabled before the application is initialized.");
+			return;
+		}
+
+		m_bUseRenderThread = bEnabled;
+	}
+
+	void Application::SetRHI(ERHI rhi)
+	{
+		if (m_FrameGraph)
+		{
+			ApplicationLogger.Error("The RHI can only be set before the application is initialized.");
+			return;
+		}
+
+		m_RHI = rhi;
+	}
+
+	void Application::SetRenderFrameLag(uint32 frameLag)
+	{
+		if (frameLag > RenderThread::MaxFrameLag)
+		{
+			ApplicationLogger.Error("Render frame lag cannot be greater than {}.", RenderThread::MaxFrameLag);
+			return;
+		}
+
+		m_RenderFrameLag = frameLag;
+
+		if (RenderThread::IsRunning())
+			RenderThread::SetFrameLag(frameLag);
+	}
+
+	void Application::SetMaxFramesInFlight(uint32 maxFramesInFlight)
+	{
+		if (maxFramesInFlight < 1 || maxFramesInFlight > TaskGraph::MaxSupportedFramesInFlight)
+		{
+			ApplicationLogger.Error("Max frames in flight has to be between 1 and {}.", TaskGraph::MaxSupportedFramesInFlight);
+			return;
+		}
+
+		m_MaxFramesInFlight = maxFramesInFlight;
+
+		// The graph is created in Init
+		if (m_FrameGraph)
+			m_FrameGraph->SetMaxFramesInFlight(maxFramesInFlight);
+	}
+
+	void Application::RunLoop()
+	{
+		TRACE_FUNCTION();
+
+		ApplicationLogger.Trace("Starting application loop.");
+
+		// Application loop
+		while (m_bRunning)
+		{
+			TRACE_SCOPE("Application Loop");
+
+			m_FrameGraph->RunFrame();
 
 			if (!m_bInFocus)
 			{
@@ -153,6 +284,12 @@ namespace Ion
 
 		ApplicationLogger.Info("Shutting down application.");
 
+		m_FrameGraph.reset();
+
+		// Finish rendering the submitted frames
+		RenderThread::Stop();
+		m_ImGuiDrawData.reset();
+
 		ShutdownImGui();
 
 		{
@@ -205,6 +342,7 @@ namespace Ion
 		TRACE_FUNCTION();
 
 		EngineTaskQueue::Update();
+		TextureStreamer::Update();
 
 		// Don't reset the cursor if the mouse is being held
 		if (!InputManager::IsMouseButtonPressed(EMouse::Left))
@@ -244,9 +382,10 @@ namespace Ion
 	{
 		TRACE_FUNCTION();
 
-		ImGui::Render();
+		// ImGui::Render is called in the BuildImGui frame stage
 
 		RHI::Get()->BeginFrame();
+		Renderer::Get()->BeginFrame();
 		SetRenderTargetToMainWindow();
 
 		{
@@ -261,9 +400,14 @@ namespace Ion
 
 		{
 			TRACE_SCOPE("Render ImGui");
-			ImGuiRenderPlatform(ImGui::GetDrawData());
+			ImDrawData* drawData = RenderThread::IsInRenderThread() ?
+				m_ImGuiDrawData[RenderThread::GetCurrentFrameDataIndex()].GetDrawData() :
+				ImGui::GetDrawData();
+			if (drawData)
+				ImGuiRenderPlatform(drawData);
 		}
 
+		Renderer::Get()->EndFrame();
 		RHI::Get()->EndFrame(m_Window->GetRHIData());
 	}
 
@@ -329,6 +473,9 @@ namespace Ion
 
 		ApplicationLogger.Trace("Resizing application window buffers to [{}x{}].", width, height);
 
+		// The render thread might be presenting the previous frame.
+		RenderThread::Flush();
+
 		//Renderer::Get()->SetViewportDimensions(ViewportDimensions { 0, 0, width, height });
 		RHI::Get()->ResizeBuffers(GetWindow()->GetRHIData(), { width, height });
 	}
@@ -362,6 +509,9 @@ namespace Ion
 			{
 				ApplicationLogger.Debug("Fullscreen Toggle");
 
+				// The render thread might be presenting the previous frame.
+				RenderThread::Flush();
+
 				bool bFullScreen = GetWindow()->IsFullScreenEnabled();
 				GetWindow()->EnableFullScreen(!bFullScreen);
 			}
@@ -399,11 +549,13 @@ namespace Ion
 		imGuiIO.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;
 		imGuiIO.ConfigFlags |= ImGuiConfigFlags_DockingEnable;
 		imGuiIO.ConfigFlags |= ImGuiConfigFlags_NoMouseCursorChange;
-		if (RHI::GetCurrent() == ERHI::DX11
+		// The platform windows are created and rendered on the main thread,
+		// so the viewports can't be used with the render thread.
+		if (!m_bUseRenderThread && (RHI::GetCurrent() == ERHI::DX11
 #if PLATFORM_SUPPORTS_OPENGL && PLATFORM_ENABLE_IMGUI_VIEWPORTS_OPENGL
 			|| RHI::GetCurrent() == ERHI::OpenGL
 #endif
-			)
+			))
 		{
 			imGuiIO.ConfigFlags |= ImGuiConfigFlags_ViewportsEnable;
 		}
@@ -23,10 +23,18 @@ namespace Ion
 	REGISTER_LOGGER(ApplicationLogger, "Application");
 
 	class Renderer;
+	enum class ERHI;
+
+	/* Default number of frames that can run at the same time. */
+	inline constexpr uint32 DefaultMaxFramesInFlight = 2;
+	/* Default number of frames the render thread can be behind the game thread. */
+	inline constexpr uint32 DefaultRenderFrameLag = 1;
 
 	class RHIShader;
 	class IndexBuffer;
 
+	class ImGuiDrawDataSnapshot;
+
 	enum class ECursorType : int8
 	{
 		NoChange = -1, // Don't change the cursor
@@ -76,6 +84,44 @@ namespace Ion
 
 		static Renderer* GetRenderer();
 
+		/**
+		 * @brief Set how many frames of the frame graph can run at the same time.
+		 * Flushes the running frames.
+		 *
+		 * @param maxFramesInFlight 1 to TaskGraph::MaxSupportedFramesInFlight
+		 */
+		void SetMaxFramesInFlight(uint32 maxFramesInFlight);
+		uint32 GetMaxFramesInFlight() const;
+
+		/**
+		 * @brief Render the frames on a dedicated render thread (if the RHI supports it).
+		 * Has to be called before the application is initialized.
+		 *
+		 * @details The Render function (and the client and layer OnRender functions)
+		 * is then called on the render thread, while the game thread updates
+		 * the next frame. It should only use the render data (e.g. the Scene render proxies).
+		 * ImGui multi-viewports are disabled in this mode.
+		 *
+		 * @see RenderThread
+		 */
+		void SetRenderThreadEnabled(bool bEnabled);
+		bool IsRenderThreadEnabled() const;
+
+		/**
+		 * @brief Set how many frames the render thread can be behind the game thread.
+		 *
+		 * @param frameLag 0 to RenderThread::MaxFrameLag
+		 */
+		void SetRenderFrameLag(uint32 frameLag);
+		uint32 GetRenderFrameLag() const;
+
+		/**
+		 * @brief Set the RHI the application will render with (DX11 by default).
+		 * Has to be called before the application is initialized.
+		 */
+		void SetRHI(ERHI rhi);
+		ERHI GetRHI() const;
+
 		static const std::shared_ptr<GenericWindow>& GetWindow();
 		static LayerStack* GetLayerStack();
 		static float GetGlobalDeltaTime();
@@ -123,6 +169,9 @@ namespace Ion
 
 		void SetRenderTargetToMainWindow();
 
+		/* Declares the stages of the application loop. */
+		void SetupFrameGraph();
+
 		void SetupWindowTitle();
 		void UpdateWindowTitle(float deltaTime);
 
@@ -149,6 +198,19 @@ namespace Ion
 
 		std::unique_ptr<LayerStack> m_LayerStack;
 
+		/* Stages of a single application loop iteration. */
+		std::unique_ptr<TaskGraph> m_FrameGraph;
+		uint32 m_MaxFramesInFlight;
+		/* Frame data buffer the BuildRendererData stage writes to (chosen in the Update stage). */
+		uint32 m_RendererDataIndex;
+
+		/* ImGui draw data of the frames that are being rendered on the render thread. */
+		std::unique_ptr<ImGuiDrawDataSnapshot[]> m_ImGuiDrawData;
+		uint32 m_RenderFrameLag;
+		bool m_bUseRenderThread;
+
+		ERHI m_RHI;
+
 		std::thread::id m_MainThreadId;
 
 		//WString m_BaseWindowTitle;
@@ -177,6 +239,26 @@ namespace Ion
 		return m_Fonts;
 	}
 
+	inline uint32 Application::GetMaxFramesInFlight() const
+	{
+		return m_MaxFramesInFlight;
+	}
+
+	inline bool Application::IsRenderThreadEnabled() const
+	{
+		return m_bUseRenderThread;
+	}
+
+	inline uint32 Application::GetRenderFrameLag() const
+	{
+		return m_RenderFrameLag;
+	}
+
+	inline ERHI Application::GetRHI() const
+	{
+		return m_RHI;
+	}
+
 	FORCEINLINE const std::shared_ptr<GenericWindow>& Application::GetWindow()
 	{
 		return Get()->m_Window;
@@ -63,7 +63,7 @@ namespace Ion
 #endif
 
 #define EVENT_CLASS_BODY(type) \
-virtual std::unique_ptr<const Event> Defer() const override { return std::make_unique<TRemoveRef<decltype(*this)>>(*this); } \
+virtual const Event* Defer() const override { return FrameAllocator::New<TRemoveConstRef<decltype(*this)>>(*this); } \
 FORCEINLINE static EEventType GetClassType() { return type; }
 
 	struct NOVTABLE Event
@@ -78,9 +78,15 @@ FORCEINLINE static EEventType GetClassType() { return type; }
 
 		Event(EEventType type, uint32 category);
 
+		virtual ~Event() = default;
+
 		bool IsInCategory(EEventCategory::Type category) const;
 
-		virtual std::unique_ptr<const Event> Defer() const = 0;
+		/**
+		 * @brief Copies the event to the FrameAllocator memory, which stays valid until the end of the next frame.
+		 * The copy has to be destroyed explicitly.
+		 */
+		virtual const Event* Defer() const = 0;
 	};
 
 	inline Event::Event(EEventType type, uint32 category) :
@@ -4,9 +4,17 @@
 
 namespace Ion
 {
+	/**
+	 * @brief Queue of the deferred events.
+	 *
+	 * @details The events and the queue itself live in the FrameAllocator memory,
+	 * so the events have to be processed in the frame they are pushed in or in the next one.
+	 */
 	class EventQueue
 	{
 	public:
+		~EventQueue();
+
 		void PushEvent(const Event& e);
 
 		template<typename F>
@@ -15,9 +23,14 @@ namespace Ion
 		void Clear();
 
 	private:
-		TArray<std::unique_ptr<const Event>> m_Events;
+		TFrameArray<const Event*> m_Events;
 	};
 
+	inline EventQueue::~EventQueue()
+	{
+		Clear();
+	}
+
 	inline void EventQueue::PushEvent(const Event& e)
 	{
 		m_Events.push_back(e.Defer());
@@ -28,15 +41,24 @@ namespace Ion
 	{
 		TRACE_FUNCTION();
 
-		for (std::unique_ptr<const Event>& e : m_Events)
+		// The events pushed by the handler are processed next time.
+		TFrameArray<const Event*> events;
+		events.swap(m_Events);
+
+		for (const Event* e : events)
 		{
 			handler(*e);
+			e->~Event();
 		}
-		Clear();
 	}
 
 	inline void EventQueue::Clear()
 	{
-		m_Events.clear();
+		for (const Event* e : m_Events)
+		{
+			e->~Event();
+		}
+		// Release the array memory too, it's only valid until the next frame ends.
+		TFrameArray<const Event*>().swap(m_Events);
 	}
 }
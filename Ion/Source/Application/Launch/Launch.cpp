@@ -8,6 +8,7 @@
 
 #include "Application/Application.h"
 #include "IonApp.h"
+#include "RHI/RHI.h"
 
 namespace Ion
 {
@@ -28,6 +29,28 @@ namespace Ion
 				EnginePath::SetEnginePath(nextArg);
 				++i;
 			}
+			else if (tstrcmp(arg, TEXT("--framesInFlight")) == 0 && bHasNextArg)
+			{
+				g_pEngineApplication->SetMaxFramesInFlight((uint32)tstrtoul(nextArg));
+				++i;
+			}
+			else if (tstrcmp(arg, TEXT("--renderThread")) == 0)
+			{
+				g_pEngineApplication->SetRenderThreadEnabled(true);
+			}
+			else if (tstrcmp(arg, TEXT("--renderFrameLag")) == 0 && bHasNextArg)
+			{
+				g_pEngineApplication->SetRenderFrameLag((uint32)tstrtoul(nextArg));
+				++i;
+			}
+			else if (tstrcmp(arg, TEXT("--rhi")) == 0 && bHasNextArg)
+			{
+				if      (tstrcmp(nextArg, TEXT("dx11")) == 0)   g_pEngineApplication->SetRHI(ERHI::DX11);
+				else if (tstrcmp(nextArg, TEXT("dx10")) == 0)   g_pEngineApplication->SetRHI(ERHI::DX10);
+				else if (tstrcmp(nextArg, TEXT("opengl")) == 0) g_pEngineApplication->SetRHI(ERHI::OpenGL);
+				else if (tstrcmp(nextArg, TEXT("null")) == 0)   g_pEngineApplication->SetRHI(ERHI::Null);
+				++i;
+			}
 		}
 	}
 
@@ -792,10 +792,12 @@ namespace Ion
 
 		RHI::Get()->ImGuiRender(drawData);
 
-		// @TODO: If viewports enabled:
-
-		ImGui::UpdatePlatformWindows();
-		ImGui::RenderPlatformWindowsDefault();
+		// Disabled when the render thread is used
+		if (ImGui::GetIO().ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
+		{
+			ImGui::UpdatePlatformWindows();
+			ImGui::RenderPlatformWindowsDefault();
+		}
 	}
 
 	void WindowsApplication::ImGuiShutdownPlatform() const
@@ -6,6 +6,8 @@
 #include "AssetDefinition.h"
 #include "Collada.h"
 
+#include "RHI/VertexLayout.h"
+
 namespace Ion
 {
 	// Asset ----------------------------------------------------------------------
@@ -183,9 +185,70 @@ namespace Ion
 		memcpy(meshData->Vertices.Ptr, colladaData.VertexAttributes, colladaData.VertexAttributeCount * sizeof(float));
 		memcpy(meshData->Indices.Ptr, colladaData.Indices, colladaData.IndexCount * sizeof(uint32));
 
+		ComputeMeshBounds(*meshData);
+
 		return meshData;
 	}
 
+	void AssetImporter::ComputeMeshBounds(ImportedMeshData& meshData)
+	{
+		TRACE_FUNCTION();
+
+		ionassert(meshData.Layout);
+
+		const TArray<VertexAttribute>& attributes = meshData.Layout->GetAttributes();
+		auto itPosition = std::find_if(attributes.begin(), attributes.end(), [](const VertexAttribute& attribute)
+		{
+			return attribute.Semantic == EVertexAttributeSemantic::Position;
+		});
+
+		// Leave the bounds invalid, the mesh will never get culled.
+		if (itPosition == attributes.end() ||
+			itPosition->Type != EVertexAttributeType::Float ||
+			itPosition->ElementCount < 3)
+		{
+			AssetLogger.Warn("Cannot compute the mesh bounds, the vertex layout has no float3 position attribute.");
+			return;
+		}
+
+		size_t stride = meshData.Layout->GetStride() / sizeof(float);
+		size_t offset = itPosition->Offset / sizeof(float);
+		if (stride == 0)
+			return;
+
+		size_t vertexCount = meshData.Vertices.Count / stride;
+		const float* vertices = meshData.Vertices.Ptr;
+
+		auto getPosition = [&](size_t index)
+		{
+			const float* position = vertices + index * stride + offset;
+			return Vector3(position[0], position[1], position[2]);
+		};
+
+		AABB bounds = AABB::Invalid();
+		for (size_t i = 0; i < vertexCount; ++i)
+		{
+			bounds.Expand(getPosition(i));
+		}
+
+		if (!bounds.IsValid())
+			return;
+
+		// Sphere around the box center - tighter than the one around the box itself.
+		BoundingSphere sphere;
+		sphere.Center = bounds.GetCenter();
+		float radiusSquared = 0.0f;
+		for (size_t i = 0; i < vertexCount; ++i)
+		{
+			Vector3 toVertex = getPosition(i) - sphere.Center;
+			radiusSquared = std::max(radiusSquared, glm::dot(toVertex, toVertex));
+		}
+		sphere.Radius = std::sqrt(radiusSquared);
+
+		meshData.Bounds = bounds;
+		meshData.Sphere = sphere;
+	}
+
 	std::shared_ptr<Image> AssetImporter::ImportImageAsset(const std::shared_ptr<AssetFileMemoryBlock>& block)
 	{
 		std::shared_ptr<Image> image = std::make_shared<Image>();
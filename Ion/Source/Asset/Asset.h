@@ -149,6 +149,10 @@ namespace Ion
 	public:
 		static std::shared_ptr<ImportedMeshData> ImportColladaMeshAsset(const std::shared_ptr<AssetFileMemoryBlock>& block);
 		static std::shared_ptr<Image> ImportImageAsset(const std::shared_ptr<AssetFileMemoryBlock>& block);
+
+	private:
+		/* Computes the local space AABB and bounding sphere from the vertex positions. */
+		static void ComputeMeshBounds(ImportedMeshData& meshData);
 	};
 }
 
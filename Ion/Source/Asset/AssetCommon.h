@@ -71,10 +71,14 @@ namespace Ion
 		TMemoryBlock<float> Vertices;
 		TMemoryBlock<uint32> Indices;
 		TRef<RHIVertexLayout> Layout;
+		/* Local space bounds, computed from the vertex positions at import time */
+		AABB Bounds;
+		BoundingSphere Sphere;
 
 		ImportedMeshData() :
 			Vertices({ }),
-			Indices({ })
+			Indices({ }),
+			Bounds(AABB::Invalid())
 		{
 		}
 
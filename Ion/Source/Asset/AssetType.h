@@ -11,6 +11,8 @@ namespace Ion
 	class IAssetCustomData
 	{
 	public:
+		ENGINE_ALLOCATED(EMemoryTag::Asset)
+
 		virtual IAssetType& GetType() const = 0;
 	};
 
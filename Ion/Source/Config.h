@@ -10,6 +10,9 @@
 #define ENABLE_D3D10_RHI 1
 // Default: 1
 #define ENABLE_D3D11_RHI 1
+// Headless RHI, that only records the commands (for CPU benchmarks and tests)
+// Default: 1
+#define ENABLE_NULL_RHI 1
 
 // --------------------------------------------------------------------------------------------------------
 // Renderer
@@ -95,6 +95,14 @@ namespace Ion
 		m_bTickEnabled = bTick;
 	}
 
+	void ComponentOld::OnRelocated(ComponentOld* oldAddress)
+	{
+		if (m_OwningEntity)
+		{
+			m_OwningEntity->RebindRelocatedComponent(oldAddress, this);
+		}
+	}
+
 	void ComponentOld::InitAsSceneComponent()
 	{
 		m_bIsSceneComponent = true;
@@ -142,6 +150,40 @@ namespace Ion
 		return nullptr;
 	}
 
+	ComponentHandle ComponentRegistry::GetComponentHandle(ComponentOld* component)
+	{
+		ionassert(component);
+		return GetContainer(component->GetFinalTypeID())->GetHandle(component);
+	}
+
+	ComponentOld* ComponentRegistry::ResolveComponentHandle(ComponentTypeID id, const ComponentHandle& handle)
+	{
+		if (!IsContainerInitialized(id))
+			return nullptr;
+
+		return GetContainer(id)->Resolve(handle);
+	}
+
+	void ComponentRegistry::AddOnComponentRelocated(const TFuncOnComponentRelocated& onRelocated)
+	{
+		ionassert(onRelocated);
+		m_OnComponentRelocated.push_back(onRelocated);
+	}
+
+	void ComponentRegistry::OnComponentRelocated(ComponentOld* oldAddress, ComponentOld* component)
+	{
+		ionassert(oldAddress != component);
+
+		m_ComponentsByGUID[component->GetGUID()] = component;
+
+		component->OnRelocated(oldAddress);
+
+		for (const TFuncOnComponentRelocated& onRelocated : m_OnComponentRelocated)
+		{
+			onRelocated(oldAddress, component);
+		}
+	}
+
 	void ComponentRegistry::MarkForDestroy(ComponentOld* component)
 	{
 		ionassert(component->IsPendingKill());
@@ -158,12 +200,25 @@ namespace Ion
 		// using the MarkForDestroy function.
 		for (auto& [id, container] : m_InvalidComponents)
 		{
+			// Destroying a component moves another one in its place,
+			// so the pointers in the container can get invalidated.
+			// Find the components by GUID instead.
+			TArray<GUID> invalidGuids;
+			invalidGuids.reserve(container.size());
 			for (ComponentOld* invalidComponent : container)
 			{
 				ionassert(id == invalidComponent->GetFinalTypeID());
-				DestroyComponent(invalidComponent);
+				invalidGuids.push_back(invalidComponent->GetGUID());
 			}
 			container.clear();
+
+			for (const GUID& guid : invalidGuids)
+			{
+				if (ComponentOld* invalidComponent = FindComponentByGUID(guid))
+				{
+					DestroyComponent(invalidComponent);
+				}
+			}
 		}
 	}
 
@@ -178,6 +233,12 @@ namespace Ion
 		}
 	}
 
+	void ComponentRegistry::AddDirtyTransformRoot(SceneComponent* component)
+	{
+		ionassert(component);
+		m_DirtyTransformRoots.insert(component->GetGUID());
+	}
+
 	void ComponentRegistry::BuildRendererData(RRendererData& data)
 	{
 		TRACE_FUNCTION();
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "ComponentStorage.h"
+
 /* Do not create custom components with constructors that take parameters.
  * This will not work, because the components are emplaced directly
  * in their containers using the default constructors.
@@ -42,7 +44,7 @@ namespace ComponentSerialCall \
 namespace ComponentSerialCall::Private \
 { \
 	/* Type of the this component container */ \
-	using func##Container = TCompContainer<ThisComponentClass>; /* THashMap<GUID, _ComponentClass_> */ \
+	using func##Container = TCompContainer<ThisComponentClass>; /* TComponentStorage<_ComponentClass_> */ \
 	static String func##TracerName = "DECLARE_COMPONENT_SERIALCALL_HELPER_EX("#func") - " + ThisComponentClass::ClassDisplayName; \
 	/* Function that calls all the components' serialcall functions in the specified component container.
 		It has to be a lambda to avoid symbol redefinition. */ \
@@ -53,13 +55,13 @@ namespace ComponentSerialCall::Private \
 		{ \
 			TRACE_SCOPE(func##TracerName.c_str()); \
 			func##Container& container = *(func##Container*)containerPtr->GetRawContainer(); \
-			/* Call the serialcall functions */ \
-			for (auto& [k, comp] : container) \
+			/* Call the serialcall functions (linear walk over the packed components) */ \
+			container.ForEach([&](ThisComponentClass& comp) \
 			{ \
 				/* Don't call the function if the component is to be destroyed */ \
 				if (comp.IsPendingKill()) return; \
 				forEachBody; \
-			} \
+			}); \
 		} \
 	}; \
 	CALL_OUTSIDE({ \
@@ -117,11 +119,14 @@ public: \
 	using Type          = ComponentContainerImpl; \
 	using ComponentT    = className; \
 	using RawContainerT = RawComponentContainerType; \
-	virtual void Erase(ComponentOld* component) override; \
+	virtual ComponentOld* Erase(ComponentOld* component) override; \
 	virtual ComponentOld* Find(ComponentOld* component) const override; \
+	virtual ComponentHandle GetHandle(ComponentOld* component) const override; \
+	virtual ComponentOld* Resolve(const ComponentHandle& handle) override; \
+	virtual uint32 GetCount() const override; \
+	virtual ComponentOld* GetAt(uint32 index) override; \
 	virtual ComponentTypeID GetTypeID() const override; \
 	virtual void* GetRawContainer() override; \
-	virtual ComponentOld* ForEachHelper(void*& inOutGenericIt) override; \
 	RawComponentContainerType Container; \
 }; \
 static inline const String ClassName = #className; \
@@ -163,20 +168,35 @@ namespace ComponentSerialCall::Private \
 	}; \
 	static OnRegisterListeners s_OnRegisterListeners; \
 } \
-void className::ComponentContainerImpl::Erase(ComponentOld* component) \
+ComponentOld* className::ComponentContainerImpl::Erase(ComponentOld* component) \
 { \
-	ionassert(Container.find(component->GetGUID()) != Container.end()); \
-	Container.erase(component->GetGUID()); \
+	ionassert(Container.Contains(component->GetGUID())); \
+	return Container.Erase(component->GetGUID()); \
 } \
 ComponentOld* className::ComponentContainerImpl::Find(ComponentOld* component) const \
 { \
-	auto it = Container.find(component->GetGUID()); \
-	if (it == Container.end()) \
+	const className* componentPtr = Container.Find(component->GetGUID()); \
+	if (!componentPtr) \
 		return nullptr; \
-	const className* componentPtr = &it->second; \
 	ionassert(componentPtr == component); \
 	return component; \
 } \
+ComponentHandle className::ComponentContainerImpl::GetHandle(ComponentOld* component) const \
+{ \
+	return Container.GetHandle(component->GetGUID()); \
+} \
+ComponentOld* className::ComponentContainerImpl::Resolve(const ComponentHandle& handle) \
+{ \
+	return Container.Resolve(handle); \
+} \
+uint32 className::ComponentContainerImpl::GetCount() const \
+{ \
+	return Container.GetCount(); \
+} \
+ComponentOld* className::ComponentContainerImpl::GetAt(uint32 index) \
+{ \
+	return &Container.At(index); \
+} \
 ComponentTypeID className::ComponentContainerImpl::GetTypeID() const \
 { \
 	return className::GetTypeID(); \
@@ -185,18 +205,6 @@ void* className::ComponentContainerImpl::GetRawContainer() \
 { \
 	return &Container; \
 } \
-ComponentOld* className::ComponentContainerImpl::ForEachHelper(void*& inOutGenericIt) \
-{ \
-	RawComponentContainerType::iterator*& typedIt = (RawComponentContainerType::iterator*&)inOutGenericIt; \
-	if (!typedIt) \
-		typedIt = new RawComponentContainerType::iterator(Container.begin()); \
-	if (*typedIt != Container.end()) \
-		return &((*typedIt)++)->second; \
-	/* Cleanup */ \
-	delete typedIt; \
-	typedIt = nullptr; \
-	return nullptr; \
-} \
 /* ComponentOld class overrides */ \
 ComponentOld* className::Duplicate_Internal(ComponentRegistry& registry) const \
 { \
@@ -271,6 +279,29 @@ if (comp.IsSceneComponent()) \
 	comp.BuildRendererData(data); \
 , RRendererData& data)
 
+/* Put in the component's .cpp file after the DECLARE_ENTITY_COMPONENT_CLASS, instead of
+   DECLARE_COMPONENT_SERIALCALL_BUILDRENDERERDATA, if the component builds the renderer data
+   for the whole container at once, in the static BuildRendererDataBatched function:
+   static void BuildRendererDataBatched(TCompContainer<ThisComponentClass>& container, RRendererData& data); */
+#define DECLARE_COMPONENT_SERIALCALL_BUILDRENDERERDATA_BATCHED() \
+namespace ComponentSerialCall::Private \
+{ \
+	using BuildRendererDataContainer = TCompContainer<ThisComponentClass>; \
+	static String BuildRendererDataTracerName = "DECLARE_COMPONENT_SERIALCALL_BUILDRENDERERDATA_BATCHED - " + ThisComponentClass::ClassDisplayName; \
+	static auto CallEachBuildRendererData = [](Ion::IComponentContainer* containerPtr, RRendererData& data) \
+	{ \
+		TRACE_SCOPE(BuildRendererDataTracerName.c_str()); \
+		BuildRendererDataContainer& container = *(BuildRendererDataContainer*)containerPtr->GetRawContainer(); \
+		ThisComponentClass::BuildRendererDataBatched(container, data); \
+	}; \
+	CALL_OUTSIDE({ \
+		s_OnRegisterListeners.Add([] \
+		{ \
+			BuildRendererData_AddFunctionForType(ThisComponentClass::GetTypeID(), ThisComponentClass::ClassName, CallEachBuildRendererData); \
+		}); \
+	}, BuildRendererDataImplement); \
+}
+
 /* For documentation purposes */
 #define SERIALCALL
 
@@ -324,10 +355,9 @@ namespace Ion
 	class ComponentRegistry;
 	class IComponentContainer;
 
-	// @TODO: Change this to something more efficient
 	/* Container for Components of type T */
 	template<typename T>
-	using TCompContainer = THashMap<GUID, T>;
+	using TCompContainer = TComponentStorage<T>;
 
 	using InstantiateComponentFPtr          = ComponentOld*(*)(ComponentRegistry*);
 	using InstantiateComponentContainerFPtr = IComponentContainer*(*)(ComponentRegistry*);
@@ -702,6 +732,10 @@ namespace Ion
 	protected:
 		ComponentOld();
 
+		/* Called by the ComponentRegistry after the component has been moved
+		   in the container. Fixes up the pointers to the component. */
+		virtual void OnRelocated(ComponentOld* oldAddress);
+
 		void InitAsSceneComponent();
 
 	public:
@@ -738,17 +772,24 @@ namespace Ion
 		// emplace components because the type has to be known.
 		// FInstantiateComponent is used for that.
 
-		virtual void Erase(ComponentOld* component) = 0;
+		virtual ~IComponentContainer() { }
+
+		/* Swap-removes the component (the last component is moved in its place).
+		   Returns the previous address of the moved component, or nullptr. */
+		virtual ComponentOld* Erase(ComponentOld* component) = 0;
 		virtual ComponentOld* Find(ComponentOld* component) const = 0;
 
+		virtual ComponentHandle GetHandle(ComponentOld* component) const = 0;
+		virtual ComponentOld* Resolve(const ComponentHandle& handle) = 0;
+
+		virtual uint32 GetCount() const = 0;
+		virtual ComponentOld* GetAt(uint32 index) = 0;
+
 		virtual ComponentTypeID GetTypeID() const = 0;
 		virtual void* GetRawContainer() = 0;
 
 		template<typename Lambda>
 		void ForEach(Lambda forEach);
-
-	private:
-		virtual ComponentOld* ForEachHelper(void*& inOutGenericIt) = 0;
 	};
 
 	/** Lambda type must be void(ComponentOld*) */
@@ -757,17 +798,20 @@ namespace Ion
 	{
 		// For Each lambda type check
 		static_assert(TIsConvertibleV<Lambda, TFunction<void(ComponentOld*)>>);
-		
-		void* genericIt = nullptr;
-		while (ComponentOld* comp = ForEachHelper(genericIt))
+
+		// Components added in forEach are not visited.
+		uint32 count = GetCount();
+		for (uint32 i = 0; i < count; ++i)
 		{
-			forEach(comp);
+			forEach(GetAt(i));
 		}
 	}
 
 	class ION_API ComponentRegistry
 	{
 	public:
+		using TFuncOnComponentRelocated = TFunction<void(ComponentOld* /* oldAddress */, ComponentOld* /* component */)>;
+
 		ComponentRegistry(World* worldContext);
 		~ComponentRegistry();
 
@@ -790,6 +834,17 @@ namespace Ion
 
 		ComponentOld* FindComponentByGUID(const GUID& guid) const;
 
+		/* Handles stay valid when the component is moved in its container. */
+		ComponentHandle GetComponentHandle(ComponentOld* component);
+		/* Returns nullptr if the component has been destroyed. */
+		ComponentOld* ResolveComponentHandle(ComponentTypeID id, const ComponentHandle& handle);
+		template<typename CompT>
+		CompT* ResolveComponentHandle(const ComponentHandle& handle);
+
+		/* Destroying a component moves another one of the same type in its place.
+		   Anything that holds raw component pointers has to update them in the callback. */
+		void AddOnComponentRelocated(const TFuncOnComponentRelocated& onRelocated);
+
 		/** Lambda type must be void(ComponentOld*) */
 		template<typename Lambda>
 		void ForEachComponentOfType(ComponentTypeID id, Lambda forEach);
@@ -813,6 +868,13 @@ namespace Ion
 		void Update(float deltaTime);
 		void BuildRendererData(RRendererData& data);
 
+		/* Called by a scene component when its world transform becomes dirty
+		   and the transform of its parent is up to date. */
+		void AddDirtyTransformRoot(SceneComponent* component);
+		/* Recomputes the world transforms of the dirty scene components,
+		   parents before children. Call once per frame, before the renderer data is built. */
+		void UpdateWorldTransforms();
+
 		static const ComponentDatabase* GetComponentTypeDatabase();
 
 		static const THashMap<ComponentTypeID, ComponentDatabase::TypeInfo>& GetRegisteredTypes();
@@ -824,6 +886,9 @@ namespace Ion
 		template<typename CompT>
 		static CompT& EmplaceDuplicateComponentInContainer(TCompContainer<CompT>& container, const CompT* component);
 
+		/* Called after a component has been moved in its container. */
+		void OnComponentRelocated(ComponentOld* oldAddress, ComponentOld* component);
+
 	private:
 		template<typename CompT>
 		void InitializeComponentContainter();
@@ -845,6 +910,12 @@ namespace Ion
 		THashMap<ComponentTypeID, TArray<ComponentOld*>> m_InvalidComponents;
 		THashMap<GUID, ComponentOld*> m_ComponentsByGUID;
 
+		TArray<TFuncOnComponentRelocated> m_OnComponentRelocated;
+
+		THashSet<GUID> m_DirtyTransformRoots;
+		/* Reused by UpdateWorldTransforms */
+		TArray<SceneComponent*> m_FlatTransformHierarchy;
+
 		World* m_WorldContext;
 
 		template<typename T>
@@ -1037,18 +1108,21 @@ namespace Ion
 
 			GUID guid = component->GetGUID();
 
-			auto it = container.find(guid);
-			if (it == container.end())
+			CompT* componentPtr = container.Find(guid);
+			if (!componentPtr)
 			{
 				ComponentLogger.Error("Component does not exist in the registry.\nGUID = {0}", component->GetGUID());
 				return;
 			}
-			CompT* componentPtr = &it->second;
 			ionassert(componentPtr == component);
 			component->OnDestroy();
 
-			container.erase(guid);
 			m_ComponentsByGUID.erase(guid);
+			// The last component of the type is moved in place of the destroyed one.
+			if (CompT* movedFrom = container.Erase(guid))
+			{
+				OnComponentRelocated(movedFrom, component);
+			}
 		}
 	}
 
@@ -1071,7 +1145,11 @@ namespace Ion
 				component->OnDestroy();
 
 				m_ComponentsByGUID.erase(component->GetGUID());
-				container->Erase(component);
+				// The last component of the type is moved in place of the destroyed one.
+				if (ComponentOld* movedFrom = container->Erase(component))
+				{
+					OnComponentRelocated(movedFrom, component);
+				}
 			}
 			else
 			{
@@ -1202,13 +1280,22 @@ namespace Ion
 		return database->RegisteredTypes;
 	}
 
+	template<typename CompT>
+	inline CompT* ComponentRegistry::ResolveComponentHandle(const ComponentHandle& handle)
+	{
+		static_assert(TIsBaseOfV<ComponentOld, CompT> && TIsComponentTypeFinal<CompT>);
+
+		if (!IsContainerInitialized<CompT>())
+			return nullptr;
+
+		return GetRawContainer<CompT>().Resolve(handle);
+	}
+
 	template<typename CompT, typename... Args>
 	CompT& ComponentRegistry::EmplaceComponentInContainer(TCompContainer<CompT>& container, Args&&... args)
 	{
 		CompT component(Forward<Args>(args)...);
-		auto [it, bUnique] = container.emplace(component.GetGUID(), Move(component));
-		ionassert(bUnique, "GUID collision?");
-		return it->second;
+		return container.Emplace(Move(component));
 	}
 
 	template<typename CompT>
@@ -1217,9 +1304,7 @@ namespace Ion
 		CompT newComponent(*component);
 		// Make sure the new component has a different GUID
 		newComponent.m_GUID = GUID();
-		auto [it, bUnique] = container.emplace(newComponent.GetGUID(), Move(newComponent));
-		ionassert(bUnique, "GUID collision?");
-		return it->second;
+		return container.Emplace(Move(newComponent));
 	}
 
 	template<typename T>
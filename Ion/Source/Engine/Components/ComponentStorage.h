@@ -0,0 +1,317 @@
+#pragma once
+
+namespace Ion
+{
+	/**
+	 * @brief Stable reference to a component in a TComponentStorage.
+	 *
+	 * @details Unlike a pointer, a handle stays valid when the component
+	 * is moved in the storage, and gets invalidated when the component
+	 * is destroyed (the slot generation changes).
+	 */
+	struct ComponentHandle
+	{
+		static constexpr uint32 InvalidIndex = (uint32)-1;
+
+		uint32 Index = InvalidIndex;
+		uint32 Generation = 0;
+
+		bool IsValid() const { return Index != InvalidIndex; }
+
+		bool operator==(const ComponentHandle& other) const { return Index == other.Index && Generation == other.Generation; }
+		bool operator!=(const ComponentHandle& other) const { return !(*this == other); }
+	};
+
+	/**
+	 * @brief Packed storage of components of a single type.
+	 *
+	 * @details The components are stored contiguously (dense indices 0 to Count - 1)
+	 * in fixed size pages, so iterating over them is a linear memory walk,
+	 * and adding components never moves the existing ones.
+	 * Erasing a component moves the last one in its place (swap-remove),
+	 * the caller has to fix up the pointers to the moved component.
+	 *
+	 * The components can be found by GUID (GUID -> dense index table)
+	 * or by a ComponentHandle (sparse slot -> dense index).
+	 *
+	 * @tparam T Final component type
+	 */
+	template<typename T>
+	class TComponentStorage
+	{
+	public:
+		/* Number of components in a single page. */
+		static constexpr uint32 PageSize = 128;
+
+		TComponentStorage();
+		~TComponentStorage();
+
+		TComponentStorage(const TComponentStorage&) = delete;
+		TComponentStorage& operator=(const TComponentStorage&) = delete;
+
+		/**
+		 * @brief Moves the component to the end of the storage.
+		 *
+		 * @return Reference to the component in the storage
+		 */
+		T& Emplace(T&& component);
+
+		/**
+		 * @brief Erases the component using the swap-remove.
+		 *
+		 * @return The previous address of the component that has been
+		 * moved in place of the erased one, or nullptr if nothing has been moved.
+		 * The moved component is now at the address of the erased one.
+		 */
+		T* Erase(const GUID& guid);
+
+		T* Find(const GUID& guid);
+		const T* Find(const GUID& guid) const;
+		bool Contains(const GUID& guid) const;
+
+		ComponentHandle GetHandle(const GUID& guid) const;
+		/* Returns nullptr if the handle is no longer valid. */
+		T* Resolve(const ComponentHandle& handle);
+
+		uint32 GetCount() const;
+		bool IsEmpty() const;
+
+		/* Component at the dense index. The index of a component can change on Erase. */
+		T& At(uint32 index);
+		const T& At(uint32 index) const;
+
+		/** Lambda type must be void(T&) */
+		template<typename Lambda>
+		void ForEach(Lambda forEach);
+
+		void Clear();
+
+	private:
+		struct Slot
+		{
+			uint32 DenseIndex;
+			uint32 Generation;
+		};
+
+		T* GetPtr(uint32 index) const;
+		void AddPage();
+
+	private:
+		TArray<T*> m_Pages;
+		uint32 m_Count;
+
+		/* Dense index -> sparse slot */
+		TArray<uint32> m_DenseToSlot;
+		/* Sparse slot -> dense index (stable handles) */
+		TArray<Slot> m_Slots;
+		TArray<uint32> m_FreeSlots;
+
+		THashMap<GUID, uint32> m_IndexByGUID;
+	};
+
+	template<typename T>
+	inline TComponentStorage<T>::TComponentStorage() :
+		m_Count(0)
+	{
+	}
+
+	template<typename T>
+	inline TComponentStorage<T>::~TComponentStorage()
+	{
+		Clear();
+		for (T* page : m_Pages)
+		{
+			::operator delete(page, std::align_val_t(alignof(T)));
+		}
+	}
+
+	template<typename T>
+	inline T& TComponentStorage<T>::Emplace(T&& component)
+	{
+		ionassert(!Contains(component.GetGUID()), "GUID collision?");
+
+		if (m_Count == (uint32)m_Pages.size() * PageSize)
+		{
+			AddPage();
+		}
+
+		uint32 index = m_Count++;
+		T* ptr = new(GetPtr(index)) T(Move(component));
+
+		uint32 slot;
+		if (!m_FreeSlots.empty())
+		{
+			slot = m_FreeSlots.back();
+			m_FreeSlots.pop_back();
+			m_Slots[slot].DenseIndex = index;
+		}
+		else
+		{
+			slot = (uint32)m_Slots.size();
+			m_Slots.push_back(Slot { index, 0 });
+		}
+		m_DenseToSlot.push_back(slot);
+
+		m_IndexByGUID.emplace(ptr->GetGUID(), index);
+
+		return *ptr;
+	}
+
+	template<typename T>
+	inline T* TComponentStorage<T>::Erase(const GUID& guid)
+	{
+		auto it = m_IndexByGUID.find(guid);
+		ionassert(it != m_IndexByGUID.end());
+
+		uint32 index = it->second;
+		uint32 lastIndex = m_Count - 1;
+		m_IndexByGUID.erase(it);
+
+		// Invalidate the handles to the erased component
+		uint32 erasedSlot = m_DenseToSlot[index];
+		m_Slots[erasedSlot].DenseIndex = ComponentHandle::InvalidIndex;
+		++m_Slots[erasedSlot].Generation;
+		m_FreeSlots.push_back(erasedSlot);
+
+		T* erased = GetPtr(index);
+		erased->~T();
+
+		T* movedFrom = nullptr;
+		if (index != lastIndex)
+		{
+			T* last = GetPtr(lastIndex);
+			new(erased) T(Move(*last));
+			last->~T();
+			movedFrom = last;
+
+			uint32 movedSlot = m_DenseToSlot[lastIndex];
+			m_Slots[movedSlot].DenseIndex = index;
+			m_DenseToSlot[index] = movedSlot;
+			m_IndexByGUID.at(erased->GetGUID()) = index;
+		}
+
+		m_DenseToSlot.pop_back();
+		--m_Count;
+
+		return movedFrom;
+	}
+
+	template<typename T>
+	inline T* TComponentStorage<T>::Find(const GUID& guid)
+	{
+		auto it = m_IndexByGUID.find(guid);
+		if (it == m_IndexByGUID.end())
+			return nullptr;
+		return GetPtr(it->second);
+	}
+
+	template<typename T>
+	inline const T* TComponentStorage<T>::Find(const GUID& guid) const
+	{
+		auto it = m_IndexByGUID.find(guid);
+		if (it == m_IndexByGUID.end())
+			return nullptr;
+		return GetPtr(it->second);
+	}
+
+	template<typename T>
+	inline bool TComponentStorage<T>::Contains(const GUID& guid) const
+	{
+		return m_IndexByGUID.find(guid) != m_IndexByGUID.end();
+	}
+
+	template<typename T>
+	inline ComponentHandle TComponentStorage<T>::GetHandle(const GUID& guid) const
+	{
+		auto it = m_IndexByGUID.find(guid);
+		if (it == m_IndexByGUID.end())
+			return ComponentHandle();
+
+		uint32 slot = m_DenseToSlot[it->second];
+		return ComponentHandle { slot, m_Slots[slot].Generation };
+	}
+
+	template<typename T>
+	inline T* TComponentStorage<T>::Resolve(const ComponentHandle& handle)
+	{
+		if (!handle.IsValid() || handle.Index >= (uint32)m_Slots.size())
+			return nullptr;
+
+		const Slot& slot = m_Slots[handle.Index];
+		if (slot.Generation != handle.Generation || slot.DenseIndex == ComponentHandle::InvalidIndex)
+			return nullptr;
+
+		return GetPtr(slot.DenseIndex);
+	}
+
+	template<typename T>
+	inline uint32 TComponentStorage<T>::GetCount() const
+	{
+		return m_Count;
+	}
+
+	template<typename T>
+	inline bool TComponentStorage<T>::IsEmpty() const
+	{
+		return m_Count == 0;
+	}
+
+	template<typename T>
+	inline T& TComponentStorage<T>::At(uint32 index)
+	{
+		ionassert(index < m_Count);
+		return *GetPtr(index);
+	}
+
+	template<typename T>
+	inline const T& TComponentStorage<T>::At(uint32 index) const
+	{
+		ionassert(index < m_Count);
+		return *GetPtr(index);
+	}
+
+	template<typename T>
+	template<typename Lambda>
+	inline void TComponentStorage<T>::ForEach(Lambda forEach)
+	{
+		// Components added in forEach are not visited.
+		uint32 count = m_Count;
+		for (uint32 pageIndex = 0; pageIndex * PageSize < count; ++pageIndex)
+		{
+			T* page = m_Pages[pageIndex];
+			uint32 pageCount = std::min(PageSize, count - pageIndex * PageSize);
+			for (uint32 i = 0; i < pageCount; ++i)
+			{
+				forEach(page[i]);
+			}
+		}
+	}
+
+	template<typename T>
+	inline void TComponentStorage<T>::Clear()
+	{
+		for (uint32 i = 0; i < m_Count; ++i)
+		{
+			GetPtr(i)->~T();
+		}
+		m_Count = 0;
+
+		m_DenseToSlot.clear();
+		m_Slots.clear();
+		m_FreeSlots.clear();
+		m_IndexByGUID.clear();
+	}
+
+	template<typename T>
+	FORCEINLINE T* TComponentStorage<T>::GetPtr(uint32 index) const
+	{
+		return m_Pages[index / PageSize] + index % PageSize;
+	}
+
+	template<typename T>
+	inline void TComponentStorage<T>::AddPage()
+	{
+		void* page = ::operator new(sizeof(T) * PageSize, std::align_val_t(alignof(T)));
+		m_Pages.push_back((T*)page);
+	}
+}
@@ -11,7 +11,7 @@ namespace Ion
 {
 	DECLARE_ENTITY_COMPONENT_CLASS(MeshComponent)
 
-	DECLARE_COMPONENT_SERIALCALL_BUILDRENDERERDATA()
+	DECLARE_COMPONENT_SERIALCALL_BUILDRENDERERDATA_BATCHED()
 
 	void MeshComponent::OnCreate()
 	{
@@ -20,19 +20,93 @@ namespace Ion
 
 	void MeshComponent::BuildRendererData(RRendererData& data)
 	{
-		// @TODO: Takes 1.5-2ms for 10k components
-
 		ionassert(GetOwner());
 
-		if (!m_Mesh)
+		if (ShouldExtractRenderProxy())
+		{
+			RPrimitiveRenderProxy proxy;
+			FillRenderProxy(proxy, Renderer::Get()->GetBasicShader().Raw());
+			data.AddPrimitive(proxy);
+		}
+	}
+
+	void MeshComponent::BuildRendererDataBatched(TCompContainer<MeshComponent>& container, RRendererData& data)
+	{
+		TRACE_FUNCTION();
+
+		uint32 count = container.GetCount();
+		if (count == 0)
 			return;
 
-		// @TODO: Make a check to see if the mesh can be rendered.
-		if (!m_Mesh->GetVertexBufferRaw() || !m_Mesh->GetIndexBufferRaw())
+		uint32 batchCount = (count + RenderProxyBatchSize - 1) / RenderProxyBatchSize;
+
+		// Each batch writes to its own range of the buffers, so no locking is needed.
+		// The buffers are kept between the frames to avoid reallocating them.
+		thread_local TArray<RPrimitiveRenderProxy> t_BatchProxies;
+		thread_local TArray<uint32> t_BatchProxyCounts;
+		thread_local TArray<uint32> t_BatchOffsets;
+
+		TArray<RPrimitiveRenderProxy>& batchProxies = t_BatchProxies;
+		TArray<uint32>& batchProxyCounts = t_BatchProxyCounts;
+		TArray<uint32>& batchOffsets = t_BatchOffsets;
+
+		if (batchProxies.size() < count)
+			batchProxies.resize(count);
+		batchProxyCounts.resize(batchCount);
+		batchOffsets.resize(batchCount);
+
+		const RHIShader* basicShader = Renderer::Get()->GetBasicShader().Raw();
+
+		{
+			TRACE_SCOPE("MeshComponent::BuildRendererDataBatched - Extract");
+
+			EngineTaskQueue::ParallelFor(0, batchCount, 1, [&](int64 batchIndex)
+			{
+				uint32 first = (uint32)batchIndex * RenderProxyBatchSize;
+				uint32 last = std::min(first + RenderProxyBatchSize, count);
+
+				// Gather the indices of the components that will be rendered first,
+				// so the proxy building loop doesn't have to branch on each component.
+				uint32 renderedIndices[RenderProxyBatchSize];
+				uint32 renderedCount = 0;
+				for (uint32 i = first; i < last; ++i)
+				{
+					renderedIndices[renderedCount] = i;
+					renderedCount += (uint32)container.At(i).ShouldExtractRenderProxy();
+				}
+
+				RPrimitiveRenderProxy* outProxies = &batchProxies[first];
+				for (uint32 n = 0; n < renderedCount; ++n)
+				{
+					container.At(renderedIndices[n]).FillRenderProxy(outProxies[n], basicShader);
+				}
+
+				batchProxyCounts[batchIndex] = renderedCount;
+			});
+		}
+
+		uint32 totalCount = 0;
+		for (uint32 batchIndex = 0; batchIndex < batchCount; ++batchIndex)
+		{
+			batchOffsets[batchIndex] = totalCount;
+			totalCount += batchProxyCounts[batchIndex];
+		}
+
+		if (totalCount == 0)
 			return;
 
-		if (ShouldBeRendered())
-			data.AddPrimitive(AsRenderProxy());
+		{
+			TRACE_SCOPE("MeshComponent::BuildRendererDataBatched - Merge");
+
+			size_t firstPrimitive = data.Primitives.size();
+			data.Primitives.resize(firstPrimitive + totalCount);
+			RPrimitiveRenderProxy* outPrimitives = &data.Primitives[firstPrimitive];
+
+			EngineTaskQueue::ParallelFor(0, batchCount, 4, [&](int64 batchIndex)
+			{
+				std::copy_n(&batchProxies[batchIndex * RenderProxyBatchSize], batchProxyCounts[batchIndex], outPrimitives + batchOffsets[batchIndex]);
+			});
+		}
 	}
 
 	void MeshComponent::SetMeshFromAsset(const Asset& asset)
@@ -75,32 +149,63 @@ namespace Ion
 		return m_Mesh;
 	}
 
-	RPrimitiveRenderProxy MeshComponent::AsRenderProxy() const
+	bool MeshComponent::ShouldExtractRenderProxy() const
 	{
-		ionassert(m_Mesh);
+		// Pending kill components are already detached from the owner.
+		const Mesh* mesh = m_Mesh.get();
+		if (!mesh || IsPendingKill())
+			return false;
+
+		ionassert(GetOwner());
+
+		// Non-short-circuiting to avoid the branches.
+		return (mesh->GetVertexBufferRaw() != nullptr) &
+			(mesh->GetIndexBufferRaw() != nullptr) &
+			IsVisible() &
+			GetOwner()->IsVisible();
+	}
 
-		Transform worldTransform = GetWorldTransform();
+	void MeshComponent::FillRenderProxy(RPrimitiveRenderProxy& outProxy, const RHIShader* defaultShader) const
+	{
+		ionassert(m_Mesh);
 
-		RHIShader* shader = Renderer::Get()->GetBasicShader().Raw();
+		const RHIShader* shader = defaultShader;
+		const RHIShader* instancedShader = nullptr;
 
-		std::shared_ptr<MaterialInstance> materialInstance = m_Mesh->GetMaterialInSlot(0);
+		// Don't copy the shared pointers - this is called for every mesh on many threads.
+		const MaterialInstance* materialInstance = m_Mesh->GetMaterialInSlotRaw(0);
 		if (materialInstance)
 		{
-			const std::shared_ptr<Material>& material = materialInstance->GetBaseMaterial();
-			if (material)
+			const Material* material = materialInstance->GetBaseMaterial().get();
+			// The shaders are compiled asynchronously, draw the mesh with the default shader until then.
+			if (material && material->IsCompiled(EShaderUsage::StaticMesh))
 			{
 				shader = material->GetShader(EShaderUsage::StaticMesh).Raw();
+				instancedShader = material->GetShaderOrFallback(EShaderUsage::StaticMeshInstanced, nullptr);
+			}
+			else
+			{
+				materialInstance = nullptr;
 			}
 		}
 
-		RPrimitiveRenderProxy mesh { };
-		mesh.Transform        = worldTransform.GetMatrix();
-		mesh.MaterialInstance = materialInstance.get();
-		mesh.Shader           = shader;
-		mesh.VertexBuffer     = m_Mesh->GetVertexBufferRaw();
-		mesh.IndexBuffer      = m_Mesh->GetIndexBufferRaw();
-		mesh.UniformBuffer    = m_Mesh->GetUniformBufferRaw();
+		const Matrix4& worldMatrix = GetWorldTransform().GetMatrix();
+		const AABB& localBounds = m_Mesh->GetBounds();
+
+		outProxy.Transform        = worldMatrix;
+		outProxy.Bounds           = localBounds.IsValid() ? Math::TransformAABB(worldMatrix, localBounds) : AABB::Invalid();
+		outProxy.MaterialInstance = materialInstance;
+		outProxy.Shader           = shader;
+		outProxy.InstancedShader  = instancedShader;
+		outProxy.VertexBuffer     = m_Mesh->GetVertexBufferRaw();
+		outProxy.IndexBuffer      = m_Mesh->GetIndexBufferRaw();
+		outProxy.UniformBuffer    = m_Mesh->GetUniformBufferRaw();
+	}
 
+	RPrimitiveRenderProxy MeshComponent::AsRenderProxy() const
+	{
+		RPrimitiveRenderProxy mesh { };
+		FillRenderProxy(mesh, Renderer::Get()->GetBasicShader().Raw());
 		return mesh;
 	}
 }
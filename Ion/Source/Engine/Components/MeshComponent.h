@@ -17,6 +17,8 @@ namespace Ion
 		virtual void OnCreate() override;
 
 		void SERIALCALL BuildRendererData(RRendererData& data);
+		/* Extracts the render proxies of all the mesh components in parallel. */
+		static void SERIALCALL BuildRendererDataBatched(TCompContainer<MeshComponent>& container, RRendererData& data);
 
 		void SetMeshFromAsset(const Asset& asset);
 
@@ -31,6 +33,14 @@ namespace Ion
 
 		RPrimitiveRenderProxy AsRenderProxy() const;
 
+		/* Number of components processed by a single job in BuildRendererDataBatched. */
+		static constexpr uint32 RenderProxyBatchSize = 512;
+
+	private:
+		/* Checks if the mesh is visible and can be rendered. */
+		bool ShouldExtractRenderProxy() const;
+		void FillRenderProxy(RPrimitiveRenderProxy& outProxy, const RHIShader* defaultShader) const;
+
 	private:
 		Asset m_MeshAsset;
 		TSharedPtr<MeshResource> m_MeshResource;
@@ -2,6 +2,7 @@
 
 #include "SceneComponent.h"
 #include "Engine/Entity/EntityOld.h"
+#include "Engine/World.h"
 
 namespace Ion
 {
@@ -13,28 +14,28 @@ namespace Ion
 	{
 		m_RelativeTransform = transform;
 
-		UpdateWorldTransformCache();
+		MarkWorldTransformDirty();
 	}
 
 	void SceneComponent::SetLocation(const Vector3& location)
 	{
 		m_RelativeTransform.SetLocation(location);
 
-		UpdateWorldTransformCache();
+		MarkWorldTransformDirty();
 	}
 
 	void SceneComponent::SetRotation(const Rotator& rotation)
 	{
 		m_RelativeTransform.SetRotation(rotation);
 
-		UpdateWorldTransformCache();
+		MarkWorldTransformDirty();
 	}
 
 	void SceneComponent::SetScale(const Vector3& scale)
 	{
 		m_RelativeTransform.SetScale(scale);
 
-		UpdateWorldTransformCache();
+		MarkWorldTransformDirty();
 	}
 
 	void SceneComponent::SetVisible(bool bVisible)
@@ -78,7 +79,7 @@ namespace Ion
 		m_Parent = parent;
 		m_Parent->AddChild(this);
 
-		UpdateWorldTransformCache();
+		OnTransformParentChanged();
 	}
 
 	SceneComponent* SceneComponent::Detach()
@@ -92,7 +93,7 @@ namespace Ion
 		}
 		GetOwner()->UnbindComponent(this);
 
-		UpdateWorldTransformCache();
+		OnTransformParentChanged();
 
 		return this;
 	}
@@ -112,9 +113,28 @@ namespace Ion
 			child = child->DeepDuplicate();
 			child->m_Parent = component;
 		}
+		// The copied dirty flag doesn't add the duplicate to the dirty transform roots.
+		component->m_bWorldTransformDirty = false;
+		component->MarkWorldTransformDirty();
 		return component;
 	}
 
+	void SceneComponent::OnRelocated(ComponentOld* oldAddress)
+	{
+		ComponentOld::OnRelocated(oldAddress);
+
+		if (m_Parent)
+		{
+			auto it = std::find(m_Parent->m_Children.begin(), m_Parent->m_Children.end(), (SceneComponent*)oldAddress);
+			ionassert(it != m_Parent->m_Children.end());
+			*it = this;
+		}
+		for (SceneComponent* child : m_Children)
+		{
+			child->m_Parent = this;
+		}
+	}
+
 	void SceneComponent::AddChild(SceneComponent* component)
 	{
 		TRACE_FUNCTION();
@@ -145,39 +165,154 @@ namespace Ion
 		}
 	}
 
-	void SceneComponent::UpdateWorldTransformCache()
+	template<typename Lambda>
+	inline void SceneComponent::ForEachTransformChild(Lambda forEach) const
+	{
+		for (SceneComponent* child : m_Children)
+		{
+			forEach(child);
+		}
+
+		// The root components of the child entities
+		EntityOld* owner = GetOwner();
+		if (owner && owner->GetRootComponent() == this)
+		{
+			for (const TObjectPtr<EntityOld>& childEntity : owner->GetChildren())
+			{
+				if (SceneComponent* childRoot = childEntity->GetRootComponent())
+				{
+					forEach(childRoot);
+				}
+			}
+		}
+	}
+
+	SceneComponent* SceneComponent::GetTransformParent() const
 	{
 		if (m_Parent)
+			return m_Parent;
+
+		EntityOld* owner = GetOwner();
+		if (owner && owner->GetParent() && owner->GetRootComponent() == this)
+		{
+			ionassert(owner->GetParent()->GetRootComponent());
+			return owner->GetParent()->GetRootComponent();
+		}
+		return nullptr;
+	}
+
+	void SceneComponent::MarkWorldTransformDirty()
+	{
+		// The descendants of a dirty component are always dirty too.
+		if (m_bWorldTransformDirty)
+			return;
+
+		m_bWorldTransformDirty = true;
+
+		TryAddDirtyTransformRoot();
+
+		ForEachTransformChild([](SceneComponent* child)
+		{
+			child->MarkWorldTransformDirty();
+		});
+	}
+
+	void SceneComponent::OnTransformParentChanged()
+	{
+		if (!m_bWorldTransformDirty)
+		{
+			MarkWorldTransformDirty();
+			return;
+		}
+
+		// The descendants are dirty already, they are updated along with this component.
+		TryAddDirtyTransformRoot();
+	}
+
+	void SceneComponent::TryAddDirtyTransformRoot()
+	{
+		SceneComponent* parent = GetTransformParent();
+		if (GetWorldContext() && (!parent || !parent->m_bWorldTransformDirty))
 		{
-			m_WorldTransformCache = m_RelativeTransform * m_Parent->GetWorldTransform();
+			GetWorldContext()->GetComponentRegistry().AddDirtyTransformRoot(this);
+		}
+	}
+
+	void SceneComponent::ResolveWorldTransform() const
+	{
+		// GetWorldTransform resolves the dirty ancestors first.
+		if (SceneComponent* parent = GetTransformParent())
+		{
+			m_WorldTransformCache = m_RelativeTransform * parent->GetWorldTransform();
 		}
 		else
 		{
-			if (GetOwner() && GetOwner()->GetParent())
+			m_WorldTransformCache = m_RelativeTransform;
+		}
+		m_bWorldTransformDirty = false;
+	}
+
+	// ComponentRegistry
+
+	void ComponentRegistry::UpdateWorldTransforms()
+	{
+		TRACE_FUNCTION();
+
+		// Flatten the dirty subtrees, so that each parent comes before its children.
+		TArray<SceneComponent*>& flatHierarchy = m_FlatTransformHierarchy;
+		flatHierarchy.clear();
+
+		for (const GUID& guid : m_DirtyTransformRoots)
+		{
+			SceneComponent* root = (SceneComponent*)FindComponentByGUID(guid);
+			if (!root)
+				continue;
+
+			// The subtree will be updated along with the dirty ancestor.
+			SceneComponent* parent = root->GetTransformParent();
+			if (parent && parent->m_bWorldTransformDirty)
+				continue;
+
+			size_t first = flatHierarchy.size();
+			flatHierarchy.push_back(root);
+			for (size_t i = first; i < flatHierarchy.size(); ++i)
+			{
+				flatHierarchy[i]->ForEachTransformChild([&flatHierarchy](SceneComponent* child)
+				{
+					flatHierarchy.push_back(child);
+				});
+			}
+		}
+		m_DirtyTransformRoots.clear();
+
+		// Compose the matrices in order - the parent is always up to date at this point.
+		for (SceneComponent* component : flatHierarchy)
+		{
+			if (SceneComponent* parent = component->GetTransformParent())
 			{
-				ionassert(GetOwner()->GetParent()->GetRootComponent());
-				m_WorldTransformCache = m_RelativeTransform * GetOwner()->GetParent()->GetWorldTransform();
+				component->m_WorldTransformCache = component->m_RelativeTransform * parent->m_WorldTransformCache;
 			}
 			else
 			{
-				m_WorldTransformCache = m_RelativeTransform;
+				component->m_WorldTransformCache = component->m_RelativeTransform;
 			}
+			component->m_bWorldTransformDirty = false;
 		}
 
-		UpdateChildrenWorldTransformCache();
-	}
-
-	void SceneComponent::UpdateChildrenWorldTransformCache()
-	{
-		for (SceneComponent* child : m_Children)
+#if ION_DEBUG
+		// A dirty component left here would be resolved lazily by the parallel renderer data extraction.
+		ForEachSceneComponent([](SceneComponent* component)
 		{
-			child->UpdateWorldTransformCache();
-		}
+			ionassert(!component->m_bWorldTransformDirty,
+				"Scene component {} has a dirty world transform, but it's not in any dirty subtree.", component->GetName());
+		});
+#endif
 	}
 
 	SceneComponent::SceneComponent() :
 		m_SceneData({ }),
-		m_Parent(nullptr)
+		m_Parent(nullptr),
+		m_bWorldTransformDirty(false)
 	{
 		InitAsSceneComponent();
 	}
@@ -30,16 +30,20 @@ namespace Ion
 		void SetVisibleInGame(bool bVisibleInGame);
 		bool IsVisibleInGame() const;
 
+		/* The world transform is updated once per frame (ComponentRegistry::UpdateWorldTransforms).
+		   If the component has been moved since, it's resolved here, on the calling thread. */
 		const Transform& GetWorldTransform() const;
+		/* True if the component has been moved since its world transform was last computed. */
+		bool IsWorldTransformDirty() const;
 
 		bool ShouldBeRendered() const;
 
 		/* Attaches to the specified parent component.
 		   Sets the owner (entity) of this component to the parent's owner.
-		   Updates the world transform cache. */
+		   Marks the world transform as dirty. */
 		void AttachTo(SceneComponent* parent);
 		/* Detaches from the parent and removes from the owner.
-		   Updates the world transform cache.
+		   Marks the world transform as dirty.
 		   Returns this component */
 		SceneComponent* Detach();
 		SceneComponent* GetParent() const;
@@ -52,25 +56,44 @@ namespace Ion
 	protected:
 		SceneComponent();
 
+		virtual void OnRelocated(ComponentOld* oldAddress) override;
+
 	private:
 		void AddChild(SceneComponent* component);
 		void RemoveChild(SceneComponent* component);
 		void GetAllDescendants_Internal(TArray<SceneComponent*>& outArray) const;
 
-		/* Called in any function that changes the relative transform. */
-		void UpdateWorldTransformCache();
-		void UpdateChildrenWorldTransformCache();
+		/* Called in any function that changes the relative transform.
+		   Marks the world transforms of this component and its descendants
+		   (including the child entities, if this is the root) as out of date. */
+		void MarkWorldTransformDirty();
+		/* Called after the transform parent has changed. If the component has already been dirty,
+		   it has to become a dirty root itself, the old parent doesn't update it anymore. */
+		void OnTransformParentChanged();
+		/* Registers the component in the dirty roots, unless its transform parent is dirty too. */
+		void TryAddDirtyTransformRoot();
+		/* Computes the world transform of this component and its dirty ancestors. */
+		void ResolveWorldTransform() const;
+
+		/* Parent component or the root component of the owner's parent entity. */
+		SceneComponent* GetTransformParent() const;
+		/* Lambda type must be void(SceneComponent*) */
+		template<typename Lambda>
+		void ForEachTransformChild(Lambda forEach) const;
 
 	private:
 		Transform m_RelativeTransform;
-		Transform m_WorldTransformCache;
+		mutable Transform m_WorldTransformCache;
 
 		SceneObjectData m_SceneData;
 
 		SceneComponent* m_Parent;
 		TArray<SceneComponent*> m_Children;
 
+		mutable uint8 m_bWorldTransformDirty : 1;
+
 		friend class EntityOld;
+		friend class ComponentRegistry;
 	};
 
 	ENTITY_COMPONENT_CLASS_HEADER(EmptySceneComponent);
@@ -115,9 +138,18 @@ namespace Ion
 
 	inline const Transform& SceneComponent::GetWorldTransform() const
 	{
+		if (m_bWorldTransformDirty)
+		{
+			ResolveWorldTransform();
+		}
 		return m_WorldTransformCache;
 	}
 
+	inline bool SceneComponent::IsWorldTransformDirty() const
+	{
+		return m_bWorldTransformDirty;
+	}
+
 	inline SceneComponent* SceneComponent::GetParent() const
 	{
 		return m_Parent;
@@ -147,7 +179,7 @@ namespace Ion
 		void Attach(const TObjectPtr<MSceneComponent>& component);
 		MMETHOD(Attach, const TObjectPtr<MSceneComponent>&)
 
-		const TArray<TObjectPtr<MSceneComponent>> GetChildComponents() const;
+		const TArray<TObjectPtr<MSceneComponent>>& GetChildComponents() const;
 		MMETHOD(GetChildComponents)
 
 		TArray<TObjectPtr<MSceneComponent>> GetAllChildren() const;
@@ -178,7 +210,7 @@ namespace Ion
 		MFIELD(bVisibleInGame)
 	};
 
-	FORCEINLINE const TArray<TObjectPtr<MSceneComponent>> MSceneComponent::GetChildComponents() const
+	FORCEINLINE const TArray<TObjectPtr<MSceneComponent>>& MSceneComponent::GetChildComponents() const
 	{
 		return m_ChildComponents;
 	}
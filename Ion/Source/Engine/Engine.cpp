@@ -142,7 +142,7 @@ namespace Ion
 		return *it;
 	}
 
-	void Engine::BuildRendererData(float deltaTime)
+	void Engine::BuildRendererData(float deltaTime, uint32 frameDataIndex)
 	{
 		TRACE_FUNCTION();
 
@@ -155,7 +155,7 @@ namespace Ion
 			RRendererData data { };
 			world->BuildRendererData(data, deltaTime);
 
-			scene->LoadSceneData(data);
+			scene->LoadSceneData(data, frameDataIndex);
 		}
 
 		for (auto& [guid, world] : m_ActiveWorlds)
@@ -166,7 +166,7 @@ namespace Ion
 			RRendererData data { };
 			world->BuildRendererData(data);
 
-			world->GetScene()->LoadSceneData(data);
+			world->GetScene()->LoadSceneData(data, frameDataIndex);
 		}
 	}
 
@@ -189,21 +189,22 @@ namespace Ion
 
 	void Engine::RemoveInvalidObjectPointers()
 	{
-		m_InvalidMObjects.reserve(m_MObjects.size());
+		ScratchArena scratch;
+		TScratchArray<GUID> invalidObjects(scratch);
+
 		for (auto& [guid, object] : m_MObjects)
 		{
 			if (object.IsExpired())
 			{
 				EngineLogger.Trace("Object with GUID {} has expired. It will get deleted shortly.", guid.ToString());
-				m_InvalidMObjects.emplace_back(guid);
+				invalidObjects.emplace_back(guid);
 			}
 		}
-		for (GUID& guid : m_InvalidMObjects)
+		for (GUID& guid : invalidObjects)
 		{
 			m_MObjects.erase(guid);
 			m_TickingMObjects.erase(guid);
 		}
-		m_InvalidMObjects.clear();
 	}
 
 	void Engine::RegisterObject(const MObjectPtr& object)
@@ -39,7 +39,10 @@ namespace Ion
 		void DestroyWorld(World* world);
 		World* FindWorld(const GUID& worldGuid) const;
 
-		void BuildRendererData(float deltaTime);
+		/**
+		 * @param frameDataIndex Scene render data buffer to write to (see RenderThread::GetFrameDataIndex)
+		 */
+		void BuildRendererData(float deltaTime, uint32 frameDataIndex);
 
 		float GetGlobalDeltaTime() const;
 
@@ -64,7 +67,6 @@ namespace Ion
 		// @TODO: Use contiguous collections for faster iteration
 		THashMap<GUID, MWeakObjectPtr> m_MObjects;
 		THashMap<GUID, MWeakObjectPtr> m_TickingMObjects;
-		mutable TArray<GUID> m_InvalidMObjects;
 
 		THashMap<GUID, TObjectPtr<MWorld>> m_ActiveWorlds;
 
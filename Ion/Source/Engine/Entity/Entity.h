@@ -19,12 +19,12 @@ namespace Ion
 	public:
 		MEntity();
 
-		TObjectPtr<MSceneComponent> GetRootComponent() const;
+		const TObjectPtr<MSceneComponent>& GetRootComponent() const;
 
 		void AddComponent(const TObjectPtr<MComponent>& component);
 		MMETHOD(AddComponent, const TObjectPtr<MComponent>&)
 
-		TArray<TObjectPtr<MComponent>> GetComponents() const;
+		const TArray<TObjectPtr<MComponent>>& GetComponents() const;
 		MMETHOD(GetComponents)
 
 		bool IsSceneEntity() const;
@@ -58,12 +58,12 @@ namespace Ion
 		friend class MWorld;
 	};
 
-	FORCEINLINE TObjectPtr<MSceneComponent> MEntity::GetRootComponent() const
+	FORCEINLINE const TObjectPtr<MSceneComponent>& MEntity::GetRootComponent() const
 	{
 		return m_RootComponent;
 	}
 
-	FORCEINLINE TArray<TObjectPtr<MComponent>> MEntity::GetComponents() const
+	FORCEINLINE const TArray<TObjectPtr<MComponent>>& MEntity::GetComponents() const
 	{
 		return m_Components;
 	}
@@ -22,32 +22,24 @@ namespace Ion
 	{
 		ionassert(m_RootComponent);
 		m_RootComponent->SetTransform(transform);
-
-		UpdateChildrenWorldTransformCache();
 	}
 
 	void EntityOld::SetLocation(const Vector3& location)
 	{
 		ionassert(m_RootComponent);
 		m_RootComponent->SetLocation(location);
-
-		UpdateChildrenWorldTransformCache();
 	}
 
 	void EntityOld::SetRotation(const Rotator& rotation)
 	{
 		ionassert(m_RootComponent);
 		m_RootComponent->SetRotation(rotation);
-
-		UpdateChildrenWorldTransformCache();
 	}
 
 	void EntityOld::SetScale(const Vector3& scale)
 	{
 		ionassert(m_RootComponent);
 		m_RootComponent->SetScale(scale);
-
-		UpdateChildrenWorldTransformCache();
 	}
 
 	void EntityOld::SetRootComponent(SceneComponent* component)
@@ -56,14 +48,14 @@ namespace Ion
 		if (m_RootComponent)
 		{
 			UnbindComponent(m_RootComponent);
-			m_RootComponent->UpdateWorldTransformCache();
+			m_RootComponent->MarkWorldTransformDirty();
 			// @TODO: Temporary
 			m_RootComponent->Destroy(false);
 		}
 
 		m_RootComponent = component;
 		BindComponent(component);
-		m_RootComponent->UpdateWorldTransformCache();
+		MarkWorldTransformDirty();
 	}
 
 	bool EntityOld::HasSceneComponent(SceneComponent* component) const
@@ -154,7 +146,8 @@ namespace Ion
 		m_Parent = parent;
 		m_WorldContext->ReparentEntityInWorld(AsPtr(), parent);
 
-		UpdateWorldTransformCache();
+		ionassert(m_RootComponent);
+		m_RootComponent->OnTransformParentChanged();
 	}
 
 	void EntityOld::Detach()
@@ -165,7 +158,8 @@ namespace Ion
 			m_Parent = nullptr;
 			m_WorldContext->ReparentEntityInWorld(AsPtr(), nullptr);
 
-			UpdateWorldTransformCache();
+			ionassert(m_RootComponent);
+			m_RootComponent->OnTransformParentChanged();
 		}
 	}
 
@@ -307,6 +301,29 @@ namespace Ion
 		}
 	}
 
+	void EntityOld::RebindRelocatedComponent(ComponentOld* oldAddress, ComponentOld* component)
+	{
+		ionassert(component);
+		ionassert(component->m_OwningEntity == this);
+
+		if (component->IsSceneComponent())
+		{
+			SceneComponent* sceneComponent = (SceneComponent*)component;
+			m_SceneComponents.erase((SceneComponent*)oldAddress);
+			m_SceneComponents.insert(sceneComponent);
+
+			if (m_RootComponent == (SceneComponent*)oldAddress)
+			{
+				m_RootComponent = sceneComponent;
+			}
+		}
+		else
+		{
+			m_Components.erase(oldAddress);
+			m_Components.insert(component);
+		}
+	}
+
 	EntityOld* EntityOld::Duplicate() const
 	{
 		ionassert(!IsPendingKill());
@@ -407,18 +424,15 @@ namespace Ion
 		Destroy(false);
 	}
 
-	void EntityOld::UpdateWorldTransformCache()
+	void EntityOld::MarkWorldTransformDirty()
 	{
 		ionassert(m_RootComponent);
-		m_RootComponent->UpdateWorldTransformCache();
-		UpdateChildrenWorldTransformCache();
-	}
+		m_RootComponent->MarkWorldTransformDirty();
 
-	void EntityOld::UpdateChildrenWorldTransformCache()
-	{
+		// The children might have already been dirty, before they were attached.
 		for (const TObjectPtr<EntityOld>& child : m_Children)
 		{
-			child->UpdateWorldTransformCache();
+			child->MarkWorldTransformDirty();
 		}
 	}
 }
@@ -62,6 +62,9 @@ namespace Ion
 		/* Reset entity related component data and remove the component from entity's collection.
 		   Updates scene component's world transform cache. */
 		void UnbindComponent(ComponentOld* component);
+		/* Replaces the old address of a component that has been moved
+		   in the ComponentRegistry. Called by ComponentOld::OnRelocated. */
+		void RebindRelocatedComponent(ComponentOld* oldAddress, ComponentOld* component);
 
 		EntityOld* Duplicate() const;
 	protected:
@@ -115,9 +118,9 @@ namespace Ion
 
 		void GetAllChildren(TArray<TObjectPtr<EntityOld>>& outChildren) const;
 
-		/* Called in any function that changes the relative transform. */
-		void UpdateWorldTransformCache();
-		void UpdateChildrenWorldTransformCache();
+		/* Called in any function that changes the parent of the entity.
+		   The world transforms are updated in ComponentRegistry::UpdateWorldTransforms. */
+		void MarkWorldTransformDirty();
 
 	protected:
 		// @TODO: Very temporary, without reflection it's pretty much impossible to do properly.
@@ -253,3 +256,5 @@ namespace Ion
 		return m_bPendingKill;
 	}
 }
+
+namespace Ion::Test { void EntityTransformTest(); }
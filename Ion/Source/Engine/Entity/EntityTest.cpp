@@ -0,0 +1,49 @@
+#include "IonPCH.h"
+
+#include "EntityOld.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Engine/Components/SceneComponent.h"
+
+namespace Ion::Test
+{
+	void EntityTransformTest()
+	{
+		WorldInitializer initializer { };
+		World* world = g_Engine->CreateWorld(initializer);
+		ComponentRegistry& registry = world->GetComponentRegistry();
+
+		TObjectPtr<EntityOld> parentA = world->SpawnEntityOfClass<EntityOld>();
+		TObjectPtr<EntityOld> parentB = world->SpawnEntityOfClass<EntityOld>();
+		TObjectPtr<EntityOld> child = world->SpawnEntityOfClass<EntityOld>();
+		SceneComponent* childRoot = child->GetRootComponent();
+
+		parentA->SetLocation(Vector3(1.0f, 0.0f, 0.0f));
+		parentB->SetLocation(Vector3(0.0f, 2.0f, 0.0f));
+		child->SetLocation(Vector3(0.0f, 0.0f, 4.0f));
+		child->AttachTo(parentA);
+		registry.UpdateWorldTransforms();
+		ionassert(!childRoot->IsWorldTransformDirty());
+
+		// The child is dirty, but it's updated along with its dirty parent, not as a dirty root.
+		parentA->SetLocation(Vector3(3.0f, 0.0f, 0.0f));
+		ionassert(childRoot->IsWorldTransformDirty());
+
+		// Reparent the already dirty child, the old parent doesn't update it anymore.
+		child->AttachTo(parentB);
+		registry.UpdateWorldTransforms();
+		ionassert(!childRoot->IsWorldTransformDirty());
+		ionassert(child->GetWorldTransform().GetLocation() == Vector3(0.0f, 2.0f, 4.0f));
+
+		// Same for an already dirty entity that's detached.
+		parentB->SetLocation(Vector3(0.0f, 5.0f, 0.0f));
+		ionassert(childRoot->IsWorldTransformDirty());
+
+		child->Detach();
+		registry.UpdateWorldTransforms();
+		ionassert(!childRoot->IsWorldTransformDirty());
+		ionassert(child->GetWorldTransform().GetLocation() == Vector3(0.0f, 0.0f, 4.0f));
+
+		g_Engine->DestroyWorld(world);
+	}
+}
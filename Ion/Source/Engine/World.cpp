@@ -85,10 +85,9 @@ namespace Ion
 		mapData->WorldGuid = m_WorldGUID;
 		mapData->Entities = [&]
 		{
-			TArray<TObjectPtr<EntityOld>> entities = GatherValues(m_Entities);
 			TArray<EntityOld*> rawPtrs;
-			rawPtrs.reserve(entities.size());
-			for (const TObjectPtr<EntityOld>& entity : entities)
+			rawPtrs.reserve(m_Entities.size());
+			for (auto& [guid, entity] : m_Entities)
 			{
 				rawPtrs.emplace_back(entity.Raw());
 			}
@@ -151,6 +150,8 @@ namespace Ion
 	{
 		TRACE_FUNCTION();
 
+		// The proxies are extracted in parallel, the world transforms have to be resolved first.
+		m_ComponentRegistry.UpdateWorldTransforms();
 		m_ComponentRegistry.BuildRendererData(data);
 	}
 
@@ -526,31 +527,31 @@ namespace Ion
 
 	void MWorld::BuildRendererData(RRendererData& data)
 	{
-		TArray<TObjectPtr<MSceneComponent>> visibleComponents = GatherVisibleSceneComponents();
+		ScratchArena scratch;
+		TScratchArray<TObjectRef<MSceneComponent>> visibleComponents(scratch);
+		GatherVisibleSceneComponents(visibleComponents);
 
-		for (const TObjectPtr<MSceneComponent>& component : visibleComponents)
+		for (TObjectRef<MSceneComponent> component : visibleComponents)
 		{
 			// component->BuildRendererData(data);
 		}
 	}
 
-	TArray<TObjectPtr<MSceneComponent>> MWorld::GatherVisibleSceneComponents() const
+	void MWorld::GatherVisibleSceneComponents(TScratchArray<TObjectRef<MSceneComponent>>& outComponents) const
 	{
-		TArray<TObjectPtr<MSceneComponent>> components;
 		// It will probably not be enough if the entities have multiple scene components visible.
-		components.reserve(m_Entities.size());
+		outComponents.reserve(outComponents.size() + m_Entities.size());
 		
+		// The entities own the components for the whole frame, borrowing them doesn't touch the ref counts.
 		for (auto& [guid, entity] : m_Entities)
 		{
 			// @TODO: Gather all components
 			const TObjectPtr<MSceneComponent>& root = entity->GetRootComponent();
 			if (root && root->bVisible)
 			{
-				components.emplace_back(root);
+				outComponents.emplace_back(root);
 			}
 		}
-
-		return components;
 	}
 
 	void MWorld::AddEntity(const TObjectPtr<MEntity>& entity)
@@ -178,7 +178,7 @@ namespace Ion
 	{
 		static_assert(TIsBaseOfV<EntityOld, EntityT>);
 
-		// @TODO: Use some sort of an allocator here
+		// Allocated with the EngineAllocator (see MObject)
 		TObjectPtr<EntityT> entity = MObject::New<EntityT>(Forward<Args>(args)...);
 		AddEntity(entity);
 		return entity;
@@ -251,7 +251,7 @@ namespace Ion
 		template<typename T, TEnableIfT<TIsConvertibleV<T*, MEntity*>>* = 0>
 		TObjectPtr<T> SpawnEntity();
 
-		const THashMap<GUID, TObjectPtr<MEntity>> GetEntities() const;
+		const THashMap<GUID, TObjectPtr<MEntity>>& GetEntities() const;
 		MMETHOD(GetEntities)
 
 		Scene* GetScene() const;
@@ -264,7 +264,7 @@ namespace Ion
 	private:
 		void BuildRendererData(RRendererData& data);
 
-		TArray<TObjectPtr<MSceneComponent>> GatherVisibleSceneComponents() const;
+		void GatherVisibleSceneComponents(TScratchArray<TObjectRef<MSceneComponent>>& outComponents) const;
 
 		void AddEntity(const TObjectPtr<MEntity>& entity);
 
@@ -288,7 +288,7 @@ namespace Ion
 		return entity;
 	}
 
-	FORCEINLINE const THashMap<GUID, TObjectPtr<MEntity>> MWorld::GetEntities() const
+	FORCEINLINE const THashMap<GUID, TObjectPtr<MEntity>>& MWorld::GetEntities() const
 	{
 		return m_Entities;
 	}
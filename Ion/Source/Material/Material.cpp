@@ -1,6 +1,7 @@
 #include "IonPCH.h"
 
 #include "Material.h"
+#include "ShaderCache.h"
 
 #include "RHI/RHI.h"
 #include "RHI/Shader.h"
@@ -201,7 +202,8 @@ namespace Ion
 		m_Name(name),
 		m_DefaultValue(defaultValue),
 		m_MinValue(min),
-		m_MaxValue(max)
+		m_MaxValue(max),
+		m_ConstantOffset(0)
 	{
 	}
 
@@ -219,7 +221,8 @@ namespace Ion
 		m_Name(name),
 		m_DefaultValue(defaultValue),
 		m_MinValue(min),
-		m_MaxValue(max)
+		m_MaxValue(max),
+		m_ConstantOffset(0)
 	{
 	}
 
@@ -361,6 +364,19 @@ namespace Ion
 
 #pragma region Material
 
+	/* Defines that select the usage specific parts of the material shader code. */
+	static String GetShaderUsageDefines(EShaderUsage usage)
+	{
+		switch (usage)
+		{
+		case EShaderUsage::StaticMeshInstanced:
+			// #line keeps the line numbers of the material code in the compilation errors.
+			return "#define ION_SHADER_INSTANCED 1\n#line 1\n";
+		default:
+			return "";
+		}
+	}
+
 	std::shared_ptr<Material> Material::Create()
 	{
 		return std::shared_ptr<Material>(new Material);
@@ -371,83 +387,149 @@ namespace Ion
 		return std::shared_ptr<Material>(new Material(materialAsset));
 	}
 
-	void Material::CompileShaders()
+	/**
+	 * @brief State of a single CompileShaders call, shared by its compilation tasks.
+	 * Each task only writes to its own permutation.
+	 */
+	struct Material::ShaderCompilation
 	{
-		for (auto& [usage, shader] : m_Shaders)
+		struct Permutation
+		{
+			TRef<RHIShader> Shader;
+			EShaderUsage Usage;
+			String Source;
+			ShaderCacheKey CacheKey;
+			bool bCompiled = false;
+		};
+
+		TArray<Permutation> Permutations;
+		/* Copied, so the material code can be changed while the tasks are running. */
+		String MaterialCode;
+		FilePath MaterialShaderPath;
+		FOnShadersCompiled OnCompiled;
+		ShadersCompiledCounter Counter;
+		/* If false, the shaders are created and compiled in FinalizeShaders */
+		bool bAsyncCompilation;
+
+		ShaderCompilation(uint32 permutationCount) :
+			Counter(permutationCount),
+			bAsyncCompilation(false)
 		{
-			EShaderUsage shaderUsage = usage;
-			ShaderPermutation& shaderPerm = shader;
+		}
+	};
 
+	static bool CompileShaderPermutation(RHIShader& shader, const ShaderCacheKey& cacheKey, const FilePath& materialShaderPath)
+	{
+		bool bCompiled = false;
+		ShaderCache::Compile(shader, cacheKey)
+			.Ok([&] { bCompiled = true; })
+			.Err([&](Error& err) { MaterialLogger.Error("Could not compile the shader of material \"{}\".\n{}", materialShaderPath.ToString(), err.Message); });
+		return bCompiled;
+	}
+
+	void Material::CompileShaders()
+	{
+		CompileShaders(FOnShadersCompiled());
+	}
+
+	void Material::CompileShaders(const FOnShadersCompiled& onCompiled)
+	{
+		TRACE_FUNCTION();
+
+		if (m_Shaders.empty())
+			return;
+
+		// Query the RHI on this thread, the tasks only hash the sources.
+		ShaderCache::GetEnvironmentHash();
+
+		std::shared_ptr<ShaderCompilation> compilation = std::make_shared<ShaderCompilation>((uint32)m_Shaders.size());
+		compilation->MaterialCode = m_MaterialCode;
+		compilation->MaterialShaderPath = m_MaterialShaderPath;
+		compilation->OnCompiled = onCompiled;
+		compilation->bAsyncCompilation = RHI::Get()->SupportsAsyncShaderCompilation();
+
+		compilation->Permutations.reserve(m_Shaders.size());
+		for (auto& [usage, shaderPerm] : m_Shaders)
+		{
 			ionassert(shaderPerm.Shader);
 			ionassert(!shaderPerm.bCompiled);
 
-			shaderPerm.Shader->AddShaderSource(EShaderType::Vertex, m_MaterialCode, m_MaterialShaderPath);
-			shaderPerm.Shader->AddShaderSource(EShaderType::Pixel, m_MaterialCode, m_MaterialShaderPath);
+			ShaderCompilation::Permutation& permutation = compilation->Permutations.emplace_back();
+			permutation.Shader = shaderPerm.Shader;
+			permutation.Usage = usage;
+		}
 
-			// Compile the shaders using the Engine Task Queue
-			AsyncTask compileTask([material = shared_from_this(), shaderUsage, &shaderPerm](IMessageQueueProvider& queue)
+		// Each permutation is a separate task, so the permutations of all the materials
+		// compiled at the same time are spread across the worker threads.
+		for (size_t i = 0; i < compilation->Permutations.size(); ++i)
+		{
+			AsyncTask compileTask([material = shared_from_this(), compilation, i](IMessageQueueProvider& queue)
 			{
-				shaderPerm.Shader->Compile()
-					.Ok([&queue, &material, &shaderUsage, &shaderPerm]
-					{
-						queue.PushMessage(FTaskMessage([material, shaderUsage, &shaderPerm]
-						{
-							ionassert(material->m_Shaders.find(shaderUsage) != material->m_Shaders.end(),
-								"Shader usage had been removed before the shader was compiled.");
-							shaderPerm.bCompiled = true;
-						}));
-					})
-					.Err<ShaderCompilationError>([&](auto& err)
+				ShaderCompilation::Permutation& permutation = compilation->Permutations[i];
+
+				permutation.Source = GetShaderUsageDefines(permutation.Usage) + compilation->MaterialCode;
+				permutation.CacheKey = ShaderCache::MakeKey(permutation.Source, permutation.Usage, compilation->MaterialShaderPath);
+
+				// Load the shader from the shader cache or compile it
+				if (compilation->bAsyncCompilation)
+				{
+					permutation.Shader->AddShaderSource(EShaderType::Vertex, permutation.Source, compilation->MaterialShaderPath);
+					permutation.Shader->AddShaderSource(EShaderType::Pixel, permutation.Source, compilation->MaterialShaderPath);
+
+					permutation.bCompiled = CompileShaderPermutation(*permutation.Shader, permutation.CacheKey, compilation->MaterialShaderPath);
+				}
+
+				// The last task finalizes all the permutations at once.
+				if (compilation->Counter.Inc() == compilation->Counter.m_Max)
+				{
+					queue.PushMessage(FTaskMessage([material, compilation]
 					{
-						// @TODO: More info
-						MaterialLogger.Error("Could not compile shader.");
-					});
+						material->FinalizeShaders(*compilation);
+					}));
+				}
 			});
 			compileTask.Schedule();
 		}
 	}
 
-	void Material::CompileShaders(const FOnShadersCompiled& onCompiled)
+	void Material::FinalizeShaders(ShaderCompilation& compilation)
 	{
-		std::shared_ptr<ShadersCompiledCounter> counter = std::make_shared<ShadersCompiledCounter>((uint32)m_Shaders.size());
+		TRACE_FUNCTION();
 
-		for (auto& [usage, shader] : m_Shaders)
+		ionassert(compilation.Counter.Done());
+
+		const ShaderPermutation* lastCompiled = nullptr;
+		bool bAllCompiled = true;
+		for (ShaderCompilation::Permutation& permutation : compilation.Permutations)
 		{
-			EShaderUsage shaderUsage = usage;
-			ShaderPermutation& shaderPerm = shader;
+			// The usage could have been removed (or added again) in the meantime.
+			auto it = m_Shaders.find(permutation.Usage);
+			if (it == m_Shaders.end() || it->second.Shader.Raw() != permutation.Shader.Raw())
+				continue;
 
-			ionassert(shaderPerm.Shader);
-			ionassert(!shaderPerm.bCompiled);
+			if (!compilation.bAsyncCompilation)
+			{
+				permutation.Shader->AddShaderSource(EShaderType::Vertex, permutation.Source, compilation.MaterialShaderPath);
+				permutation.Shader->AddShaderSource(EShaderType::Pixel, permutation.Source, compilation.MaterialShaderPath);
 
-			shaderPerm.Shader->AddShaderSource(EShaderType::Vertex, m_MaterialCode, m_MaterialShaderPath);
-			shaderPerm.Shader->AddShaderSource(EShaderType::Pixel, m_MaterialCode, m_MaterialShaderPath);
+				permutation.bCompiled = CompileShaderPermutation(*permutation.Shader, permutation.CacheKey, compilation.MaterialShaderPath);
+			}
 
-			// Compile the shaders using the Engine Task Queue
-			AsyncTask compileTask([material = shared_from_this(), shaderUsage, &shaderPerm, counter, onCompiled](IMessageQueueProvider& queue)
+			it->second.bCompiled = permutation.bCompiled;
+			if (permutation.bCompiled)
 			{
-				shaderPerm.Shader->Compile()
-					.Ok([&queue, &material, &shaderUsage, &shaderPerm, &counter, &onCompiled]
-					{
-						queue.PushMessage(FTaskMessage([material, shaderUsage, &shaderPerm, counter, onCompiled]
-						{
-							ionassert(material->m_Shaders.find(shaderUsage) != material->m_Shaders.end(),
-								"Shader usage had been removed before the shader was compiled.");
-							shaderPerm.bCompiled = true;
-
-							counter->Inc();
-							if (counter->Done())
-							{
-								onCompiled(shaderPerm);
-							}
-						}));
-					})
-					.Err<ShaderCompilationError>([&](auto& err)
-					{
-						// @TODO: More info
-						MaterialLogger.Error("Could not compile shader.");
-					});
-			});
-			compileTask.Schedule();
+				lastCompiled = &it->second;
+			}
+			else
+			{
+				bAllCompiled = false;
+			}
+		}
+
+		// The callback means that the whole material is ready, not just some of its permutations.
+		if (compilation.OnCompiled && bAllCompiled && lastCompiled)
+		{
+			compilation.OnCompiled(*lastCompiled);
 		}
 	}
 
@@ -478,9 +560,13 @@ namespace Ion
 		return m_Shaders.at(usage).Shader;
 	}
 
-	void Material::UpdateConstantBuffer() const
+	const RHIShader* Material::GetShaderOrFallback(EShaderUsage usage, const RHIShader* fallback) const
 	{
-		m_MaterialConstants->UpdateData();
+		auto it = m_Shaders.find(usage);
+		if (it == m_Shaders.end() || !it->second.bCompiled)
+			return fallback;
+
+		return it->second.Shader.Raw();
 	}
 
 	void Material::AddUsage(EShaderUsage usage)
@@ -551,6 +637,7 @@ namespace Ion
 	}
 
 	Material::Material() :
+		m_ConstantBlockSize(0),
 		m_Usage(0),
 		m_bInvalid(false),
 		m_UsedTextureSlotsMask(0)
@@ -558,6 +645,7 @@ namespace Ion
 	}
 
 	Material::Material(Asset materialAsset) :
+		m_ConstantBlockSize(0),
 		m_Usage(0),
 		m_bInvalid(false),
 		m_UsedTextureSlotsMask(0),
@@ -830,6 +918,28 @@ namespace Ion
 		}
 
 		m_MaterialConstants = factory.Construct();
+
+		// 3. Resolve the parameter offsets, so the instances don't have to look them up by name
+
+		m_ConstantBlockSize = 0;
+
+		for (MaterialParameterVector* vectorParam : vectorParams)
+		{
+			const UniformData* uniform = m_MaterialConstants->GetUniformData(vectorParam->GetName());
+			ionassert(uniform);
+
+			vectorParam->m_ConstantOffset = uniform->Offset;
+			m_ConstantBlockSize = std::max(m_ConstantBlockSize, uniform->Offset + (uint32)sizeof(Vector4));
+		}
+
+		for (MaterialParameterScalar* scalarParam : scalarParams)
+		{
+			const UniformData* uniform = m_MaterialConstants->GetUniformData(scalarParam->GetName());
+			ionassert(uniform);
+
+			scalarParam->m_ConstantOffset = uniform->Offset;
+			m_ConstantBlockSize = std::max(m_ConstantBlockSize, uniform->Offset + (uint32)sizeof(float));
+		}
 	}
 
 	uint32 Material::GetTextureParameterCount() const
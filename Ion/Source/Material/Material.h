@@ -12,7 +12,9 @@ namespace Ion
 		None = 0,
 		StaticMesh   = Bitflag(0),
 		SkeletalMesh = Bitflag(1),
-		PostProcess  = Bitflag(2)
+		PostProcess  = Bitflag(2),
+		/* Static mesh drawn with GPU instancing - compiled with ION_SHADER_INSTANCED */
+		StaticMeshInstanced = Bitflag(3),
 	};
 
 	struct ShaderPermutation
@@ -65,6 +67,9 @@ namespace Ion
 		float GetMinValue() const;
 		float GetMaxValue() const;
 
+		/* Byte offset of the parameter in the material constant buffer (resolved in Material::BuildConstantBuffer) */
+		uint32 GetConstantOffset() const;
+
 	private:
 		void SetDefaultValue(float value);
 		void SetMinValue(float min);
@@ -75,6 +80,8 @@ namespace Ion
 		float m_MinValue;
 		float m_MaxValue;
 
+		uint32 m_ConstantOffset;
+
 		String m_Name;
 
 		friend class Material;
@@ -96,6 +103,11 @@ namespace Ion
 		return m_MaxValue;
 	}
 
+	inline uint32 MaterialParameterScalar::GetConstantOffset() const
+	{
+		return m_ConstantOffset;
+	}
+
 	inline void MaterialParameterScalar::SetDefaultValue(float value)
 	{
 		m_DefaultValue = value;
@@ -130,6 +142,9 @@ namespace Ion
 		const Vector4& GetMinValue() const;
 		const Vector4& GetMaxValue() const;
 
+		/* Byte offset of the parameter in the material constant buffer (resolved in Material::BuildConstantBuffer) */
+		uint32 GetConstantOffset() const;
+
 	private:
 		void SetDefaultValue(const Vector4& value);
 		void SetMinValue(const Vector4& min);
@@ -140,6 +155,8 @@ namespace Ion
 		Vector4 m_MinValue;
 		Vector4 m_MaxValue;
 
+		uint32 m_ConstantOffset;
+
 		String m_Name;
 
 		friend class Material;
@@ -161,6 +178,11 @@ namespace Ion
 		return m_MaxValue;
 	}
 
+	inline uint32 MaterialParameterVector::GetConstantOffset() const
+	{
+		return m_ConstantOffset;
+	}
+
 	inline void MaterialParameterVector::SetDefaultValue(const Vector4& value)
 	{
 		m_DefaultValue = value;
@@ -228,17 +250,24 @@ namespace Ion
 
 	using FOnShadersCompiled = TFunction<void(const ShaderPermutation&)>;
 
+	/**
+	 * @brief Counts the shader permutations processed by the compilation tasks.
+	 * Thread-safe - Inc returns the value it has incremented the counter to,
+	 * so exactly one task gets the maximum value, the one that processed the last
+	 * permutation. Done only tells if that has already happened.
+	 */
 	class ShadersCompiledCounter
 	{
 	public:
 		ShadersCompiledCounter(uint32 max);
 
+		/* Returns the incremented value */
 		uint32 Inc();
 		bool Done() const;
 
 	public:
 		const uint32 m_Max;
-		uint32 m_Count;
+		TAtomic<uint32> m_Count;
 	};
 
 	inline ShadersCompiledCounter::ShadersCompiledCounter(uint32 max) :
@@ -249,8 +278,9 @@ namespace Ion
 
 	inline uint32 ShadersCompiledCounter::Inc()
 	{
-		ionassert(m_Count < m_Max, "Counter has been incremented more than the maximum value.");
-		return ++m_Count;
+		uint32 count = ++m_Count;
+		ionassert(count <= m_Max, "Counter has been incremented more than the maximum value.");
+		return count;
 	}
 
 	inline bool ShadersCompiledCounter::Done() const
@@ -303,17 +333,22 @@ namespace Ion
 		/**
 		 * @brief Compile the shaders for this material.
 		 * 
-		 * Async function - the shaders will be compiled on the worker threads.
+		 * Async function - every permutation is prepared (and compiled, if the RHI
+		 * supports it) on the worker threads. The permutations are finalized together
+		 * on the main thread, when all of them are done. Until then, the material
+		 * is drawn with a fallback shader (see Renderer::GetBasicShader).
+		 *
+		 * @param onCompiled Called on the main thread, after all the permutations have been finalized
 		 */
 		void CompileShaders();
 		void CompileShaders(const FOnShadersCompiled& onCompiled);
 		bool IsCompiled(EShaderUsage usage) const;
+		/* Returns the fallback shader, if the permutation has not been compiled yet. */
+		const RHIShader* GetShaderOrFallback(EShaderUsage usage, const RHIShader* fallback) const;
 
 		bool BindShader(EShaderUsage usage) const;
 		const TRef<RHIShader>& GetShader(EShaderUsage usage) const;
 
-		void UpdateConstantBuffer() const;
-
 		void AddUsage(EShaderUsage usage);
 		void RemoveUsage(EShaderUsage usage);
 		bool IsUsableWith(EShaderUsage usage);
@@ -348,11 +383,18 @@ namespace Ion
 
 		bool CompileMaterialCode_Internal(EShaderUsage usage, ShaderPermutation& outShader);
 
+		struct ShaderCompilation;
+		/* Called on the main thread, when all the compilation tasks are done. */
+		void FinalizeShaders(ShaderCompilation& compilation);
+
 	private:
 		THashMap<EShaderUsage, ShaderPermutation> m_Shaders;
 		THashMap<String, IMaterialParameter*> m_Parameters;
 		THashMap<MaterialInstance*, std::weak_ptr<MaterialInstance>> m_MaterialInstances;
+		/* Layout and default values of the constants, the instances create their own buffers from it */
 		TRef<RHIUniformBufferDynamic> m_MaterialConstants;
+		/* Size of the constant block of the material instances */
+		uint32 m_ConstantBlockSize;
 		uint64 m_Usage;
 		String m_MaterialCode;
 		FilePath m_MaterialShaderPath;
@@ -390,6 +432,7 @@ NODISCARD FORCEINLINE String ToString(Ion::EShaderUsage value)
 	case Ion::EShaderUsage::StaticMesh:   return "StaticMesh";
 	case Ion::EShaderUsage::SkeletalMesh: return "SkeletalMesh";
 	case Ion::EShaderUsage::PostProcess:  return "PostProcess";
+	case Ion::EShaderUsage::StaticMeshInstanced: return "StaticMeshInstanced";
 	}
 	ionassert(0, "Invalid enum value.");
 	return "";
@@ -15,4 +15,8 @@ namespace Ion
 	class MaterialRegistry;
 	class Material;
 	class MaterialInstance;
+
+	// ShaderCache.h
+	struct ShaderCacheKey;
+	class ShaderCache;
 }
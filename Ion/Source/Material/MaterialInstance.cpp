@@ -4,6 +4,7 @@
 #include "MaterialRegistry.h"
 
 #include "RHI/UniformBuffer.h"
+#include "Renderer/RenderThread.h"
 
 #include "Asset/AssetParser.h"
 
@@ -49,11 +50,20 @@ namespace Ion
 		}
 	}
 
-	MaterialParameterInstanceScalar::MaterialParameterInstanceScalar(MaterialParameterScalar* parentParameter, float value) :
-		m_Parameter(parentParameter),
-		m_Value(value)
+	MaterialParameterInstanceScalar::MaterialParameterInstanceScalar(MaterialInstance* owner, MaterialParameterScalar* parentParameter, float value) :
+		m_Owner(owner),
+		m_Parameter(parentParameter)
 	{
+		ionassert(m_Owner);
 		ionassert(m_Parameter);
+
+		SetValue(value);
+	}
+
+	void MaterialParameterInstanceScalar::SetValue(float value)
+	{
+		m_Value = value;
+		m_Owner->WriteConstant(m_Parameter->GetConstantOffset(), &m_Value, sizeof(m_Value));
 	}
 
 	IMaterialParameter* MaterialParameterInstanceScalar::GetParameter() const
@@ -66,11 +76,20 @@ namespace Ion
 		return m_Parameter;
 	}
 
-	MaterialParameterInstanceVector::MaterialParameterInstanceVector(MaterialParameterVector* parentParameter, const Vector4& value) :
-		m_Parameter(parentParameter),
-		m_Value(value)
+	MaterialParameterInstanceVector::MaterialParameterInstanceVector(MaterialInstance* owner, MaterialParameterVector* parentParameter, const Vector4& value) :
+		m_Owner(owner),
+		m_Parameter(parentParameter)
 	{
+		ionassert(m_Owner);
 		ionassert(m_Parameter);
+
+		SetValue(value);
+	}
+
+	void MaterialParameterInstanceVector::SetValue(const Vector4& value)
+	{
+		m_Value = value;
+		m_Owner->WriteConstant(m_Parameter->GetConstantOffset(), &m_Value, sizeof(m_Value));
 	}
 
 	IMaterialParameter* MaterialParameterInstanceVector::GetParameter() const
@@ -102,9 +121,9 @@ namespace Ion
 
 	void MaterialParameterInstanceTexture2D::Bind(uint32 slot)
 	{
-		if (m_Texture)
+		if (m_TextureResource && m_TextureResource->IsLoaded())
 		{
-			m_Texture->Bind(slot);
+			m_TextureResource->GetRenderData().Texture->Bind(slot);
 		}
 	}
 
@@ -121,13 +140,10 @@ namespace Ion
 		{
 			m_TextureResource = TextureResource::Query(m_Value);
 
-			// @TODO: Make sure the instance is not deleted before this gets done
-			m_TextureResource->Take([this](const TSharedPtr<TextureResource>& resource)
-			{
-				// Check to avoid overriding the texture when it's already been changed to a different one.
-				if (resource == m_TextureResource)
-					m_Texture = resource->GetRenderData().Texture;
-			});
+			// The material textures are drawn in the world, so they only need the mips
+			// for their size on the screen. Bind reads the texture from the resource.
+			m_TextureResource->EnableStreaming();
+			m_TextureResource->Take([](const TSharedPtr<TextureResource>& resource) { });
 		}
 	}
 
@@ -245,31 +261,23 @@ namespace Ion
 		return nullptr;
 	}
 
-	void MaterialInstance::TransferParameters() const
+	void MaterialInstance::UpdateConstantBuffer() const
 	{
-		// Update the constant buffer fields from parameters
-		// Textures need to be loaded and bound normally
+		MaterialInstanceRenderData& renderData = *m_RenderData;
+		if (!renderData.ConstantBuffer || renderData.UploadedConstantsVersion == renderData.ConstantsVersion)
+			return;
 
-		TRef<RHIUniformBufferDynamic> constants = m_ParentMaterial->m_MaterialConstants;
-		constants->Bind(2);
+		renderData.ConstantBuffer->SetData(renderData.ConstantBlock.data(), renderData.ConstantBlock.size());
+		renderData.ConstantBuffer->UpdateData();
 
-		for (auto& [name, parameter] : m_ParameterInstances)
+		renderData.UploadedConstantsVersion = renderData.ConstantsVersion;
+	}
+
+	void MaterialInstance::BindConstantBuffer() const
+	{
+		if (m_RenderData->ConstantBuffer)
 		{
-			switch (parameter->GetType())
-			{
-				case EMaterialParameterType::Scalar:
-				{
-					MaterialParameterInstanceScalar* scalarParamInstance = (MaterialParameterInstanceScalar*)parameter;
-					constants->SetUniformValue(name, scalarParamInstance->GetValue());
-					break;
-				}
-				case EMaterialParameterType::Vector:
-				{
-					MaterialParameterInstanceVector* vectorParamInstance = (MaterialParameterInstanceVector*)parameter;
-					constants->SetUniformValue(name, vectorParamInstance->GetValue());
-					break;
-				}
-			}
+			m_RenderData->ConstantBuffer->Bind(2);
 		}
 	}
 
@@ -279,7 +287,9 @@ namespace Ion
 	}
 
 	MaterialInstance::MaterialInstance(const std::shared_ptr<Material>& parentMaterial) :
-		m_ParentMaterial(parentMaterial)
+		m_ParentMaterial(parentMaterial),
+		m_ConstantsVersion(0),
+		m_RenderData(MakeShared<MaterialInstanceRenderData>())
 	{
 		ionassert(parentMaterial);
 
@@ -287,6 +297,8 @@ namespace Ion
 	}
 
 	MaterialInstance::MaterialInstance(Asset materialInstanceAsset) :
+		m_ConstantsVersion(0),
+		m_RenderData(MakeShared<MaterialInstanceRenderData>()),
 		m_Asset(materialInstanceAsset)
 	{
 		ionassert(materialInstanceAsset);
@@ -325,6 +337,8 @@ namespace Ion
 
 		ionassert(m_ParentMaterial, "Cannot create parameter instances. Parent Material is not set.");
 
+		m_ConstantBlock.resize(m_ParentMaterial->m_ConstantBlockSize);
+
 		for (auto& [name, parameter] : m_ParentMaterial->m_Parameters)
 		{
 			IMaterialParameterInstance* instance = nullptr;
@@ -334,13 +348,13 @@ namespace Ion
 				case EMaterialParameterType::Scalar:
 				{
 					MaterialParameterScalar* scalarParam = (MaterialParameterScalar*)parameter;
-					instance = new MaterialParameterInstanceScalar(scalarParam, scalarParam->GetDefaultValue());
+					instance = new MaterialParameterInstanceScalar(this, scalarParam, scalarParam->GetDefaultValue());
 					break;
 				}
 				case EMaterialParameterType::Vector:
 				{
 					MaterialParameterVector* vectorParam = (MaterialParameterVector*)parameter;
-					instance = new MaterialParameterInstanceVector(vectorParam, vectorParam->GetDefaultValue());
+					instance = new MaterialParameterInstanceVector(this, vectorParam, vectorParam->GetDefaultValue());
 					break;
 				}
 				case EMaterialParameterType::Texture2D:
@@ -354,6 +368,23 @@ namespace Ion
 
 			m_ParameterInstances.emplace(name, instance);
 		}
+
+		// The block already contains the default values, so the buffer is up to date.
+		TRef<RHIUniformBufferDynamic> constantBuffer;
+		const TRef<RHIUniformBufferDynamic>& materialConstants = m_ParentMaterial->m_MaterialConstants;
+		if (materialConstants && !m_ConstantBlock.empty())
+		{
+			constantBuffer = RHIUniformBufferDynamic::Create(m_ConstantBlock.data(), m_ConstantBlock.size(), materialConstants->GetUniformDataMap());
+		}
+
+		// The render thread might still be drawing with the previous parent's constants.
+		RenderThread::EnqueueCommand([renderData = m_RenderData, block = m_ConstantBlock, constantBuffer, version = m_ConstantsVersion]() mutable
+		{
+			renderData->ConstantBlock = Move(block);
+			renderData->ConstantBuffer = Move(constantBuffer);
+			renderData->ConstantsVersion = version;
+			renderData->UploadedConstantsVersion = version;
+		});
 	}
 
 	void MaterialInstance::DestroyParameterInstances()
@@ -367,6 +398,33 @@ namespace Ion
 		}
 		m_ParameterInstances.clear();
 		m_TextureParameterInstances.clear();
+		m_ConstantBlock.clear();
+
+		RenderThread::EnqueueCommand([renderData = m_RenderData]
+		{
+			renderData->ConstantBlock.clear();
+			renderData->ConstantBuffer = nullptr;
+		});
+	}
+
+	void MaterialInstance::WriteConstant(uint32 offset, const void* value, size_t size)
+	{
+		ionassert(offset + size <= m_ConstantBlock.size());
+
+		memcpy(m_ConstantBlock.data() + offset, value, size);
+		++m_ConstantsVersion;
+
+		// The render thread might be uploading its copy right now, the value is written there between the frames.
+		TFixedArray<uint8, sizeof(Vector4)> data;
+		ionassert(size <= data.size());
+		memcpy(data.data(), value, size);
+
+		RenderThread::EnqueueCommand([renderData = m_RenderData, offset, size, data, version = m_ConstantsVersion]
+		{
+			ionassert(offset + size <= renderData->ConstantBlock.size());
+			memcpy(renderData->ConstantBlock.data() + offset, data.data(), size);
+			renderData->ConstantsVersion = version;
+		});
 	}
 
 #pragma endregion
@@ -30,7 +30,7 @@ namespace Ion
 	class MaterialParameterInstanceScalar : public IMaterialParameterInstance
 	{
 	public:
-		MaterialParameterInstanceScalar(MaterialParameterScalar* parentParameter, float value);
+		MaterialParameterInstanceScalar(MaterialInstance* owner, MaterialParameterScalar* parentParameter, float value);
 
 		virtual IMaterialParameter* GetParameter() const override;
 
@@ -42,15 +42,12 @@ namespace Ion
 		float GetValue() const;
 
 	private:
+		/* Writes the value to the owner constant block */
+		MaterialInstance* m_Owner;
 		MaterialParameterScalar* m_Parameter;
 		float m_Value;
 	};
 
-	inline void MaterialParameterInstanceScalar::SetValue(float value)
-	{
-		m_Value = value;
-	}
-
 	inline float MaterialParameterInstanceScalar::GetValue() const
 	{
 		return m_Value;
@@ -59,7 +56,7 @@ namespace Ion
 	class MaterialParameterInstanceVector : public IMaterialParameterInstance
 	{
 	public:
-		MaterialParameterInstanceVector(MaterialParameterVector* parentParameter, const Vector4& value);
+		MaterialParameterInstanceVector(MaterialInstance* owner, MaterialParameterVector* parentParameter, const Vector4& value);
 
 		virtual IMaterialParameter* GetParameter() const override;
 
@@ -71,15 +68,12 @@ namespace Ion
 		const Vector4& GetValue() const;
 
 	private:
+		/* Writes the value to the owner constant block */
+		MaterialInstance* m_Owner;
 		MaterialParameterVector* m_Parameter;
 		Vector4 m_Value;
 	};
 
-	inline void MaterialParameterInstanceVector::SetValue(const Vector4& value)
-	{
-		m_Value = value;
-	}
-
 	inline const Vector4& MaterialParameterInstanceVector::GetValue() const
 	{
 		return m_Value;
@@ -99,8 +93,11 @@ namespace Ion
 		void SetValue(Asset value);
 		Asset GetValue() const;
 
+		/* Binds the current texture of the resource (the streamed textures get replaced). */
 		void Bind(uint32 slot);
 
+		const TSharedPtr<TextureResource>& GetTextureResource() const;
+
 	private:
 		void UpdateTexture();
 
@@ -109,7 +106,6 @@ namespace Ion
 		Asset m_Value;
 
 		TSharedPtr<TextureResource> m_TextureResource;
-		TRef<RHITexture> m_Texture;
 	};
 
 	inline void MaterialParameterInstanceTexture2D::SetValue(Asset value)
@@ -123,6 +119,11 @@ namespace Ion
 		return m_Value;
 	}
 
+	inline const TSharedPtr<TextureResource>& MaterialParameterInstanceTexture2D::GetTextureResource() const
+	{
+		return m_TextureResource;
+	}
+
 #pragma endregion
 
 #pragma region Material Instance Asset Type
@@ -159,6 +160,20 @@ namespace Ion
 
 #pragma region Material Instance
 
+	/* The constants of a material instance used by the render thread.
+	   The game thread passes the changes with render commands, including
+	   the whole block and buffer when the parent material changes. */
+	struct MaterialInstanceRenderData
+	{
+		/* Copy of the instance constant block */
+		TArray<uint8> ConstantBlock;
+		/* Created from the parent material constants layout (null if there are no constants) */
+		TRef<RHIUniformBufferDynamic> ConstantBuffer;
+		uint32 ConstantsVersion = 0;
+		/* Version of the constant block in ConstantBuffer */
+		uint32 UploadedConstantsVersion = 0;
+	};
+
 	class ION_API MaterialInstance
 	{
 	public:
@@ -174,11 +189,20 @@ namespace Ion
 
 		const std::shared_ptr<Material>& GetBaseMaterial() const;
 
+		const THashSet<MaterialParameterInstanceTexture2D*>& GetTextureParameterInstances() const;
+
 		/**
-		 * @brief Set the values in the associated material uniform buffer
-		 * to the parameter instance values
+		 * @brief Uploads the constant block to the instance constant buffer,
+		 * if any parameter has changed since the last upload.
+		 * Render thread only.
 		 */
-		void TransferParameters() const;
+		void UpdateConstantBuffer() const;
+
+		/* Binds the instance constant buffer (doesn't upload anything). */
+		void BindConstantBuffer() const;
+
+		/* Incremented every time a scalar or vector parameter value is set. */
+		uint32 GetConstantsVersion() const;
 
 		Asset GetAsset() const;
 
@@ -193,13 +217,26 @@ namespace Ion
 		void CreateParameterInstances();
 		void DestroyParameterInstances();
 
+		/* Called by the parameter instances, when their value changes */
+		void WriteConstant(uint32 offset, const void* value, size_t size);
+
 	private:
 		std::shared_ptr<Material> m_ParentMaterial;
 
 		THashMap<String, IMaterialParameterInstance*> m_ParameterInstances;
 		THashSet<MaterialParameterInstanceTexture2D*> m_TextureParameterInstances;
 
+		/* Scalar and vector parameter values, laid out like the material constant buffer (game thread) */
+		TArray<uint8> m_ConstantBlock;
+		uint32 m_ConstantsVersion;
+		/* Created with the instance and never reassigned, the render thread dereferences it
+		   without synchronization. Its contents are only modified with render commands. */
+		TSharedPtr<MaterialInstanceRenderData> m_RenderData;
+
 		Asset m_Asset;
+
+		friend class MaterialParameterInstanceScalar;
+		friend class MaterialParameterInstanceVector;
 	};
 
 	template<typename T>
@@ -214,6 +251,16 @@ namespace Ion
 		return m_ParentMaterial;
 	}
 
+	inline const THashSet<MaterialParameterInstanceTexture2D*>& MaterialInstance::GetTextureParameterInstances() const
+	{
+		return m_TextureParameterInstances;
+	}
+
+	inline uint32 MaterialInstance::GetConstantsVersion() const
+	{
+		return m_ConstantsVersion;
+	}
+
 	inline Asset MaterialInstance::GetAsset() const
 	{
 		return m_Asset;
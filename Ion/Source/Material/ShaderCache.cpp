@@ -0,0 +1,439 @@
+#include "IonPCH.h"
+
+#include "ShaderCache.h"
+
+#include "RHI/RHI.h"
+#include "RHI/Shader.h"
+#include "Renderer/RendererCore.h"
+#include "Application/EnginePath.h"
+
+namespace Ion
+{
+#pragma region Shader Cache
+
+	/* Written at the beginning of every cache file */
+	struct ShaderCacheFileHeader
+	{
+		static constexpr uint32 MagicValue = 0x43485349; // "ISHC"
+
+		uint32 Magic;
+		uint32 Version;
+		uint64 SourceHash;
+		uint64 EnvironmentHash;
+		uint64 Usage;
+		uint64 BinaryHash;
+		uint64 BinarySize;
+	};
+
+	String ShaderCacheKey::GetFileName() const
+	{
+		return fmt::format("{:016x}{:016x}_{:02x}.shadercache", SourceHash, EnvironmentHash, (uint32)Usage);
+	}
+
+	ShaderCache::ShaderCache() :
+		m_MemoryCapacity(DefaultMemoryCapacity),
+		m_CachePath(EnginePath::GetEnginePath() / "ShaderCache"),
+		m_EnvironmentHash(0),
+		m_bEnvironmentHashValid(false),
+		m_bEnabled(true)
+	{
+	}
+
+	ShaderCache& ShaderCache::Get()
+	{
+		// The first call can come from any of the compile tasks,
+		// the initialization of a local static is thread-safe.
+		static ShaderCache* s_Instance = new ShaderCache;
+		return *s_Instance;
+	}
+
+	ShaderCacheKey ShaderCache::MakeKey(const String& source, EShaderUsage usage, const FilePath& sourcePath)
+	{
+		TRACE_FUNCTION();
+
+		ShaderCacheKey key { };
+		THashSet<String> visitedIncludes;
+		FilePath sourceDir = sourcePath.IsEmpty() ? FilePath() : sourcePath / "..";
+		key.SourceHash = HashIncludes(source, sourceDir, HashBytes(source.data(), source.size()), visitedIncludes);
+		key.EnvironmentHash = GetEnvironmentHash();
+		key.Usage = usage;
+		return key;
+	}
+
+	uint64 ShaderCache::GetEnvironmentHash()
+	{
+		ShaderCache& instance = Get();
+
+		ScopedLock lock(instance.m_Mutex);
+
+		if (!instance.m_bEnvironmentHashValid)
+		{
+			ionassert(RHI::Get(), "The RHI has to be initialized before the shader cache is used.");
+
+			String environment = RHI::Get()->GetShaderCacheTag();
+
+			uint64 environmentHash = HashBytes(environment.data(), environment.size());
+			ERHI rhi = RHI::GetCurrent();
+			environmentHash = HashBytes(&rhi, sizeof(rhi), environmentHash);
+			uint32 bShaderDebug = SHADER_DEBUG_ENABLED;
+			environmentHash = HashBytes(&bShaderDebug, sizeof(bShaderDebug), environmentHash);
+
+			instance.m_EnvironmentHash = environmentHash;
+			instance.m_bEnvironmentHashValid = true;
+		}
+
+		return instance.m_EnvironmentHash;
+	}
+
+	Result<void, RHIError, ShaderCompilationError> ShaderCache::Compile(RHIShader& shader, const ShaderCacheKey& key)
+	{
+		TRACE_FUNCTION();
+
+		if (!IsEnabled() || !shader.SupportsBinary())
+		{
+			return shader.Compile();
+		}
+
+		TArray<uint8> binary;
+		if (Find(key, binary))
+		{
+			if (shader.LoadBinary(binary))
+			{
+				return Ok();
+			}
+
+			// The binary is not valid anymore, compile the shader again.
+			MaterialLogger.Warn("Cached shader \"{}\" has been rejected by the RHI.", key.GetFileName());
+			Remove(key);
+		}
+
+		fwdthrowall(shader.Compile());
+
+		if (shader.GetBinary(binary))
+		{
+			Store(key, binary);
+		}
+
+		return Ok();
+	}
+
+	bool ShaderCache::Find(const ShaderCacheKey& key, TArray<uint8>& outBinary)
+	{
+		TRACE_FUNCTION();
+
+		ShaderCache& instance = Get();
+
+		if (instance.FindInMemory(key, outBinary))
+			return true;
+
+		if (instance.LoadFromDisk(key, outBinary))
+		{
+			instance.AddToMemory(key, outBinary);
+			return true;
+		}
+
+		ScopedLock lock(instance.m_Mutex);
+		++instance.m_Stats.Misses;
+
+		return false;
+	}
+
+	void ShaderCache::Store(const ShaderCacheKey& key, const TArray<uint8>& binary)
+	{
+		TRACE_FUNCTION();
+
+		ShaderCache& instance = Get();
+
+		instance.AddToMemory(key, binary);
+		instance.SaveToDisk(key, binary);
+	}
+
+	void ShaderCache::Remove(const ShaderCacheKey& key)
+	{
+		ShaderCache& instance = Get();
+
+		{
+			ScopedLock lock(instance.m_Mutex);
+
+			++instance.m_Stats.Rejected;
+
+			auto it = instance.m_Entries.find(key.GetHash());
+			if (it != instance.m_Entries.end() && it->second->Key == key)
+			{
+				instance.m_LRU.erase(it->second);
+				instance.m_Entries.erase(it);
+			}
+		}
+
+		ScopedLock lock(instance.m_FileMutex);
+
+		FilePath path = instance.GetFilePath(key);
+		if (path.IsFile())
+		{
+			path.Delete();
+		}
+	}
+
+	void ShaderCache::SetCachePath(const FilePath& path)
+	{
+		ShaderCache& instance = Get();
+
+		ScopedLock lock(instance.m_FileMutex);
+		instance.m_CachePath = path;
+	}
+
+	FilePath ShaderCache::GetCachePath()
+	{
+		ShaderCache& instance = Get();
+
+		ScopedLock lock(instance.m_FileMutex);
+		return instance.m_CachePath;
+	}
+
+	void ShaderCache::SetMemoryCapacity(uint32 capacity)
+	{
+		ShaderCache& instance = Get();
+
+		ScopedLock lock(instance.m_Mutex);
+
+		instance.m_MemoryCapacity = capacity;
+		while (instance.m_LRU.size() > capacity)
+		{
+			instance.m_Entries.erase(instance.m_LRU.back().Key.GetHash());
+			instance.m_LRU.pop_back();
+		}
+	}
+
+	uint32 ShaderCache::GetMemoryCapacity()
+	{
+		ShaderCache& instance = Get();
+
+		ScopedLock lock(instance.m_Mutex);
+		return instance.m_MemoryCapacity;
+	}
+
+	void ShaderCache::SetEnabled(bool bEnabled)
+	{
+		ShaderCache& instance = Get();
+
+		ScopedLock lock(instance.m_Mutex);
+		instance.m_bEnabled = bEnabled;
+	}
+
+	bool ShaderCache::IsEnabled()
+	{
+		ShaderCache& instance = Get();
+
+		ScopedLock lock(instance.m_Mutex);
+		return instance.m_bEnabled;
+	}
+
+	void ShaderCache::ClearMemory()
+	{
+		ShaderCache& instance = Get();
+
+		ScopedLock lock(instance.m_Mutex);
+		instance.m_LRU.clear();
+		instance.m_Entries.clear();
+	}
+
+	ShaderCacheStats ShaderCache::GetStats()
+	{
+		ShaderCache& instance = Get();
+
+		ScopedLock lock(instance.m_Mutex);
+		return instance.m_Stats;
+	}
+
+	void ShaderCache::ResetStats()
+	{
+		ShaderCache& instance = Get();
+
+		ScopedLock lock(instance.m_Mutex);
+		instance.m_Stats = ShaderCacheStats();
+	}
+
+	bool ShaderCache::FindInMemory(const ShaderCacheKey& key, TArray<uint8>& outBinary)
+	{
+		ScopedLock lock(m_Mutex);
+
+		auto it = m_Entries.find(key.GetHash());
+		if (it == m_Entries.end() || it->second->Key != key)
+			return false;
+
+		// Move the entry to the front, so it's evicted last
+		m_LRU.splice(m_LRU.begin(), m_LRU, it->second);
+
+		outBinary = m_LRU.front().Binary;
+		++m_Stats.MemoryHits;
+
+		return true;
+	}
+
+	void ShaderCache::AddToMemory(const ShaderCacheKey& key, const TArray<uint8>& binary)
+	{
+		ScopedLock lock(m_Mutex);
+
+		if (!m_MemoryCapacity)
+			return;
+
+		uint64 hash = key.GetHash();
+
+		auto it = m_Entries.find(hash);
+		if (it != m_Entries.end())
+		{
+			m_LRU.erase(it->second);
+			m_Entries.erase(it);
+		}
+
+		m_LRU.push_front(Entry { key, binary });
+		m_Entries.emplace(hash, m_LRU.begin());
+
+		while (m_LRU.size() > m_MemoryCapacity)
+		{
+			m_Entries.erase(m_LRU.back().Key.GetHash());
+			m_LRU.pop_back();
+		}
+	}
+
+	bool ShaderCache::LoadFromDisk(const ShaderCacheKey& key, TArray<uint8>& outBinary)
+	{
+		TRACE_FUNCTION();
+
+		ScopedLock lock(m_FileMutex);
+
+		FilePath path = GetFilePath(key);
+		if (!path.IsFile())
+			return false;
+
+		File file(path);
+		if (!file.Open(EFileMode::Read))
+			return false;
+
+		ShaderCacheFileHeader header { };
+		bool bValid = file.Read((uint8*)&header, sizeof(header)) &&
+			header.Magic == ShaderCacheFileHeader::MagicValue &&
+			header.Version == FileVersion &&
+			header.SourceHash == key.SourceHash &&
+			header.EnvironmentHash == key.EnvironmentHash &&
+			header.Usage == (uint64)key.Usage &&
+			header.BinarySize == (uint64)file.GetSize() - sizeof(header);
+
+		if (bValid)
+		{
+			outBinary.resize(header.BinarySize);
+			bValid = file.Read(outBinary.data(), header.BinarySize) &&
+				HashBytes(outBinary.data(), outBinary.size()) == header.BinaryHash;
+		}
+
+		file.Close();
+
+		ScopedLock statsLock(m_Mutex);
+		if (!bValid)
+		{
+			MaterialLogger.Warn("Shader cache file \"{}\" is invalid.", path.ToString());
+			++m_Stats.Rejected;
+			return false;
+		}
+
+		++m_Stats.DiskHits;
+
+		return true;
+	}
+
+	void ShaderCache::SaveToDisk(const ShaderCacheKey& key, const TArray<uint8>& binary)
+	{
+		TRACE_FUNCTION();
+
+		ScopedLock lock(m_FileMutex);
+
+		if (!m_CachePath.IsDirectory())
+		{
+			FilePath parent = m_CachePath;
+			if (!parent.Back().MkDir(m_CachePath.LastElement()))
+			{
+				MaterialLogger.Error("Cannot create the shader cache directory \"{}\".", m_CachePath.ToString());
+				return;
+			}
+		}
+
+		ShaderCacheFileHeader header { };
+		header.Magic = ShaderCacheFileHeader::MagicValue;
+		header.Version = FileVersion;
+		header.SourceHash = key.SourceHash;
+		header.EnvironmentHash = key.EnvironmentHash;
+		header.Usage = (uint64)key.Usage;
+		header.BinaryHash = HashBytes(binary.data(), binary.size());
+		header.BinarySize = binary.size();
+
+		File file(GetFilePath(key));
+		if (!file.Open(EFileMode::Write | EFileMode::Reset | EFileMode::CreateNew))
+		{
+			MaterialLogger.Error("Cannot open the shader cache file \"{}\".", file.GetFullPath());
+			return;
+		}
+
+		if (!file.Write((const uint8*)&header, sizeof(header)) ||
+			!file.Write(binary.data(), binary.size()))
+		{
+			MaterialLogger.Error("Cannot write the shader cache file \"{}\".", file.GetFullPath());
+		}
+
+		file.Close();
+	}
+
+	FilePath ShaderCache::GetFilePath(const ShaderCacheKey& key) const
+	{
+		return m_CachePath / key.GetFileName();
+	}
+
+	uint64 ShaderCache::HashIncludes(const String& source, const FilePath& sourceDir, uint64 hash, THashSet<String>& visited)
+	{
+		static constexpr StringView IncludeDirective = "#include";
+
+		for (size_t pos = source.find(IncludeDirective); pos != String::npos; pos = source.find(IncludeDirective, pos))
+		{
+			pos += IncludeDirective.size();
+
+			size_t begin = source.find_first_of("\"<\n", pos);
+			if (begin == String::npos || source[begin] == '\n')
+				continue;
+
+			bool bSystem = source[begin] == '<';
+			size_t end = source.find(bSystem ? '>' : '"', begin + 1);
+			if (end == String::npos)
+				break;
+
+			String includeName = source.substr(begin + 1, end - begin - 1);
+			pos = end + 1;
+
+			FilePath includePath;
+			if (!bSystem && !sourceDir.IsEmpty() && (sourceDir / includeName).IsFile())
+				includePath = sourceDir / includeName;
+			else
+				includePath = RHI::GetEngineShadersPath() / includeName;
+
+			// Each file is hashed only once, this also stops the include cycles.
+			if (!visited.emplace(includePath.ToString()).second)
+				continue;
+
+			String includeSource;
+			ionmatchresult(File::ReadToString(includePath),
+				mcaseok includeSource = R.Unwrap();
+				melse
+				{
+					// The compilation is going to fail anyway, but the hash has to change if the file appears.
+					hash = HashBytes(includeName.data(), includeName.size(), hash);
+					continue;
+				}
+			);
+
+			hash = HashBytes(includeSource.data(), includeSource.size(), hash);
+			hash = HashIncludes(includeSource, includePath / "..", hash, visited);
+		}
+
+		return hash;
+	}
+
+#pragma endregion
+}
@@ -0,0 +1,159 @@
+#pragma once
+
+#include "Material.h"
+
+namespace Ion
+{
+#pragma region Shader Cache
+
+	/**
+	 * @brief Identifies a compiled shader permutation.
+	 * A change of the source, the usage or the RHI environment results in a different key.
+	 */
+	struct ShaderCacheKey
+	{
+		/* Hash of the generated shader source (usage defines + material code) */
+		uint64 SourceHash;
+		/* Hash of the RHI, its shader cache tag and the shader compilation settings */
+		uint64 EnvironmentHash;
+		EShaderUsage Usage;
+
+		uint64 GetHash() const;
+		/* Name of the file the binary is stored in on disk */
+		String GetFileName() const;
+
+		bool operator==(const ShaderCacheKey& other) const;
+		bool operator!=(const ShaderCacheKey& other) const;
+	};
+
+	struct ShaderCacheStats
+	{
+		uint32 MemoryHits = 0;
+		uint32 DiskHits = 0;
+		uint32 Misses = 0;
+		/* Cached binaries that were stale, corrupted or have been rejected by the RHI */
+		uint32 Rejected = 0;
+	};
+
+	/**
+	 * @brief Cache of the compiled shader binaries.
+	 *
+	 * @details The binaries are kept in an in-memory LRU and stored on disk,
+	 * one file per key. Each file contains the whole key and a hash of the binary,
+	 * so a stale or a corrupted file is detected and the shader is compiled again.
+	 * Thread-safe - the shaders are compiled on the Engine Task Queue.
+	 *
+	 * Only used if the current RHI supports the shader binaries (RHIShader::SupportsBinary).
+	 */
+	class ION_API ShaderCache
+	{
+	public:
+		/* Number of binaries kept in memory */
+		static constexpr uint32 DefaultMemoryCapacity = 128;
+		/* Incremented when the file format changes, the old files get rejected. */
+		static constexpr uint32 FileVersion = 1;
+
+		/**
+		 * @brief Hashes the source, together with the contents of all the files it includes,
+		 * so a change of a shared shader header invalidates the binary too.
+		 * Can be called on any thread, after the environment hash has been queried (see GetEnvironmentHash).
+		 *
+		 * @param sourcePath Path of the file the source comes from (the local includes are relative to it)
+		 */
+		static ShaderCacheKey MakeKey(const String& source, EShaderUsage usage, const FilePath& sourcePath = FilePath());
+
+		/**
+		 * @brief Hash of the RHI, its shader cache tag and the shader compilation settings.
+		 * Queried from the RHI on the first call, so make it on the thread the RHI has been initialized on.
+		 */
+		static uint64 GetEnvironmentHash();
+
+		/**
+		 * @brief Creates the shader from the cached binary, or compiles it on a miss
+		 * and stores the compiled binary in the cache.
+		 * The sources have to be added to the shader beforehand.
+		 */
+		static Result<void, RHIError, ShaderCompilationError> Compile(RHIShader& shader, const ShaderCacheKey& key);
+
+		/* Looks for the binary in memory first, then on disk. */
+		static bool Find(const ShaderCacheKey& key, TArray<uint8>& outBinary);
+		static void Store(const ShaderCacheKey& key, const TArray<uint8>& binary);
+		/* Removes the binary from memory and from disk (e.g. if the RHI has rejected it). */
+		static void Remove(const ShaderCacheKey& key);
+
+		/* Directory the binaries are stored in ({EnginePath}/ShaderCache by default) */
+		static void SetCachePath(const FilePath& path);
+		static FilePath GetCachePath();
+
+		static void SetMemoryCapacity(uint32 capacity);
+		static uint32 GetMemoryCapacity();
+
+		static void SetEnabled(bool bEnabled);
+		static bool IsEnabled();
+
+		/* Clears the in-memory cache, the files are kept. */
+		static void ClearMemory();
+
+		static ShaderCacheStats GetStats();
+		static void ResetStats();
+
+	private:
+		ShaderCache();
+
+		static ShaderCache& Get();
+
+		bool FindInMemory(const ShaderCacheKey& key, TArray<uint8>& outBinary);
+		void AddToMemory(const ShaderCacheKey& key, const TArray<uint8>& binary);
+
+		bool LoadFromDisk(const ShaderCacheKey& key, TArray<uint8>& outBinary);
+		void SaveToDisk(const ShaderCacheKey& key, const TArray<uint8>& binary);
+
+		FilePath GetFilePath(const ShaderCacheKey& key) const;
+
+		/* Resolves the includes the same way as the shader compilers do (see DXInclude),
+		   the nested local includes relative to the file that includes them. */
+		static uint64 HashIncludes(const String& source, const FilePath& sourceDir, uint64 hash, THashSet<String>& visited);
+
+	private:
+		struct Entry
+		{
+			ShaderCacheKey Key;
+			TArray<uint8> Binary;
+		};
+
+		/* Most recently used first */
+		TDoubleLinkedList<Entry> m_LRU;
+		THashMap<uint64, TDoubleLinkedList<Entry>::iterator> m_Entries;
+		uint32 m_MemoryCapacity;
+
+		FilePath m_CachePath;
+		ShaderCacheStats m_Stats;
+		uint64 m_EnvironmentHash;
+		bool m_bEnvironmentHashValid;
+		bool m_bEnabled;
+
+		Mutex m_Mutex;
+		/* Held while the files are accessed, so the memory lookups don't wait for the disk. */
+		Mutex m_FileMutex;
+	};
+
+	inline uint64 ShaderCacheKey::GetHash() const
+	{
+		return CombineHashes(CombineHashes(SourceHash, EnvironmentHash), (uint64)Usage);
+	}
+
+	inline bool ShaderCacheKey::operator==(const ShaderCacheKey& other) const
+	{
+		return
+			SourceHash == other.SourceHash &&
+			EnvironmentHash == other.EnvironmentHash &&
+			Usage == other.Usage;
+	}
+
+	inline bool ShaderCacheKey::operator!=(const ShaderCacheKey& other) const
+	{
+		return !(*this == other);
+	}
+
+#pragma endregion
+}
@@ -13,6 +13,7 @@ namespace Ion
 	{
 	public:
 		MATTER_DECLARE_CLASS(MObject)
+		ENGINE_ALLOCATED(EMemoryTag::Engine)
 
 		/**
 		 * @brief Used to create and register an MObject instance at runtime.
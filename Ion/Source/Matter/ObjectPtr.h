@@ -14,8 +14,13 @@ namespace Ion
 	template<typename T>
 	using TWeakObjectPtr = TWeakPtr<T>;
 
+	/* Non-owning, doesn't touch the ref count. Only valid as long as an owning pointer keeps the object alive. */
+	template<typename T>
+	using TObjectRef = TBorrowedPtr<T>;
+
 	using MObjectPtr = TSharedPtr<MObject>;
 	using MWeakObjectPtr = TWeakPtr<MObject>;
+	using MObjectRef = TBorrowedPtr<MObject>;
 
 #pragma endregion
 
@@ -40,6 +40,13 @@ namespace Ion
 
 		virtual String GetCurrentDisplayName() override;
 
+		virtual bool SupportsInstancing() const override { return true; }
+		virtual bool SupportsAsyncShaderCompilation() const override { return true; }
+		// BC7 requires Direct3D 11
+		virtual bool SupportsTextureFormat(ETextureFormat format) const override { return format != ETextureFormat::BC7; }
+		/* The shaders are compiled for the feature level */
+		virtual String GetShaderCacheTag() const override { return GetFeatureLevelString(); }
+
 		static FORCEINLINE const char* GetFeatureLevelString();
 		static FORCEINLINE D3D10_FEATURE_LEVEL1 GetFeatureLevel();
 
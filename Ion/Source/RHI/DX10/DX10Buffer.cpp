@@ -18,8 +18,10 @@ namespace Ion
 	DX10VertexBuffer::DX10VertexBuffer(float* vertexAttributes, uint64 count) :
 		m_VertexCount(0),
 		m_ID(0),
+		m_DynamicSize(0),
 		m_Buffer(nullptr),
-		m_InputLayout(nullptr)
+		m_InputLayout(nullptr),
+		m_InstanceInputLayout(nullptr)
 	{
 		DX10Logger.Info("DX10VertexBuffer has been created.");
 
@@ -28,12 +30,28 @@ namespace Ion
 			.Unwrap();
 	}
 
+	DX10VertexBuffer::DX10VertexBuffer(uint64 size) :
+		m_VertexCount(0),
+		m_ID(0),
+		m_DynamicSize(size),
+		m_Buffer(nullptr),
+		m_InputLayout(nullptr),
+		m_InstanceInputLayout(nullptr)
+	{
+		DX10Logger.Info("DX10VertexBuffer (dynamic) has been created.");
+
+		CreateDynamicBuffer(size)
+			.Err([](Error& error) { DX10Logger.Critical("Cannot create a dynamic Vertex Buffer.\n{}", error.Message); })
+			.Unwrap();
+	}
+
 	DX10VertexBuffer::~DX10VertexBuffer()
 	{
 		TRACE_FUNCTION();
 
 		COMRelease(m_Buffer);
 		COMRelease(m_InputLayout);
+		COMRelease(m_InstanceInputLayout);
 
 		DX10Logger.Info("DX10VertexBuffer has been destroyed.");
 	}
@@ -48,26 +66,92 @@ namespace Ion
 
 		m_IEDArray.reserve(m_VertexLayout->GetAttributes().size());
 
-		for (const VertexAttribute& attribute : m_VertexLayout->GetAttributes())
+		AddInputElements(m_IEDArray, *m_VertexLayout, 0);
+	}
+
+	Result<void, RHIError> DX10VertexBuffer::SetLayoutShader(const TRef<RHIShader>& shader)
+	{
+		return CreateDX10Layout(RefCast<DX10Shader>(shader));
+	}
+
+	Result<void, RHIError> DX10VertexBuffer::SetInstanceLayoutShader(const TRef<RHIVertexLayout>& instanceLayout, const TRef<RHIShader>& shader)
+	{
+		TRACE_FUNCTION();
+
+		ionassert(instanceLayout);
+		ionassert(instanceLayout->GetInputRate() == EVertexInputRate::Instance);
+		ionassert(shader);
+		ionassert(shader->IsCompiled());
+		ionassert(m_VertexLayout, "The vertex layout has to be set first.");
+
+		TArray<D3D10_INPUT_ELEMENT_DESC> iedArray = m_IEDArray;
+		AddInputElements(iedArray, *instanceLayout, 1);
+
+		ID3D10Device* device = DX10::GetDevice();
+
+		ID3DBlob* blob = RefCast<DX10Shader>(shader)->GetVertexShaderByteCode();
+
+		// The layout can be recreated for a different shader
+		COMRelease(m_InstanceInputLayout);
+		m_InstanceInputLayout = nullptr;
+
+		dxcall(device->CreateInputLayout(iedArray.data(), (uint32)iedArray.size(), blob->GetBufferPointer(), blob->GetBufferSize(), &m_InstanceInputLayout),
+			"Could not create the instanced Input Layout.");
+
+		m_InstanceLayout = instanceLayout;
+
+		DX10Logger.Debug("DX10VertexBuffer instanced Input Layout object has been created.");
+
+		return Ok();
+	}
+
+	bool DX10VertexBuffer::HasInstanceLayout() const
+	{
+		return m_InstanceInputLayout != nullptr;
+	}
+
+	Result<void, RHIError> DX10VertexBuffer::UpdateData(const void* data, uint64 size)
+	{
+		ionassert(m_DynamicSize, "Only a dynamic Vertex Buffer can be updated.");
+		ionassert(size <= m_DynamicSize);
+
+		void* pData = nullptr;
+		dxcall(m_Buffer->Map(D3D10_MAP_WRITE_DISCARD, 0, &pData));
+		memcpy(pData, data, size);
+		dxcall(m_Buffer->Unmap());
+
+		return Ok();
+	}
+
+	void DX10VertexBuffer::AddInputElements(TArray<D3D10_INPUT_ELEMENT_DESC>& outIEDArray, const RHIVertexLayout& layout, uint32 inputSlot)
+	{
+		bool bPerInstance = layout.GetInputRate() == EVertexInputRate::Instance;
+
+		const TArray<VertexAttribute>& attributes = layout.GetAttributes();
+		for (size_t i = 0; i < attributes.size(); ++i)
 		{
+			const VertexAttribute& attribute = attributes[i];
+
+			uint32 semanticIndex = 0;
+			for (size_t j = 0; j < i; ++j)
+			{
+				if (attributes[j].Semantic == attribute.Semantic)
+					++semanticIndex;
+			}
+
 			D3D10_INPUT_ELEMENT_DESC ied { };
 			ied.SemanticName = DXCommon::GetSemanticName(attribute.Semantic);
-			ied.SemanticIndex = 0;
+			ied.SemanticIndex = semanticIndex;
 			ied.Format = DXCommon::VertexAttributeToDXGIFormat({ attribute.Type, attribute.ElementCount });
-			ied.InputSlot = 0;
+			ied.InputSlot = inputSlot;
 			ied.AlignedByteOffset = D3D10_APPEND_ALIGNED_ELEMENT;
-			ied.InputSlotClass = D3D10_INPUT_PER_VERTEX_DATA;
-			ied.InstanceDataStepRate = 0;
+			ied.InputSlotClass = bPerInstance ? D3D10_INPUT_PER_INSTANCE_DATA : D3D10_INPUT_PER_VERTEX_DATA;
+			ied.InstanceDataStepRate = bPerInstance ? 1 : 0;
 
-			m_IEDArray.emplace_back(ied);
+			outIEDArray.emplace_back(ied);
 		}
 	}
 
-	Result<void, RHIError> DX10VertexBuffer::SetLayoutShader(const TRef<RHIShader>& shader)
-	{
-		return CreateDX10Layout(RefCast<DX10Shader>(shader));
-	}
-
 	Result<void, RHIError> DX10VertexBuffer::CreateDX10Layout(const TRef<DX10Shader>& shader)
 	{
 		TRACE_FUNCTION();
@@ -126,6 +210,31 @@ namespace Ion
 		return Ok();
 	}
 
+	Result<void, RHIError> DX10VertexBuffer::BindInstanceLayout() const
+	{
+		ionassert(m_InstanceInputLayout, "Instance Layout has not been set.");
+
+		ID3D10Device* device = DX10::GetDevice();
+
+		dxcall(device->IASetInputLayout(m_InstanceInputLayout));
+
+		return Ok();
+	}
+
+	Result<void, RHIError> DX10VertexBuffer::BindInstances(const RHIVertexLayout& instanceLayout, uint64 offset) const
+	{
+		ionassert(instanceLayout.GetInputRate() == EVertexInputRate::Instance);
+		ionassert(offset <= std::numeric_limits<UINT>::max());
+
+		ID3D10Device* device = DX10::GetDevice();
+
+		uint32 stride = instanceLayout.GetStride();
+		uint32 offset32 = (uint32)offset;
+		dxcall(device->IASetVertexBuffers(1, 1, &m_Buffer, &stride, &offset32));
+
+		return Ok();
+	}
+
 	Result<void, RHIError> DX10VertexBuffer::CreateBuffer(float* vertexAttributes, uint64 count)
 	{
 		TRACE_FUNCTION();
@@ -156,6 +265,29 @@ namespace Ion
 		return Ok();
 	}
 
+	Result<void, RHIError> DX10VertexBuffer::CreateDynamicBuffer(uint64 size)
+	{
+		TRACE_FUNCTION();
+
+		ionassert(size > 0);
+		ionassert(size <= std::numeric_limits<UINT>::max());
+
+		ID3D10Device* device = DX10::GetDevice();
+
+		D3D10_BUFFER_DESC bd { };
+		bd.ByteWidth = (uint32)size;
+		bd.BindFlags = D3D10_BIND_VERTEX_BUFFER;
+		bd.Usage = D3D10_USAGE_DYNAMIC;
+		bd.CPUAccessFlags = D3D10_CPU_ACCESS_WRITE;
+
+		dxcall(device->CreateBuffer(&bd, nullptr, &m_Buffer),
+			"Could not create dynamic Vertex Buffer.");
+
+		DX10Logger.Debug("DX10VertexBuffer dynamic Buffer object has been created.");
+
+		return Ok();
+	}
+
 	// -------------------------------------------------------------------
 	// DX10IndexBuffer ---------------------------------------------------
 	// -------------------------------------------------------------------
@@ -374,6 +506,14 @@ namespace Ion
 		return &it->second;
 	}
 
+	void DX10UniformBufferDynamic::SetData(const void* data, size_t size)
+	{
+		ionassert(data);
+		ionassert(size <= m_Common.DataSize);
+
+		memcpy(m_Common.Data, data, size);
+	}
+
 	Result<void, RHIError> DX10UniformBufferDynamic::UpdateData() const
 	{
 		return m_Common.UpdateData();
@@ -11,31 +11,47 @@ namespace Ion
 	{
 	public:
 		DX10VertexBuffer(float* vertexAttributes, uint64 count);
+		/* Dynamic buffer */
+		DX10VertexBuffer(uint64 size);
 		virtual ~DX10VertexBuffer() override;
 
 		virtual void SetLayout(const TRef<RHIVertexLayout>& layout) override;
 		virtual Result<void, RHIError> SetLayoutShader(const TRef<RHIShader>& shader) override;
 
+		virtual Result<void, RHIError> SetInstanceLayoutShader(const TRef<RHIVertexLayout>& instanceLayout, const TRef<RHIShader>& shader) override;
+		virtual bool HasInstanceLayout() const override;
+
+		virtual Result<void, RHIError> UpdateData(const void* data, uint64 size) override;
+
 		virtual uint32 GetVertexCount() const override;
 
 	protected:
 		virtual Result<void, RHIError> Bind() const override;
 		virtual Result<void, RHIError> BindLayout() const override;
+		virtual Result<void, RHIError> BindInstanceLayout() const override;
+		virtual Result<void, RHIError> BindInstances(const RHIVertexLayout& instanceLayout, uint64 offset) const override;
 		virtual Result<void, RHIError> Unbind() const override;
 
 	private:
 		Result<void, RHIError> CreateBuffer(float* vertexAttributes, uint64 count);
+		Result<void, RHIError> CreateDynamicBuffer(uint64 size);
 
 		Result<void, RHIError> CreateDX10Layout(const TRef<class DX10Shader>& shader);
 
+		/* Attributes that share a semantic (e.g. the matrix columns) get consecutive semantic indices. */
+		static void AddInputElements(TArray<D3D10_INPUT_ELEMENT_DESC>& outIEDArray, const RHIVertexLayout& layout, uint32 inputSlot);
+
 	private:
 		uint32 m_ID;
 		uint32 m_VertexCount;
+		uint64 m_DynamicSize;
 		TRef<RHIVertexLayout> m_VertexLayout;
+		TRef<RHIVertexLayout> m_InstanceLayout;
 		TArray<D3D10_INPUT_ELEMENT_DESC> m_IEDArray;
 
 		ID3D10Buffer* m_Buffer;
 		ID3D10InputLayout* m_InputLayout;
+		ID3D10InputLayout* m_InstanceInputLayout;
 
 		friend class DX10Renderer;
 	};
@@ -114,6 +130,8 @@ namespace Ion
 
 		virtual const UniformData* GetUniformData(const String& name) const override;
 
+		virtual void SetData(const void* data, size_t size) override;
+
 		virtual ~DX10UniformBufferDynamic() override;
 
 	protected:
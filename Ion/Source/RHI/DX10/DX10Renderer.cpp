@@ -70,6 +70,15 @@ namespace Ion
 		return Ok();
 	}
 
+	Result<void, RHIError> DX10Renderer::DrawIndexedInstanced(uint32 indexCount, uint32 instanceCount) const
+	{
+		ID3D10Device* device = DX10::GetDevice();
+
+		dxcall(device->DrawIndexedInstanced(indexCount, instanceCount, 0, 0, 0));
+
+		return Ok();
+	}
+
 	Result<void, RHIError> DX10Renderer::UnbindResources() const
 	{
 		ID3D10Device* device = DX10::GetDevice();
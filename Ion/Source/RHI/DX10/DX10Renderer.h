@@ -20,6 +20,7 @@ namespace Ion
 		virtual Result<void, RHIError> Clear(const RendererClearOptions& options) const override;
 
 		virtual Result<void, RHIError> DrawIndexed(uint32 indexCount) const override;
+		virtual Result<void, RHIError> DrawIndexedInstanced(uint32 indexCount, uint32 instanceCount) const override;
 
 		virtual Result<void, RHIError> UnbindResources() const override;
 
@@ -21,6 +21,7 @@ namespace Ion
 
 		virtual Result<void, RHIError> SetDimensions(TextureDimensions dimensions) override;
 		virtual Result<void, RHIError> UpdateSubresource(Image* image) override;
+		virtual Result<void, RHIError> UpdateSubresource(uint32 mipLevel, const void* pixelData, uint32 lineSize) override;
 
 		virtual Result<void, RHIError> Bind(uint32 slot = 0) const override;
 		virtual Result<void, RHIError> Unbind() const override;
@@ -13,6 +13,8 @@
 
 #include "UserInterface/ImGui.h"
 
+#include <d3d10.h>
+
 #pragma comment(lib, "d3d11.lib")
 #pragma comment(lib, "dxguid.lib")
 
@@ -110,6 +112,22 @@ namespace Ion
 
 			dxcall(device->QueryInterface(IID_PPV_ARGS(&s_Device)));
 			dxcall(context->QueryInterface(IID_PPV_ARGS(&s_Context)));
+
+			// The immediate context can be used by the render thread
+			// and the game thread (e.g. uploading resources) at the same time.
+			ID3D10Multithread* multithread;
+			if (SUCCEEDED(s_Context->QueryInterface(IID_PPV_ARGS(&multithread))))
+			{
+				multithread->SetMultithreadProtected(true);
+				multithread->Release();
+			}
+
+			// Required by the RHIUniformRingBuffer
+			D3D11_FEATURE_DATA_D3D11_OPTIONS options { };
+			if (SUCCEEDED(s_Device->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS, &options, sizeof(options))))
+			{
+				s_bConstantBufferOffsetting = options.ConstantBufferOffsetting && options.MapNoOverwriteOnDynamicConstantBuffer;
+			}
 		}
 		// Create Render Target
 
@@ -478,6 +496,7 @@ namespace Ion
 
 	bool DX11::s_Initialized = false;
 	D3D_FEATURE_LEVEL DX11::s_FeatureLevel = D3D_FEATURE_LEVEL_1_0_CORE;
+	bool DX11::s_bConstantBufferOffsetting = false;
 
 	char DX11::s_DisplayName[120] = "DirectX ";
 
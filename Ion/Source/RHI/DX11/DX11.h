@@ -45,6 +45,14 @@ namespace Ion
 
 		virtual String GetCurrentDisplayName() override;
 
+		virtual bool SupportsRenderThread() const override { return true; }
+		virtual bool SupportsInstancing() const override { return true; }
+		virtual bool SupportsUniformRingBuffer() const override { return s_bConstantBufferOffsetting; }
+		virtual bool SupportsAsyncShaderCompilation() const override { return true; }
+		virtual bool SupportsTextureFormat(ETextureFormat format) const override { return true; }
+		/* The shaders are compiled for the feature level */
+		virtual String GetShaderCacheTag() const override { return GetFeatureLevelString(); }
+
 		static FORCEINLINE const char* GetFeatureLevelString()
 		{
 			return DXCommon::D3DFeatureLevelToString(s_FeatureLevel);
@@ -114,6 +122,8 @@ namespace Ion
 	protected:
 		static bool s_Initialized;
 		static D3D_FEATURE_LEVEL s_FeatureLevel;
+		/* D3D11.1 - the constant buffers can be bound by offset and mapped with NO_OVERWRITE */
+		static bool s_bConstantBufferOffsetting;
 
 	private:
 		static char s_DisplayName[120];
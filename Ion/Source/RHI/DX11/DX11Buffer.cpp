@@ -7,6 +7,8 @@
 #include "DX11Buffer.h"
 #include "DX11Shader.h"
 
+#include "Renderer/RenderThread.h"
+
 namespace Ion
 {
 	// -------------------------------------------------------------------
@@ -16,8 +18,10 @@ namespace Ion
 	DX11VertexBuffer::DX11VertexBuffer(float* vertexAttributes, uint64 count) :
 		m_VertexCount(0),
 		m_ID(0),
+		m_DynamicSize(0),
 		m_Buffer(nullptr),
-		m_InputLayout(nullptr)
+		m_InputLayout(nullptr),
+		m_InstanceInputLayout(nullptr)
 	{
 		DX11Logger.Info("DX11VertexBuffer has been created.");
 
@@ -35,12 +39,28 @@ namespace Ion
 		//}
 	}
 
+	DX11VertexBuffer::DX11VertexBuffer(uint64 size) :
+		m_VertexCount(0),
+		m_ID(0),
+		m_DynamicSize(size),
+		m_Buffer(nullptr),
+		m_InputLayout(nullptr),
+		m_InstanceInputLayout(nullptr)
+	{
+		DX11Logger.Info("DX11VertexBuffer (dynamic) has been created.");
+
+		CreateDynamicBuffer(size)
+			.Err([](Error& error) { DX11Logger.Critical("Cannot create a dynamic Vertex Buffer.\n{}", error.Message); })
+			.Unwrap();
+	}
+
 	DX11VertexBuffer::~DX11VertexBuffer()
 	{
 		TRACE_FUNCTION();
 
 		COMRelease(m_Buffer);
 		COMRelease(m_InputLayout);
+		COMRelease(m_InstanceInputLayout);
 
 		DX11Logger.Info("DX11VertexBuffer has been destroyed.");
 	}
@@ -55,26 +75,98 @@ namespace Ion
 
 		m_IEDArray.reserve(m_VertexLayout->GetAttributes().size());
 
-		for (const VertexAttribute& attribute : m_VertexLayout->GetAttributes())
+		AddInputElements(m_IEDArray, *m_VertexLayout, 0);
+	}
+
+	Result<void, RHIError> DX11VertexBuffer::SetLayoutShader(const TRef<RHIShader>& shader)
+	{
+		return CreateDX11Layout(RefCast<DX11Shader>(shader));
+	}
+
+	Result<void, RHIError> DX11VertexBuffer::SetInstanceLayoutShader(const TRef<RHIVertexLayout>& instanceLayout, const TRef<RHIShader>& shader)
+	{
+		TRACE_FUNCTION();
+
+		ionassert(instanceLayout);
+		ionassert(instanceLayout->GetInputRate() == EVertexInputRate::Instance);
+		ionassert(shader);
+		ionassert(shader->IsCompiled());
+		ionassert(m_VertexLayout, "The vertex layout has to be set first.");
+
+		TArray<D3D11_INPUT_ELEMENT_DESC> iedArray = m_IEDArray;
+		AddInputElements(iedArray, *instanceLayout, 1);
+
+		ID3D11Device* device = DX11::GetDevice();
+
+		ID3DBlob* blob = RefCast<DX11Shader>(shader)->GetVertexShaderByteCode();
+
+		ID3D11InputLayout* instanceInputLayout = nullptr;
+		dxcall(device->CreateInputLayout(iedArray.data(), (uint32)iedArray.size(), blob->GetBufferPointer(), blob->GetBufferSize(), &instanceInputLayout),
+			"Could not create the instanced Input Layout.");
+
+		DX11Logger.Debug("DX11VertexBuffer instanced Input Layout object has been created.");
+
+		// The layout can be recreated for a different shader, while the render thread is drawing with the old one.
+		// The buffer is kept alive until the layouts are swapped.
+		RenderThread::EnqueueCommand([buffer = TRef<DX11VertexBuffer>(this), instanceInputLayout, instanceLayout]
 		{
+			COMRelease(buffer->m_InstanceInputLayout);
+			buffer->m_InstanceInputLayout = instanceInputLayout;
+			buffer->m_InstanceLayout = instanceLayout;
+		});
+
+		return Ok();
+	}
+
+	bool DX11VertexBuffer::HasInstanceLayout() const
+	{
+		return m_InstanceInputLayout != nullptr;
+	}
+
+	Result<void, RHIError> DX11VertexBuffer::UpdateData(const void* data, uint64 size)
+	{
+		ionassert(m_DynamicSize, "Only a dynamic Vertex Buffer can be updated.");
+		ionassert(size <= m_DynamicSize);
+
+		ID3D11DeviceContext* context = DX11::GetContext();
+
+		D3D11_MAPPED_SUBRESOURCE msd { };
+		dxcall(context->Map(m_Buffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &msd));
+		memcpy(msd.pData, data, size);
+		dxcall(context->Unmap(m_Buffer, 0));
+
+		return Ok();
+	}
+
+	void DX11VertexBuffer::AddInputElements(TArray<D3D11_INPUT_ELEMENT_DESC>& outIEDArray, const RHIVertexLayout& layout, uint32 inputSlot)
+	{
+		bool bPerInstance = layout.GetInputRate() == EVertexInputRate::Instance;
+
+		const TArray<VertexAttribute>& attributes = layout.GetAttributes();
+		for (size_t i = 0; i < attributes.size(); ++i)
+		{
+			const VertexAttribute& attribute = attributes[i];
+
+			uint32 semanticIndex = 0;
+			for (size_t j = 0; j < i; ++j)
+			{
+				if (attributes[j].Semantic == attribute.Semantic)
+					++semanticIndex;
+			}
+
 			D3D11_INPUT_ELEMENT_DESC ied { };
 			ied.SemanticName = GetSemanticName(attribute.Semantic);
-			ied.SemanticIndex = 0;
+			ied.SemanticIndex = semanticIndex;
 			ied.Format = DXCommon::VertexAttributeToDXGIFormat({ attribute.Type, attribute.ElementCount });
-			ied.InputSlot = 0;
+			ied.InputSlot = inputSlot;
 			ied.AlignedByteOffset = D3D11_APPEND_ALIGNED_ELEMENT;
-			ied.InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
-			ied.InstanceDataStepRate = 0;
+			ied.InputSlotClass = bPerInstance ? D3D11_INPUT_PER_INSTANCE_DATA : D3D11_INPUT_PER_VERTEX_DATA;
+			ied.InstanceDataStepRate = bPerInstance ? 1 : 0;
 
-			m_IEDArray.emplace_back(ied);
+			outIEDArray.emplace_back(ied);
 		}
 	}
 
-	Result<void, RHIError> DX11VertexBuffer::SetLayoutShader(const TRef<RHIShader>& shader)
-	{
-		return CreateDX11Layout(RefCast<DX11Shader>(shader));
-	}
-
 	Result<void, RHIError> DX11VertexBuffer::CreateDX11Layout(const TRef<DX11Shader>& shader)
 	{
 		TRACE_FUNCTION();
@@ -133,6 +225,31 @@ namespace Ion
 		return Ok();
 	}
 
+	Result<void, RHIError> DX11VertexBuffer::BindInstanceLayout() const
+	{
+		ionassert(m_InstanceInputLayout, "Instance Layout has not been set.");
+
+		ID3D11DeviceContext* context = DX11::GetContext();
+
+		dxcall(context->IASetInputLayout(m_InstanceInputLayout));
+
+		return Ok();
+	}
+
+	Result<void, RHIError> DX11VertexBuffer::BindInstances(const RHIVertexLayout& instanceLayout, uint64 offset) const
+	{
+		ionassert(instanceLayout.GetInputRate() == EVertexInputRate::Instance);
+		ionassert(offset <= std::numeric_limits<UINT>::max());
+
+		ID3D11DeviceContext* context = DX11::GetContext();
+
+		uint32 stride = instanceLayout.GetStride();
+		uint32 offset32 = (uint32)offset;
+		dxcall(context->IASetVertexBuffers(1, 1, &m_Buffer, &stride, &offset32));
+
+		return Ok();
+	}
+
 	Result<void, RHIError> DX11VertexBuffer::CreateBuffer(float* vertexAttributes, uint64 count)
 	{
 		TRACE_FUNCTION();
@@ -164,6 +281,29 @@ namespace Ion
 		return Ok();
 	}
 
+	Result<void, RHIError> DX11VertexBuffer::CreateDynamicBuffer(uint64 size)
+	{
+		TRACE_FUNCTION();
+
+		ionassert(size > 0);
+		ionassert(size <= std::numeric_limits<UINT>::max());
+
+		ID3D11Device* device = DX11::GetDevice();
+
+		D3D11_BUFFER_DESC bd { };
+		bd.ByteWidth = (uint32)size;
+		bd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+		bd.Usage = D3D11_USAGE_DYNAMIC;
+		bd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+
+		dxcall(device->CreateBuffer(&bd, nullptr, &m_Buffer),
+			"Could not create dynamic Vertex Buffer.");
+
+		DX11Logger.Debug("DX11VertexBuffer dynamic Buffer object has been created.");
+
+		return Ok();
+	}
+
 	// -------------------------------------------------------------------
 	// DX11IndexBuffer ---------------------------------------------------
 	// -------------------------------------------------------------------
@@ -387,6 +527,14 @@ namespace Ion
 		return &it->second;
 	}
 
+	void DX11UniformBufferDynamic::SetData(const void* data, size_t size)
+	{
+		ionassert(data);
+		ionassert(size <= m_Common.DataSize);
+
+		memcpy(m_Common.Data, data, size);
+	}
+
 	Result<void, RHIError> DX11UniformBufferDynamic::UpdateData() const
 	{
 		return m_Common.UpdateData();
@@ -417,6 +565,149 @@ namespace Ion
 
 		return (uint8*)m_Common.Data + it->second.Offset;
 	}
+
+	// Uniform Ring Buffer -----------------------------------------------------------
+
+	DX11UniformRingBuffer::DX11UniformRingBuffer(uint32 frameCapacity, uint32 framesInFlight) :
+		RHIUniformRingBuffer(frameCapacity, framesInFlight),
+		m_Buffer(nullptr),
+		m_FrameQueries(framesInFlight, nullptr),
+		m_FrameQueryIssued(framesInFlight, false),
+		m_bMapped(false)
+	{
+		ionassert(DX11::GetDevice(), "The device has not been created.");
+
+		CreateBuffer()
+			.Err([](Error& error) { DX11Logger.Critical("Cannot create a Uniform Ring Buffer.\n{}", error.Message); })
+			.Unwrap();
+
+		DX11Logger.Info("DX11UniformRingBuffer has been created.");
+	}
+
+	DX11UniformRingBuffer::~DX11UniformRingBuffer()
+	{
+		TRACE_FUNCTION();
+
+		for (ID3D11Query* query : m_FrameQueries)
+		{
+			COMRelease(query);
+		}
+		COMRelease(m_Buffer);
+
+		_aligned_free(m_Data);
+
+		DX11Logger.Info("DX11UniformRingBuffer has been destroyed.");
+	}
+
+	Result<void, RHIError> DX11UniformRingBuffer::BeginFrame()
+	{
+		TRACE_FUNCTION();
+
+		AdvanceFrame();
+
+		// Wait until the GPU has finished the last frame that used this part of the ring.
+		if (m_FrameQueryIssued[m_FrameIndex])
+		{
+			ID3D11DeviceContext* context = DX11::GetContext();
+			ID3D11Query* query = m_FrameQueries[m_FrameIndex];
+
+			HRESULT hResult;
+			while ((hResult = context->GetData(query, nullptr, 0, 0)) == S_FALSE)
+			{
+				std::this_thread::yield();
+			}
+			dxcall(hResult, "Cannot wait for the Uniform Ring Buffer frame query.");
+
+			m_FrameQueryIssued[m_FrameIndex] = false;
+		}
+
+		return Ok();
+	}
+
+	Result<void, RHIError> DX11UniformRingBuffer::EndFrame()
+	{
+		ID3D11DeviceContext* context = DX11::GetContext();
+
+		dxcall(context->End(m_FrameQueries[m_FrameIndex]));
+		m_FrameQueryIssued[m_FrameIndex] = true;
+
+		return Ok();
+	}
+
+	Result<void, RHIError> DX11UniformRingBuffer::Flush()
+	{
+		TRACE_FUNCTION();
+
+		uint32 offset, size;
+		GetUnflushedRange(offset, size);
+		if (!size)
+			return Ok();
+
+		ID3D11DeviceContext* context = DX11::GetContext();
+
+		// The parts of the ring in use by the GPU are never written,
+		// so the buffer doesn't have to be renamed by the driver.
+		D3D11_MAP mapType = m_bMapped ? D3D11_MAP_WRITE_NO_OVERWRITE : D3D11_MAP_WRITE_DISCARD;
+
+		D3D11_MAPPED_SUBRESOURCE msd { };
+		dxcall(context->Map(m_Buffer, 0, mapType, 0, &msd));
+		memcpy((uint8*)msd.pData + offset, m_Data + offset, size);
+		dxcall(context->Unmap(m_Buffer, 0));
+
+		m_bMapped = true;
+		OnFlushed();
+
+		return Ok();
+	}
+
+	Result<void, RHIError> DX11UniformRingBuffer::Bind(const RHIUniformRingAllocation& allocation, uint32 slot) const
+	{
+		ionassert(allocation.Size);
+		ionassert(allocation.Offset % Alignment == 0);
+
+		ID3D11DeviceContext1* context = (ID3D11DeviceContext1*)DX11::GetContext();
+
+		// In shader constants (16 bytes), the count has to be a multiple of 16.
+		uint32 firstConstant = allocation.Offset / 16;
+		uint32 constantCount = (uint32)AlignAs(allocation.Size, Alignment) / 16;
+
+		dxcall(context->VSSetConstantBuffers1(slot, 1, &m_Buffer, &firstConstant, &constantCount));
+		dxcall(context->PSSetConstantBuffers1(slot, 1, &m_Buffer, &firstConstant, &constantCount));
+
+		return Ok();
+	}
+
+	Result<void, RHIError> DX11UniformRingBuffer::CreateBuffer()
+	{
+		TRACE_FUNCTION();
+
+		ID3D11Device* device = DX11::GetDevice();
+
+		uint32 size = m_FrameCapacity * m_FramesInFlight;
+
+		// Staging copy, the allocations are written to it and copied to the buffer in Flush.
+		m_Data = (uint8*)_aligned_malloc(size, Alignment);
+
+		D3D11_BUFFER_DESC bd { };
+		bd.ByteWidth = size;
+		bd.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+		bd.Usage = D3D11_USAGE_DYNAMIC;
+		bd.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+
+		dxcall(device->CreateBuffer(&bd, nullptr, &m_Buffer),
+			"Could not create Uniform Ring Buffer.");
+
+		D3D11_QUERY_DESC qd { };
+		qd.Query = D3D11_QUERY_EVENT;
+
+		for (ID3D11Query*& query : m_FrameQueries)
+		{
+			dxcall(device->CreateQuery(&qd, &query),
+				"Could not create Uniform Ring Buffer frame query.");
+		}
+
+		return Ok();
+	}
 }
 
 #endif // RHI_BUILD_DX11
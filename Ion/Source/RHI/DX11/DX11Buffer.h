@@ -11,42 +11,60 @@ namespace Ion
 	{
 	public:
 		DX11VertexBuffer(float* vertexAttributes, uint64 count);
+		/* Dynamic buffer */
+		DX11VertexBuffer(uint64 size);
 		virtual ~DX11VertexBuffer() override;
 
 		virtual void SetLayout(const TRef<RHIVertexLayout>& layout) override;
 		virtual Result<void, RHIError> SetLayoutShader(const TRef<RHIShader>& shader) override;
 
+		virtual Result<void, RHIError> SetInstanceLayoutShader(const TRef<RHIVertexLayout>& instanceLayout, const TRef<RHIShader>& shader) override;
+		virtual bool HasInstanceLayout() const override;
+
+		virtual Result<void, RHIError> UpdateData(const void* data, uint64 size) override;
+
 		virtual uint32 GetVertexCount() const override;
 
 		static constexpr const char* GetSemanticName(const EVertexAttributeSemantic semantic)
 		{
 			switch (semantic)
 			{
-			case EVertexAttributeSemantic::Position:  return "POSITION";
-			case EVertexAttributeSemantic::Normal:    return "NORMAL";
-			case EVertexAttributeSemantic::TexCoord:  return "TEXCOORD";
-			default:                                  return "";
+			case EVertexAttributeSemantic::Position:                  return "POSITION";
+			case EVertexAttributeSemantic::Normal:                    return "NORMAL";
+			case EVertexAttributeSemantic::TexCoord:                  return "TEXCOORD";
+			case EVertexAttributeSemantic::InstanceTransform:         return "INSTANCE_TRANSFORM";
+			case EVertexAttributeSemantic::InstanceInverseTranspose:  return "INSTANCE_INVTRANSPOSE";
+			default:                                                  return "";
 			}
 		}
 
 	protected:
 		virtual Result<void, RHIError> Bind() const override;
 		virtual Result<void, RHIError> BindLayout() const override;
+		virtual Result<void, RHIError> BindInstanceLayout() const override;
+		virtual Result<void, RHIError> BindInstances(const RHIVertexLayout& instanceLayout, uint64 offset) const override;
 		virtual Result<void, RHIError> Unbind() const override;
 
 	private:
 		Result<void, RHIError> CreateBuffer(float* vertexAttributes, uint64 count);
+		Result<void, RHIError> CreateDynamicBuffer(uint64 size);
 
 		Result<void, RHIError> CreateDX11Layout(const TRef<class DX11Shader>& shader);
 
+		/* Attributes that share a semantic (e.g. the matrix columns) get consecutive semantic indices. */
+		static void AddInputElements(TArray<D3D11_INPUT_ELEMENT_DESC>& outIEDArray, const RHIVertexLayout& layout, uint32 inputSlot);
+
 	private:
 		uint32 m_ID;
 		uint32 m_VertexCount;
+		uint64 m_DynamicSize;
 		TRef<RHIVertexLayout> m_VertexLayout;
+		TRef<RHIVertexLayout> m_InstanceLayout;
 		TArray<D3D11_INPUT_ELEMENT_DESC> m_IEDArray;
 
 		ID3D11Buffer* m_Buffer;
 		ID3D11InputLayout* m_InputLayout;
+		ID3D11InputLayout* m_InstanceInputLayout;
 
 		friend class DX11Renderer;
 	};
@@ -125,6 +143,8 @@ namespace Ion
 
 		virtual const UniformData* GetUniformData(const String& name) const override;
 
+		virtual void SetData(const void* data, size_t size) override;
+
 		virtual ~DX11UniformBufferDynamic() override;
 
 	protected:
@@ -139,4 +159,29 @@ namespace Ion
 		friend class RHIUniformBufferDynamic;
 		FRIEND_MAKE_REF;
 	};
+
+	class ION_API DX11UniformRingBuffer : public RHIUniformRingBuffer
+	{
+	public:
+		DX11UniformRingBuffer(uint32 frameCapacity, uint32 framesInFlight);
+		virtual ~DX11UniformRingBuffer() override;
+
+		virtual Result<void, RHIError> BeginFrame() override;
+		virtual Result<void, RHIError> EndFrame() override;
+
+		virtual Result<void, RHIError> Flush() override;
+
+		virtual Result<void, RHIError> Bind(const RHIUniformRingAllocation& allocation, uint32 slot) const override;
+
+	private:
+		Result<void, RHIError> CreateBuffer();
+
+	private:
+		ID3D11Buffer* m_Buffer;
+		/* Event query per frame part, signaled when the GPU has finished the frame */
+		TArray<ID3D11Query*> m_FrameQueries;
+		TArray<bool> m_FrameQueryIssued;
+		/* The first map has to discard the buffer */
+		bool m_bMapped;
+	};
 }
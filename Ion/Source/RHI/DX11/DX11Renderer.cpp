@@ -70,6 +70,15 @@ namespace Ion
 		return Ok();
 	}
 
+	Result<void, RHIError> DX11Renderer::DrawIndexedInstanced(uint32 indexCount, uint32 instanceCount) const
+	{
+		ID3D11DeviceContext* context = DX11::GetContext();
+
+		dxcall(context->DrawIndexedInstanced(indexCount, instanceCount, 0, 0, 0));
+
+		return Ok();
+	}
+
 	Result<void, RHIError> DX11Renderer::UnbindResources() const
 	{
 		ID3D11DeviceContext* context = DX11::GetContext();
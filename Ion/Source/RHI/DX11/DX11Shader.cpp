@@ -65,8 +65,6 @@ namespace Ion
 				continue;
 			}
 
-			ID3D11Device* device = DX11::GetDevice();
-
 			uint32 compileFlags =
 #if SHADER_DEBUG_ENABLED
 				D3DCOMPILE_SKIP_OPTIMIZATION |
@@ -117,33 +115,116 @@ namespace Ion
 				errorMessagesBlob->Release();
 			}
 
-			void* blobPtr = shader.ShaderBlob->GetBufferPointer();
-			size_t blobSize = shader.ShaderBlob->GetBufferSize();
+			fwdthrowall(CreateShaderObject(shader));
+		}
 
-			if (shader.Type == EShaderType::Vertex)
-			{
-				dxcall(device->CreateVertexShader(blobPtr, blobSize, nullptr, (ID3D11VertexShader**)&shader.ShaderPtr),
-					"Could not create Vertex Shader");
+		m_bCompiled = true;
 
-				DX11Logger.Debug("DX11Shader Vertex Shader object has been created.");
-			}
-			else if (shader.Type == EShaderType::Pixel)
-			{
-				dxcall(device->CreatePixelShader(blobPtr, blobSize, nullptr, (ID3D11PixelShader**)&shader.ShaderPtr),
-					"Could not create Pixel Shader");
+		return Ok();
+	}
 
-				DX11Logger.Debug("DX11Shader Pixel Shader object has been created.");
-			}
-			else
+	Result<void, RHIError> DX11Shader::GetBinary(TArray<uint8>& outBinary) const
+	{
+		TRACE_FUNCTION();
+
+		ionassert(m_bCompiled, "Cannot get a binary of a shader that has not been compiled.");
+
+		outBinary.clear();
+
+		// [type (uint8), size (uint32), bytecode] per shader
+		for (const auto& [type, shader] : m_Shaders)
+		{
+			if (!shader.ShaderBlob)
+				continue;
+
+			uint8 shaderType = (uint8)shader.Type;
+			uint32 size = (uint32)shader.ShaderBlob->GetBufferSize();
+
+			size_t offset = outBinary.size();
+			outBinary.resize(offset + sizeof(shaderType) + sizeof(size) + size);
+
+			uint8* data = outBinary.data() + offset;
+			memcpy(data, &shaderType, sizeof(shaderType));
+			memcpy(data + sizeof(shaderType), &size, sizeof(size));
+			memcpy(data + sizeof(shaderType) + sizeof(size), shader.ShaderBlob->GetBufferPointer(), size);
+		}
+
+		return Ok();
+	}
+
+	Result<void, RHIError> DX11Shader::LoadBinary(const TArray<uint8>& binary)
+	{
+		TRACE_FUNCTION();
+
+		ionassert(!m_bCompiled, "Shader has already been compiled.");
+
+		size_t offset = 0;
+		while (offset < binary.size())
+		{
+			uint8 shaderType;
+			uint32 size;
+
+			ionthrowif(offset + sizeof(shaderType) + sizeof(size) > binary.size(), RHIError, "The shader binary is corrupted.");
+
+			memcpy(&shaderType, binary.data() + offset, sizeof(shaderType));
+			memcpy(&size, binary.data() + offset + sizeof(shaderType), sizeof(size));
+			offset += sizeof(shaderType) + sizeof(size);
+
+			ionthrowif(offset + size > binary.size(), RHIError, "The shader binary is corrupted.");
+
+			EShaderType type = (EShaderType)shaderType;
+			auto it = m_Shaders.find(type);
+			if (it == m_Shaders.end())
 			{
-				ionbreak("Unknown shader type.");
-				shader.ShaderBlob->Release();
-				shader.ShaderBlob = nullptr;
+				it = m_Shaders.emplace(type, DXShader(DXShaderSource(EmptyString, FilePath()), type)).first;
 			}
+			DXShader& shader = it->second;
+
+			dxcall(D3DCreateBlob(size, &shader.ShaderBlob),
+				"Could not create a shader blob.");
+			memcpy(shader.ShaderBlob->GetBufferPointer(), binary.data() + offset, size);
+			offset += size;
+
+			fwdthrowall(CreateShaderObject(shader));
 		}
 
 		m_bCompiled = true;
 
+		DX11Logger.Trace("DX11Shader has been loaded from a binary.");
+
+		return Ok();
+	}
+
+	Result<void, RHIError> DX11Shader::CreateShaderObject(DXShader& shader)
+	{
+		ionassert(shader.ShaderBlob);
+
+		ID3D11Device* device = DX11::GetDevice();
+
+		void* blobPtr = shader.ShaderBlob->GetBufferPointer();
+		size_t blobSize = shader.ShaderBlob->GetBufferSize();
+
+		if (shader.Type == EShaderType::Vertex)
+		{
+			dxcall(device->CreateVertexShader(blobPtr, blobSize, nullptr, (ID3D11VertexShader**)&shader.ShaderPtr),
+				"Could not create Vertex Shader");
+
+			DX11Logger.Debug("DX11Shader Vertex Shader object has been created.");
+		}
+		else if (shader.Type == EShaderType::Pixel)
+		{
+			dxcall(device->CreatePixelShader(blobPtr, blobSize, nullptr, (ID3D11PixelShader**)&shader.ShaderPtr),
+				"Could not create Pixel Shader");
+
+			DX11Logger.Debug("DX11Shader Pixel Shader object has been created.");
+		}
+		else
+		{
+			ionbreak("Unknown shader type.");
+			shader.ShaderBlob->Release();
+			shader.ShaderBlob = nullptr;
+		}
+
 		return Ok();
 	}
 
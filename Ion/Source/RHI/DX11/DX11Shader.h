@@ -17,6 +17,10 @@ namespace Ion
 		virtual Result<void, RHIError, ShaderCompilationError> Compile() override;
 		virtual bool IsCompiled() override;
 
+		virtual bool SupportsBinary() const override { return true; }
+		virtual Result<void, RHIError> GetBinary(TArray<uint8>& outBinary) const override;
+		virtual Result<void, RHIError> LoadBinary(const TArray<uint8>& binary) override;
+
 		virtual void Bind() const override;
 		virtual void Unbind() const override;
 
@@ -27,6 +31,9 @@ namespace Ion
 		void IterateShaders(T callback) const;
 		ID3DBlob* GetVertexShaderByteCode() const;
 
+	private:
+		Result<void, RHIError> CreateShaderObject(DXShader& shader);
+
 	private:
 		THashMap<EShaderType, DXShader> m_Shaders;
 		bool m_bCompiled;
@@ -54,6 +54,22 @@ namespace Ion
 		return Ok();
 	}
 
+	Result<void, RHIError> DX11Texture::UpdateSubresource(uint32 mipLevel, const void* pixelData, uint32 lineSize)
+	{
+		TRACE_FUNCTION();
+
+		ionassert(pixelData);
+		ionassert(mipLevel < m_Description.GetMipLevelCount(), "The texture does not have mip level {}.", mipLevel);
+		ionassert(m_Description.Usage == ETextureUsage::Default, "Only the default usage textures can be updated.");
+
+		ID3D11DeviceContext* context = DX11::GetContext();
+
+		// Single array slice, the subresource index is the mip level.
+		dxcall(context->UpdateSubresource(m_Texture, mipLevel, nullptr, pixelData, lineSize, 0));
+
+		return Ok();
+	}
+
 	Result<void, RHIError> DX11Texture::Bind(uint32 slot) const
 	{
 		ionassert(m_SRV);
@@ -183,7 +199,7 @@ namespace Ion
 
 		DXGI_FORMAT resourceFormat = DXCommon::TextureFormatToDXGIFormat(desc.Format, EDXTextureFormatUsage::Resource);
 
-		int32 mipLevels = desc.bGenerateMips ? 0 : 1;
+		int32 mipLevels = desc.MipLevels ? desc.MipLevels : (desc.bGenerateMips ? 0 : 1);
 		int32 sampleCount = (bool)desc.MultiSampling ? (int32)desc.MultiSampling : 1;
 
 		uint32 availQuality;
@@ -178,6 +178,10 @@ namespace Ion
 			break;
 		}
 		case ETextureFormat::UInt128GUID: return DXGI_FORMAT_R32G32B32A32_UINT;
+		case ETextureFormat::BC1:         return DXGI_FORMAT_BC1_UNORM;
+		case ETextureFormat::BC3:         return DXGI_FORMAT_BC3_UNORM;
+		case ETextureFormat::BC5:         return DXGI_FORMAT_BC5_UNORM;
+		case ETextureFormat::BC7:         return DXGI_FORMAT_BC7_UNORM;
 		}
 		ionbreak("Invalid format.");
 		return DXGI_FORMAT_UNKNOWN;
@@ -200,10 +204,12 @@ namespace Ion
 	{
 		switch (semantic)
 		{
-		case EVertexAttributeSemantic::Position:  return "POSITION";
-		case EVertexAttributeSemantic::Normal:    return "NORMAL";
-		case EVertexAttributeSemantic::TexCoord:  return "TEXCOORD";
-		default:                                  return "";
+		case EVertexAttributeSemantic::Position:                  return "POSITION";
+		case EVertexAttributeSemantic::Normal:                    return "NORMAL";
+		case EVertexAttributeSemantic::TexCoord:                  return "TEXCOORD";
+		case EVertexAttributeSemantic::InstanceTransform:         return "INSTANCE_TRANSFORM";
+		case EVertexAttributeSemantic::InstanceInverseTranspose:  return "INSTANCE_INVTRANSPOSE";
+		default:                                                  return "";
 		}
 	}
 
@@ -17,17 +17,18 @@ namespace Ion
 
 	HRESULT DXInclude::Open(D3D_INCLUDE_TYPE IncludeType, LPCSTR pFileName, LPCVOID pParentData, LPCVOID* ppData, UINT* pBytes)
 	{
-		// @TODO: Finish the local includes
-
 		FilePath fullIncludePath;
 
 		switch (IncludeType)
 		{
 			case D3D_INCLUDE_LOCAL:
 			{
-				if (!m_SourceDir.IsEmpty())
+				// Relative to the file that includes this one (null parent means the main source)
+				auto it = m_IncludeDirs.find(pParentData);
+				const FilePath& parentDir = it != m_IncludeDirs.end() ? it->second : m_SourceDir;
+				if (!parentDir.IsEmpty())
 				{
-					FilePath includeRelativeToSource = m_SourceDir / pFileName;
+					FilePath includeRelativeToSource = parentDir / pFileName;
 					if (includeRelativeToSource.IsFile())
 					{
 						fullIncludePath = includeRelativeToSource;
@@ -64,6 +65,8 @@ namespace Ion
 		*ppData = buffer;
 		*pBytes = (uint32)size;
 
+		m_IncludeDirs.emplace(buffer, fullIncludePath / "..");
+
 		return S_OK;
 	}
 
@@ -71,6 +74,7 @@ namespace Ion
 	{
 		if (pData)
 		{
+			m_IncludeDirs.erase(pData);
 			free((void*)pData);
 		}
 
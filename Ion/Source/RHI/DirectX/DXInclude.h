@@ -24,5 +24,7 @@ namespace Ion
 
 	private:
 		FilePath m_SourceDir;
+		/* Directories of the opened includes, the nested local includes are relative to them. */
+		THashMap<LPCVOID, FilePath> m_IncludeDirs;
 	};
 }
@@ -7,6 +7,8 @@ namespace Ion
 	class ION_API RHIIndexBuffer : public RefCountable
 	{
 	public:
+		ENGINE_ALLOCATED(EMemoryTag::Renderer)
+
 		static TRef<RHIIndexBuffer> Create(uint32* indices, uint32 count);
 
 		virtual ~RHIIndexBuffer();
@@ -0,0 +1,343 @@
+#include "IonPCH.h"
+
+#include "RHI/RHICore.h"
+
+#if RHI_BUILD_NULL
+
+#include "NullBuffer.h"
+
+namespace Ion
+{
+	// -------------------------------------------------------------------------------
+	// Vertex Buffer -----------------------------------------------------------------
+	// -------------------------------------------------------------------------------
+
+	NullVertexBuffer::NullVertexBuffer(float* vertexAttributes, uint64 count) :
+		m_bDynamic(false)
+	{
+		ionverify(vertexAttributes);
+
+		m_Data.resize(count * sizeof(float));
+		memcpy(m_Data.data(), vertexAttributes, m_Data.size());
+
+		NullRHICommandLog::Record(ENullRHICommand::UpdateVertexBuffer, this, 0, 0, m_Data.size());
+
+		NullRHILogger.Debug("NullVertexBuffer has been created.");
+	}
+
+	NullVertexBuffer::NullVertexBuffer(uint64 size) :
+		m_bDynamic(true)
+	{
+		m_Data.resize(size);
+
+		NullRHILogger.Debug("NullVertexBuffer (dynamic) has been created.");
+	}
+
+	NullVertexBuffer::~NullVertexBuffer()
+	{
+		NullRHILogger.Debug("NullVertexBuffer has been destroyed.");
+	}
+
+	void NullVertexBuffer::SetLayout(const TRef<RHIVertexLayout>& layout)
+	{
+		m_VertexLayout = layout;
+	}
+
+	Result<void, RHIError> NullVertexBuffer::SetLayoutShader(const TRef<RHIShader>& shader)
+	{
+		ionassert(m_VertexLayout, "Set the Vertex Layout first.");
+		ionassert(shader);
+
+		return Ok();
+	}
+
+	Result<void, RHIError> NullVertexBuffer::SetInstanceLayoutShader(const TRef<RHIVertexLayout>& instanceLayout, const TRef<RHIShader>& shader)
+	{
+		ionassert(m_VertexLayout, "Set the Vertex Layout first.");
+		ionassert(instanceLayout && instanceLayout->GetInputRate() == EVertexInputRate::Instance);
+		ionassert(shader);
+
+		m_InstanceLayout = instanceLayout;
+
+		return Ok();
+	}
+
+	bool NullVertexBuffer::HasInstanceLayout() const
+	{
+		return m_InstanceLayout != nullptr;
+	}
+
+	Result<void, RHIError> NullVertexBuffer::UpdateData(const void* data, uint64 size)
+	{
+		ionassert(m_bDynamic, "Only a dynamic buffer can be updated.");
+		ionassert(size <= m_Data.size());
+
+		memcpy(m_Data.data(), data, size);
+
+		NullRHICommandLog::Record(ENullRHICommand::UpdateVertexBuffer, this, 0, 0, size);
+
+		return Ok();
+	}
+
+	uint32 NullVertexBuffer::GetVertexCount() const
+	{
+		if (!m_VertexLayout || !m_VertexLayout->GetStride())
+			return 0;
+
+		return (uint32)(m_Data.size() / m_VertexLayout->GetStride());
+	}
+
+	Result<void, RHIError> NullVertexBuffer::Bind() const
+	{
+		ionassert(m_VertexLayout, "Vertex Layout has not been set.");
+
+		NullRHICommandLog::Record(ENullRHICommand::BindVertexBuffer, this, 0, m_VertexLayout->GetStride());
+
+		return Ok();
+	}
+
+	Result<void, RHIError> NullVertexBuffer::BindLayout() const
+	{
+		ionassert(m_VertexLayout, "Vertex Layout has not been set.");
+
+		NullRHICommandLog::Record(ENullRHICommand::BindVertexLayout, this);
+
+		return Ok();
+	}
+
+	Result<void, RHIError> NullVertexBuffer::BindInstanceLayout() const
+	{
+		ionassert(m_InstanceLayout, "Instance Layout has not been set.");
+
+		NullRHICommandLog::Record(ENullRHICommand::BindInstanceLayout, this);
+
+		return Ok();
+	}
+
+	Result<void, RHIError> NullVertexBuffer::BindInstances(const RHIVertexLayout& instanceLayout, uint64 offset) const
+	{
+		ionassert(offset < m_Data.size());
+
+		NullRHICommandLog::Record(ENullRHICommand::BindInstances, this, 1, instanceLayout.GetStride(), offset);
+
+		return Ok();
+	}
+
+	Result<void, RHIError> NullVertexBuffer::Unbind() const
+	{
+		NullRHICommandLog::Record(ENullRHICommand::UnbindVertexBuffer, this);
+
+		return Ok();
+	}
+
+	// -------------------------------------------------------------------------------
+	// Index Buffer ------------------------------------------------------------------
+	// -------------------------------------------------------------------------------
+
+	NullIndexBuffer::NullIndexBuffer(uint32* indices, uint32 count) :
+		m_Indices(indices, indices + count)
+	{
+		NullRHICommandLog::Record(ENullRHICommand::UpdateVertexBuffer, this, 0, 0, count * sizeof(uint32));
+
+		NullRHILogger.Debug("NullIndexBuffer has been created.");
+	}
+
+	NullIndexBuffer::~NullIndexBuffer()
+	{
+		NullRHILogger.Debug("NullIndexBuffer has been destroyed.");
+	}
+
+	uint32 NullIndexBuffer::GetIndexCount() const
+	{
+		return (uint32)m_Indices.size();
+	}
+
+	uint32 NullIndexBuffer::GetTriangleCount() const
+	{
+		return (uint32)m_Indices.size() / 3;
+	}
+
+	Result<void, RHIError> NullIndexBuffer::Bind() const
+	{
+		NullRHICommandLog::Record(ENullRHICommand::BindIndexBuffer, this, (uint32)m_Indices.size());
+
+		return Ok();
+	}
+
+	Result<void, RHIError> NullIndexBuffer::Unbind() const
+	{
+		NullRHICommandLog::Record(ENullRHICommand::UnbindIndexBuffer, this);
+
+		return Ok();
+	}
+
+	// -------------------------------------------------------------------------------
+	// Uniform Buffer ----------------------------------------------------------------
+	// -------------------------------------------------------------------------------
+
+	_NullUniformBufferCommon::_NullUniformBufferCommon(void* initialData, size_t size) :
+		Data(AlignAs(size, 16) / sizeof(Vector4)),
+		DataSize(size)
+	{
+		ionverify(initialData);
+
+		memcpy(Data.data(), initialData, size);
+	}
+
+	Result<void, RHIError> _NullUniformBufferCommon::Bind(uint32 slot) const
+	{
+		NullRHICommandLog::Record(ENullRHICommand::BindUniformBuffer, this, slot);
+
+		return Ok();
+	}
+
+	Result<void, RHIError> _NullUniformBufferCommon::UpdateData() const
+	{
+		NullRHICommandLog::Record(ENullRHICommand::UpdateUniformBuffer, this, 0, 0, DataSize);
+
+		return Ok();
+	}
+
+	NullUniformBuffer::NullUniformBuffer(void* initialData, size_t size) :
+		m_Common(initialData, size)
+	{
+		NullRHILogger.Debug("NullUniformBuffer has been created.");
+	}
+
+	NullUniformBuffer::~NullUniformBuffer()
+	{
+		NullRHILogger.Debug("NullUniformBuffer has been destroyed.");
+	}
+
+	Result<void, RHIError> NullUniformBuffer::Bind(uint32 slot) const
+	{
+		return m_Common.Bind(slot);
+	}
+
+	void* NullUniformBuffer::GetDataPtr() const
+	{
+		return (void*)m_Common.Data.data();
+	}
+
+	Result<void, RHIError> NullUniformBuffer::UpdateData() const
+	{
+		return m_Common.UpdateData();
+	}
+
+	NullUniformBufferDynamic::NullUniformBufferDynamic(void* initialData, size_t size, const UniformDataMap& uniforms) :
+		RHIUniformBufferDynamic(uniforms),
+		m_Common(initialData, size)
+	{
+		NullRHILogger.Debug("NullUniformBufferDynamic has been created.");
+	}
+
+	NullUniformBufferDynamic::~NullUniformBufferDynamic()
+	{
+		NullRHILogger.Debug("NullUniformBufferDynamic has been destroyed.");
+	}
+
+	Result<void, RHIError> NullUniformBufferDynamic::Bind(uint32 slot) const
+	{
+		return m_Common.Bind(slot);
+	}
+
+	const UniformData* NullUniformBufferDynamic::GetUniformData(const String& name) const
+	{
+		auto it = GetUniformDataMap().find(name);
+		if (it == GetUniformDataMap().end())
+			return nullptr;
+		return &it->second;
+	}
+
+	void NullUniformBufferDynamic::SetData(const void* data, size_t size)
+	{
+		ionassert(data);
+		ionassert(size <= m_Common.DataSize);
+
+		memcpy(m_Common.Data.data(), data, size);
+	}
+
+	Result<void, RHIError> NullUniformBufferDynamic::UpdateData() const
+	{
+		return m_Common.UpdateData();
+	}
+
+	bool NullUniformBufferDynamic::SetUniformValue_Internal(const String& name, const void* value)
+	{
+		void* fieldAddress = GetUniformAddress(name);
+		if (!fieldAddress)
+			return false;
+
+		size_t fieldSize = GetUniformTypeSize(GetUniformData(name)->Type);
+		ionassert(fieldSize);
+
+		memcpy(fieldAddress, value, fieldSize);
+
+		return true;
+	}
+
+	void* NullUniformBufferDynamic::GetUniformAddress(const String& name) const
+	{
+		auto it = GetUniformDataMap().find(name);
+		if (it == GetUniformDataMap().end())
+			return nullptr;
+
+		return (uint8*)m_Common.Data.data() + it->second.Offset;
+	}
+
+	// -------------------------------------------------------------------------------
+	// Uniform Ring Buffer -----------------------------------------------------------
+	// -------------------------------------------------------------------------------
+
+	NullUniformRingBuffer::NullUniformRingBuffer(uint32 frameCapacity, uint32 framesInFlight) :
+		RHIUniformRingBuffer(frameCapacity, framesInFlight)
+	{
+		m_Memory.resize((size_t)m_FrameCapacity * m_FramesInFlight / sizeof(Vector4));
+		m_Data = (uint8*)m_Memory.data();
+
+		NullRHILogger.Debug("NullUniformRingBuffer has been created.");
+	}
+
+	NullUniformRingBuffer::~NullUniformRingBuffer()
+	{
+		NullRHILogger.Debug("NullUniformRingBuffer has been destroyed.");
+	}
+
+	Result<void, RHIError> NullUniformRingBuffer::BeginFrame()
+	{
+		AdvanceFrame();
+
+		return Ok();
+	}
+
+	Result<void, RHIError> NullUniformRingBuffer::EndFrame()
+	{
+		return Ok();
+	}
+
+	Result<void, RHIError> NullUniformRingBuffer::Flush()
+	{
+		uint32 offset, size;
+		GetUnflushedRange(offset, size);
+		if (size)
+		{
+			NullRHICommandLog::Record(ENullRHICommand::UpdateUniformBuffer, this, offset, 0, size);
+		}
+
+		OnFlushed();
+
+		return Ok();
+	}
+
+	Result<void, RHIError> NullUniformRingBuffer::Bind(const RHIUniformRingAllocation& allocation, uint32 slot) const
+	{
+		ionassert(allocation.Size);
+
+		NullRHICommandLog::Record(ENullRHICommand::BindUniformBuffer, this, slot, allocation.Offset);
+
+		return Ok();
+	}
+}
+
+
+#endif // RHI_BUILD_NULL
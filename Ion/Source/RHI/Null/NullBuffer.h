@@ -0,0 +1,136 @@
+#pragma once
+
+#include "RHI/VertexBuffer.h"
+#include "RHI/IndexBuffer.h"
+#include "RHI/UniformBuffer.h"
+#include "NullRHI.h"
+
+namespace Ion
+{
+	class ION_API NullVertexBuffer : public RHIVertexBuffer
+	{
+	public:
+		NullVertexBuffer(float* vertexAttributes, uint64 count);
+		/* Dynamic buffer */
+		NullVertexBuffer(uint64 size);
+		virtual ~NullVertexBuffer() override;
+
+		virtual void SetLayout(const TRef<RHIVertexLayout>& layout) override;
+		virtual Result<void, RHIError> SetLayoutShader(const TRef<RHIShader>& shader) override;
+
+		virtual Result<void, RHIError> SetInstanceLayoutShader(const TRef<RHIVertexLayout>& instanceLayout, const TRef<RHIShader>& shader) override;
+		virtual bool HasInstanceLayout() const override;
+
+		virtual Result<void, RHIError> UpdateData(const void* data, uint64 size) override;
+
+		virtual uint32 GetVertexCount() const override;
+
+	protected:
+		virtual Result<void, RHIError> Bind() const override;
+		virtual Result<void, RHIError> BindLayout() const override;
+		virtual Result<void, RHIError> BindInstanceLayout() const override;
+		virtual Result<void, RHIError> BindInstances(const RHIVertexLayout& instanceLayout, uint64 offset) const override;
+		virtual Result<void, RHIError> Unbind() const override;
+
+	private:
+		TArray<uint8> m_Data;
+		bool m_bDynamic;
+		TRef<RHIVertexLayout> m_VertexLayout;
+		TRef<RHIVertexLayout> m_InstanceLayout;
+	};
+
+	class ION_API NullIndexBuffer : public RHIIndexBuffer
+	{
+	public:
+		NullIndexBuffer(uint32* indices, uint32 count);
+		virtual ~NullIndexBuffer() override;
+
+		virtual uint32 GetIndexCount() const override;
+		virtual uint32 GetTriangleCount() const override;
+
+	protected:
+		virtual Result<void, RHIError> Bind() const override;
+		virtual Result<void, RHIError> Unbind() const override;
+
+	private:
+		TArray<uint32> m_Indices;
+	};
+
+	class _NullUniformBufferCommon
+	{
+		_NullUniformBufferCommon(void* initialData, size_t size);
+
+		Result<void, RHIError> Bind(uint32 slot) const;
+		Result<void, RHIError> UpdateData() const;
+
+		/* Stored as 16 byte blocks, so the data is aligned like in the other RHIs. */
+		TArray<Vector4> Data;
+		size_t DataSize;
+
+		friend class NullUniformBuffer;
+		friend class NullUniformBufferDynamic;
+	};
+
+	class ION_API NullUniformBuffer : public RHIUniformBuffer
+	{
+	public:
+		virtual Result<void, RHIError> Bind(uint32 slot = 0) const override;
+
+		virtual ~NullUniformBuffer() override;
+
+	protected:
+		NullUniformBuffer(void* initialData, size_t size);
+
+		virtual void* GetDataPtr() const override;
+		virtual Result<void, RHIError> UpdateData() const override;
+
+	private:
+		_NullUniformBufferCommon m_Common;
+
+		friend class RHIUniformBuffer;
+		FRIEND_MAKE_REF;
+	};
+
+	class ION_API NullUniformBufferDynamic : public RHIUniformBufferDynamic
+	{
+	public:
+		NullUniformBufferDynamic(void* initialData, size_t size, const UniformDataMap& uniforms);
+
+		virtual Result<void, RHIError> Bind(uint32 slot = 0) const override;
+
+		virtual const UniformData* GetUniformData(const String& name) const override;
+
+		virtual void SetData(const void* data, size_t size) override;
+
+		virtual ~NullUniformBufferDynamic() override;
+
+	protected:
+		virtual Result<void, RHIError> UpdateData() const override;
+
+		virtual bool SetUniformValue_Internal(const String& name, const void* value) override;
+		virtual void* GetUniformAddress(const String& name) const override;
+
+	private:
+		_NullUniformBufferCommon m_Common;
+
+		friend class RHIUniformBufferDynamic;
+		FRIEND_MAKE_REF;
+	};
+
+	class ION_API NullUniformRingBuffer : public RHIUniformRingBuffer
+	{
+	public:
+		NullUniformRingBuffer(uint32 frameCapacity, uint32 framesInFlight);
+		virtual ~NullUniformRingBuffer() override;
+
+		virtual Result<void, RHIError> BeginFrame() override;
+		virtual Result<void, RHIError> EndFrame() override;
+
+		virtual Result<void, RHIError> Flush() override;
+
+		virtual Result<void, RHIError> Bind(const RHIUniformRingAllocation& allocation, uint32 slot) const override;
+
+	private:
+		TArray<Vector4> m_Memory;
+	};
+}
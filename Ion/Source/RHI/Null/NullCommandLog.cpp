@@ -0,0 +1,102 @@
+#include "IonPCH.h"
+
+#include "RHI/RHICore.h"
+
+#if RHI_BUILD_NULL
+
+#include "NullCommandLog.h"
+#include "NullRHI.h"
+
+namespace Ion
+{
+	void NullRHICommandLog::Record(ENullRHICommand type, const void* object, uint32 arg0, uint32 arg1, uint64 bytes)
+	{
+		ionassert(type < ENullRHICommand::_Count);
+
+		ScopedLock lock(s_Mutex);
+
+		NullRHICommandStats& stats = s_Stats[(size_t)type];
+		++stats.Count;
+		stats.Bytes += bytes;
+
+		if (s_bStoreCommands)
+		{
+			s_Commands.push_back(NullRHICommand { type, object, arg0, arg1, bytes });
+		}
+	}
+
+	void NullRHICommandLog::Reset()
+	{
+		ScopedLock lock(s_Mutex);
+
+		s_Commands.clear();
+		for (NullRHICommandStats& stats : s_Stats)
+		{
+			stats = NullRHICommandStats();
+		}
+	}
+
+	TArray<NullRHICommand> NullRHICommandLog::GetCommands()
+	{
+		ScopedLock lock(s_Mutex);
+
+		return s_Commands;
+	}
+
+	NullRHICommandStats NullRHICommandLog::GetStats(ENullRHICommand type)
+	{
+		ionassert(type < ENullRHICommand::_Count);
+
+		ScopedLock lock(s_Mutex);
+
+		return s_Stats[(size_t)type];
+	}
+
+	NullRHICommandStats NullRHICommandLog::GetTotalStats()
+	{
+		ScopedLock lock(s_Mutex);
+
+		NullRHICommandStats total;
+		for (const NullRHICommandStats& stats : s_Stats)
+		{
+			total.Count += stats.Count;
+			total.Bytes += stats.Bytes;
+		}
+		return total;
+	}
+
+	void NullRHICommandLog::SetCommandStorageEnabled(bool bEnabled)
+	{
+		ScopedLock lock(s_Mutex);
+
+		s_bStoreCommands = bEnabled;
+	}
+
+	bool NullRHICommandLog::IsCommandStorageEnabled()
+	{
+		ScopedLock lock(s_Mutex);
+
+		return s_bStoreCommands;
+	}
+
+	void NullRHICommandLog::PrintStats()
+	{
+		ScopedLock lock(s_Mutex);
+
+		for (size_t i = 0; i < (size_t)ENullRHICommand::_Count; ++i)
+		{
+			const NullRHICommandStats& stats = s_Stats[i];
+			if (stats.Count)
+			{
+				NullRHILogger.Info("{:<24} {:>10} calls {:>14} bytes", CommandToString((ENullRHICommand)i), stats.Count, stats.Bytes);
+			}
+		}
+	}
+
+	Mutex NullRHICommandLog::s_Mutex;
+	TArray<NullRHICommand> NullRHICommandLog::s_Commands;
+	NullRHICommandStats NullRHICommandLog::s_Stats[(size_t)ENullRHICommand::_Count];
+	bool NullRHICommandLog::s_bStoreCommands = true;
+}
+
+#endif // RHI_BUILD_NULL
@@ -0,0 +1,141 @@
+#pragma once
+
+#include "RHI/RHICore.h"
+
+namespace Ion
+{
+	enum class ENullRHICommand : uint8
+	{
+		BeginFrame,
+		EndFrame,
+		Clear,
+		DrawIndexed,
+		DrawIndexedInstanced,
+		SetRenderTarget,
+		SetDepthStencil,
+		SetViewport,
+		SetBlending,
+		SetPolygonDrawMode,
+		UnbindResources,
+		CompileShader,
+		BindShader,
+		UnbindShader,
+		BindVertexBuffer,
+		BindVertexLayout,
+		BindInstanceLayout,
+		BindInstances,
+		UnbindVertexBuffer,
+		UpdateVertexBuffer,
+		BindIndexBuffer,
+		UnbindIndexBuffer,
+		BindUniformBuffer,
+		UpdateUniformBuffer,
+		BindTexture,
+		UnbindTexture,
+		UpdateTexture,
+		CopyTexture,
+		MapTexture,
+		UnmapTexture,
+		_Count
+	};
+
+	/**
+	 * @brief A command recorded by the Null RHI.
+	 */
+	struct NullRHICommand
+	{
+		ENullRHICommand Type;
+		/* The RHI object the command has been called on (null for the renderer commands) */
+		const void* Object;
+		/* Command specific - the slot, the index count, ... */
+		uint32 Arg0;
+		/* Command specific - the instance count, ... */
+		uint32 Arg1;
+		/* Number of bytes the command would transfer to / from the GPU */
+		uint64 Bytes;
+	};
+
+	struct NullRHICommandStats
+	{
+		uint64 Count = 0;
+		uint64 Bytes = 0;
+	};
+
+	/**
+	 * @brief Log of all the commands submitted to the Null RHI.
+	 *
+	 * @details Thread-safe, the commands can be recorded on any thread.
+	 * Reset it before the measured part (e.g. a frame), and inspect it after.
+	 */
+	class ION_API NullRHICommandLog
+	{
+	public:
+		static void Record(ENullRHICommand type, const void* object, uint32 arg0 = 0, uint32 arg1 = 0, uint64 bytes = 0);
+
+		/* Clears the commands and the stats. */
+		static void Reset();
+
+		/* Returns a copy of the recorded commands, in the submission order. */
+		static TArray<NullRHICommand> GetCommands();
+
+		static NullRHICommandStats GetStats(ENullRHICommand type);
+		/* Stats of all the commands together */
+		static NullRHICommandStats GetTotalStats();
+
+		/**
+		 * @brief If disabled, only the stats are updated and the commands are not stored.
+		 * Useful for long benchmarks, where the log would grow without limit. Enabled by default.
+		 */
+		static void SetCommandStorageEnabled(bool bEnabled);
+		static bool IsCommandStorageEnabled();
+
+		/* Logs the stats of every command type with any calls. */
+		static void PrintStats();
+
+		static constexpr const char* CommandToString(ENullRHICommand type);
+
+	private:
+		static Mutex s_Mutex;
+		static TArray<NullRHICommand> s_Commands;
+		static NullRHICommandStats s_Stats[(size_t)ENullRHICommand::_Count];
+		static bool s_bStoreCommands;
+	};
+
+	inline constexpr const char* NullRHICommandLog::CommandToString(ENullRHICommand type)
+	{
+		switch (type)
+		{
+		case ENullRHICommand::BeginFrame:           return "BeginFrame";
+		case ENullRHICommand::EndFrame:             return "EndFrame";
+		case ENullRHICommand::Clear:                return "Clear";
+		case ENullRHICommand::DrawIndexed:          return "DrawIndexed";
+		case ENullRHICommand::DrawIndexedInstanced: return "DrawIndexedInstanced";
+		case ENullRHICommand::SetRenderTarget:      return "SetRenderTarget";
+		case ENullRHICommand::SetDepthStencil:      return "SetDepthStencil";
+		case ENullRHICommand::SetViewport:          return "SetViewport";
+		case ENullRHICommand::SetBlending:          return "SetBlending";
+		case ENullRHICommand::SetPolygonDrawMode:   return "SetPolygonDrawMode";
+		case ENullRHICommand::UnbindResources:      return "UnbindResources";
+		case ENullRHICommand::CompileShader:        return "CompileShader";
+		case ENullRHICommand::BindShader:           return "BindShader";
+		case ENullRHICommand::UnbindShader:         return "UnbindShader";
+		case ENullRHICommand::BindVertexBuffer:     return "BindVertexBuffer";
+		case ENullRHICommand::BindVertexLayout:     return "BindVertexLayout";
+		case ENullRHICommand::BindInstanceLayout:   return "BindInstanceLayout";
+		case ENullRHICommand::BindInstances:        return "BindInstances";
+		case ENullRHICommand::UnbindVertexBuffer:   return "UnbindVertexBuffer";
+		case ENullRHICommand::UpdateVertexBuffer:   return "UpdateVertexBuffer";
+		case ENullRHICommand::BindIndexBuffer:      return "BindIndexBuffer";
+		case ENullRHICommand::UnbindIndexBuffer:    return "UnbindIndexBuffer";
+		case ENullRHICommand::BindUniformBuffer:    return "BindUniformBuffer";
+		case ENullRHICommand::UpdateUniformBuffer:  return "UpdateUniformBuffer";
+		case ENullRHICommand::BindTexture:          return "BindTexture";
+		case ENullRHICommand::UnbindTexture:        return "UnbindTexture";
+		case ENullRHICommand::UpdateTexture:        return "UpdateTexture";
+		case ENullRHICommand::CopyTexture:          return "CopyTexture";
+		case ENullRHICommand::MapTexture:           return "MapTexture";
+		case ENullRHICommand::UnmapTexture:         return "UnmapTexture";
+		default:                                    return "Unknown";
+		}
+	}
+}
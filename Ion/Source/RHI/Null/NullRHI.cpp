@@ -0,0 +1,144 @@
+#include "IonPCH.h"
+
+#include "RHI/RHICore.h"
+
+#if RHI_BUILD_NULL
+
+#include "NullRHI.h"
+#include "RHI/Texture.h"
+
+#include "UserInterface/ImGui.h"
+
+namespace Ion
+{
+	Result<void, RHIError> NullRHI::Init(RHIWindowData& mainWindow)
+	{
+		TRACE_FUNCTION();
+
+		NullRHILogger.Info("Null RHI has been initialized. Nothing will be rendered.");
+
+		return InitWindow(mainWindow);
+	}
+
+	Result<void, RHIError> NullRHI::InitWindow(RHIWindowData& window)
+	{
+		TRACE_FUNCTION();
+
+		CreateWindowTextures(window, DefaultWindowDimensions);
+
+		return Ok();
+	}
+
+	void NullRHI::Shutdown()
+	{
+		TRACE_FUNCTION();
+
+		NullRHICommandLog::Reset();
+	}
+
+	void NullRHI::ShutdownWindow(RHIWindowData& window)
+	{
+	}
+
+	Result<void, RHIError> NullRHI::BeginFrame()
+	{
+		NullRHICommandLog::Record(ENullRHICommand::BeginFrame, nullptr);
+
+		return Ok();
+	}
+
+	Result<void, RHIError> NullRHI::EndFrame(RHIWindowData& window)
+	{
+		NullRHICommandLog::Record(ENullRHICommand::EndFrame, window.ColorTexture.Raw());
+
+		return Ok();
+	}
+
+	Result<void, RHIError> NullRHI::ChangeDisplayMode(RHIWindowData& window, EWindowDisplayMode mode, uint32 width, uint32 height)
+	{
+		return ResizeBuffers(window, { width, height });
+	}
+
+	Result<void, RHIError> NullRHI::ResizeBuffers(RHIWindowData& window, const TextureDimensions& size)
+	{
+		TRACE_FUNCTION();
+
+		window.ColorTexture = nullptr;
+		window.DepthStencilTexture = nullptr;
+
+		CreateWindowTextures(window, size);
+
+		return Ok();
+	}
+
+	String NullRHI::GetCurrentDisplayName()
+	{
+		return "Null";
+	}
+
+	void NullRHI::InitImGuiBackend()
+	{
+		ImGuiIO& io = ImGui::GetIO();
+		io.BackendRendererName = "Ion_Null";
+	}
+
+	void NullRHI::ImGuiNewFrame()
+	{
+		// There is no renderer backend that would build the font atlas.
+		if (!m_bImGuiFontsBuilt)
+		{
+			uint8* pixels = nullptr;
+			int32 width = 0;
+			int32 height = 0;
+			ImGui::GetIO().Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+
+			NullRHICommandLog::Record(ENullRHICommand::UpdateTexture, nullptr, 0, 0, (uint64)width * height * 4);
+
+			m_bImGuiFontsBuilt = true;
+		}
+	}
+
+	void NullRHI::ImGuiRender(ImDrawData* drawData)
+	{
+		TRACE_FUNCTION();
+
+		if (!drawData)
+			return;
+
+		NullRHICommandLog::Record(ENullRHICommand::UpdateVertexBuffer, drawData, 0, 0, (uint64)drawData->TotalVtxCount * sizeof(ImDrawVert));
+		NullRHICommandLog::Record(ENullRHICommand::UpdateVertexBuffer, drawData, 0, 0, (uint64)drawData->TotalIdxCount * sizeof(ImDrawIdx));
+
+		for (int32 i = 0; i < drawData->CmdListsCount; ++i)
+		{
+			for (const ImDrawCmd& command : drawData->CmdLists[i]->CmdBuffer)
+			{
+				NullRHICommandLog::Record(ENullRHICommand::DrawIndexed, drawData, command.ElemCount);
+			}
+		}
+	}
+
+	void NullRHI::ImGuiShutdown()
+	{
+		ImGui::GetIO().BackendRendererName = nullptr;
+		m_bImGuiFontsBuilt = false;
+	}
+
+	void NullRHI::CreateWindowTextures(RHIWindowData& window, const TextureDimensions& size)
+	{
+		TextureDescription colorDesc { };
+		colorDesc.Format = ETextureFormat::RGBA8;
+		colorDesc.bUseAsRenderTarget = true;
+		colorDesc.Dimensions = size;
+		colorDesc.DebugName = "Window_BackBuffer_RT";
+		window.ColorTexture = RHITexture::Create(colorDesc);
+
+		TextureDescription depthDesc { };
+		depthDesc.Format = ETextureFormat::D24S8;
+		depthDesc.bUseAsDepthStencil = true;
+		depthDesc.Dimensions = size;
+		depthDesc.DebugName = "Window_BackBuffer_DS";
+		window.DepthStencilTexture = RHITexture::Create(depthDesc);
+	}
+}
+
+#endif // RHI_BUILD_NULL
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "RHI/RHI.h"
+#include "RHI/Texture.h"
+#include "NullCommandLog.h"
+
+namespace Ion
+{
+	REGISTER_LOGGER(NullRHILogger, "RHI::Null");
+
+	/**
+	 * @brief Headless RHI, that doesn't need a GPU or a window.
+	 *
+	 * @details The resources are kept in the CPU memory and every command
+	 * is recorded in the NullRHICommandLog, so the CPU side of the rendering
+	 * (Renderer, Scene, Material, ...) can be benchmarked and tested anywhere.
+	 */
+	class ION_API NullRHI : public RHI
+	{
+	public:
+		/* Size of the window textures, until the buffers are resized. */
+		static constexpr TextureDimensions DefaultWindowDimensions = { 1280, 720 };
+
+		virtual Result<void, RHIError> Init(RHIWindowData& mainWindow) override;
+		virtual Result<void, RHIError> InitWindow(RHIWindowData& window) override;
+		virtual void Shutdown() override;
+		virtual void ShutdownWindow(RHIWindowData& window) override;
+
+		virtual Result<void, RHIError> BeginFrame() override;
+		virtual Result<void, RHIError> EndFrame(RHIWindowData& window) override;
+
+		virtual Result<void, RHIError> ChangeDisplayMode(RHIWindowData& window, EWindowDisplayMode mode, uint32 width, uint32 height) override;
+		virtual Result<void, RHIError> ResizeBuffers(RHIWindowData& window, const TextureDimensions& size) override;
+
+		virtual String GetCurrentDisplayName() override;
+
+		virtual bool SupportsRenderThread() const override { return true; }
+		virtual bool SupportsInstancing() const override { return true; }
+		virtual bool SupportsUniformRingBuffer() const override { return true; }
+		virtual bool SupportsAsyncShaderCompilation() const override { return true; }
+		virtual bool SupportsTextureFormat(ETextureFormat format) const override { return true; }
+
+		virtual void InitImGuiBackend() override;
+		virtual void ImGuiNewFrame() override;
+		virtual void ImGuiRender(ImDrawData* drawData) override;
+		virtual void ImGuiShutdown() override;
+
+	private:
+		static void CreateWindowTextures(RHIWindowData& window, const TextureDimensions& size);
+
+	private:
+		bool m_bImGuiFontsBuilt = false;
+	};
+}
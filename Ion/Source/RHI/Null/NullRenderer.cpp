@@ -0,0 +1,123 @@
+#include "IonPCH.h"
+
+#include "RHI/RHICore.h"
+
+#if RHI_BUILD_NULL
+
+#include "NullRenderer.h"
+
+namespace Ion
+{
+	NullRenderer::NullRenderer() :
+		m_PolygonDrawMode(EPolygonDrawMode::Fill),
+		m_bVSyncEnabled(false)
+	{
+	}
+
+	NullRenderer::~NullRenderer()
+	{
+	}
+
+	void NullRenderer::Init()
+	{
+		TRACE_FUNCTION();
+
+		Renderer::Init();
+	}
+
+	Result<void, RHIError> NullRenderer::Clear(const RendererClearOptions& options) const
+	{
+		NullRHICommandLog::Record(ENullRHICommand::Clear, nullptr,
+			FlagsIf(options.bClearColor, 1) | FlagsIf(options.bClearDepth, 2) | FlagsIf(options.bClearStencil, 4));
+
+		return Ok();
+	}
+
+	Result<void, RHIError> NullRenderer::DrawIndexed(uint32 indexCount) const
+	{
+		NullRHICommandLog::Record(ENullRHICommand::DrawIndexed, nullptr, indexCount);
+
+		return Ok();
+	}
+
+	Result<void, RHIError> NullRenderer::DrawIndexedInstanced(uint32 indexCount, uint32 instanceCount) const
+	{
+		NullRHICommandLog::Record(ENullRHICommand::DrawIndexedInstanced, nullptr, indexCount, instanceCount);
+
+		return Ok();
+	}
+
+	Result<void, RHIError> NullRenderer::UnbindResources() const
+	{
+		NullRHICommandLog::Record(ENullRHICommand::UnbindResources, nullptr);
+
+		return Ok();
+	}
+
+	Result<void, RHIError> NullRenderer::SetBlendingEnabled(bool bEnable) const
+	{
+		NullRHICommandLog::Record(ENullRHICommand::SetBlending, nullptr, bEnable);
+
+		return Ok();
+	}
+
+	Result<void, RHIError> NullRenderer::SetVSyncEnabled(bool bEnabled) const
+	{
+		m_bVSyncEnabled = bEnabled;
+
+		return Ok();
+	}
+
+	bool NullRenderer::IsVSyncEnabled() const
+	{
+		return m_bVSyncEnabled;
+	}
+
+	Result<void, RHIError> NullRenderer::SetViewport(const ViewportDescription& viewport)
+	{
+		m_CurrentViewport = viewport;
+
+		NullRHICommandLog::Record(ENullRHICommand::SetViewport, nullptr, viewport.Width, viewport.Height);
+
+		return Ok();
+	}
+
+	Result<ViewportDescription, RHIError> NullRenderer::GetViewport() const
+	{
+		return m_CurrentViewport;
+	}
+
+	Result<void, RHIError> NullRenderer::SetPolygonDrawMode(EPolygonDrawMode drawMode) const
+	{
+		m_PolygonDrawMode = drawMode;
+
+		NullRHICommandLog::Record(ENullRHICommand::SetPolygonDrawMode, nullptr, (uint32)drawMode);
+
+		return Ok();
+	}
+
+	Result<EPolygonDrawMode, RHIError> NullRenderer::GetPolygonDrawMode() const
+	{
+		return m_PolygonDrawMode;
+	}
+
+	Result<void, RHIError> NullRenderer::SetRenderTarget(const TRef<RHITexture>& targetTexture)
+	{
+		ionassert(!targetTexture || targetTexture->IsRenderTarget());
+
+		NullRHICommandLog::Record(ENullRHICommand::SetRenderTarget, targetTexture.Raw());
+
+		return Ok();
+	}
+
+	Result<void, RHIError> NullRenderer::SetDepthStencil(const TRef<RHITexture>& targetTexture)
+	{
+		ionassert(!targetTexture || targetTexture->IsDepthStencil());
+
+		NullRHICommandLog::Record(ENullRHICommand::SetDepthStencil, targetTexture.Raw());
+
+		return Ok();
+	}
+}
+
+#endif // RHI_BUILD_NULL
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Renderer/Renderer.h"
+#include "NullRHI.h"
+
+namespace Ion
+{
+	/**
+	 * @brief Renderer of the Null RHI. Keeps the state that can be queried,
+	 * everything else is only recorded in the NullRHICommandLog.
+	 */
+	class ION_API NullRenderer : public Renderer
+	{
+	public:
+		NullRenderer();
+		virtual ~NullRenderer() override;
+
+		virtual void Init() override;
+
+		virtual Result<void, RHIError> Clear(const RendererClearOptions& options) const override;
+
+		virtual Result<void, RHIError> DrawIndexed(uint32 indexCount) const override;
+		virtual Result<void, RHIError> DrawIndexedInstanced(uint32 indexCount, uint32 instanceCount) const override;
+
+		virtual Result<void, RHIError> UnbindResources() const override;
+
+		virtual Result<void, RHIError> SetBlendingEnabled(bool bEnable) const override;
+
+		virtual Result<void, RHIError> SetVSyncEnabled(bool bEnabled) const override;
+		virtual bool IsVSyncEnabled() const override;
+
+		virtual Result<void, RHIError> SetViewport(const ViewportDescription& viewport) override;
+		virtual Result<ViewportDescription, RHIError> GetViewport() const override;
+
+		virtual Result<void, RHIError> SetPolygonDrawMode(EPolygonDrawMode drawMode) const override;
+		virtual Result<EPolygonDrawMode, RHIError> GetPolygonDrawMode() const override;
+
+		virtual Result<void, RHIError> SetRenderTarget(const TRef<RHITexture>& targetTexture) override;
+		virtual Result<void, RHIError> SetDepthStencil(const TRef<RHITexture>& targetTexture) override;
+
+	private:
+		ViewportDescription m_CurrentViewport;
+		mutable EPolygonDrawMode m_PolygonDrawMode;
+		mutable bool m_bVSyncEnabled;
+	};
+}
@@ -0,0 +1,118 @@
+#include "IonPCH.h"
+
+#include "RHI/RHICore.h"
+
+#if RHI_BUILD_NULL
+
+#include "NullShader.h"
+
+namespace Ion
+{
+	NullShader::NullShader() :
+		m_bCompiled(false)
+	{
+	}
+
+	NullShader::~NullShader()
+	{
+	}
+
+	void NullShader::AddShaderSource(EShaderType type, const String& source)
+	{
+		ionassert(type != EShaderType::Unknown);
+
+		m_Sources[type] = source;
+		m_bCompiled = false;
+	}
+
+	void NullShader::AddShaderSource(EShaderType type, const String& source, const FilePath& sourcePath)
+	{
+		AddShaderSource(type, source);
+	}
+
+	Result<void, RHIError, ShaderCompilationError> NullShader::Compile()
+	{
+		TRACE_FUNCTION();
+
+		for (auto& [type, source] : m_Sources)
+		{
+			NullRHICommandLog::Record(ENullRHICommand::CompileShader, this, (uint32)type, 0, source.size());
+		}
+
+		m_bCompiled = true;
+
+		return Ok();
+	}
+
+	bool NullShader::IsCompiled()
+	{
+		return m_bCompiled;
+	}
+
+	Result<void, RHIError> NullShader::GetBinary(TArray<uint8>& outBinary) const
+	{
+		ionassert(m_bCompiled, "Cannot get a binary of a shader that has not been compiled.");
+
+		// There is no bytecode, the sources are stored as [type (uint8), size (uint32), source]
+		outBinary.clear();
+		for (auto& [type, source] : m_Sources)
+		{
+			uint8 shaderType = (uint8)type;
+			uint32 size = (uint32)source.size();
+
+			size_t offset = outBinary.size();
+			outBinary.resize(offset + sizeof(shaderType) + sizeof(size) + size);
+
+			uint8* data = outBinary.data() + offset;
+			memcpy(data, &shaderType, sizeof(shaderType));
+			memcpy(data + sizeof(shaderType), &size, sizeof(size));
+			memcpy(data + sizeof(shaderType) + sizeof(size), source.data(), size);
+		}
+
+		return Ok();
+	}
+
+	Result<void, RHIError> NullShader::LoadBinary(const TArray<uint8>& binary)
+	{
+		ionassert(!m_bCompiled, "Shader has already been compiled.");
+
+		THashMap<EShaderType, String> sources;
+
+		size_t offset = 0;
+		while (offset < binary.size())
+		{
+			uint8 shaderType;
+			uint32 size;
+
+			ionthrowif(offset + sizeof(shaderType) + sizeof(size) > binary.size(), RHIError, "The shader binary is corrupted.");
+
+			memcpy(&shaderType, binary.data() + offset, sizeof(shaderType));
+			memcpy(&size, binary.data() + offset + sizeof(shaderType), sizeof(size));
+			offset += sizeof(shaderType) + sizeof(size);
+
+			ionthrowif(offset + size > binary.size(), RHIError, "The shader binary is corrupted.");
+
+			sources[(EShaderType)shaderType].assign((const char*)binary.data() + offset, size);
+			offset += size;
+		}
+
+		m_Sources = Move(sources);
+		m_bCompiled = true;
+
+		return Ok();
+	}
+
+	void NullShader::Bind() const
+	{
+		ionassert(m_bCompiled, "Cannot bind a shader that has not been compiled.");
+
+		NullRHICommandLog::Record(ENullRHICommand::BindShader, this);
+	}
+
+	void NullShader::Unbind() const
+	{
+		NullRHICommandLog::Record(ENullRHICommand::UnbindShader, this);
+	}
+}
+
+#endif // RHI_BUILD_NULL
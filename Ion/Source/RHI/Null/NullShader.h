@@ -0,0 +1,31 @@
+#pragma once
+
+#include "RHI/Shader.h"
+#include "NullRHI.h"
+
+namespace Ion
+{
+	class ION_API NullShader : public RHIShader
+	{
+	public:
+		NullShader();
+		virtual ~NullShader() override;
+
+		virtual void AddShaderSource(EShaderType type, const String& source) override;
+		virtual void AddShaderSource(EShaderType type, const String& source, const FilePath& sourcePath) override;
+
+		virtual Result<void, RHIError, ShaderCompilationError> Compile() override;
+		virtual bool IsCompiled() override;
+
+		virtual bool SupportsBinary() const override { return true; }
+		virtual Result<void, RHIError> GetBinary(TArray<uint8>& outBinary) const override;
+		virtual Result<void, RHIError> LoadBinary(const TArray<uint8>& binary) override;
+
+		virtual void Bind() const override;
+		virtual void Unbind() const override;
+
+	private:
+		THashMap<EShaderType, String> m_Sources;
+		bool m_bCompiled;
+	};
+}
@@ -0,0 +1,145 @@
+#include "IonPCH.h"
+
+#include "RHI/RHICore.h"
+
+#if RHI_BUILD_NULL
+
+#include "NullTexture.h"
+
+namespace Ion
+{
+	NullTexture::NullTexture(const TextureDescription& desc) :
+		RHITexture(desc)
+	{
+		AllocatePixels();
+
+		if (desc.InitialData)
+		{
+			memcpy(m_Pixels.data(), desc.InitialData, m_Pixels.size());
+			NullRHICommandLog::Record(ENullRHICommand::UpdateTexture, this, 0, 0, m_Pixels.size());
+		}
+
+		NullRHILogger.Debug("NullTexture \"{}\" has been created.", desc.DebugName);
+	}
+
+	NullTexture::~NullTexture()
+	{
+		NullRHILogger.Debug("NullTexture \"{}\" has been destroyed.", m_Description.DebugName);
+	}
+
+	Result<void, RHIError> NullTexture::SetDimensions(TextureDimensions dimensions)
+	{
+		m_Description.Dimensions = dimensions;
+		AllocatePixels();
+
+		return Ok();
+	}
+
+	Result<void, RHIError> NullTexture::UpdateSubresource(Image* image)
+	{
+		TRACE_FUNCTION();
+
+		ionassert(image->IsLoaded(), "Cannot Update Subresource of Texture. Image has not been loaded.");
+
+		ionassert(
+			image->GetWidth() == m_Description.Dimensions.Width &&
+			image->GetHeight() == m_Description.Dimensions.Height,
+			"Image dimensions do not match texture dimensions.");
+
+		uint64 size = std::min((uint64)image->GetPixelDataSize(), (uint64)m_Pixels.size());
+		memcpy(m_Pixels.data(), image->GetPixelData(), size);
+
+		NullRHICommandLog::Record(ENullRHICommand::UpdateTexture, this, 0, 0, size);
+
+		return Ok();
+	}
+
+	Result<void, RHIError> NullTexture::UpdateSubresource(uint32 mipLevel, const void* pixelData, uint32 lineSize)
+	{
+		TRACE_FUNCTION();
+
+		ionassert(pixelData);
+		ionassert(mipLevel < m_Description.GetMipLevelCount(), "The texture does not have mip level {}.", mipLevel);
+
+		uint64 size = (uint64)lineSize * TextureDescription::CalcMipLineCount(m_Description.Format, TextureDescription::CalcMipDimensions(m_Description.Dimensions, mipLevel).Height);
+
+		// Only the first mip level is stored
+		if (mipLevel == 0)
+		{
+			memcpy(m_Pixels.data(), pixelData, std::min(size, (uint64)m_Pixels.size()));
+		}
+
+		NullRHICommandLog::Record(ENullRHICommand::UpdateTexture, this, mipLevel, 0, size);
+
+		return Ok();
+	}
+
+	Result<void, RHIError> NullTexture::Bind(uint32 slot) const
+	{
+		NullRHICommandLog::Record(ENullRHICommand::BindTexture, this, slot);
+
+		return Ok();
+	}
+
+	Result<void, RHIError> NullTexture::Unbind() const
+	{
+		NullRHICommandLog::Record(ENullRHICommand::UnbindTexture, this);
+
+		return Ok();
+	}
+
+	Result<void, RHIError> NullTexture::CopyTo(const TRef<RHITexture>& destination) const
+	{
+		TRACE_FUNCTION();
+
+		ionassert(destination);
+		ionassert(m_Description.Dimensions.Width == destination->GetDimensions().Width);
+		ionassert(m_Description.Dimensions.Height == destination->GetDimensions().Height);
+		ionassert(m_Description.Format == destination->GetDescription().Format);
+
+		TRef<NullTexture> nullDestination = RefCast<NullTexture>(destination);
+		nullDestination->m_Pixels = m_Pixels;
+
+		NullRHICommandLog::Record(ENullRHICommand::CopyTexture, this, 0, 0, m_Pixels.size());
+
+		return Ok();
+	}
+
+	Result<void, RHIError> NullTexture::Map(void*& outBuffer, int32& outLineSize, ETextureMapType mapType)
+	{
+		outBuffer = m_Pixels.data();
+		outLineSize = (int32)GetLineSize();
+
+		NullRHICommandLog::Record(ENullRHICommand::MapTexture, this, (uint32)mapType, 0, m_Pixels.size());
+
+		return Ok();
+	}
+
+	Result<void, RHIError> NullTexture::Unmap()
+	{
+		NullRHICommandLog::Record(ENullRHICommand::UnmapTexture, this);
+
+		return Ok();
+	}
+
+	void* NullTexture::GetNativeID() const
+	{
+		return (void*)m_Pixels.data();
+	}
+
+	void NullTexture::AllocatePixels()
+	{
+		m_Pixels.clear();
+		m_Pixels.resize((size_t)GetLineSize() * TextureDescription::CalcMipLineCount(m_Description.Format, m_Description.Dimensions.Height));
+	}
+
+	uint32 NullTexture::GetLineSize() const
+	{
+		if (TextureDescription::IsBlockCompressed(m_Description.Format))
+			return TextureDescription::CalcMipLineSize(m_Description.Format, m_Description.Dimensions.Width);
+
+		return m_Description.Dimensions.Width * GetFormatPixelSize(m_Description.Format);
+	}
+}
+
+#endif // RHI_BUILD_NULL
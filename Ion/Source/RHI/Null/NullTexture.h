@@ -0,0 +1,58 @@
+#pragma once
+
+#include "RHI/Texture.h"
+#include "NullRHI.h"
+
+namespace Ion
+{
+	class ION_API NullTexture : public RHITexture
+	{
+	public:
+		virtual ~NullTexture() override;
+
+		virtual Result<void, RHIError> SetDimensions(TextureDimensions dimensions) override;
+		virtual Result<void, RHIError> UpdateSubresource(Image* image) override;
+		virtual Result<void, RHIError> UpdateSubresource(uint32 mipLevel, const void* pixelData, uint32 lineSize) override;
+
+		virtual Result<void, RHIError> Bind(uint32 slot = 0) const override;
+		virtual Result<void, RHIError> Unbind() const override;
+
+		virtual Result<void, RHIError> CopyTo(const TRef<RHITexture>& destination) const override;
+		virtual Result<void, RHIError> Map(void*& outBuffer, int32& outLineSize, ETextureMapType mapType) override;
+		virtual Result<void, RHIError> Unmap() override;
+
+		virtual void* GetNativeID() const override;
+
+		static constexpr uint32 GetFormatPixelSize(ETextureFormat format);
+
+	protected:
+		NullTexture(const TextureDescription& desc);
+
+	private:
+		void AllocatePixels();
+		uint32 GetLineSize() const;
+
+	private:
+		/* The pixels of the first mip level */
+		TArray<uint8> m_Pixels;
+
+		friend class RHITexture;
+		FRIEND_MAKE_REF;
+	};
+
+	inline constexpr uint32 NullTexture::GetFormatPixelSize(ETextureFormat format)
+	{
+		switch (format)
+		{
+		case ETextureFormat::RGBA8:       return 4;
+		case ETextureFormat::RGBA10:      return 4;
+		case ETextureFormat::RGBAFloat32: return 16;
+		case ETextureFormat::UInt32:      return 4;
+		case ETextureFormat::Float32:     return 4;
+		case ETextureFormat::D24S8:       return 4;
+		case ETextureFormat::UInt128GUID: return 16;
+		}
+		ionassert(false, "Invalid format.");
+		return 0;
+	}
+}
@@ -28,6 +28,25 @@ namespace Ion
 
 		virtual String GetCurrentDisplayName() override;
 
+		/* glVertexAttribDivisor requires OpenGL 3.3 */
+		virtual bool SupportsInstancing() const override { return s_MajorVersion > 3 || (s_MajorVersion == 3 && s_MinorVersion >= 3); }
+		/* The persistently mapped buffers (glBufferStorage) require OpenGL 4.4 */
+		virtual bool SupportsUniformRingBuffer() const override { return (s_MajorVersion > 4 || (s_MajorVersion == 4 && s_MinorVersion >= 4)) && glBufferStorage; }
+		/* RGTC (BC5) is core since OpenGL 3.0, BPTC (BC7) since OpenGL 4.2 */
+		virtual bool SupportsTextureFormat(ETextureFormat format) const override
+		{
+			switch (format)
+			{
+				case ETextureFormat::BC1:
+				case ETextureFormat::BC3: return false;
+				case ETextureFormat::BC5: return s_MajorVersion >= 3;
+				case ETextureFormat::BC7: return s_MajorVersion > 4 || (s_MajorVersion == 4 && s_MinorVersion >= 2);
+			}
+			return true;
+		}
+		/* The program binaries are only valid for the driver they have been retrieved from */
+		virtual String GetShaderCacheTag() const override { return String(GetRendererName()) + " " + GetVersion(); }
+
 		static FORCEINLINE const char* GetVendor()           { return (const char*)glGetString(GL_VENDOR); }
 		static FORCEINLINE const char* GetRendererName()     { return (const char*)glGetString(GL_RENDERER); }
 		static FORCEINLINE const char* GetVersion()          { return (const char*)glGetString(GL_VERSION); }
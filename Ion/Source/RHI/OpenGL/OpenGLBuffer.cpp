@@ -15,7 +15,8 @@ namespace Ion
 	// -------------------------------------------------------------------
 
 	OpenGLVertexBuffer::OpenGLVertexBuffer(float* vertexAttributes, uint64 count)
-		: m_VertexCount(0)
+		: m_VertexCount(0),
+		m_DynamicSize(0)
 	{
 		TRACE_FUNCTION();
 
@@ -24,6 +25,17 @@ namespace Ion
 		glBufferData(GL_ARRAY_BUFFER, count * sizeof(float), vertexAttributes, GL_STATIC_DRAW);
 	}
 
+	OpenGLVertexBuffer::OpenGLVertexBuffer(uint64 size)
+		: m_VertexCount(0),
+		m_DynamicSize(size)
+	{
+		TRACE_FUNCTION();
+
+		glGenBuffers(1, &m_ID);
+		glBindBuffer(GL_ARRAY_BUFFER, m_ID);
+		glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+	}
+
 	OpenGLVertexBuffer::~OpenGLVertexBuffer()
 	{
 		TRACE_FUNCTION();
@@ -41,6 +53,36 @@ namespace Ion
 		return Ok();
 	}
 
+	Result<void, RHIError> OpenGLVertexBuffer::SetInstanceLayoutShader(const TRef<RHIVertexLayout>& instanceLayout, const TRef<RHIShader>& shader)
+	{
+		ionassert(instanceLayout);
+		ionassert(instanceLayout->GetInputRate() == EVertexInputRate::Instance);
+
+		m_InstanceLayout = instanceLayout;
+
+		return Ok();
+	}
+
+	bool OpenGLVertexBuffer::HasInstanceLayout() const
+	{
+		return (bool)m_InstanceLayout;
+	}
+
+	Result<void, RHIError> OpenGLVertexBuffer::UpdateData(const void* data, uint64 size)
+	{
+		TRACE_FUNCTION();
+
+		ionassert(m_DynamicSize, "Only a dynamic Vertex Buffer can be updated.");
+		ionassert(size <= m_DynamicSize);
+
+		glBindBuffer(GL_ARRAY_BUFFER, m_ID);
+		// Orphan the old storage, so the driver doesn't have to wait for the previous draws.
+		glBufferData(GL_ARRAY_BUFFER, m_DynamicSize, nullptr, GL_DYNAMIC_DRAW);
+		glBufferSubData(GL_ARRAY_BUFFER, 0, size, data);
+
+		return Ok();
+	}
+
 	uint32 OpenGLVertexBuffer::GetVertexCount() const
 	{
 		return m_VertexCount;
@@ -84,6 +126,37 @@ namespace Ion
 		return Ok();
 	}
 
+	Result<void, RHIError> OpenGLVertexBuffer::BindInstanceLayout() const
+	{
+		// The per-vertex part is the same, the instance part is set in BindInstances.
+		return BindLayout();
+	}
+
+	Result<void, RHIError> OpenGLVertexBuffer::BindInstances(const RHIVertexLayout& instanceLayout, uint64 offset) const
+	{
+		TRACE_FUNCTION();
+
+		ionassert(instanceLayout.GetInputRate() == EVertexInputRate::Instance);
+
+		glBindBuffer(GL_ARRAY_BUFFER, m_ID);
+
+		uint32 attributeIndex = InstanceAttributeFirstIndex;
+		for (const VertexAttribute& attribute : instanceLayout.GetAttributes())
+		{
+			glVertexAttribPointer(attributeIndex,
+				attribute.ElementCount,
+				VertexAttributeTypeToGLType(attribute.Type),
+				attribute.bNormalized,
+				instanceLayout.GetStride(),
+				(const void*)(offset + attribute.Offset));
+			glVertexAttribDivisor(attributeIndex, 1);
+			glEnableVertexAttribArray(attributeIndex);
+			attributeIndex++;
+		}
+
+		return Ok();
+	}
+
 	// -------------------------------------------------------------------
 	// OpenGLIndexBuffer -------------------------------------------------
 	// -------------------------------------------------------------------
@@ -189,6 +262,106 @@ namespace Ion
 
 		return Ok();
 	}
+
+	// -------------------------------------------------------------------
+	// OpenGLUniformRingBuffer -------------------------------------------
+	// -------------------------------------------------------------------
+
+	OpenGLUniformRingBuffer::OpenGLUniformRingBuffer(uint32 frameCapacity, uint32 framesInFlight) :
+		RHIUniformRingBuffer(frameCapacity, framesInFlight),
+		m_ID(0),
+		m_FrameFences(framesInFlight, nullptr)
+	{
+		TRACE_FUNCTION();
+
+#if ION_DEBUG
+		GLint offsetAlignment = 0;
+		glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &offsetAlignment);
+		ionassert(Alignment % offsetAlignment == 0, "Unsupported uniform buffer offset alignment ({}).", offsetAlignment);
+#endif
+
+		uint32 size = m_FrameCapacity * m_FramesInFlight;
+		GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+		glGenBuffers(1, &m_ID);
+		glBindBuffer(GL_UNIFORM_BUFFER, m_ID);
+		glBufferStorage(GL_UNIFORM_BUFFER, size, nullptr, flags);
+
+		// Stays mapped for the whole lifetime of the buffer.
+		m_Data = (uint8*)glMapBufferRange(GL_UNIFORM_BUFFER, 0, size, flags);
+		ionassert(m_Data, "Cannot map the Uniform Ring Buffer.");
+
+		OpenGLLogger.Info("OpenGLUniformRingBuffer has been created.");
+	}
+
+	OpenGLUniformRingBuffer::~OpenGLUniformRingBuffer()
+	{
+		TRACE_FUNCTION();
+
+		for (GLsync fence : m_FrameFences)
+		{
+			if (fence)
+				glDeleteSync(fence);
+		}
+
+		glBindBuffer(GL_UNIFORM_BUFFER, m_ID);
+		glUnmapBuffer(GL_UNIFORM_BUFFER);
+		glDeleteBuffers(1, &m_ID);
+
+		OpenGLLogger.Info("OpenGLUniformRingBuffer has been destroyed.");
+	}
+
+	Result<void, RHIError> OpenGLUniformRingBuffer::BeginFrame()
+	{
+		TRACE_FUNCTION();
+
+		AdvanceFrame();
+
+		// Wait until the GPU has finished the last frame that used this part of the ring.
+		GLsync& fence = m_FrameFences[m_FrameIndex];
+		if (fence)
+		{
+			GLenum result;
+			while ((result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000)) == GL_TIMEOUT_EXPIRED);
+
+			glDeleteSync(fence);
+			fence = nullptr;
+
+			if (result == GL_WAIT_FAILED)
+			{
+				ionthrow(RHIError, "Cannot wait for the Uniform Ring Buffer frame fence.");
+			}
+		}
+
+		return Ok();
+	}
+
+	Result<void, RHIError> OpenGLUniformRingBuffer::EndFrame()
+	{
+		GLsync& fence = m_FrameFences[m_FrameIndex];
+		ionassert(!fence);
+
+		fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+		return Ok();
+	}
+
+	Result<void, RHIError> OpenGLUniformRingBuffer::Flush()
+	{
+		// The mapping is coherent, the written data is visible to the GPU.
+		OnFlushed();
+
+		return Ok();
+	}
+
+	Result<void, RHIError> OpenGLUniformRingBuffer::Bind(const RHIUniformRingAllocation& allocation, uint32 slot) const
+	{
+		ionassert(allocation.Size);
+
+		glBindBufferRange(GL_UNIFORM_BUFFER, slot, m_ID, allocation.Offset, allocation.Size);
+
+		return Ok();
+	}
 }
 
 #endif // RHI_BUILD_OPENGL
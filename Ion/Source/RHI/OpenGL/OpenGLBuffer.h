@@ -12,13 +12,24 @@ namespace Ion
 		friend class OpenGLRenderer;
 	public:
 		OpenGLVertexBuffer(float* vertexAttributes, uint64 count);
+		/* Dynamic buffer */
+		OpenGLVertexBuffer(uint64 size);
 		virtual ~OpenGLVertexBuffer() override;
 
 		virtual void SetLayout(const TRef<RHIVertexLayout>& layout) override;
 		virtual Result<void, RHIError> SetLayoutShader(const TRef<RHIShader>& shader) override;
 
+		virtual Result<void, RHIError> SetInstanceLayoutShader(const TRef<RHIVertexLayout>& instanceLayout, const TRef<RHIShader>& shader) override;
+		virtual bool HasInstanceLayout() const override;
+
+		virtual Result<void, RHIError> UpdateData(const void* data, uint64 size) override;
+
 		virtual uint32 GetVertexCount() const override;
 
+		/* The instance attributes are bound starting at this location,
+		   so they don't overlap with the per-vertex ones. */
+		static constexpr uint32 InstanceAttributeFirstIndex = 8;
+
 		static constexpr FORCEINLINE uint32 VertexAttributeTypeToGLType(EVertexAttributeType type)
 		{
 			switch (type)
@@ -39,12 +50,16 @@ namespace Ion
 	protected:
 		virtual Result<void, RHIError> Bind() const override;
 		virtual Result<void, RHIError> BindLayout() const override;
+		virtual Result<void, RHIError> BindInstanceLayout() const override;
+		virtual Result<void, RHIError> BindInstances(const RHIVertexLayout& instanceLayout, uint64 offset) const override;
 		virtual Result<void, RHIError> Unbind() const override;
 
 	private:
 		uint32 m_ID;
 		uint32 m_VertexCount;
+		uint64 m_DynamicSize;
 		TRef<RHIVertexLayout> m_VertexLayout;
+		TRef<RHIVertexLayout> m_InstanceLayout;
 	};
 
 	class ION_API OpenGLIndexBuffer : public RHIIndexBuffer
@@ -90,4 +105,23 @@ namespace Ion
 		friend class RHIUniformBuffer;
 		FRIEND_MAKE_REF;
 	};
+
+	class ION_API OpenGLUniformRingBuffer : public RHIUniformRingBuffer
+	{
+	public:
+		OpenGLUniformRingBuffer(uint32 frameCapacity, uint32 framesInFlight);
+		virtual ~OpenGLUniformRingBuffer() override;
+
+		virtual Result<void, RHIError> BeginFrame() override;
+		virtual Result<void, RHIError> EndFrame() override;
+
+		virtual Result<void, RHIError> Flush() override;
+
+		virtual Result<void, RHIError> Bind(const RHIUniformRingAllocation& allocation, uint32 slot) const override;
+
+	private:
+		uint32 m_ID;
+		/* Fence per frame part, signaled when the GPU has finished the frame */
+		TArray<GLsync> m_FrameFences;
+	};
 }
@@ -119,6 +119,12 @@ namespace Ion
 		return Ok();
 	}
 
+	Result<void, RHIError> OpenGLRenderer::DrawIndexedInstanced(uint32 indexCount, uint32 instanceCount) const
+	{
+		glDrawElementsInstanced(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, nullptr, instanceCount);
+		return Ok();
+	}
+
 	Result<void, RHIError> OpenGLRenderer::UnbindResources() const
 	{
 		return Ok();
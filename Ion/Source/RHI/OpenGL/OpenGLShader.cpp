@@ -98,6 +98,12 @@ namespace Ion
 		}
 		TRACE_END(1);
 
+		if (SupportsBinary())
+		{
+			// Has to be set before linking, so the binary can be retrieved for the shader cache
+			glProgramParameteri(m_ProgramID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+		}
+
 		TRACE_BEGIN(2, "OpenGLShader - Shader Linking");
 		glLinkProgram(m_ProgramID);
 		TRACE_END(2);
@@ -132,6 +138,62 @@ namespace Ion
 		return m_bCompiled;
 	}
 
+	Result<void, RHIError> OpenGLShader::GetBinary(TArray<uint8>& outBinary) const
+	{
+		TRACE_FUNCTION();
+
+		ionassert(m_bCompiled, "Cannot get a binary of a shader that has not been compiled.");
+		ionassert(SupportsBinary());
+
+		int32 length = 0;
+		glGetProgramiv(m_ProgramID, GL_PROGRAM_BINARY_LENGTH, &length);
+
+		ionthrowif(length <= 0, RHIError, "The program binary is not available.");
+
+		// [format (uint32), program binary]
+		uint32 format = 0;
+		outBinary.resize(sizeof(format) + length);
+		glGetProgramBinary(m_ProgramID, length, &length, &format, outBinary.data() + sizeof(format));
+		memcpy(outBinary.data(), &format, sizeof(format));
+		outBinary.resize(sizeof(format) + length);
+
+		return Ok();
+	}
+
+	Result<void, RHIError> OpenGLShader::LoadBinary(const TArray<uint8>& binary)
+	{
+		TRACE_FUNCTION();
+
+		ionassert(!m_bCompiled, "Shader has already been compiled.");
+		ionassert(SupportsBinary());
+
+		uint32 format;
+		ionthrowif(binary.size() <= sizeof(format), RHIError, "The program binary is corrupted.");
+		memcpy(&format, binary.data(), sizeof(format));
+
+		m_ProgramID = glCreateProgram();
+		glProgramBinary(m_ProgramID, format, binary.data() + sizeof(format), (int32)(binary.size() - sizeof(format)));
+
+		int32 bLinked = 0;
+		glGetProgramiv(m_ProgramID, GL_LINK_STATUS, &bLinked);
+
+		if (!bLinked)
+		{
+			glDeleteProgram(m_ProgramID);
+			m_ProgramID = 0;
+
+			// The driver can reject the binaries of a different driver version.
+			ionthrow(RHIError, "The program binary has been rejected by the driver.");
+		}
+
+		// The sources are not needed anymore
+		CleanupDeleteShaders();
+
+		m_bCompiled = true;
+
+		return Ok();
+	}
+
 	int32 OpenGLShader::GetUniformLocation(const String& name) const
 	{
 		TRACE_FUNCTION();
@@ -25,6 +25,11 @@ namespace Ion
 		virtual Result<void, RHIError, ShaderCompilationError> Compile() override;
 		virtual bool IsCompiled() override;
 
+		/* glGetProgramBinary requires OpenGL 4.1 */
+		virtual bool SupportsBinary() const override { return glGetProgramBinary && glProgramBinary; }
+		virtual Result<void, RHIError> GetBinary(TArray<uint8>& outBinary) const override;
+		virtual Result<void, RHIError> LoadBinary(const TArray<uint8>& binary) override;
+
 		int32 GetUniformLocation(const String& name) const;
 
 		FORCEINLINE static constexpr uint32 ShaderTypeToGLShaderType(EShaderType type)
@@ -56,6 +56,33 @@ namespace Ion
 		return Ok();
 	}
 
+	Result<void, RHIError> OpenGLTexture::UpdateSubresource(uint32 mipLevel, const void* pixelData, uint32 lineSize)
+	{
+		TRACE_FUNCTION();
+
+		ionassert(pixelData);
+		ionassert(mipLevel < m_Description.GetMipLevelCount(), "The texture does not have mip level {}.", mipLevel);
+
+		TextureDimensions mipDimensions = TextureDescription::CalcMipDimensions(m_Description.Dimensions, mipLevel);
+
+		glBindTexture(GL_TEXTURE_2D, m_ID);
+
+		if (TextureDescription::IsBlockCompressed(m_Description.Format))
+		{
+			// The rows of blocks are tightly packed
+			uint32 size = lineSize * TextureDescription::CalcMipLineCount(m_Description.Format, mipDimensions.Height);
+			glCompressedTexSubImage2D(GL_TEXTURE_2D, mipLevel, 0, 0, mipDimensions.Width, mipDimensions.Height, SelectGLCompressedFormat(m_Description.Format), size, pixelData);
+			return Ok();
+		}
+
+		// The row length is specified in pixels
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, lineSize / 4);
+		glTexSubImage2D(GL_TEXTURE_2D, mipLevel, 0, 0, mipDimensions.Width, mipDimensions.Height, GL_RGBA, GL_UNSIGNED_BYTE, pixelData);
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+
+		return Ok();
+	}
+
 	Result<void, RHIError> OpenGLTexture::Bind(uint32 slot) const
 	{
 		TRACE_FUNCTION();
@@ -114,15 +141,39 @@ namespace Ion
 		}
 
 		//glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA, desc.Dimensions.Width, desc.Dimensions.Height);
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, desc.Dimensions.Width, desc.Dimensions.Height, 0, GL_RGB, GL_UNSIGNED_BYTE, nullptr);
+		if (desc.MipLevels)
+		{
+			// Explicit mip chain - all the levels are uploaded separately (see UpdateSubresource)
+			for (uint32 mip = 0; mip < desc.MipLevels; ++mip)
+			{
+				TextureDimensions mipDimensions = TextureDescription::CalcMipDimensions(desc.Dimensions, mip);
+				if (TextureDescription::IsBlockCompressed(desc.Format))
+				{
+					uint32 size =
+						TextureDescription::CalcMipLineSize(desc.Format, mipDimensions.Width) *
+						TextureDescription::CalcMipLineCount(desc.Format, mipDimensions.Height);
+					glCompressedTexImage2D(GL_TEXTURE_2D, mip, SelectGLCompressedFormat(desc.Format), mipDimensions.Width, mipDimensions.Height, 0, size, nullptr);
+				}
+				else
+				{
+					glTexImage2D(GL_TEXTURE_2D, mip, GL_RGBA8, mipDimensions.Width, mipDimensions.Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+				}
+			}
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, desc.MipLevels - 1);
+		}
+		else
+		{
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, desc.Dimensions.Width, desc.Dimensions.Height, 0, GL_RGB, GL_UNSIGNED_BYTE, nullptr);
+		}
 
 		//{
 		//	TRACE_SCOPE("OpenGLTexture - glTexImage2D");
 		//	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixelData);
 		//}
 
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, SelectGLFilterType(desc.MinFilter, desc.bGenerateMips, desc.MipFilter));
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, SelectGLFilterType(desc.MagFilter, desc.bGenerateMips, desc.MipFilter));
+		bool bMips = desc.GetMipLevelCount() > 1;
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, SelectGLFilterType(desc.MinFilter, bMips, desc.MipFilter));
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, SelectGLFilterType(desc.MagFilter, bMips, desc.MipFilter));
 		glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_LOD_BIAS, desc.LODBias);
 
 		//{
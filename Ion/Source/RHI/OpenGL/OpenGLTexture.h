@@ -12,6 +12,7 @@ namespace Ion
 
 		virtual Result<void, RHIError> SetDimensions(TextureDimensions dimensions) override;
 		virtual Result<void, RHIError> UpdateSubresource(Image* image) override;
+		virtual Result<void, RHIError> UpdateSubresource(uint32 mipLevel, const void* pixelData, uint32 lineSize) override;
 
 		virtual Result<void, RHIError> Bind(uint32 slot = 0) const override;
 		virtual Result<void, RHIError> Unbind() const override;
@@ -54,6 +55,17 @@ namespace Ion
 			return GL_NEAREST;
 		}
 
+		/* Internal format of a block compressed texture (BC1 and BC3 require the S3TC extension, not exposed by the loader) */
+		inline static constexpr GLenum SelectGLCompressedFormat(ETextureFormat format)
+		{
+			switch (format)
+			{
+				case ETextureFormat::BC5: return GL_COMPRESSED_RG_RGTC2;
+				case ETextureFormat::BC7: return GL_COMPRESSED_RGBA_BPTC_UNORM;
+			}
+			return 0;
+		}
+
 	protected:
 		OpenGLTexture(const TextureDescription& desc);
 
@@ -11,6 +11,9 @@
 #if RHI_BUILD_DX11
 #include "DX11/DX11.h"
 #endif
+#if RHI_BUILD_NULL
+#include "Null/NullRHI.h"
+#endif
 
 //DECLARE_PERFORMANCE_COUNTER(RenderAPI_InitTime, "RenderAPI Init Time", "Init");
 
@@ -48,6 +51,12 @@ namespace Ion
 #endif
 			break;
 
+		case ERHI::Null:
+#if RHI_BUILD_NULL
+			return s_RHI = new NullRHI;
+#endif
+			break;
+
 		default:
 			s_CurrentRHI = ERHI::None;
 		}
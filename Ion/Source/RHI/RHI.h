@@ -1,6 +1,7 @@
 #pragma once
 
 #include "RHICore.h"
+#include "Texture.h"
 #include "Renderer/RendererCore.h"
 
 struct ImDrawData;
@@ -16,6 +17,8 @@ namespace Ion
 		DX11,
 		DX12,
 		Vulkan,
+		/* Headless, records the commands instead of rendering */
+		Null,
 	};
 
 	inline String ERHIAsString(ERHI rhi)
@@ -28,6 +31,7 @@ namespace Ion
 		case ERHI::DX11:   return "DX11";
 		case ERHI::DX12:   return "DX12";
 		case ERHI::Vulkan: return "Vulkan";
+		case ERHI::Null:   return "Null";
 		}
 		return "";
 	}
@@ -77,6 +81,55 @@ namespace Ion
 
 		virtual String GetCurrentDisplayName() = 0;
 
+		/**
+		 * @brief Checks if the rendering can be done on a different thread
+		 * than the one the RHI has been initialized on.
+		 * 
+		 * @see RenderThread
+		 */
+		virtual bool SupportsRenderThread() const { return false; }
+
+		/**
+		 * @brief Checks if the RHI can draw many instances of a mesh in a single draw call,
+		 * using the per-instance vertex streams.
+		 *
+		 * @see RHIVertexBuffer::SetInstanceLayoutShader
+		 */
+		virtual bool SupportsInstancing() const { return false; }
+
+		/**
+		 * @brief Checks if the uniform buffers can be bound by offset,
+		 * so a single ring buffer can be used for all the transient uniforms.
+		 *
+		 * @see RHIUniformRingBuffer
+		 */
+		virtual bool SupportsUniformRingBuffer() const { return false; }
+
+		/**
+		 * @brief Checks if the shaders can be created and compiled
+		 * on the worker threads (e.g. the Engine Task Queue).
+		 * Otherwise, only the shader sources can be prepared asynchronously.
+		 *
+		 * @see Material::CompileShaders
+		 */
+		virtual bool SupportsAsyncShaderCompilation() const { return false; }
+
+		/**
+		 * @brief Checks if the textures of the format can be created.
+		 * The block compressed formats are not supported by default.
+		 *
+		 * @see TextureMipChain::DecodeMip
+		 */
+		virtual bool SupportsTextureFormat(ETextureFormat format) const { return !TextureDescription::IsBlockCompressed(format); }
+
+		/**
+		 * @brief Identifies the environment the shader binaries are valid in
+		 * (e.g. the feature level or the driver version). Part of the shader cache key.
+		 *
+		 * @see RHIShader::GetBinary
+		 */
+		virtual String GetShaderCacheTag() const { return EmptyString; }
+
 		virtual void InitImGuiBackend() = 0;
 		virtual void ImGuiNewFrame() = 0;
 		virtual void ImGuiRender(ImDrawData* drawData) = 0;
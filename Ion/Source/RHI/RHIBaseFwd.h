@@ -21,4 +21,6 @@ namespace Ion
 	class IRHIUniformBuffer;
 	class RHIUniformBuffer;
 	class RHIUniformBufferDynamic;
+	struct RHIUniformRingAllocation;
+	class RHIUniformRingBuffer;
 }
@@ -5,10 +5,12 @@
 #define RHI_BUILD_OPENGL (PLATFORM_SUPPORTS_OPENGL && ENABLE_OPENGL_RHI)
 #define RHI_BUILD_DX10   (PLATFORM_SUPPORTS_DX10   && ENABLE_D3D10_RHI)
 #define RHI_BUILD_DX11   (PLATFORM_SUPPORTS_DX11   && ENABLE_D3D11_RHI)
+// The Null RHI does not depend on the platform
+#define RHI_BUILD_NULL   (ENABLE_NULL_RHI)
 
-#if !PLATFORM_SUPPORTS_OPENGL && !PLATFORM_SUPPORTS_DX10 && !PLATFORM_SUPPORTS_DX11
+#if !PLATFORM_SUPPORTS_OPENGL && !PLATFORM_SUPPORTS_DX10 && !PLATFORM_SUPPORTS_DX11 && !RHI_BUILD_NULL
 #error None of the available RHIs is supported on this platform.
-#elif !RHI_BUILD_OPENGL && !RHI_BUILD_DX10 && !RHI_BUILD_DX11
+#elif !RHI_BUILD_OPENGL && !RHI_BUILD_DX10 && !RHI_BUILD_DX11 && !RHI_BUILD_NULL
 #error At least one supported RHI must be enabled.
 #endif
 
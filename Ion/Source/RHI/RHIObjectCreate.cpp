@@ -23,6 +23,11 @@
 #include "RHI/DX11/DX11Buffer.h"
 #include "RHI/DX11/DX11Shader.h"
 #endif
+#if RHI_BUILD_NULL
+#include "RHI/Null/NullTexture.h"
+#include "RHI/Null/NullBuffer.h"
+#include "RHI/Null/NullShader.h"
+#endif
 
 namespace Ion
 {
@@ -41,6 +46,10 @@ namespace Ion
 #if RHI_BUILD_DX11
 		case ERHI::DX11:
 			return MakeRef<DX11Texture>(desc);
+#endif
+#if RHI_BUILD_NULL
+		case ERHI::Null:
+			return MakeRef<NullTexture>(desc);
 #endif
 		default:
 			return nullptr;
@@ -63,6 +72,35 @@ namespace Ion
 #if RHI_BUILD_DX11
 		case ERHI::DX11:
 			return MakeRef<DX11VertexBuffer>(vertexAttributes, count);
+#endif
+#if RHI_BUILD_NULL
+		case ERHI::Null:
+			return MakeRef<NullVertexBuffer>(vertexAttributes, count);
+#endif
+		default:
+			return nullptr;
+		}
+	}
+
+	TRef<RHIVertexBuffer> RHIVertexBuffer::CreateDynamic(uint64 size)
+	{
+		switch (RHI::GetCurrent())
+		{
+#if RHI_BUILD_OPENGL
+		case ERHI::OpenGL:
+			return MakeRef<OpenGLVertexBuffer>(size);
+#endif
+#if RHI_BUILD_DX10
+		case ERHI::DX10:
+			return MakeRef<DX10VertexBuffer>(size);
+#endif
+#if RHI_BUILD_DX11
+		case ERHI::DX11:
+			return MakeRef<DX11VertexBuffer>(size);
+#endif
+#if RHI_BUILD_NULL
+		case ERHI::Null:
+			return MakeRef<NullVertexBuffer>(size);
 #endif
 		default:
 			return nullptr;
@@ -85,6 +123,10 @@ namespace Ion
 #if RHI_BUILD_DX11
 		case ERHI::DX11:
 			return MakeRef<DX11IndexBuffer>(indices, count);
+#endif
+#if RHI_BUILD_NULL
+		case ERHI::Null:
+			return MakeRef<NullIndexBuffer>(indices, count);
 #endif
 		default:
 			return nullptr;
@@ -107,6 +149,10 @@ namespace Ion
 #if RHI_BUILD_DX11
 		case ERHI::DX11:
 			return MakeRef<DX11UniformBuffer>(initialData, size);
+#endif
+#if RHI_BUILD_NULL
+		case ERHI::Null:
+			return MakeRef<NullUniformBuffer>(initialData, size);
 #endif
 		default:
 			return nullptr;
@@ -124,6 +170,33 @@ namespace Ion
 #if RHI_BUILD_DX11
 		case ERHI::DX11:
 			return MakeRef<DX11UniformBufferDynamic>(data, size, uniforms);
+#endif
+#if RHI_BUILD_NULL
+		case ERHI::Null:
+			return MakeRef<NullUniformBufferDynamic>(data, size, uniforms);
+#endif
+		default:
+			return nullptr;
+		}
+	}
+
+	TRef<RHIUniformRingBuffer> RHIUniformRingBuffer::Create(uint32 frameCapacity, uint32 framesInFlight)
+	{
+		ionassert(RHI::Get()->SupportsUniformRingBuffer());
+
+		switch (RHI::GetCurrent())
+		{
+#if RHI_BUILD_OPENGL
+		case ERHI::OpenGL:
+			return MakeRef<OpenGLUniformRingBuffer>(frameCapacity, framesInFlight);
+#endif
+#if RHI_BUILD_DX11
+		case ERHI::DX11:
+			return MakeRef<DX11UniformRingBuffer>(frameCapacity, framesInFlight);
+#endif
+#if RHI_BUILD_NULL
+		case ERHI::Null:
+			return MakeRef<NullUniformRingBuffer>(frameCapacity, framesInFlight);
 #endif
 		default:
 			return nullptr;
@@ -145,6 +218,10 @@ namespace Ion
 #if RHI_BUILD_DX11
 		case ERHI::DX11:
 			return MakeRef<DX11Shader>();
+#endif
+#if RHI_BUILD_NULL
+		case ERHI::Null:
+			return MakeRef<NullShader>();
 #endif
 		default:
 			return nullptr;
@@ -18,4 +18,14 @@ namespace Ion
 	{
 		RHILogger.Info("RHIShader \"TODO\" has been destroyed.");
 	}
+
+	Result<void, RHIError> RHIShader::GetBinary(TArray<uint8>& outBinary) const
+	{
+		ionthrow(RHIError, "The shader binaries are not supported by the current RHI.");
+	}
+
+	Result<void, RHIError> RHIShader::LoadBinary(const TArray<uint8>& binary)
+	{
+		ionthrow(RHIError, "The shader binaries are not supported by the current RHI.");
+	}
 }
@@ -16,6 +16,8 @@ namespace Ion
 	class ION_API RHIShader : public RefCountable
 	{
 	public:
+		ENGINE_ALLOCATED(EMemoryTag::Renderer)
+
 		static TRef<RHIShader> Create();
 
 		virtual ~RHIShader();
@@ -26,6 +28,21 @@ namespace Ion
 		virtual Result<void, RHIError, ShaderCompilationError> Compile() = 0;
 		virtual bool IsCompiled() = 0;
 
+		/**
+		 * @brief Checks if the compiled shader can be retrieved (GetBinary)
+		 * and created again later (LoadBinary), without compiling the sources.
+		 */
+		virtual bool SupportsBinary() const { return false; }
+
+		/* Retrieves the compiled shader code (the format is RHI specific). The shader must be compiled. */
+		virtual Result<void, RHIError> GetBinary(TArray<uint8>& outBinary) const;
+
+		/**
+		 * @brief Creates the shader from a binary retrieved by GetBinary, instead of compiling it.
+		 * Fails if the binary is not valid anymore (e.g. after a driver update).
+		 */
+		virtual Result<void, RHIError> LoadBinary(const TArray<uint8>& binary);
+
 		virtual void Bind() const = 0;
 		virtual void Unbind() const = 0;
 
@@ -50,6 +50,10 @@ namespace Ion
 		Float32,      // Single channel - Float
 		D24S8,        // Depth Stencil
 		UInt128GUID,  // GUID - For editor
+		BC1,          // Block compressed RGB (1-bit Alpha) - 8 bytes per 4x4 block
+		BC3,          // Block compressed RGBA - 16 bytes per 4x4 block
+		BC5,          // Block compressed RG (e.g. normal maps) - 16 bytes per 4x4 block
+		BC7,          // Block compressed RGBA, high quality - 16 bytes per 4x4 block
 	};
 
 	/** For MSAA multisampling */
@@ -91,6 +95,8 @@ namespace Ion
 		void* InitialData;
 		TextureDimensions Dimensions;
 		float LODBias;
+		/* Number of mip levels (0 - full chain, if bGenerateMips is set, or else 1) */
+		uint32 MipLevels;
 		union
 		{
 			uint32 Flags;
@@ -125,17 +131,92 @@ namespace Ion
 		{
 			return !(MultiSampling == ETextureMSMode::Default || MultiSampling == ETextureMSMode::X1);
 		}
+
+		inline uint32 GetMipLevelCount() const
+		{
+			if (MipLevels)
+				return MipLevels;
+
+			return bGenerateMips ? CalcMipLevelCount(Dimensions) : 1;
+		}
+
+		/* Number of mips in a full chain (down to 1x1) */
+		static inline uint32 CalcMipLevelCount(TextureDimensions dimensions)
+		{
+			uint32 size = std::max(dimensions.Width, dimensions.Height);
+			uint32 count = 1;
+			while (size > 1)
+			{
+				size >>= 1;
+				++count;
+			}
+			return count;
+		}
+
+		/* Dimensions of the specified mip level of a texture */
+		static inline TextureDimensions CalcMipDimensions(TextureDimensions dimensions, uint32 mipLevel)
+		{
+			return TextureDimensions {
+				std::max(dimensions.Width >> mipLevel, 1u),
+				std::max(dimensions.Height >> mipLevel, 1u)
+			};
+		}
+
+		/* The block compressed formats are stored in 4x4 pixel blocks */
+		static inline constexpr bool IsBlockCompressed(ETextureFormat format)
+		{
+			return
+				format == ETextureFormat::BC1 ||
+				format == ETextureFormat::BC3 ||
+				format == ETextureFormat::BC5 ||
+				format == ETextureFormat::BC7;
+		}
+
+		/* Size of a 4x4 block of a block compressed format in bytes */
+		static inline constexpr uint32 GetBlockSize(ETextureFormat format)
+		{
+			return format == ETextureFormat::BC1 ? 8 : 16;
+		}
+
+		/**
+		 * @brief Size of a single row of a mip level in bytes.
+		 * For a block compressed format, it's a row of 4x4 blocks.
+		 * Only RGBA8 and the block compressed formats are supported.
+		 */
+		static inline uint32 CalcMipLineSize(ETextureFormat format, uint32 width)
+		{
+			if (IsBlockCompressed(format))
+				return ((width + 3) / 4) * GetBlockSize(format);
+
+			ionassert(format == ETextureFormat::RGBA8);
+			return width * 4;
+		}
+
+		/* Number of rows of a mip level (rows of 4x4 blocks for a block compressed format) */
+		static inline uint32 CalcMipLineCount(ETextureFormat format, uint32 height)
+		{
+			return IsBlockCompressed(format) ? (height + 3) / 4 : height;
+		}
 	};
 
 	class ION_API RHITexture : public RefCountable
 	{
 	public:
+		ENGINE_ALLOCATED(EMemoryTag::Renderer)
+
 		static TRef<RHITexture> Create(const TextureDescription& desc);
 
 		virtual ~RHITexture();
 
 		virtual Result<void, RHIError> SetDimensions(TextureDimensions dimensions) = 0;
 		virtual Result<void, RHIError> UpdateSubresource(Image* image) = 0;
+		/**
+		 * @brief Uploads the pixels of a single mip level.
+		 * The mips are not generated, even if bGenerateMips is set.
+		 *
+		 * @param lineSize Size of a single row of pixels in bytes
+		 */
+		virtual Result<void, RHIError> UpdateSubresource(uint32 mipLevel, const void* pixelData, uint32 lineSize) = 0;
 
 		virtual Result<void, RHIError> Bind(uint32 slot = 0) const = 0;
 		virtual Result<void, RHIError> Unbind() const = 0;
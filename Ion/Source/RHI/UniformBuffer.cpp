@@ -76,4 +76,40 @@ namespace Ion
 	{
 		RHILogger.Info("RHIUniformBufferDynamic \"TODO\" has been destroyed.");
 	}
+
+	RHIUniformRingBuffer::RHIUniformRingBuffer(uint32 frameCapacity, uint32 framesInFlight) :
+		m_Data(nullptr),
+		m_FrameCapacity((uint32)AlignAs(frameCapacity, Alignment)),
+		m_FramesInFlight(framesInFlight),
+		m_FrameIndex(0),
+		m_FrameOffset(0),
+		m_FlushedOffset(0)
+	{
+		ionassert(frameCapacity);
+		ionassert(framesInFlight);
+		ionassert((uint64)m_FrameCapacity * framesInFlight <= std::numeric_limits<uint32>::max());
+	}
+
+	RHIUniformRingBuffer::~RHIUniformRingBuffer()
+	{
+	}
+
+	void RHIUniformRingBuffer::GetUnflushedRange(uint32& outOffset, uint32& outSize) const
+	{
+		uint32 end = GetFrameBytesUploaded();
+		outOffset = m_FrameIndex * m_FrameCapacity + m_FlushedOffset;
+		outSize = end > m_FlushedOffset ? end - m_FlushedOffset : 0;
+	}
+
+	void RHIUniformRingBuffer::OnFlushed()
+	{
+		m_FlushedOffset = GetFrameBytesUploaded();
+	}
+
+	void RHIUniformRingBuffer::AdvanceFrame()
+	{
+		m_FrameIndex = (m_FrameIndex + 1) % m_FramesInFlight;
+		m_FrameOffset = 0;
+		m_FlushedOffset = 0;
+	}
 }
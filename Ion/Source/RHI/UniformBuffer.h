@@ -153,16 +153,19 @@ template<> constexpr EUniformType TTypeToUniformTypeV<type> = EUniformType::name
 	protected:
 		/**
 		 * Copy the constants data from the CPU to the GPU.
-		 * Accessible in Material
+		 * Accessible in Material and MaterialInstance
 		 */
 		virtual Result<void, RHIError> UpdateData() const = 0;
 
 		friend class Material;
+		friend class MaterialInstance;
 	};
 
 	class ION_API RHIUniformBuffer : public RefCountable, public IRHIUniformBuffer
 	{
 	public:
+		ENGINE_ALLOCATED(EMemoryTag::Renderer)
+
 		static TRef<RHIUniformBuffer> Create(void* initialData, size_t size);
 
 		/* Creates a UniformBuffer with specified struct data. */
@@ -214,6 +217,8 @@ template<> constexpr EUniformType TTypeToUniformTypeV<type> = EUniformType::name
 	class ION_API RHIUniformBufferDynamic : public RefCountable, public IRHIUniformBuffer
 	{
 	public:
+		ENGINE_ALLOCATED(EMemoryTag::Renderer)
+
 		static TRef<RHIUniformBufferDynamic> Create(void* initialData, size_t size, const UniformDataMap& uniforms);
 
 		const UniformDataMap& GetUniformDataMap() const;
@@ -223,6 +228,14 @@ template<> constexpr EUniformType TTypeToUniformTypeV<type> = EUniformType::name
 
 		virtual const UniformData* GetUniformData(const String& name) const = 0;
 
+		/**
+		 * @brief Replaces the whole CPU side data with a block laid out
+		 * by the uniform offsets (see UniformData::Offset) in a single copy.
+		 * 
+		 * @param size Must not exceed the buffer size
+		 */
+		virtual void SetData(const void* data, size_t size) = 0;
+
 		bool HasUniform(const String& name) const;
 
 		virtual ~RHIUniformBufferDynamic();
@@ -262,4 +275,114 @@ template<> constexpr EUniformType TTypeToUniformTypeV<type> = EUniformType::name
 	{
 		return m_UniformDataMap.find(name) != m_UniformDataMap.end();
 	}
+
+	/**
+	 * @brief Part of the uniform ring buffer, allocated for a single use in the current frame.
+	 */
+	struct RHIUniformRingAllocation
+	{
+		/* CPU address to write the uniforms to (null if the ring is full) */
+		void* Data = nullptr;
+		/* Offset in bytes from the start of the ring */
+		uint32 Offset = 0;
+		uint32 Size = 0;
+
+		bool IsValid() const { return Data != nullptr; }
+	};
+
+	/**
+	 * @brief A single uniform buffer, that is suballocated for the transient
+	 * uniforms of a frame (e.g. per-draw constants). The allocations are bound by offset.
+	 *
+	 * @details The ring is split into a part per frame in flight.
+	 * BeginFrame waits until the GPU has finished the frame that used the part
+	 * that is going to be reused, EndFrame fences the current part.
+	 * The allocations are written by the CPU directly (Allocate is thread-safe),
+	 * and Flush makes the written data visible to the GPU - call it before the draws.
+	 *
+	 * Requires RHI::SupportsUniformRingBuffer.
+	 */
+	class ION_API RHIUniformRingBuffer : public RefCountable
+	{
+	public:
+		ENGINE_ALLOCATED(EMemoryTag::Renderer)
+
+		/* Required alignment of the constant buffer offsets (DX11.1 - 16 constants) */
+		static constexpr uint32 Alignment = 256;
+		static constexpr uint32 DefaultFramesInFlight = 3;
+
+		/**
+		 * @param frameCapacity Number of bytes that can be allocated in a single frame
+		 */
+		static TRef<RHIUniformRingBuffer> Create(uint32 frameCapacity, uint32 framesInFlight = DefaultFramesInFlight);
+
+		virtual ~RHIUniformRingBuffer();
+
+		/* Moves to the next part of the ring (waits for the GPU if it's still in use). */
+		virtual Result<void, RHIError> BeginFrame() = 0;
+		/* Fences the part of the ring used in the current frame. */
+		virtual Result<void, RHIError> EndFrame() = 0;
+
+		/**
+		 * @brief Allocates the memory in the current frame part of the ring.
+		 * Can be called from any thread. The allocation is invalid if the frame part is full.
+		 */
+		RHIUniformRingAllocation Allocate(uint32 size);
+
+		/* Uploads the data allocated since the last flush. */
+		virtual Result<void, RHIError> Flush() = 0;
+
+		/* Only the offset and the size of the allocation are used. */
+		virtual Result<void, RHIError> Bind(const RHIUniformRingAllocation& allocation, uint32 slot) const = 0;
+
+		/* Number of bytes allocated in the current frame */
+		uint32 GetFrameBytesUploaded() const;
+		uint32 GetFrameCapacity() const;
+
+	protected:
+		RHIUniformRingBuffer(uint32 frameCapacity, uint32 framesInFlight);
+
+		/* Range of the current frame part, that has been allocated, but not flushed yet. */
+		void GetUnflushedRange(uint32& outOffset, uint32& outSize) const;
+		void OnFlushed();
+		void AdvanceFrame();
+
+	protected:
+		/* CPU memory of the whole ring - persistently mapped or a staging copy. Set by the implementation. */
+		uint8* m_Data;
+		uint32 m_FrameCapacity;
+		uint32 m_FramesInFlight;
+		uint32 m_FrameIndex;
+		TAtomic<uint32> m_FrameOffset;
+		uint32 m_FlushedOffset;
+	};
+
+	inline RHIUniformRingAllocation RHIUniformRingBuffer::Allocate(uint32 size)
+	{
+		ionassert(m_Data);
+		ionassert(size);
+
+		uint32 alignedSize = (uint32)AlignAs(size, Alignment);
+		uint32 frameOffset = m_FrameOffset.fetch_add(alignedSize, std::memory_order_relaxed);
+		if (frameOffset + alignedSize > m_FrameCapacity)
+			return RHIUniformRingAllocation();
+
+		uint32 offset = m_FrameIndex * m_FrameCapacity + frameOffset;
+
+		RHIUniformRingAllocation allocation;
+		allocation.Data = m_Data + offset;
+		allocation.Offset = offset;
+		allocation.Size = size;
+		return allocation;
+	}
+
+	inline uint32 RHIUniformRingBuffer::GetFrameBytesUploaded() const
+	{
+		return std::min(m_FrameOffset.load(std::memory_order_relaxed), m_FrameCapacity);
+	}
+
+	inline uint32 RHIUniformRingBuffer::GetFrameCapacity() const
+	{
+		return m_FrameCapacity;
+	}
 }
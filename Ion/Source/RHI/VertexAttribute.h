@@ -22,6 +22,21 @@ namespace Ion
 		Position,
 		Normal,
 		TexCoord,
+		/* Per-instance model matrix, as 4 float4 columns */
+		InstanceTransform,
+		/* Per-instance normal matrix, as 4 float4 columns */
+		InstanceInverseTranspose,
+	};
+
+	/**
+	 * @brief How often the attributes of a vertex stream advance.
+	 */
+	enum class EVertexInputRate : uint8
+	{
+		/* Once per vertex (the mesh data) */
+		Vertex = 0,
+		/* Once per instance (e.g. the instance transforms) */
+		Instance,
 	};
 
 	struct VertexAttribute
@@ -4,8 +4,9 @@
 
 namespace Ion
 {
-	RHIVertexLayout::RHIVertexLayout(uint32 initialAttributeCount)
-		: m_Offset(0)
+	RHIVertexLayout::RHIVertexLayout(uint32 initialAttributeCount, EVertexInputRate inputRate)
+		: m_Offset(0),
+		m_InputRate(inputRate)
 	{
 		m_Attributes.reserve(initialAttributeCount * sizeof(VertexAttribute));
 	}
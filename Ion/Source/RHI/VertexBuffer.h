@@ -11,13 +11,37 @@ namespace Ion
 	class ION_API RHIVertexBuffer : public RefCountable
 	{
 	public:
+		ENGINE_ALLOCATED(EMemoryTag::Renderer)
+
 		static TRef<RHIVertexBuffer> Create(float* vertexAttributes, uint64 count);
+		/**
+		 * @brief Creates a buffer that can be rewritten by the CPU every frame (e.g. an instance buffer).
+		 *
+		 * @param size Capacity in bytes
+		 */
+		static TRef<RHIVertexBuffer> CreateDynamic(uint64 size);
 
 		virtual ~RHIVertexBuffer();
 
 		virtual void SetLayout(const TRef<RHIVertexLayout>& layout) = 0;
 		virtual Result<void, RHIError> SetLayoutShader(const TRef<RHIShader>& shader) = 0;
 
+		/**
+		 * @brief Sets the per-instance layout, that can be bound together with this (per-vertex) buffer.
+		 * Creates an input layout for the (instanced) shader, with the vertex stream in slot 0
+		 * and the instance stream in slot 1.
+		 *
+		 * @param instanceLayout Layout with the EVertexInputRate::Instance input rate
+		 */
+		virtual Result<void, RHIError> SetInstanceLayoutShader(const TRef<RHIVertexLayout>& instanceLayout, const TRef<RHIShader>& shader) = 0;
+		virtual bool HasInstanceLayout() const = 0;
+
+		/**
+		 * @brief Overwrites the data of a dynamic buffer (see CreateDynamic).
+		 * The previous contents are discarded.
+		 */
+		virtual Result<void, RHIError> UpdateData(const void* data, uint64 size) = 0;
+
 		virtual uint32 GetVertexCount() const = 0;
 
 	protected:
@@ -25,6 +49,15 @@ namespace Ion
 
 		virtual Result<void, RHIError> Bind() const = 0;
 		virtual Result<void, RHIError> BindLayout() const = 0;
+		/* Binds the layout set with SetInstanceLayoutShader, instead of the per-vertex one. */
+		virtual Result<void, RHIError> BindInstanceLayout() const = 0;
+		/**
+		 * @brief Binds the buffer as the instance stream (slot 1).
+		 *
+		 * @param instanceLayout Layout of the instance data in the buffer
+		 * @param offset Offset in bytes of the first instance
+		 */
+		virtual Result<void, RHIError> BindInstances(const RHIVertexLayout& instanceLayout, uint64 offset) const = 0;
 		virtual Result<void, RHIError> Unbind() const = 0;
 
 		friend class Renderer;
@@ -5,17 +5,21 @@ namespace Ion
 	class ION_API RHIVertexLayout : public RefCountable
 	{
 	public:
-		RHIVertexLayout(uint32 initialAttributeCount);
+		ENGINE_ALLOCATED(EMemoryTag::Renderer)
+
+		RHIVertexLayout(uint32 initialAttributeCount, EVertexInputRate inputRate = EVertexInputRate::Vertex);
 
 		void AddAttribute(EVertexAttributeType attributeType, uint8 elementCount, bool bNormalized = false);
 		void AddAttribute(EVertexAttributeSemantic semantic, EVertexAttributeType attributeType, uint8 elementCount, bool bNormalized = false);
 
 		uint32 GetStride() const;
+		EVertexInputRate GetInputRate() const;
 		const TArray<VertexAttribute>& GetAttributes() const;
 		static constexpr uint64 GetSizeOfAttributeType(const EVertexAttributeType type);
 
 	private:
 		uint64 m_Offset;
+		EVertexInputRate m_InputRate;
 		TArray<VertexAttribute> m_Attributes;
 
 		friend class RHIVertexBuffer;
@@ -26,6 +30,11 @@ namespace Ion
 		return (uint32)m_Offset;
 	}
 
+	FORCEINLINE EVertexInputRate RHIVertexLayout::GetInputRate() const
+	{
+		return m_InputRate;
+	}
+
 	FORCEINLINE const TArray<VertexAttribute>& RHIVertexLayout::GetAttributes() const
 	{
 		return m_Attributes;
@@ -0,0 +1,25 @@
+#include "IonPCH.h"
+
+#include "CommandList.h"
+
+namespace Ion
+{
+	void RCommandList::UpdateUniformBuffer(const RHIUniformBuffer* uniformBuffer, const void* data, uint32 size)
+	{
+		ionassert(data);
+		ionassert(size);
+
+		uint32 offset = (uint32)m_Payload.size();
+		m_Payload.resize(offset + size);
+		memcpy(m_Payload.data() + offset, data, size);
+
+		Add(ERCommandType::UpdateUniformBuffer, uniformBuffer, offset, size);
+	}
+
+	void RCommandList::Reset()
+	{
+		m_Commands.clear();
+		m_Payload.clear();
+		m_State.Reset();
+	}
+}
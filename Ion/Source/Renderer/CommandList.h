@@ -0,0 +1,186 @@
+#pragma once
+
+#include "RendererCore.h"
+#include "DrawList.h"
+#include "RHI/UniformBuffer.h"
+
+namespace Ion
+{
+	enum class ERCommandType : uint8
+	{
+		BindShader,
+		BindMaterialInstance,
+		/* Binds the buffer with the per-vertex layout */
+		BindVertexBuffer,
+		/* Binds the buffer with the instanced layout (see RHIVertexBuffer::SetInstanceLayoutShader) */
+		BindVertexBufferInstanced,
+		/* Binds an instance buffer with the renderer instance layout */
+		BindInstances,
+		BindIndexBuffer,
+		/* Copies the recorded data to the uniform buffer and uploads it */
+		UpdateUniformBuffer,
+		BindUniformBuffer,
+		/* Binds a part of the uniform ring buffer */
+		BindUniformRing,
+		DrawIndexed,
+		DrawIndexedInstanced,
+	};
+
+	/**
+	 * @brief A recorded RHI call.
+	 */
+	struct RCommand
+	{
+		ERCommandType Type;
+		union
+		{
+			const RHIShader* Shader;
+			const MaterialInstance* MaterialInstance;
+			const RHIVertexBuffer* VertexBuffer;
+			const RHIIndexBuffer* IndexBuffer;
+			const RHIUniformBuffer* UniformBuffer;
+			const RHIUniformRingBuffer* UniformRing;
+		};
+		/* Slot / index count / byte offset of the instances / payload or ring offset */
+		uint32 Arg0;
+		/* Instance count / payload or ring allocation size */
+		uint32 Arg1;
+		/* Slot of the ring allocation */
+		uint32 Arg2;
+	};
+
+	/**
+	 * @brief RHI calls recorded for a later execution (see Renderer::ExecuteCommandList).
+	 *
+	 * @details Recording does not touch the RHI, so a separate list can be
+	 * recorded on each worker thread. The lists are then executed in order
+	 * on the thread that owns the RHI context.
+	 * The objects referenced by the commands must stay alive until the list is executed.
+	 */
+	class ION_API RCommandList
+	{
+	public:
+		void BindShader(const RHIShader* shader);
+		void BindMaterialInstance(const MaterialInstance* materialInstance);
+		void BindVertexBuffer(const RHIVertexBuffer* vertexBuffer);
+		void BindVertexBufferInstanced(const RHIVertexBuffer* vertexBuffer);
+		/**
+		 * @param instanceBuffer Dynamic buffer with the RInstanceData
+		 * @param offset Offset in bytes of the first instance
+		 */
+		void BindInstances(const RHIVertexBuffer* instanceBuffer, uint32 offset);
+		void BindIndexBuffer(const RHIIndexBuffer* indexBuffer);
+		/* The data is copied into the list. */
+		void UpdateUniformBuffer(const RHIUniformBuffer* uniformBuffer, const void* data, uint32 size);
+		void BindUniformBuffer(const RHIUniformBuffer* uniformBuffer, uint32 slot);
+		/* The allocation has to be written before the list is executed. */
+		void BindUniformRing(const RHIUniformRingBuffer* uniformRing, const RHIUniformRingAllocation& allocation, uint32 slot);
+		void DrawIndexed(uint32 indexCount);
+		void DrawIndexedInstanced(uint32 indexCount, uint32 instanceCount);
+
+		/* Clears the commands and the bind state, but keeps the memory. */
+		void Reset();
+
+		const TArray<RCommand>& GetCommands() const;
+		const void* GetPayload(uint32 offset) const;
+		bool IsEmpty() const;
+
+		/* State of the binds recorded so far, used to skip the redundant ones. */
+		RDrawState& GetState();
+		const RDrawState& GetState() const;
+
+	private:
+		void Add(ERCommandType type, const void* object, uint32 arg0 = 0, uint32 arg1 = 0, uint32 arg2 = 0);
+
+	private:
+		TArray<RCommand> m_Commands;
+		TArray<uint8> m_Payload;
+		RDrawState m_State;
+	};
+
+	inline void RCommandList::BindShader(const RHIShader* shader)
+	{
+		Add(ERCommandType::BindShader, shader);
+	}
+
+	inline void RCommandList::BindMaterialInstance(const MaterialInstance* materialInstance)
+	{
+		Add(ERCommandType::BindMaterialInstance, materialInstance);
+	}
+
+	inline void RCommandList::BindVertexBuffer(const RHIVertexBuffer* vertexBuffer)
+	{
+		Add(ERCommandType::BindVertexBuffer, vertexBuffer);
+	}
+
+	inline void RCommandList::BindVertexBufferInstanced(const RHIVertexBuffer* vertexBuffer)
+	{
+		Add(ERCommandType::BindVertexBufferInstanced, vertexBuffer);
+	}
+
+	inline void RCommandList::BindInstances(const RHIVertexBuffer* instanceBuffer, uint32 offset)
+	{
+		Add(ERCommandType::BindInstances, instanceBuffer, offset);
+	}
+
+	inline void RCommandList::BindIndexBuffer(const RHIIndexBuffer* indexBuffer)
+	{
+		Add(ERCommandType::BindIndexBuffer, indexBuffer);
+	}
+
+	inline void RCommandList::BindUniformBuffer(const RHIUniformBuffer* uniformBuffer, uint32 slot)
+	{
+		Add(ERCommandType::BindUniformBuffer, uniformBuffer, slot);
+	}
+
+	inline void RCommandList::BindUniformRing(const RHIUniformRingBuffer* uniformRing, const RHIUniformRingAllocation& allocation, uint32 slot)
+	{
+		Add(ERCommandType::BindUniformRing, uniformRing, allocation.Offset, allocation.Size, slot);
+	}
+
+	inline void RCommandList::DrawIndexed(uint32 indexCount)
+	{
+		Add(ERCommandType::DrawIndexed, nullptr, indexCount);
+	}
+
+	inline void RCommandList::DrawIndexedInstanced(uint32 indexCount, uint32 instanceCount)
+	{
+		Add(ERCommandType::DrawIndexedInstanced, nullptr, indexCount, instanceCount);
+	}
+
+	inline const TArray<RCommand>& RCommandList::GetCommands() const
+	{
+		return m_Commands;
+	}
+
+	inline const void* RCommandList::GetPayload(uint32 offset) const
+	{
+		ionassert(offset < m_Payload.size());
+		return m_Payload.data() + offset;
+	}
+
+	inline bool RCommandList::IsEmpty() const
+	{
+		return m_Commands.empty();
+	}
+
+	inline RDrawState& RCommandList::GetState()
+	{
+		return m_State;
+	}
+
+	inline const RDrawState& RCommandList::GetState() const
+	{
+		return m_State;
+	}
+
+	inline void RCommandList::Add(ERCommandType type, const void* object, uint32 arg0, uint32 arg1, uint32 arg2)
+	{
+		RCommand& command = m_Commands.emplace_back();
+		command.Type = type;
+		command.Shader = (const RHIShader*)object;
+		command.Arg0 = arg0;
+		command.Arg1 = arg1;
+		command.Arg2 = arg2;
+	}
+}
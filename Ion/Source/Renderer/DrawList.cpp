@@ -0,0 +1,99 @@
+#include "IonPCH.h"
+
+#include "DrawList.h"
+#include "Camera.h"
+
+namespace Ion
+{
+	/* Reduces a pointer to 16 bits. Collisions only make the order less optimal,
+	   the redundant binds are detected by comparing the actual pointers. */
+	static uint64 HashPointer16(const void* ptr)
+	{
+		uint64 value = (uint64)ptr;
+		value ^= value >> 33;
+		value *= 0xff51afd7ed558ccdull;
+		value ^= value >> 33;
+		return value & 0xFFFF;
+	}
+
+	/* The bit pattern of a non-negative float grows with its value,
+	   so the highest 16 bits are a logarithmically quantized depth. */
+	static uint64 QuantizeDepth16(float depth)
+	{
+		depth = std::max(depth, 0.0f);
+		uint32 bits;
+		memcpy(&bits, &depth, sizeof(bits));
+		return bits >> 16;
+	}
+
+	uint64 RDrawList::MakeSortKey(const RHIShader* shader, const MaterialInstance* materialInstance, const RHIVertexBuffer* vertexBuffer, float depth)
+	{
+		return
+			HashPointer16(shader)           << 48 |
+			HashPointer16(materialInstance) << 32 |
+			HashPointer16(vertexBuffer)     << 16 |
+			QuantizeDepth16(depth);
+	}
+
+	void RDrawList::Build(const TArray<RPrimitiveRenderProxy>& primitives, const TArray<uint32>& primitiveIndices, const RCameraRenderProxy& camera)
+	{
+		TRACE_FUNCTION();
+
+		m_Commands.resize(primitiveIndices.size());
+
+		for (size_t i = 0; i < primitiveIndices.size(); ++i)
+		{
+			uint32 index = primitiveIndices[i];
+			const RPrimitiveRenderProxy& primitive = primitives[index];
+
+			Vector3 location = primitive.Bounds.IsValid() ? primitive.Bounds.GetCenter() : Vector3(primitive.Transform[3]);
+			float depth = glm::dot(location - camera.Location, camera.Forward);
+
+			RDrawCommand& command = m_Commands[i];
+			command.SortKey = MakeSortKey(primitive.Shader, primitive.MaterialInstance, primitive.VertexBuffer, depth);
+			command.PrimitiveIndex = index;
+		}
+	}
+
+	void RDrawList::Sort()
+	{
+		TRACE_FUNCTION();
+
+		std::sort(m_Commands.begin(), m_Commands.end(), [](const RDrawCommand& a, const RDrawCommand& b)
+		{
+			// Keep the order deterministic
+			return a.SortKey != b.SortKey ? a.SortKey < b.SortKey : a.PrimitiveIndex < b.PrimitiveIndex;
+		});
+	}
+
+	void RDrawList::BuildBatches(const TArray<RPrimitiveRenderProxy>& primitives)
+	{
+		TRACE_FUNCTION();
+
+		m_Batches.clear();
+
+		uint32 commandCount = (uint32)m_Commands.size();
+		uint32 first = 0;
+		while (first < commandCount)
+		{
+			const RPrimitiveRenderProxy& firstPrimitive = primitives[m_Commands[first].PrimitiveIndex];
+
+			uint32 end = first + 1;
+			while (end < commandCount)
+			{
+				const RPrimitiveRenderProxy& primitive = primitives[m_Commands[end].PrimitiveIndex];
+				if (primitive.VertexBuffer != firstPrimitive.VertexBuffer ||
+					primitive.IndexBuffer != firstPrimitive.IndexBuffer ||
+					primitive.MaterialInstance != firstPrimitive.MaterialInstance ||
+					primitive.Shader != firstPrimitive.Shader)
+				{
+					break;
+				}
+				++end;
+			}
+
+			m_Batches.push_back(RDrawBatch { first, end - first });
+			first = end;
+		}
+	}
+}
@@ -0,0 +1,139 @@
+#pragma once
+
+#include "RendererCore.h"
+
+namespace Ion
+{
+	/**
+	 * @brief A single draw of a scene primitive.
+	 *
+	 * @details The sort key is built from (most significant first):
+	 * shader (16 bits), material instance (16 bits), vertex buffer (16 bits), view depth (16 bits).
+	 * So the draws that share the state end up next to each other,
+	 * and the draws with the same state are sorted front to back.
+	 */
+	struct RDrawCommand
+	{
+		uint64 SortKey;
+		uint32 PrimitiveIndex;
+	};
+
+	/**
+	 * @brief Consecutive draw commands of the same mesh, with the same material instance.
+	 * Such commands can be submitted as a single instanced draw.
+	 */
+	struct RDrawBatch
+	{
+		uint32 FirstCommand;
+		uint32 CommandCount;
+	};
+
+	/**
+	 * @brief Per-instance data of an instanced draw.
+	 * Matches the instance vertex layout (see Renderer::GetInstanceVertexLayout).
+	 */
+	struct RInstanceData
+	{
+		Matrix4 Transform;
+		Matrix4 InverseTranspose;
+	};
+
+	/**
+	 * @brief State changes done (and avoided) while submitting the draws in a frame.
+	 */
+	struct RDrawStats
+	{
+		uint32 DrawCalls = 0;
+		uint32 StateChanges = 0;
+		uint32 StateChangesAvoided = 0;
+		uint32 InstancedDrawCalls = 0;
+		uint32 Instances = 0;
+
+		RDrawStats& operator+=(const RDrawStats& other)
+		{
+			DrawCalls += other.DrawCalls;
+			StateChanges += other.StateChanges;
+			StateChangesAvoided += other.StateChangesAvoided;
+			InstancedDrawCalls += other.InstancedDrawCalls;
+			Instances += other.Instances;
+			return *this;
+		}
+	};
+
+	/**
+	 * @brief Bound pipeline state, used to skip the redundant binds.
+	 *
+	 * @details Only valid for a sequence of draws submitted with the same state object.
+	 * Anything bound outside of it has to reset the state (Reset).
+	 */
+	struct RDrawState
+	{
+		const RHIShader* Shader = nullptr;
+		const MaterialInstance* MaterialInstance = nullptr;
+		const RHIVertexBuffer* VertexBuffer = nullptr;
+		const RHIIndexBuffer* IndexBuffer = nullptr;
+
+		RDrawStats Stats;
+
+		void Reset()
+		{
+			*this = RDrawState();
+		}
+	};
+
+	/**
+	 * @brief Scene primitive draws, sorted to minimize the state changes.
+	 */
+	class ION_API RDrawList
+	{
+	public:
+		/**
+		 * @brief Creates the draw commands for the primitives.
+		 *
+		 * @param primitiveIndices Indices of the primitives to draw (e.g. the visible ones)
+		 */
+		void Build(const TArray<RPrimitiveRenderProxy>& primitives, const TArray<uint32>& primitiveIndices, const RCameraRenderProxy& camera);
+
+		/* Sorts the commands by the sort keys. */
+		void Sort();
+
+		/**
+		 * @brief Groups the consecutive commands that draw the same vertex and index buffers
+		 * with the same material instance. Call it after Sort.
+		 */
+		void BuildBatches(const TArray<RPrimitiveRenderProxy>& primitives);
+
+		void Clear();
+
+		const TArray<RDrawCommand>& GetCommands() const;
+		const TArray<RDrawBatch>& GetBatches() const;
+		size_t GetCount() const;
+
+		static uint64 MakeSortKey(const RHIShader* shader, const MaterialInstance* materialInstance, const RHIVertexBuffer* vertexBuffer, float depth);
+
+	private:
+		TArray<RDrawCommand> m_Commands;
+		TArray<RDrawBatch> m_Batches;
+	};
+
+	inline void RDrawList::Clear()
+	{
+		m_Commands.clear();
+		m_Batches.clear();
+	}
+
+	inline const TArray<RDrawCommand>& RDrawList::GetCommands() const
+	{
+		return m_Commands;
+	}
+
+	inline const TArray<RDrawBatch>& RDrawList::GetBatches() const
+	{
+		return m_Batches;
+	}
+
+	inline size_t RDrawList::GetCount() const
+	{
+		return m_Commands.size();
+	}
+}
@@ -4,6 +4,7 @@
 #include "RHI/UniformBuffer.h"
 #include "Resource/TextureResource.h"
 #include "Renderer/Renderer.h"
+#include "RHI/RHI.h"
 
 namespace Ion
 {
@@ -26,6 +27,7 @@ namespace Ion
 			{
 				mesh->SetVertexBuffer(resource->GetRenderData().VertexBuffer);
 				mesh->SetIndexBuffer(resource->GetRenderData().IndexBuffer);
+				mesh->SetBounds(resource->GetRenderData().Bounds, resource->GetRenderData().Sphere);
 			}
 		});
 
@@ -51,6 +53,7 @@ namespace Ion
 		m_VertexCount(0),
 		m_TriangleCount(0),
 		m_UniformBuffer(RHIUniformBuffer::Create<MeshUniforms>()),
+		m_Bounds(AABB::Invalid()),
 		m_MaterialSlots(1, MaterialSlot())
 	{
 	}
@@ -86,9 +89,9 @@ namespace Ion
 		// @TODO: Handle each material slot in the future
 		std::shared_ptr<MaterialInstance> instance = m_MaterialSlots.at(0).MaterialInstance;
 		// @TODO: This checking for compiled shit is really wrong, there should be a system that does this automatically
-		if (instance && instance->GetBaseMaterial()->IsCompiled(EShaderUsage::StaticMesh))
+		if (instance)
 		{
-			m_VertexBuffer->SetLayoutShader(instance->GetBaseMaterial()->GetShader(EShaderUsage::StaticMesh));
+			SetLayoutShaders(*instance->GetBaseMaterial());
 		}
 	}
 
@@ -98,6 +101,12 @@ namespace Ion
 		m_TriangleCount = indexBuffer->GetTriangleCount();
 	}
 
+	void Mesh::SetBounds(const AABB& bounds, const BoundingSphere& sphere)
+	{
+		m_Bounds = bounds;
+		m_BoundingSphere = sphere;
+	}
+
 	const TRef<RHIVertexBuffer>& Mesh::GetVertexBuffer() const
 	{
 		return m_VertexBuffer;
@@ -122,7 +131,7 @@ namespace Ion
 			{
 				if (m_VertexBuffer)
 				{
-					m_VertexBuffer->SetLayoutShader(material->GetBaseMaterial()->GetShader(EShaderUsage::StaticMesh));
+					SetLayoutShaders(*material->GetBaseMaterial());
 				}
 			};
 
@@ -130,6 +139,11 @@ namespace Ion
 			if (!baseMaterial->IsUsableWith(EShaderUsage::StaticMesh))
 			{
 				baseMaterial->AddUsage(EShaderUsage::StaticMesh);
+				// All the permutations have to be added before the compilation.
+				if (RHI::Get()->SupportsInstancing())
+				{
+					baseMaterial->AddUsage(EShaderUsage::StaticMeshInstanced);
+				}
 				baseMaterial->CompileShaders([setLayoutShader](const ShaderPermutation& shader)
 				{
 					setLayoutShader();
@@ -145,6 +159,20 @@ namespace Ion
 		slot.MaterialInstance = material;
 	}
 
+	void Mesh::SetLayoutShaders(const Material& material)
+	{
+		ionassert(m_VertexBuffer);
+
+		if (material.IsCompiled(EShaderUsage::StaticMesh))
+		{
+			m_VertexBuffer->SetLayoutShader(material.GetShader(EShaderUsage::StaticMesh));
+		}
+		if (material.IsCompiled(EShaderUsage::StaticMeshInstanced))
+		{
+			m_VertexBuffer->SetInstanceLayoutShader(Renderer::GetInstanceVertexLayout(), material.GetShader(EShaderUsage::StaticMeshInstanced));
+		}
+	}
+
 	std::shared_ptr<MaterialInstance> Mesh::GetMaterialInSlot(uint16 index) const
 	{
 		ionassert(index < m_MaterialSlots.size(), "Slot {0} does not exist.", index);
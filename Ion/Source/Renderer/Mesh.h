@@ -54,8 +54,15 @@ namespace Ion
 		const TRef<RHIVertexBuffer>& GetVertexBuffer() const;
 		const TRef<RHIIndexBuffer>& GetIndexBuffer() const;
 
+		/* Sets the local space bounds of the mesh. The mesh is not culled if the bounds are invalid. */
+		void SetBounds(const AABB& bounds, const BoundingSphere& sphere);
+		const AABB& GetBounds() const;
+		const BoundingSphere& GetBoundingSphere() const;
+
 		void AssignMaterialToSlot(uint16 index, const std::shared_ptr<MaterialInstance>& material);
 		std::shared_ptr<MaterialInstance> GetMaterialInSlot(uint16 slot) const;
+		/* Doesn't copy the shared pointer. Returns nullptr if the slot doesn't exist. */
+		MaterialInstance* GetMaterialInSlotRaw(uint16 slot) const;
 
 		MeshUniforms& GetUniformsData();
 
@@ -70,6 +77,9 @@ namespace Ion
 	private:
 		Mesh();
 
+		/* Creates the vertex buffer input layouts for the compiled material shaders. */
+		void SetLayoutShaders(const Material& material);
+
 	private:
 		TArray<MaterialSlot> m_MaterialSlots;
 
@@ -81,10 +91,28 @@ namespace Ion
 
 		TSharedPtr<TextureResource> m_Texture;
 
+		AABB m_Bounds;
+		BoundingSphere m_BoundingSphere;
+
 		uint32 m_VertexCount;
 		uint32 m_TriangleCount;
 	};
 
+	inline MaterialInstance* Mesh::GetMaterialInSlotRaw(uint16 slot) const
+	{
+		return slot < m_MaterialSlots.size() ? m_MaterialSlots[slot].MaterialInstance.get() : nullptr;
+	}
+
+	inline const AABB& Mesh::GetBounds() const
+	{
+		return m_Bounds;
+	}
+
+	inline const BoundingSphere& Mesh::GetBoundingSphere() const
+	{
+		return m_BoundingSphere;
+	}
+
 	inline const TSharedPtr<MeshResource>& Mesh::GetMeshResource() const
 	{
 		return m_MeshResource;
@@ -0,0 +1,230 @@
+#include "IonPCH.h"
+
+#include "RenderThread.h"
+#include "RHI/RHI.h"
+
+namespace Ion
+{
+	static Thread s_RenderThread;
+	static TAtomic<bool> s_bRunning = false;
+
+	static Mutex s_CommandsMutex;
+	static ConditionVariable s_CommandsCV;
+	static TQueue<TFuncRenderCommand> s_Commands;
+	static uint64 s_SubmittedCommandCount = 0;
+	static bool s_bExit = false;
+
+	static Mutex s_CompletionMutex;
+	static ConditionVariable s_CompletionCV;
+	static uint64 s_ExecutedCommandCount = 0;
+
+	static TAtomic<uint64> s_GameFrameIndex = 0;
+	static TAtomic<uint64> s_RenderedFrameCount = 0;
+	static TAtomic<uint32> s_FrameLag = 1;
+
+	/* Frame the render thread is rendering (only accessed on the render thread). */
+	static uint64 s_RenderFrameIndex = 0;
+
+	static thread_local bool t_bRenderThread = false;
+
+	void RenderThread::Start(uint32 frameLag)
+	{
+		TRACE_FUNCTION();
+
+		ionassert(!IsRunning(), "The render thread is already running.");
+		ionassert(RHI::Get()->SupportsRenderThread(), "The current RHI does not support the render thread.");
+
+		SetFrameLag(frameLag);
+
+		s_bExit = false;
+		s_RenderedFrameCount.store(s_GameFrameIndex.load());
+		s_bRunning.store(true);
+
+		s_RenderThread = Thread(&RenderThread::RenderThreadProc);
+
+		RenderThreadLogger.Info("Render thread has been started (frame lag: {}).", GetFrameLag());
+	}
+
+	void RenderThread::Stop()
+	{
+		TRACE_FUNCTION();
+
+		if (!IsRunning())
+			return;
+
+		{
+			UniqueLock lock(s_CommandsMutex);
+			s_bExit = true;
+		}
+		s_CommandsCV.notify_one();
+
+		// The thread executes the remaining commands before exiting.
+		s_RenderThread.join();
+		s_bRunning.store(false);
+
+		RenderThreadLogger.Info("Render thread has been stopped.");
+	}
+
+	bool RenderThread::IsRunning()
+	{
+		return s_bRunning.load(std::memory_order_acquire);
+	}
+
+	bool RenderThread::IsInRenderThread()
+	{
+		return t_bRenderThread;
+	}
+
+	void RenderThread::EnqueueCommand(TFuncRenderCommand&& command)
+	{
+		ionassert(command);
+
+		if (!IsRunning() || IsInRenderThread())
+		{
+			command();
+			return;
+		}
+
+		{
+			UniqueLock lock(s_CommandsMutex);
+			s_Commands.emplace(Move(command));
+			++s_SubmittedCommandCount;
+		}
+		s_CommandsCV.notify_one();
+	}
+
+	void RenderThread::SubmitFrame(TFuncRenderCommand&& renderFrame)
+	{
+		TRACE_FUNCTION();
+
+		ionassert(!IsInRenderThread());
+
+		uint64 frameIndex = s_GameFrameIndex.load(std::memory_order_relaxed);
+
+		if (!IsRunning())
+		{
+			renderFrame();
+			s_RenderedFrameCount.store(frameIndex + 1, std::memory_order_release);
+			s_GameFrameIndex.store(frameIndex + 1, std::memory_order_release);
+			return;
+		}
+
+		EnqueueCommand([frameIndex, renderFrame = Move(renderFrame)]
+		{
+			TRACE_SCOPE("RenderThread - Render Frame");
+
+			s_RenderFrameIndex = frameIndex;
+			renderFrame();
+			s_RenderedFrameCount.store(frameIndex + 1, std::memory_order_release);
+		});
+
+		// From now on, the game thread writes to the next frame data buffer.
+		s_GameFrameIndex.store(frameIndex + 1, std::memory_order_release);
+
+		// Don't let the render thread fall too far behind.
+		uint64 frameLag = GetFrameLag();
+		uint64 minRenderedFrameCount = frameIndex + 1 > frameLag ? frameIndex + 1 - frameLag : 0;
+		if (s_RenderedFrameCount.load(std::memory_order_acquire) < minRenderedFrameCount)
+		{
+			TRACE_SCOPE("RenderThread - Wait for Frame Lag");
+
+			UniqueLock lock(s_CompletionMutex);
+			s_CompletionCV.wait(lock, [minRenderedFrameCount]
+			{
+				return s_RenderedFrameCount.load(std::memory_order_acquire) >= minRenderedFrameCount;
+			});
+		}
+	}
+
+	void RenderThread::Flush()
+	{
+		TRACE_FUNCTION();
+
+		if (!IsRunning() || IsInRenderThread())
+			return;
+
+		uint64 submittedCommandCount;
+		{
+			UniqueLock lock(s_CommandsMutex);
+			submittedCommandCount = s_SubmittedCommandCount;
+		}
+
+		UniqueLock lock(s_CompletionMutex);
+		s_CompletionCV.wait(lock, [submittedCommandCount]
+		{
+			return s_ExecutedCommandCount >= submittedCommandCount;
+		});
+	}
+
+	void RenderThread::SetFrameLag(uint32 frameLag)
+	{
+		ionassert(frameLag <= MaxFrameLag, "The frame lag cannot be greater than {}.", MaxFrameLag);
+
+		s_FrameLag.store(std::min(frameLag, MaxFrameLag), std::memory_order_relaxed);
+	}
+
+	uint32 RenderThread::GetFrameLag()
+	{
+		return s_FrameLag.load(std::memory_order_relaxed);
+	}
+
+	uint64 RenderThread::GetGameFrameIndex()
+	{
+		return s_GameFrameIndex.load(std::memory_order_acquire);
+	}
+
+	uint64 RenderThread::GetRenderedFrameCount()
+	{
+		return s_RenderedFrameCount.load(std::memory_order_acquire);
+	}
+
+	uint32 RenderThread::GetCurrentFrameDataIndex()
+	{
+		uint64 frameIndex = IsInRenderThread() ? s_RenderFrameIndex : GetGameFrameIndex();
+		return GetFrameDataIndex(frameIndex);
+	}
+
+	uint32 RenderThread::GetFrameDataIndex(uint64 frameIndex)
+	{
+		return (uint32)(frameIndex % FrameDataBufferCount);
+	}
+
+	void RenderThread::RenderThreadProc()
+	{
+		t_bRenderThread = true;
+		Platform::SetCurrentThreadDescription(L"RenderThread");
+
+		// A game job picked up while waiting for a task would stall the frame.
+		TaskQueue::SetExecuteJobsWhileWaiting(false);
+
+		while (true)
+		{
+			TFuncRenderCommand command;
+			{
+				UniqueLock lock(s_CommandsMutex);
+				s_CommandsCV.wait(lock, []
+				{
+					return !s_Commands.empty() || s_bExit;
+				});
+
+				// Exit only after all the commands have been executed.
+				if (s_Commands.empty())
+					break;
+
+				command = Move(s_Commands.front());
+				s_Commands.pop();
+			}
+
+			command();
+
+			{
+				UniqueLock lock(s_CompletionMutex);
+				++s_ExecutedCommandCount;
+			}
+			s_CompletionCV.notify_all();
+		}
+
+		TaskQueue::SetExecuteJobsWhileWaiting(true);
+		t_bRenderThread = false;
+	}
+}
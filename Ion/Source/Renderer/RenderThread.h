@@ -0,0 +1,104 @@
+#pragma once
+
+#include "RendererCore.h"
+
+namespace Ion
+{
+	REGISTER_LOGGER(RenderThreadLogger, "Renderer::RenderThread");
+
+	using TFuncRenderCommand = TFunction<void()>;
+
+	/**
+	 * @brief Thread that executes the frames and commands submitted by the game thread.
+	 *
+	 * @details The game thread builds the render data of frame N+1, while
+	 * the render thread draws frame N. The render thread can be at most
+	 * FrameLag frames behind - SubmitFrame waits for it otherwise.
+	 * The render data that is used by both threads (e.g. the Scene render
+	 * proxies) has to be buffered with FrameDataBufferCount buffers,
+	 * indexed with GetCurrentFrameDataIndex.
+	 *
+	 * If the render thread is not running, the frames and commands are
+	 * executed immediately on the calling thread.
+	 */
+	class ION_API RenderThread
+	{
+	public:
+		/* Max number of frames the render thread can be behind the game thread. */
+		static constexpr uint32 MaxFrameLag = 2;
+		/* Number of buffers needed for the data shared by the game and render threads.
+		   The frames the render thread is behind, the submitted one, and the one
+		   the workers build ahead of the submission (see Application::SetupFrameGraph). */
+		static constexpr uint32 FrameDataBufferCount = MaxFrameLag + 2;
+
+		/**
+		 * @brief Start the render thread. The RHI has to support it.
+		 *
+		 * @param frameLag Max number of frames the render thread can be behind
+		 */
+		static void Start(uint32 frameLag);
+		/**
+		 * @brief Finish all the submitted frames and commands and stop the render thread.
+		 */
+		static void Stop();
+
+		static bool IsRunning();
+		/**
+		 * @brief Checks if the calling thread is the render thread.
+		 */
+		static bool IsInRenderThread();
+
+		/**
+		 * @brief Execute a command on the render thread, after the frames
+		 * and commands that have been submitted before it.
+		 */
+		static void EnqueueCommand(TFuncRenderCommand&& command);
+
+		/**
+		 * @brief Render the current game frame on the render thread
+		 * and advance the game frame index.
+		 *
+		 * @details Waits for the render thread if it is more than FrameLag frames behind.
+		 *
+		 * @param renderFrame Function that renders the frame
+		 */
+		static void SubmitFrame(TFuncRenderCommand&& renderFrame);
+
+		/**
+		 * @brief Wait until all the submitted frames and commands have been executed.
+		 */
+		static void Flush();
+
+		/**
+		 * @param frameLag 0 to MaxFrameLag (0 means that SubmitFrame waits for the frame to finish)
+		 */
+		static void SetFrameLag(uint32 frameLag);
+		static uint32 GetFrameLag();
+
+		/**
+		 * @brief Index of the frame the game thread is currently building.
+		 */
+		static uint64 GetGameFrameIndex();
+		/**
+		 * @brief Number of frames that have been rendered.
+		 */
+		static uint64 GetRenderedFrameCount();
+
+		/**
+		 * @brief Index of the frame data buffer that should be used on the calling thread.
+		 * The render thread uses the buffer of the frame it is rendering,
+		 * every other thread - the one of the frame the game thread is building.
+		 */
+		static uint32 GetCurrentFrameDataIndex();
+
+		/**
+		 * @brief Index of the frame data buffer of the specified frame.
+		 * Use it on the threads that work on a frame other than the one
+		 * implied by GetCurrentFrameDataIndex (e.g. the worker tasks).
+		 */
+		static uint32 GetFrameDataIndex(uint64 frameIndex);
+
+	private:
+		static void RenderThreadProc();
+	};
+}
@@ -12,9 +12,21 @@
 #if RHI_BUILD_DX11
 #include "RHI/DX11/DX11Renderer.h"
 #endif
+#if RHI_BUILD_NULL
+#include "RHI/Null/NullRenderer.h"
+#endif
 
 namespace Ion
 {
+	static DECLARE_VALUE_COUNTER(Renderer_VisiblePrimitives, "Renderer - Visible Primitives");
+	static DECLARE_VALUE_COUNTER(Renderer_CulledPrimitives, "Renderer - Culled Primitives");
+	static DECLARE_VALUE_COUNTER(Renderer_DrawCalls, "Renderer - Draw Calls");
+	static DECLARE_VALUE_COUNTER(Renderer_StateChanges, "Renderer - State Changes");
+	static DECLARE_VALUE_COUNTER(Renderer_StateChangesAvoided, "Renderer - State Changes Avoided");
+	static DECLARE_VALUE_COUNTER(Renderer_InstancedDrawCalls, "Renderer - Instanced Draw Calls");
+	static DECLARE_VALUE_COUNTER(Renderer_Instances, "Renderer - Instances");
+	static DECLARE_VALUE_COUNTER(Renderer_UniformRingBytes, "Renderer - Uniform Ring Bytes");
+
 	Renderer* Renderer::Create()
 	{
 		TRACE_FUNCTION();
@@ -41,6 +53,13 @@ namespace Ion
 			{
 #if RHI_BUILD_DX11
 				s_Instance = new DX11Renderer;
+#endif
+				break;
+			}
+			case ERHI::Null:
+			{
+#if RHI_BUILD_NULL
+				s_Instance = new NullRenderer;
 #endif
 				break;
 			}
@@ -57,9 +76,28 @@ namespace Ion
 	{
 		InitScreenTextureRendering();
 		InitShaders();
+		InitInstancing();
+		InitUniformRing();
 		InitUtilityPrimitives();
 	}
 
+	void Renderer::BeginFrame()
+	{
+		if (m_UniformRing)
+		{
+			m_UniformRing->BeginFrame().Unwrap();
+		}
+	}
+
+	void Renderer::EndFrame()
+	{
+		if (m_UniformRing)
+		{
+			SET_VALUE_COUNTER(Renderer_UniformRingBytes, m_UniformRing->GetFrameBytesUploaded());
+			m_UniformRing->EndFrame().Unwrap();
+		}
+	}
+
 	void Renderer::Clear() const
 	{
 		Clear(RendererClearOptions());
@@ -71,10 +109,11 @@ namespace Ion
 
 		// Set global matrices and other scene data
 		SceneUniforms& uniforms = scene->m_SceneUniformBuffer->Data<SceneUniforms>();
-		uniforms.ViewMatrix = scene->m_RenderCamera.ViewMatrix;
-		uniforms.ProjectionMatrix = scene->m_RenderCamera.ProjectionMatrix;
-		uniforms.ViewProjectionMatrix = scene->m_RenderCamera.ViewProjectionMatrix;
-		uniforms.CameraLocation = scene->m_RenderCamera.Location;
+		const RCameraRenderProxy& camera = scene->GetCameraRenderProxy();
+		uniforms.ViewMatrix = camera.ViewMatrix;
+		uniforms.ProjectionMatrix = camera.ProjectionMatrix;
+		uniforms.ViewProjectionMatrix = camera.ViewProjectionMatrix;
+		uniforms.CameraLocation = camera.Location;
 
 		// Set lights
 		const RLightRenderProxy& dirLight = scene->GetRenderDirLight();
@@ -92,7 +131,7 @@ namespace Ion
 			uniforms.DirLight.Intensity = 0.0f;
 		}
 
-		uniforms.AmbientLightColor = scene->m_RenderAmbientLight;
+		uniforms.AmbientLightColor = scene->GetRenderAmbientLight();
 		uniforms.LightNum = lightNum;
 
 		uint32 lightIndex = 0;
@@ -114,56 +153,393 @@ namespace Ion
 
 		{
 			TRACE_SCOPE("Renderer::RenderScene - Draw Primitives");
-			for (const RPrimitiveRenderProxy& primitive : scene->GetScenePrimitives())
+
+			const TArray<RPrimitiveRenderProxy>& primitives = scene->GetScenePrimitives();
+
+			static thread_local TArray<uint32> t_VisiblePrimitives;
+			CullPrimitives(primitives, camera, t_VisiblePrimitives);
+
+			// Sort the draws, so the ones that share the state are submitted together.
+			static thread_local RDrawList t_DrawList;
+			t_DrawList.Build(primitives, t_VisiblePrimitives, camera);
+			t_DrawList.Sort();
+			t_DrawList.BuildBatches(primitives);
+
+			const TArray<RDrawCommand>& commands = t_DrawList.GetCommands();
+			size_t drawCount = commands.size();
+
+			// Compute the per-draw matrices of all the draws at once, using the batched math kernels.
+			static thread_local TArray<Matrix4> t_ModelMatrices;
+			static thread_local TArray<Matrix4> t_MVPMatrices;
+			static thread_local TArray<Matrix4> t_InverseTransposeMatrices;
+			t_ModelMatrices.resize(drawCount);
+			t_MVPMatrices.resize(drawCount);
+			t_InverseTransposeMatrices.resize(drawCount);
+
+			for (size_t i = 0; i < drawCount; ++i)
+			{
+				t_ModelMatrices[i] = primitives[commands[i].PrimitiveIndex].Transform;
+			}
+			Math::MultiplyMatrices(camera.ViewProjectionMatrix, t_ModelMatrices.data(), t_MVPMatrices.data(), drawCount);
+			Math::InverseTransposeAffine(t_ModelMatrices.data(), t_InverseTransposeMatrices.data(), drawCount);
+
+			const TArray<RDrawBatch>& batches = t_DrawList.GetBatches();
+
+			// Pack the instance data of all the instanced batches, so it can be uploaded at once.
+			static thread_local TArray<RInstanceData> t_InstanceData;
+			static thread_local TArray<uint32> t_BatchFirstInstances;
+			t_InstanceData.clear();
+			t_BatchFirstInstances.resize(batches.size());
+
+			for (size_t b = 0; b < batches.size(); ++b)
 			{
-				Draw(primitive, scene);
+				const RDrawBatch& batch = batches[b];
+				if (CanDrawInstanced(primitives[commands[batch.FirstCommand].PrimitiveIndex], batch.CommandCount))
+				{
+					t_BatchFirstInstances[b] = (uint32)t_InstanceData.size();
+					for (uint32 i = batch.FirstCommand; i < batch.FirstCommand + batch.CommandCount; ++i)
+					{
+						t_InstanceData.push_back(RInstanceData { t_ModelMatrices[i], t_InverseTransposeMatrices[i] });
+					}
+				}
+				else
+				{
+					t_BatchFirstInstances[b] = InvalidInstance;
+				}
 			}
+
+			if (!t_InstanceData.empty())
+			{
+				UploadInstanceData(t_InstanceData);
+			}
+
+			// Record the draws on the workers and execute them here, in the original order.
+			static thread_local TArray<RCommandList> t_CommandLists;
+			RecordBatches(primitives, t_DrawList, t_MVPMatrices.data(), t_InverseTransposeMatrices.data(), t_BatchFirstInstances.data(), t_CommandLists);
+
+			// Upload the per-draw uniforms written to the ring while recording.
+			if (m_UniformRing)
+			{
+				m_UniformRing->Flush();
+			}
+
+			RDrawStats stats;
+			for (const RCommandList& commandList : t_CommandLists)
+			{
+				ExecuteCommandList(commandList);
+				stats += commandList.GetState().Stats;
+			}
+
+			SET_VALUE_COUNTER(Renderer_DrawCalls, stats.DrawCalls);
+			SET_VALUE_COUNTER(Renderer_StateChanges, stats.StateChanges);
+			SET_VALUE_COUNTER(Renderer_StateChangesAvoided, stats.StateChangesAvoided);
+			SET_VALUE_COUNTER(Renderer_InstancedDrawCalls, stats.InstancedDrawCalls);
+			SET_VALUE_COUNTER(Renderer_Instances, stats.Instances);
 		}
 	}
 
-	void Renderer::Draw(const RPrimitiveRenderProxy& primitive, const Scene* targetScene) const
+	void Renderer::CullPrimitives(const TArray<RPrimitiveRenderProxy>& primitives, const RCameraRenderProxy& camera, TArray<uint32>& outVisibleIndices) const
 	{
 		TRACE_FUNCTION();
 
-		ionassert(targetScene);
+		size_t primitiveCount = primitives.size();
+		outVisibleIndices.clear();
 
-		const MaterialInstance* materialInstance = primitive.MaterialInstance;
-		if (materialInstance)
+		static thread_local TArray<uint8> t_Visibility;
+		t_Visibility.resize(primitiveCount);
+
+		if (primitiveCount > 0)
 		{
-			const Material* material = materialInstance->GetBaseMaterial().get();
-			if (material->BindShader(EShaderUsage::StaticMesh))
+			Frustum frustum = Frustum::FromMatrix(camera.ViewProjectionMatrix);
+
+			// The thread_local array cannot be accessed directly on the workers.
+			uint8* visibility = t_Visibility.data();
+
+			EngineTaskQueue::ParallelForRange(0, (int64)primitiveCount, CullingBatchSize, [&primitives, &frustum, visibility](int64 begin, int64 end)
 			{
-				materialInstance->TransferParameters();
-				material->UpdateConstantBuffer();
+				TRACE_SCOPE("Renderer::CullPrimitives - Batch");
+
+				Math::TestFrustumAABBs(frustum, &primitives[begin].Bounds, sizeof(RPrimitiveRenderProxy), visibility + begin, (size_t)(end - begin));
+			});
+		}
 
-				materialInstance->BindTextures();
+		outVisibleIndices.reserve(primitiveCount);
+		for (uint32 i = 0; i < (uint32)primitiveCount; ++i)
+		{
+			if (t_Visibility[i])
+			{
+				outVisibleIndices.push_back(i);
 			}
-			else
+		}
+
+		SET_VALUE_COUNTER(Renderer_VisiblePrimitives, outVisibleIndices.size());
+		SET_VALUE_COUNTER(Renderer_CulledPrimitives, primitiveCount - outVisibleIndices.size());
+	}
+
+	void Renderer::RecordBatches(const TArray<RPrimitiveRenderProxy>& primitives, const RDrawList& drawList,
+		const Matrix4* mvpMatrices, const Matrix4* inverseTransposeMatrices, const uint32* batchFirstInstances,
+		TArray<RCommandList>& outCommandLists) const
+	{
+		TRACE_FUNCTION();
+
+		const TArray<RDrawCommand>& commands = drawList.GetCommands();
+		const TArray<RDrawBatch>& batches = drawList.GetBatches();
+
+		uint32 batchCount = (uint32)batches.size();
+		uint32 listCount = (batchCount + CommandListBatchCount - 1) / CommandListBatchCount;
+
+		// The lists keep their memory between the frames.
+		outCommandLists.resize(listCount);
+		RCommandList* commandLists = outCommandLists.data();
+
+		// The render thread only records the lists of this loop, it never picks up other jobs in the meantime.
+		EngineTaskQueue::ParallelFor(0, (int64)listCount, 1, [&, commandLists](int64 listIndex)
+		{
+			TRACE_SCOPE("Renderer::RecordBatches - Command List");
+
+			RCommandList& commandList = commandLists[listIndex];
+			commandList.Reset();
+
+			uint32 firstBatch = (uint32)listIndex * CommandListBatchCount;
+			uint32 endBatch = std::min(firstBatch + CommandListBatchCount, batchCount);
+			for (uint32 b = firstBatch; b < endBatch; ++b)
 			{
-				m_BasicShader->Bind();
+				const RDrawBatch& batch = batches[b];
+				if (batchFirstInstances[b] != InvalidInstance)
+				{
+					const RPrimitiveRenderProxy& batchPrimitive = primitives[commands[batch.FirstCommand].PrimitiveIndex];
+					RecordDrawInstanced(batchPrimitive, batch.CommandCount, batchFirstInstances[b], commandList);
+					continue;
+				}
+
+				for (uint32 i = batch.FirstCommand; i < batch.FirstCommand + batch.CommandCount; ++i)
+				{
+					RecordDraw(primitives[commands[i].PrimitiveIndex], mvpMatrices[i], inverseTransposeMatrices[i], commandList);
+				}
+			}
+		});
+	}
+
+	void Renderer::ExecuteCommandList(const RCommandList& commandList) const
+	{
+		TRACE_FUNCTION();
+
+		for (const RCommand& command : commandList.GetCommands())
+		{
+			switch (command.Type)
+			{
+			case ERCommandType::BindShader:
+				command.Shader->Bind();
+				break;
+			case ERCommandType::BindMaterialInstance:
+				command.MaterialInstance->UpdateConstantBuffer();
+				command.MaterialInstance->BindConstantBuffer();
+				command.MaterialInstance->BindTextures();
+				break;
+			case ERCommandType::BindVertexBuffer:
+				command.VertexBuffer->Bind();
+				command.VertexBuffer->BindLayout();
+				break;
+			case ERCommandType::BindVertexBufferInstanced:
+				command.VertexBuffer->Bind();
+				command.VertexBuffer->BindInstanceLayout();
+				break;
+			case ERCommandType::BindInstances:
+				command.VertexBuffer->BindInstances(*m_InstanceVertexLayout, command.Arg0);
+				break;
+			case ERCommandType::BindIndexBuffer:
+				command.IndexBuffer->Bind();
+				break;
+			case ERCommandType::UpdateUniformBuffer:
+				memcpy(command.UniformBuffer->GetDataPtr(), commandList.GetPayload(command.Arg0), command.Arg1);
+				command.UniformBuffer->UpdateData();
+				break;
+			case ERCommandType::BindUniformBuffer:
+				command.UniformBuffer->Bind(command.Arg0);
+				break;
+			case ERCommandType::BindUniformRing:
+			{
+				RHIUniformRingAllocation allocation;
+				allocation.Offset = command.Arg0;
+				allocation.Size = command.Arg1;
+				command.UniformRing->Bind(allocation, command.Arg2);
+				break;
+			}
+			case ERCommandType::DrawIndexed:
+				DrawIndexed(command.Arg0);
+				break;
+			case ERCommandType::DrawIndexedInstanced:
+				DrawIndexedInstanced(command.Arg0, command.Arg1);
+				break;
+			default:
+				ionassert(false, "Invalid command type.");
 			}
 		}
+	}
+
+	void Renderer::Draw(const RPrimitiveRenderProxy& primitive, const Scene* targetScene) const
+	{
+		ionassert(targetScene);
+
+		const Matrix4& viewProjectionMatrix = targetScene->GetCameraRenderProxy().ViewProjectionMatrix;
+		const Matrix4& modelMatrix = primitive.Transform;
+
+		// Nothing is known about the currently bound state.
+		static thread_local RCommandList t_CommandList;
+		t_CommandList.Reset();
+		RecordDraw(primitive, Math::MultiplyMatrix(viewProjectionMatrix, modelMatrix), Math::InverseTransposeAffine(modelMatrix), t_CommandList);
+		if (m_UniformRing)
+		{
+			m_UniformRing->Flush();
+		}
+		ExecuteCommandList(t_CommandList);
+	}
+
+	void Renderer::RecordDraw(const RPrimitiveRenderProxy& primitive, const Matrix4& modelViewProjectionMatrix, const Matrix4& inverseTransposeMatrix, RCommandList& commandList) const
+	{
+		RDrawState& state = commandList.GetState();
+		RDrawStats& stats = state.Stats;
+
+		// The material readiness is resolved when the proxy is created (see MeshComponent::FillRenderProxy),
+		// so the permutations finalized on the main thread don't change the state in the middle of a frame.
+		RecordBindShader(primitive.Shader, commandList);
+		if (primitive.MaterialInstance)
+		{
+			RecordBindMaterialInstance(primitive.MaterialInstance, commandList);
+		}
+
+		if (state.VertexBuffer != primitive.VertexBuffer)
+		{
+			commandList.BindVertexBuffer(primitive.VertexBuffer);
+			state.VertexBuffer = primitive.VertexBuffer;
+			++stats.StateChanges;
+		}
 		else
 		{
-			primitive.Shader->Bind();
+			++stats.StateChangesAvoided;
 		}
 
-		primitive.VertexBuffer->Bind();
-		primitive.VertexBuffer->BindLayout();
-		primitive.IndexBuffer->Bind();
+		RecordBindIndexBuffer(primitive.IndexBuffer, commandList);
 
-		const Matrix4& viewProjectionMatrix = targetScene->m_RenderCamera.ViewProjectionMatrix;
-		const Matrix4& modelMatrix = primitive.Transform;
+		// The uniform buffer can be shared by multiple primitives (of the same mesh),
+		// so the data is written to it only when the command is executed.
+		MeshUniforms uniformData = primitive.UniformBuffer->Data<MeshUniforms>();
+		uniformData.TransformMatrix = primitive.Transform;
+		uniformData.InverseTransposeMatrix = inverseTransposeMatrix;
+		uniformData.ModelViewProjectionMatrix = modelViewProjectionMatrix;
+
+		// Write the uniforms directly to the ring, if there's space left in the frame.
+		RHIUniformRingAllocation allocation = m_UniformRing ? m_UniformRing->Allocate(sizeof(MeshUniforms)) : RHIUniformRingAllocation();
+		if (allocation.IsValid())
+		{
+			memcpy(allocation.Data, &uniformData, sizeof(MeshUniforms));
+			commandList.BindUniformRing(m_UniformRing.Raw(), allocation, 1);
+		}
+		else
+		{
+			commandList.UpdateUniformBuffer(primitive.UniformBuffer, &uniformData, sizeof(MeshUniforms));
+			commandList.BindUniformBuffer(primitive.UniformBuffer, 1);
+		}
+
+		commandList.DrawIndexed(primitive.IndexBuffer->GetIndexCount());
+		++stats.DrawCalls;
+	}
+
+	void Renderer::RecordDrawInstanced(const RPrimitiveRenderProxy& primitive, uint32 instanceCount, uint32 firstInstance, RCommandList& commandList) const
+	{
+		ionassert(CanDrawInstanced(primitive, instanceCount));
+		ionassert(firstInstance + instanceCount <= m_InstanceBufferCapacity);
+
+		RDrawState& state = commandList.GetState();
+		RDrawStats& stats = state.Stats;
+
+		RecordBindShader(primitive.InstancedShader, commandList);
+		RecordBindMaterialInstance(primitive.MaterialInstance, commandList);
+
+		// The instanced input layout replaces the per-vertex one,
+		// so the next non-instanced draw has to bind the vertex buffer again.
+		commandList.BindVertexBufferInstanced(primitive.VertexBuffer);
+		commandList.BindInstances(m_InstanceBuffer.Raw(), firstInstance * (uint32)sizeof(RInstanceData));
+		state.VertexBuffer = nullptr;
+		++stats.StateChanges;
+
+		RecordBindIndexBuffer(primitive.IndexBuffer, commandList);
+
+		commandList.DrawIndexedInstanced(primitive.IndexBuffer->GetIndexCount(), instanceCount);
+		++stats.DrawCalls;
+		++stats.InstancedDrawCalls;
+		stats.Instances += instanceCount;
+	}
+
+	bool Renderer::CanDrawInstanced(const RPrimitiveRenderProxy& primitive, uint32 instanceCount) const
+	{
+		if (instanceCount < MinInstancedBatchSize || !m_InstanceBuffer)
+			return false;
+
+		if (!primitive.MaterialInstance)
+			return false;
+
+		// The shader permutation and the input layout are created asynchronously.
+		return
+			primitive.InstancedShader &&
+			primitive.VertexBuffer->HasInstanceLayout();
+	}
+
+	void Renderer::UploadInstanceData(const TArray<RInstanceData>& instances) const
+	{
+		TRACE_FUNCTION();
 
-		MeshUniforms& uniformData = primitive.UniformBuffer->Data<MeshUniforms>();
-		uniformData.TransformMatrix = modelMatrix;
-		uniformData.InverseTransposeMatrix = Math::InverseTranspose(modelMatrix);
-		uniformData.ModelViewProjectionMatrix = viewProjectionMatrix * modelMatrix;
+		ionassert(m_InstanceBuffer);
 
-		primitive.UniformBuffer->UpdateData();
-		primitive.UniformBuffer->Bind(1);
+		uint32 instanceCount = (uint32)instances.size();
+		if (instanceCount > m_InstanceBufferCapacity)
+		{
+			m_InstanceBufferCapacity = std::max(instanceCount, m_InstanceBufferCapacity * 2);
+			m_InstanceBuffer = RHIVertexBuffer::CreateDynamic((uint64)m_InstanceBufferCapacity * sizeof(RInstanceData));
+		}
 
-		DrawIndexed(primitive.IndexBuffer->GetIndexCount());
+		m_InstanceBuffer->UpdateData(instances.data(), (uint64)instanceCount * sizeof(RInstanceData));
+	}
+
+	void Renderer::RecordBindShader(const RHIShader* shader, RCommandList& commandList) const
+	{
+		RDrawState& state = commandList.GetState();
+		if (state.Shader == shader)
+		{
+			++state.Stats.StateChangesAvoided;
+			return;
+		}
+		commandList.BindShader(shader);
+		state.Shader = shader;
+		++state.Stats.StateChanges;
+	}
+
+	void Renderer::RecordBindMaterialInstance(const MaterialInstance* materialInstance, RCommandList& commandList) const
+	{
+		// Every instance has its own constant buffer, which is only uploaded
+		// when its parameters change, so rebinding the same instance is redundant.
+		RDrawState& state = commandList.GetState();
+		if (state.MaterialInstance == materialInstance)
+		{
+			++state.Stats.StateChangesAvoided;
+			return;
+		}
+		commandList.BindMaterialInstance(materialInstance);
+		state.MaterialInstance = materialInstance;
+		++state.Stats.StateChanges;
+	}
+
+	void Renderer::RecordBindIndexBuffer(const RHIIndexBuffer* indexBuffer, RCommandList& commandList) const
+	{
+		RDrawState& state = commandList.GetState();
+		if (state.IndexBuffer == indexBuffer)
+		{
+			++state.Stats.StateChangesAvoided;
+			return;
+		}
+		commandList.BindIndexBuffer(indexBuffer);
+		state.IndexBuffer = indexBuffer;
+		++state.Stats.StateChanges;
 	}
 
 	void Renderer::DrawBillboard(const RBillboardRenderProxy& billboard, const RHIShader* shader, const Scene* targetScene) const
@@ -193,7 +569,7 @@ namespace Ion
 
 		MeshUniforms& uniforms = billboardMesh->GetUniformsData();
 		uniforms.TransformMatrix = transform.GetMatrix();
-		uniforms.ModelViewProjectionMatrix = targetScene->m_RenderCamera.ViewProjectionMatrix * transform.GetMatrix();
+		uniforms.ModelViewProjectionMatrix = targetScene->GetCameraRenderProxy().ViewProjectionMatrix * transform.GetMatrix();
 
 		billboardMesh->GetUniformBufferRaw()->UpdateData();
 		billboardMesh->GetUniformBufferRaw()->Bind(1);
@@ -345,6 +721,40 @@ namespace Ion
 		m_ScreenTextureRenderData.IndexBuffer->Bind();
 	}
 
+	void Renderer::InitInstancing()
+	{
+		TRACE_FUNCTION();
+
+		// Model and normal matrices, as columns
+		m_InstanceVertexLayout = MakeRef<RHIVertexLayout>(8, EVertexInputRate::Instance);
+		for (int32 i = 0; i < 4; ++i)
+			m_InstanceVertexLayout->AddAttribute(EVertexAttributeSemantic::InstanceTransform, EVertexAttributeType::Float, 4, false);
+		for (int32 i = 0; i < 4; ++i)
+			m_InstanceVertexLayout->AddAttribute(EVertexAttributeSemantic::InstanceInverseTranspose, EVertexAttributeType::Float, 4, false);
+
+		ionassert(m_InstanceVertexLayout->GetStride() == sizeof(RInstanceData));
+
+		if (RHI::Get()->SupportsInstancing())
+		{
+			m_InstanceBufferCapacity = InitialInstanceBufferCapacity;
+			m_InstanceBuffer = RHIVertexBuffer::CreateDynamic((uint64)m_InstanceBufferCapacity * sizeof(RInstanceData));
+		}
+	}
+
+	void Renderer::InitUniformRing()
+	{
+		TRACE_FUNCTION();
+
+		if (RHI::Get()->SupportsUniformRingBuffer())
+		{
+			m_UniformRing = RHIUniformRingBuffer::Create(UniformRingFrameCapacity);
+		}
+		else
+		{
+			RendererLogger.Info("The current RHI does not support the uniform ring buffer. Each mesh uniform buffer will be updated separately.");
+		}
+	}
+
 	void Renderer::InitShaders()
 	{
 		InitBasicShader();
@@ -569,10 +979,11 @@ namespace Ion
 		Clear(clearOptions);
 
 		SceneUniforms& uniforms = scene->m_SceneUniformBuffer->Data<SceneUniforms>();
-		uniforms.ViewMatrix = scene->m_RenderCamera.ViewMatrix;
-		uniforms.ProjectionMatrix = scene->m_RenderCamera.ProjectionMatrix;
-		uniforms.ViewProjectionMatrix = scene->m_RenderCamera.ViewProjectionMatrix;
-		uniforms.CameraLocation = scene->m_RenderCamera.Location;
+		const RCameraRenderProxy& camera = scene->GetCameraRenderProxy();
+		uniforms.ViewMatrix = camera.ViewMatrix;
+		uniforms.ProjectionMatrix = camera.ProjectionMatrix;
+		uniforms.ViewProjectionMatrix = camera.ViewProjectionMatrix;
+		uniforms.CameraLocation = camera.Location;
 		scene->m_SceneUniformBuffer->UpdateData();
 		scene->m_SceneUniformBuffer->Bind(0);
 
@@ -4,6 +4,8 @@
 #include "Light.h"
 #include "Camera.h"
 #include "Scene.h"
+#include "DrawList.h"
+#include "CommandList.h"
 #include "RHI/VertexBuffer.h"
 #include "RHI/IndexBuffer.h"
 #include "RHI/UniformBuffer.h"
@@ -12,10 +14,14 @@
 
 namespace Ion
 {
+	/**
+	 * @brief Render data gathered from a world each frame, loaded into its Scene.
+	 * The arrays use the FrameAllocator memory, so it cannot outlive the next frame.
+	 */
 	struct RRendererData
 	{
-		TArray<RPrimitiveRenderProxy> Primitives;
-		TArray<RLightRenderProxy> Lights;
+		TFrameArray<RPrimitiveRenderProxy> Primitives;
+		TFrameArray<RLightRenderProxy> Lights;
 		RLightRenderProxy DirectionalLight;
 		Vector4 AmbientLightColor;
 
@@ -93,6 +99,11 @@ namespace Ion
 
 		virtual void Init();
 
+		/* Called by the Application, after the RHI frame has begun. */
+		void BeginFrame();
+		/* Called by the Application, before the RHI frame ends. */
+		void EndFrame();
+
 		void Clear() const;
 		void RenderScene(const Scene* scene) const;
 
@@ -102,9 +113,17 @@ namespace Ion
 		void DrawScreenTexture(const TRef<RHITexture>& texture) const;
 		void DrawScreenTexture(const TRef<RHITexture>& texture, const RHIShader* shader) const;
 
+		/**
+		 * @brief Executes the recorded commands on the RHI.
+		 * Call it on the thread that renders the frame.
+		 */
+		void ExecuteCommandList(const RCommandList& commandList) const;
+
 		virtual Result<void, RHIError> Clear(const RendererClearOptions& options) const = 0;
 
 		virtual Result<void, RHIError> DrawIndexed(uint32 indexCount) const = 0;
+		/* Requires RHI::SupportsInstancing */
+		virtual Result<void, RHIError> DrawIndexedInstanced(uint32 indexCount, uint32 instanceCount) const = 0;
 
 		virtual Result<void, RHIError> UnbindResources() const = 0;
 
@@ -161,6 +180,12 @@ namespace Ion
 			return Renderer::Get()->m_PPFXAAShader;
 		}
 
+		/* Layout of the per-instance data (RInstanceData) of the instanced draws. */
+		inline static const TRef<RHIVertexLayout>& GetInstanceVertexLayout()
+		{
+			return Renderer::Get()->m_InstanceVertexLayout;
+		}
+
 		inline static const std::shared_ptr<Mesh>& GetBillboardMesh()
 		{
 			return Renderer::Get()->m_BillboardMesh;
@@ -180,6 +205,9 @@ namespace Ion
 		void BindScreenTexturePrimitives() const;
 		void BindScreenTexturePrimitives(const RHIShader* customShader) const;
 
+		void InitInstancing();
+		void InitUniformRing();
+
 		void InitShaders();
 		void InitBasicShader();
 		void InitBasicUnlitMaskedShader();
@@ -190,6 +218,61 @@ namespace Ion
 		void InitEditorViewportMSShader();
 
 	private:
+		/* Number of primitives tested against the frustum in a single task. */
+		static constexpr int64 CullingBatchSize = 1024;
+
+		/* Smallest number of the same mesh draws, that are worth an instanced draw. */
+		static constexpr uint32 MinInstancedBatchSize = 2;
+		static constexpr uint32 InitialInstanceBufferCapacity = 1024;
+		static constexpr uint32 InvalidInstance = (uint32)-1;
+
+		/* Max bytes of the transient uniforms in a frame (8192 draws with MeshUniforms) */
+		static constexpr uint32 UniformRingFrameCapacity = 2 * 1024 * 1024;
+
+		/* Number of draw batches recorded into a single command list (by a single task). */
+		static constexpr uint32 CommandListBatchCount = 64;
+
+		/**
+		 * @brief Tests the primitive bounds against the camera frustum,
+		 * in parallel on the Engine Task Queue.
+		 *
+		 * @param outVisibleIndices Indices of the visible primitives, in the original order
+		 */
+		void CullPrimitives(const TArray<RPrimitiveRenderProxy>& primitives, const RCameraRenderProxy& camera, TArray<uint32>& outVisibleIndices) const;
+
+		/**
+		 * @brief Records the draw of the primitive with the precomputed per-draw matrices.
+		 * The binds that match the command list state are skipped.
+		 */
+		void RecordDraw(const RPrimitiveRenderProxy& primitive, const Matrix4& modelViewProjectionMatrix, const Matrix4& inverseTransposeMatrix, RCommandList& commandList) const;
+
+		/**
+		 * @brief Records the draw of the instances of the primitive mesh as a single draw call.
+		 *
+		 * @param firstInstance Index of the first instance data in the instance buffer
+		 */
+		void RecordDrawInstanced(const RPrimitiveRenderProxy& primitive, uint32 instanceCount, uint32 firstInstance, RCommandList& commandList) const;
+
+		/**
+		 * @brief Records the draw batches into command lists, in parallel on the Engine Task Queue.
+		 * Each list gets up to CommandListBatchCount consecutive batches.
+		 *
+		 * @param batchFirstInstances Index of the first instance of each instanced batch (InvalidInstance otherwise)
+		 */
+		void RecordBatches(const TArray<RPrimitiveRenderProxy>& primitives, const RDrawList& drawList,
+			const Matrix4* mvpMatrices, const Matrix4* inverseTransposeMatrices, const uint32* batchFirstInstances,
+			TArray<RCommandList>& outCommandLists) const;
+
+		/* Checks if a batch of draws of the primitive mesh can be drawn with instancing. */
+		bool CanDrawInstanced(const RPrimitiveRenderProxy& primitive, uint32 instanceCount) const;
+
+		/* Uploads the instance data of all the instanced draws of the frame, growing the buffer if needed. */
+		void UploadInstanceData(const TArray<RInstanceData>& instances) const;
+
+		void RecordBindShader(const RHIShader* shader, RCommandList& commandList) const;
+		void RecordBindMaterialInstance(const MaterialInstance* materialInstance, RCommandList& commandList) const;
+		void RecordBindIndexBuffer(const RHIIndexBuffer* indexBuffer, RCommandList& commandList) const;
+
 		void CreateScreenTexturePrimitives();
 
 	private:
@@ -205,6 +288,14 @@ namespace Ion
 		TRef<RHIShader> m_EditorViewportShader;
 		TRef<RHIShader> m_EditorViewportMSShader;
 
+		TRef<RHIVertexLayout> m_InstanceVertexLayout;
+		/* Dynamic buffer with the instance data of all the instanced draws in a frame */
+		mutable TRef<RHIVertexBuffer> m_InstanceBuffer;
+		mutable uint32 m_InstanceBufferCapacity = 0;
+
+		/* Transient per-draw uniforms (null if the RHI doesn't support it) */
+		TRef<RHIUniformRingBuffer> m_UniformRing;
+
 		std::shared_ptr<Mesh> m_BillboardMesh;
 
 		TRef<RHITexture> m_WhiteTexture;
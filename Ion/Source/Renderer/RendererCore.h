@@ -74,9 +74,15 @@ namespace Ion
 		const RHIVertexBuffer* VertexBuffer;
 		const RHIIndexBuffer* IndexBuffer;
 		const RHIUniformBuffer* UniformBuffer;
+		/* Null, until the shaders of the material have been compiled */
 		const MaterialInstance* MaterialInstance;
+		/* Material shader, or the fallback one, if the material is not ready */
 		const RHIShader* Shader;
+		/* Instanced permutation of the material shader, null if it has not been compiled */
+		const RHIShader* InstancedShader = nullptr;
 		Matrix4 Transform;
+		/* World space bounds, used for culling. Invalid bounds are never culled. */
+		AABB Bounds = AABB::Invalid();
 	};
 
 	struct REditorPassPrimitive
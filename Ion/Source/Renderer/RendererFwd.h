@@ -5,6 +5,16 @@ namespace Ion
 	// Camera.h
 	struct RCameraRenderProxy;
 	class Camera;
+	// CommandList.h
+	struct RCommand;
+	class RCommandList;
+	// DrawList.h
+	struct RDrawCommand;
+	struct RDrawBatch;
+	struct RInstanceData;
+	struct RDrawStats;
+	struct RDrawState;
+	class RDrawList;
 	// Light.h
 	struct RLightRenderProxy;
 	struct LightUniforms;
@@ -21,7 +31,10 @@ namespace Ion
 	class Renderer;
 	// RendererCore.h
 	struct ViewportDescription;
+	// RenderThread.h
+	class RenderThread;
 	// Scene.h
+	struct RSceneRenderData;
 	struct SceneUniforms;
 	struct RPrimitiveRenderProxy;
 	class Scene;
@@ -4,14 +4,14 @@
 #include "Light.h"
 #include "RHI/UniformBuffer.h"
 #include "Renderer/Renderer.h"
+#include "Resource/TextureStreamer.h"
 
 namespace Ion
 {
 	Scene::Scene() :
 		m_AmbientLightColor(0.0f),
 		m_ActiveDirectionalLight(nullptr),
-		m_RenderCamera({ }),
-		m_RenderDirLight({ })
+		m_RenderData()
 	{
 		m_SceneUniformBuffer = RHIUniformBuffer::Create<SceneUniforms>();
 	}
@@ -42,27 +42,41 @@ namespace Ion
 		return (bool)m_Lights.erase(light);
 	}
 
-	void Scene::LoadSceneData(const RRendererData& data)
+	void Scene::LoadSceneData(const RRendererData& data, uint32 frameDataIndex)
 	{
-		m_RenderPrimitives = data.Primitives;
-		m_RenderLights = data.Lights;
-		m_RenderDirLight = data.DirectionalLight;
-		m_RenderAmbientLight = data.AmbientLightColor;
+		ionassert(frameDataIndex < RenderThread::FrameDataBufferCount);
+		// The render thread reads the buffer of the frame it's drawing.
+		ionassert(!RenderThread::IsInRenderThread());
+
+		// Buffer of the frame that is being built by the game thread
+		RSceneRenderData& renderData = m_RenderData[frameDataIndex];
+
+		renderData.Primitives.assign(data.Primitives.begin(), data.Primitives.end());
+		renderData.Lights.assign(data.Lights.begin(), data.Lights.end());
+		renderData.DirLight = data.DirectionalLight;
+		renderData.AmbientLight = data.AmbientLightColor;
 
 		if (m_ActiveCamera)
-			m_ActiveCamera->CopyRenderData(m_RenderCamera);
+		{
+			m_ActiveCamera->CopyRenderData(renderData.Camera);
+
+			// This runs on the worker, the streamer applies the requests in its next Update.
+			TArray<TextureStreamingRequest> textureRequests;
+			TextureStreamer::GatherRequests(renderData.Primitives, renderData.Camera, textureRequests);
+			TextureStreamer::SubmitRequests(Move(textureRequests));
+		}
 
 		// Shrink arrays
 
-		if (m_RenderPrimitives.capacity() > m_RenderPrimitives.size() * 2)
-			m_RenderPrimitives.shrink_to_fit();
+		if (renderData.Primitives.capacity() > renderData.Primitives.size() * 2)
+			renderData.Primitives.shrink_to_fit();
 
-		if (m_RenderLights.capacity() > m_RenderLights.size() * 2)
-			m_RenderLights.shrink_to_fit();
+		if (renderData.Lights.capacity() > renderData.Lights.size() * 2)
+			renderData.Lights.shrink_to_fit();
 	}
 
 	void Scene::LoadCamera(const std::shared_ptr<Camera>& camera)
 	{
-		camera->CopyRenderData(m_RenderCamera);
+		camera->CopyRenderData(GetCurrentRenderData().Camera);
 	}
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "RendererCore.h"
+#include "RenderThread.h"
 #include "Camera.h"
 #include "Light.h"
 
@@ -23,6 +24,18 @@ namespace Ion
 		uint32 LightNum;
 	};
 
+	/**
+	 * @brief Render proxies of the scene in a single frame.
+	 */
+	struct RSceneRenderData
+	{
+		TArray<RPrimitiveRenderProxy> Primitives;
+		TArray<RLightRenderProxy> Lights;
+		RLightRenderProxy DirLight;
+		Vector4 AmbientLight;
+		RCameraRenderProxy Camera;
+	};
+
 	class ION_API Scene
 	{
 	public:
@@ -45,18 +58,32 @@ namespace Ion
 		Scene();
 		~Scene() { }
 
-		void LoadSceneData(const RRendererData& data);
+		/**
+		 * @brief Copy the renderer data to one of the render data buffers.
+		 * 
+		 * @param frameDataIndex Buffer of the frame the data is built for (see RenderThread::GetFrameDataIndex)
+		 */
+		void LoadSceneData(const RRendererData& data, uint32 frameDataIndex);
 		void LoadCamera(const std::shared_ptr<Camera>& camera);
 
 		// Render Thread: --------------------------------------------------------------------------
 
-		FORCEINLINE const TArray<RPrimitiveRenderProxy>& GetScenePrimitives() const { return m_RenderPrimitives; }
-		FORCEINLINE const TArray<RLightRenderProxy>& GetRenderLights() const { return m_RenderLights; }
-		FORCEINLINE const RLightRenderProxy& GetRenderDirLight() const { return m_RenderDirLight; }
-		FORCEINLINE const RCameraRenderProxy& GetCameraRenderProxy() const { return m_RenderCamera; }
+		/* Render data of the frame the current thread is working on.
+		   The game thread writes to one buffer, while the render thread reads another.
+		   @see RenderThread::GetCurrentFrameDataIndex */
+		FORCEINLINE const RSceneRenderData& GetCurrentRenderData() const { return m_RenderData[RenderThread::GetCurrentFrameDataIndex()]; }
+
+		FORCEINLINE const TArray<RPrimitiveRenderProxy>& GetScenePrimitives() const { return GetCurrentRenderData().Primitives; }
+		FORCEINLINE const TArray<RLightRenderProxy>& GetRenderLights() const { return GetCurrentRenderData().Lights; }
+		FORCEINLINE const RLightRenderProxy& GetRenderDirLight() const { return GetCurrentRenderData().DirLight; }
+		FORCEINLINE const Vector4& GetRenderAmbientLight() const { return GetCurrentRenderData().AmbientLight; }
+		FORCEINLINE const RCameraRenderProxy& GetCameraRenderProxy() const { return GetCurrentRenderData().Camera; }
 		
 		FORCEINLINE bool HasDirectionalLight() const { return m_ActiveDirectionalLight; }
 
+	private:
+		RSceneRenderData& GetCurrentRenderData();
+
 	private:
 		World* m_OwningWorld;
 
@@ -70,11 +97,7 @@ namespace Ion
 
 		// Render Thread: -------------------------------------
 
-		TArray<RPrimitiveRenderProxy> m_RenderPrimitives;
-		TArray<RLightRenderProxy> m_RenderLights;
-		RLightRenderProxy m_RenderDirLight;
-		Vector4 m_RenderAmbientLight;
-		RCameraRenderProxy m_RenderCamera;
+		RSceneRenderData m_RenderData[RenderThread::FrameDataBufferCount];
 
 		friend class Renderer;
 		friend class OpenGLRenderer;
@@ -82,4 +105,9 @@ namespace Ion
 		friend class World;
 		friend class MWorld;
 	};
+
+	FORCEINLINE RSceneRenderData& Scene::GetCurrentRenderData()
+	{
+		return m_RenderData[RenderThread::GetCurrentFrameDataIndex()];
+	}
 }
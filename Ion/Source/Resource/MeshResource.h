@@ -28,6 +28,9 @@ namespace Ion
 	{
 		TRef<RHIVertexBuffer> VertexBuffer;
 		TRef<RHIIndexBuffer> IndexBuffer;
+		/* Local space bounds of the mesh */
+		AABB Bounds = AABB::Invalid();
+		BoundingSphere Sphere;
 
 		bool IsAvailable() const
 		{
@@ -147,6 +150,9 @@ namespace Ion
 
 				m_RenderData.VertexBuffer->SetLayout(meshData->Layout);
 
+				m_RenderData.Bounds = meshData->Bounds;
+				m_RenderData.Sphere = meshData->Sphere;
+
 				ResourceLogger.Trace("Mesh Resource \"{}\" render data is now available.", m_Asset->GetVirtualPath());
 
 				onTake(self);
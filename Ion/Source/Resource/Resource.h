@@ -27,6 +27,8 @@ namespace Ion
 	class ION_API Resource : public TEnableSFT<Resource>
 	{
 	public:
+		ENGINE_ALLOCATED(EMemoryTag::Asset)
+
 		/**
 		 * @return true if the resource render data is available.
 		 */
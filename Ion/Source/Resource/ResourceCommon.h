@@ -11,6 +11,7 @@
 // TextureResource ----------------------------------------------------
 
 #define IASSET_NODE_Resource_Texture_Prop_Filter  "Filter"
+#define IASSET_NODE_Resource_Texture_Prop_Compression "Compression"
 
 // MeshResource ----------------------------------------------------
 
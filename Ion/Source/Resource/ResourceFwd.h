@@ -12,6 +12,21 @@ namespace Ion
 	struct TextureResourceDescription;
 	struct TextureResourceRenderData;
 	class TextureResource;
+	// TextureMipChain.h
+	struct TextureCookSettings;
+	struct TextureMipChainHeader;
+	struct TextureMipChainMip;
+	class TextureMipChain;
+	// TextureStreamer.h
+	struct TextureStreamingState;
+	struct TextureImportedMips;
+	struct TextureStreamingRequest;
+	struct TextureStreamerStats;
+	class TextureStreamer;
+	// TextureCompression.h
+	class TextureCompression;
+	// TextureCooker.h
+	class TextureCooker;
 	// ResourceManager.h
 	class ResourceManager;
 }
@@ -0,0 +1,738 @@
+#include "IonPCH.h"
+
+#include "TextureCompression.h"
+
+namespace Ion
+{
+	// Common ------------------------------------------------------------------------
+
+	/* 4x4 block of RGBA8 pixels */
+	struct PixelBlock
+	{
+		uint8 Pixels[16][4];
+	};
+
+	static void LoadBlock(const uint8* pixels, uint32 width, uint32 height, uint32 blockX, uint32 blockY, PixelBlock& outBlock)
+	{
+		for (uint32 y = 0; y < 4; ++y)
+		{
+			// Pad with the edge pixels
+			uint32 pixelY = std::min(blockY * 4 + y, height - 1);
+			for (uint32 x = 0; x < 4; ++x)
+			{
+				uint32 pixelX = std::min(blockX * 4 + x, width - 1);
+				memcpy(outBlock.Pixels[y * 4 + x], pixels + ((size_t)pixelY * width + pixelX) * 4, 4);
+			}
+		}
+	}
+
+	static void StoreBlock(const PixelBlock& block, uint32 width, uint32 height, uint32 blockX, uint32 blockY, uint8* outPixels)
+	{
+		for (uint32 y = 0; y < 4 && blockY * 4 + y < height; ++y)
+		{
+			for (uint32 x = 0; x < 4 && blockX * 4 + x < width; ++x)
+			{
+				memcpy(outPixels + ((size_t)(blockY * 4 + y) * width + blockX * 4 + x) * 4, block.Pixels[y * 4 + x], 4);
+			}
+		}
+	}
+
+	/**
+	 * @brief Fits the endpoints to the extremes of the points along their principal axis.
+	 * The endpoints are clamped to [0, 255].
+	 */
+	static void FitEndpoints(const float points[16][4], uint32 count, uint32 dimensions, float outEndpoint0[4], float outEndpoint1[4])
+	{
+		float mean[4] = { };
+		for (uint32 i = 0; i < count; ++i)
+			for (uint32 c = 0; c < dimensions; ++c)
+				mean[c] += points[i][c];
+
+		for (uint32 c = 0; c < dimensions; ++c)
+			mean[c] /= (float)count;
+
+		float covariance[4][4] = { };
+		for (uint32 i = 0; i < count; ++i)
+			for (uint32 r = 0; r < dimensions; ++r)
+				for (uint32 c = 0; c < dimensions; ++c)
+					covariance[r][c] += (points[i][r] - mean[r]) * (points[i][c] - mean[c]);
+
+		// Power iteration - converges to the eigenvector with the largest eigenvalue
+		float axis[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+		for (uint32 iteration = 0; iteration < 8; ++iteration)
+		{
+			float next[4] = { };
+			float length = 0.0f;
+			for (uint32 r = 0; r < dimensions; ++r)
+			{
+				for (uint32 c = 0; c < dimensions; ++c)
+					next[r] += covariance[r][c] * axis[c];
+				length += next[r] * next[r];
+			}
+
+			// All the points are the same
+			if (length < 1e-8f)
+				break;
+
+			length = std::sqrt(length);
+			for (uint32 c = 0; c < dimensions; ++c)
+				axis[c] = next[c] / length;
+		}
+
+		float minProjection = FLT_MAX;
+		float maxProjection = -FLT_MAX;
+		for (uint32 i = 0; i < count; ++i)
+		{
+			float projection = 0.0f;
+			for (uint32 c = 0; c < dimensions; ++c)
+				projection += (points[i][c] - mean[c]) * axis[c];
+
+			minProjection = std::min(minProjection, projection);
+			maxProjection = std::max(maxProjection, projection);
+		}
+
+		for (uint32 c = 0; c < dimensions; ++c)
+		{
+			outEndpoint0[c] = std::clamp(mean[c] + axis[c] * minProjection, 0.0f, 255.0f);
+			outEndpoint1[c] = std::clamp(mean[c] + axis[c] * maxProjection, 0.0f, 255.0f);
+		}
+	}
+
+	/**
+	 * @brief Least squares fit of the endpoints to the points, given the interpolation
+	 * weight (0 - endpoint 0, 1 - endpoint 1) of each point.
+	 *
+	 * @return false, if the system cannot be solved (e.g. all the weights are the same)
+	 */
+	static bool RefineEndpoints(const float points[16][4], const float weights[16], uint32 count, uint32 dimensions, float outEndpoint0[4], float outEndpoint1[4])
+	{
+		float a = 0.0f, b = 0.0f, c = 0.0f;
+		float x0[4] = { };
+		float x1[4] = { };
+		for (uint32 i = 0; i < count; ++i)
+		{
+			float w1 = weights[i];
+			float w0 = 1.0f - w1;
+			a += w0 * w0;
+			b += w0 * w1;
+			c += w1 * w1;
+			for (uint32 d = 0; d < dimensions; ++d)
+			{
+				x0[d] += w0 * points[i][d];
+				x1[d] += w1 * points[i][d];
+			}
+		}
+
+		float determinant = a * c - b * b;
+		if (std::abs(determinant) < 1e-6f)
+			return false;
+
+		for (uint32 d = 0; d < dimensions; ++d)
+		{
+			outEndpoint0[d] = std::clamp((c * x0[d] - b * x1[d]) / determinant, 0.0f, 255.0f);
+			outEndpoint1[d] = std::clamp((a * x1[d] - b * x0[d]) / determinant, 0.0f, 255.0f);
+		}
+		return true;
+	}
+
+	// BC1 / BC3 color block ---------------------------------------------------------
+
+	/* Weight of color 1 for each index */
+	static constexpr float c_ColorWeights4[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+	static constexpr float c_ColorWeights3[4] = { 0.0f, 1.0f, 0.5f, 0.0f };
+
+	FORCEINLINE static uint16 PackColor565(const float color[4])
+	{
+		uint32 r = (uint32)std::clamp(color[0] * (31.0f / 255.0f) + 0.5f, 0.0f, 31.0f);
+		uint32 g = (uint32)std::clamp(color[1] * (63.0f / 255.0f) + 0.5f, 0.0f, 63.0f);
+		uint32 b = (uint32)std::clamp(color[2] * (31.0f / 255.0f) + 0.5f, 0.0f, 31.0f);
+		return (uint16)((r << 11) | (g << 5) | b);
+	}
+
+	FORCEINLINE static void UnpackColor565(uint16 packed, int32 outColor[4])
+	{
+		int32 r = (packed >> 11) & 31;
+		int32 g = (packed >> 5) & 63;
+		int32 b = packed & 31;
+		outColor[0] = (r << 3) | (r >> 2);
+		outColor[1] = (g << 2) | (g >> 4);
+		outColor[2] = (b << 3) | (b >> 2);
+		outColor[3] = 255;
+	}
+
+	/* 4 colors, or 3 colors and transparent black */
+	static void MakeColorPalette(uint16 color0, uint16 color1, bool bFourColors, int32 outPalette[4][4])
+	{
+		UnpackColor565(color0, outPalette[0]);
+		UnpackColor565(color1, outPalette[1]);
+
+		for (uint32 c = 0; c < 3; ++c)
+		{
+			if (bFourColors)
+			{
+				outPalette[2][c] = (2 * outPalette[0][c] + outPalette[1][c] + 1) / 3;
+				outPalette[3][c] = (outPalette[0][c] + 2 * outPalette[1][c] + 1) / 3;
+			}
+			else
+			{
+				outPalette[2][c] = (outPalette[0][c] + outPalette[1][c]) / 2;
+				outPalette[3][c] = 0;
+			}
+		}
+		outPalette[2][3] = 255;
+		outPalette[3][3] = bFourColors ? 255 : 0;
+	}
+
+	struct ColorBlockFit
+	{
+		uint16 Color0;
+		uint16 Color1;
+		/* 2 bits per pixel, the first pixel in the lowest bits */
+		uint32 Indices;
+		uint32 Error;
+	};
+
+	/**
+	 * @param bAlwaysFourColors The BC3 color block is always decoded with 4 colors,
+	 * regardless of the endpoint order.
+	 */
+	static ColorBlockFit FitColorBlock(const PixelBlock& block, const bool bTransparent[16], bool bAnyTransparent, bool bAlwaysFourColors, const float endpoint0[4], const float endpoint1[4])
+	{
+		ColorBlockFit fit { };
+		fit.Color0 = PackColor565(endpoint0);
+		fit.Color1 = PackColor565(endpoint1);
+
+		bool bFourColors = true;
+		if (!bAlwaysFourColors)
+		{
+			// color0 > color1 selects the 4 color mode, else the transparent index is available
+			if (bAnyTransparent == (fit.Color0 > fit.Color1))
+				std::swap(fit.Color0, fit.Color1);
+
+			bFourColors = fit.Color0 > fit.Color1;
+		}
+
+		int32 palette[4][4];
+		MakeColorPalette(fit.Color0, fit.Color1, bFourColors, palette);
+		uint32 paletteSize = bFourColors ? 4 : 3;
+
+		for (uint32 i = 0; i < 16; ++i)
+		{
+			uint32 bestIndex = 3;
+			if (!bTransparent[i])
+			{
+				uint32 bestError = UINT32_MAX;
+				for (uint32 index = 0; index < paletteSize; ++index)
+				{
+					uint32 error = 0;
+					for (uint32 c = 0; c < 3; ++c)
+					{
+						int32 delta = palette[index][c] - (int32)block.Pixels[i][c];
+						error += delta * delta;
+					}
+					if (error < bestError)
+					{
+						bestError = error;
+						bestIndex = index;
+					}
+				}
+				fit.Error += bestError;
+			}
+			fit.Indices |= bestIndex << (i * 2);
+		}
+
+		return fit;
+	}
+
+	/**
+	 * @param bPunchThroughAlpha Encode the pixels with alpha < 128 as transparent (BC1)
+	 */
+	static void EncodeColorBlock(const PixelBlock& block, bool bPunchThroughAlpha, bool bAlwaysFourColors, uint8* out)
+	{
+		float points[16][4];
+		uint32 pointPixels[16];
+		bool bTransparent[16];
+		uint32 count = 0;
+
+		for (uint32 i = 0; i < 16; ++i)
+		{
+			bTransparent[i] = bPunchThroughAlpha && block.Pixels[i][3] < 128;
+			if (!bTransparent[i])
+			{
+				for (uint32 c = 0; c < 3; ++c)
+					points[count][c] = (float)block.Pixels[i][c];
+				pointPixels[count++] = i;
+			}
+		}
+
+		// All the pixels are transparent
+		ColorBlockFit best { 0, 0, UINT32_MAX, 0 };
+
+		if (count > 0)
+		{
+			bool bAnyTransparent = count < 16;
+
+			float endpoint0[4];
+			float endpoint1[4];
+			FitEndpoints(points, count, 3, endpoint0, endpoint1);
+
+			// Inset the endpoints, so the extremes don't pull the palette too much
+			for (uint32 c = 0; c < 3; ++c)
+			{
+				float inset = (endpoint1[c] - endpoint0[c]) / 16.0f;
+				endpoint0[c] += inset;
+				endpoint1[c] -= inset;
+			}
+
+			best = FitColorBlock(block, bTransparent, bAnyTransparent, bAlwaysFourColors, endpoint0, endpoint1);
+
+			for (uint32 iteration = 0; iteration < 2 && best.Error > 0; ++iteration)
+			{
+				const float* indexWeights = (bAlwaysFourColors || best.Color0 > best.Color1) ? c_ColorWeights4 : c_ColorWeights3;
+
+				float weights[16];
+				for (uint32 i = 0; i < count; ++i)
+					weights[i] = indexWeights[(best.Indices >> (pointPixels[i] * 2)) & 3];
+
+				if (!RefineEndpoints(points, weights, count, 3, endpoint0, endpoint1))
+					break;
+
+				ColorBlockFit fit = FitColorBlock(block, bTransparent, bAnyTransparent, bAlwaysFourColors, endpoint0, endpoint1);
+				if (fit.Error >= best.Error)
+					break;
+
+				best = fit;
+			}
+		}
+
+		out[0] = (uint8)best.Color0;
+		out[1] = (uint8)(best.Color0 >> 8);
+		out[2] = (uint8)best.Color1;
+		out[3] = (uint8)(best.Color1 >> 8);
+		memcpy(out + 4, &best.Indices, 4);
+	}
+
+	static void DecodeColorBlock(const uint8* in, bool bAlwaysFourColors, PixelBlock& outBlock)
+	{
+		uint16 color0 = (uint16)(in[0] | (in[1] << 8));
+		uint16 color1 = (uint16)(in[2] | (in[3] << 8));
+		uint32 indices;
+		memcpy(&indices, in + 4, 4);
+
+		int32 palette[4][4];
+		MakeColorPalette(color0, color1, bAlwaysFourColors || color0 > color1, palette);
+
+		for (uint32 i = 0; i < 16; ++i)
+		{
+			const int32* color = palette[(indices >> (i * 2)) & 3];
+			for (uint32 c = 0; c < 4; ++c)
+				outBlock.Pixels[i][c] = (uint8)color[c];
+		}
+	}
+
+	// BC3 alpha / BC5 channel block -------------------------------------------------
+
+	static void MakeValuePalette(uint8 value0, uint8 value1, int32 outPalette[8])
+	{
+		outPalette[0] = value0;
+		outPalette[1] = value1;
+
+		if (value0 > value1)
+		{
+			for (int32 i = 2; i < 8; ++i)
+				outPalette[i] = ((8 - i) * value0 + (i - 1) * value1 + 3) / 7;
+		}
+		else
+		{
+			for (int32 i = 2; i < 6; ++i)
+				outPalette[i] = ((6 - i) * value0 + (i - 1) * value1 + 2) / 5;
+			outPalette[6] = 0;
+			outPalette[7] = 255;
+		}
+	}
+
+	static void EncodeValueBlock(const uint8 values[16], uint8* out)
+	{
+		uint8 minValue = 255;
+		uint8 maxValue = 0;
+		for (uint32 i = 0; i < 16; ++i)
+		{
+			minValue = std::min(minValue, values[i]);
+			maxValue = std::max(maxValue, values[i]);
+		}
+
+		// The 8 value mode (value0 > value1), all the indices are 0 if the block is uniform
+		out[0] = maxValue;
+		out[1] = minValue;
+
+		int32 palette[8];
+		MakeValuePalette(maxValue, minValue, palette);
+
+		uint64 indices = 0;
+		if (maxValue != minValue)
+		{
+			for (uint32 i = 0; i < 16; ++i)
+			{
+				uint32 bestIndex = 0;
+				int32 bestError = INT32_MAX;
+				for (uint32 index = 0; index < 8; ++index)
+				{
+					int32 error = std::abs(palette[index] - (int32)values[i]);
+					if (error < bestError)
+					{
+						bestError = error;
+						bestIndex = index;
+					}
+				}
+				indices |= (uint64)bestIndex << (i * 3);
+			}
+		}
+
+		for (uint32 i = 0; i < 6; ++i)
+			out[2 + i] = (uint8)(indices >> (i * 8));
+	}
+
+	static void DecodeValueBlock(const uint8* in, uint8 outValues[16])
+	{
+		int32 palette[8];
+		MakeValuePalette(in[0], in[1], palette);
+
+		uint64 indices = 0;
+		for (uint32 i = 0; i < 6; ++i)
+			indices |= (uint64)in[2 + i] << (i * 8);
+
+		for (uint32 i = 0; i < 16; ++i)
+			outValues[i] = (uint8)palette[(indices >> (i * 3)) & 7];
+	}
+
+	// BC7 (mode 6) ------------------------------------------------------------------
+
+	static constexpr int32 c_BC7Weights4[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+	FORCEINLINE static int32 InterpolateBC7(int32 value0, int32 value1, int32 weight)
+	{
+		return ((64 - weight) * value0 + weight * value1 + 32) >> 6;
+	}
+
+	struct BlockBitWriter
+	{
+		uint8* Data;
+		uint32 Offset = 0;
+
+		void Write(uint32 value, uint32 bitCount)
+		{
+			for (uint32 i = 0; i < bitCount; ++i, ++Offset)
+			{
+				if ((value >> i) & 1)
+					Data[Offset >> 3] |= (uint8)(1 << (Offset & 7));
+			}
+		}
+	};
+
+	struct BlockBitReader
+	{
+		const uint8* Data;
+		uint32 Offset = 0;
+
+		uint32 Read(uint32 bitCount)
+		{
+			uint32 value = 0;
+			for (uint32 i = 0; i < bitCount; ++i, ++Offset)
+			{
+				value |= (uint32)((Data[Offset >> 3] >> (Offset & 7)) & 1) << i;
+			}
+			return value;
+		}
+	};
+
+	/* 7 bits per channel and a p-bit (the shared least significant bit) */
+	static void QuantizeBC7Endpoint(const float endpoint[4], uint8 outQuantized[4], uint8& outPBit)
+	{
+		float bestError = FLT_MAX;
+		for (uint8 pBit = 0; pBit < 2; ++pBit)
+		{
+			uint8 quantized[4];
+			float error = 0.0f;
+			for (uint32 c = 0; c < 4; ++c)
+			{
+				quantized[c] = (uint8)std::clamp((int32)((endpoint[c] - pBit) * 0.5f + 0.5f), 0, 127);
+				float delta = (float)(quantized[c] * 2 + pBit) - endpoint[c];
+				error += delta * delta;
+			}
+			if (error < bestError)
+			{
+				bestError = error;
+				outPBit = pBit;
+				memcpy(outQuantized, quantized, 4);
+			}
+		}
+	}
+
+	static uint32 FindBC7Indices(const PixelBlock& block, const int32 endpoint0[4], const int32 endpoint1[4], uint8 outIndices[16])
+	{
+		int32 palette[16][4];
+		for (uint32 index = 0; index < 16; ++index)
+			for (uint32 c = 0; c < 4; ++c)
+				palette[index][c] = InterpolateBC7(endpoint0[c], endpoint1[c], c_BC7Weights4[index]);
+
+		uint32 totalError = 0;
+		for (uint32 i = 0; i < 16; ++i)
+		{
+			uint32 bestError = UINT32_MAX;
+			for (uint32 index = 0; index < 16; ++index)
+			{
+				uint32 error = 0;
+				for (uint32 c = 0; c < 4; ++c)
+				{
+					int32 delta = palette[index][c] - (int32)block.Pixels[i][c];
+					error += delta * delta;
+				}
+				if (error < bestError)
+				{
+					bestError = error;
+					outIndices[i] = (uint8)index;
+				}
+			}
+			totalError += bestError;
+		}
+		return totalError;
+	}
+
+	static void EncodeBC7Block(const PixelBlock& block, uint8* out)
+	{
+		float points[16][4];
+		for (uint32 i = 0; i < 16; ++i)
+			for (uint32 c = 0; c < 4; ++c)
+				points[i][c] = (float)block.Pixels[i][c];
+
+		float endpoint0[4];
+		float endpoint1[4];
+		FitEndpoints(points, 16, 4, endpoint0, endpoint1);
+
+		uint8 quantized[2][4];
+		uint8 pBits[2];
+		uint8 indices[16];
+		uint32 bestError = UINT32_MAX;
+
+		for (uint32 iteration = 0; iteration < 3; ++iteration)
+		{
+			uint8 candidate[2][4];
+			uint8 candidatePBits[2];
+			QuantizeBC7Endpoint(endpoint0, candidate[0], candidatePBits[0]);
+			QuantizeBC7Endpoint(endpoint1, candidate[1], candidatePBits[1]);
+
+			int32 unquantized[2][4];
+			for (uint32 e = 0; e < 2; ++e)
+				for (uint32 c = 0; c < 4; ++c)
+					unquantized[e][c] = candidate[e][c] * 2 + candidatePBits[e];
+
+			uint8 candidateIndices[16];
+			uint32 error = FindBC7Indices(block, unquantized[0], unquantized[1], candidateIndices);
+			if (error >= bestError)
+				break;
+
+			bestError = error;
+			memcpy(quantized, candidate, sizeof(quantized));
+			memcpy(pBits, candidatePBits, sizeof(pBits));
+			memcpy(indices, candidateIndices, sizeof(indices));
+
+			if (error == 0)
+				break;
+
+			float weights[16];
+			for (uint32 i = 0; i < 16; ++i)
+				weights[i] = c_BC7Weights4[indices[i]] / 64.0f;
+
+			if (!RefineEndpoints(points, weights, 16, 4, endpoint0, endpoint1))
+				break;
+		}
+
+		// The most significant bit of the first index is implicit (0), the weights are symmetric
+		if (indices[0] & 8)
+		{
+			std::swap(quantized[0], quantized[1]);
+			std::swap(pBits[0], pBits[1]);
+			for (uint32 i = 0; i < 16; ++i)
+				indices[i] = 15 - indices[i];
+		}
+
+		memset(out, 0, 16);
+		BlockBitWriter writer { out };
+		// Mode 6 - 6 zero bits and a one
+		writer.Write(1 << 6, 7);
+		for (uint32 c = 0; c < 4; ++c)
+		{
+			writer.Write(quantized[0][c], 7);
+			writer.Write(quantized[1][c], 7);
+		}
+		writer.Write(pBits[0], 1);
+		writer.Write(pBits[1], 1);
+		writer.Write(indices[0], 3);
+		for (uint32 i = 1; i < 16; ++i)
+			writer.Write(indices[i], 4);
+
+		ionassert(writer.Offset == 128);
+	}
+
+	static bool DecodeBC7Block(const uint8* in, PixelBlock& outBlock)
+	{
+		BlockBitReader reader { in };
+
+		uint32 mode = 0;
+		while (mode < 8 && reader.Read(1) == 0)
+			++mode;
+
+		if (mode != 6)
+			return false;
+
+		int32 endpoints[2][4];
+		for (uint32 c = 0; c < 4; ++c)
+		{
+			endpoints[0][c] = (int32)reader.Read(7) << 1;
+			endpoints[1][c] = (int32)reader.Read(7) << 1;
+		}
+		uint32 pBit0 = reader.Read(1);
+		uint32 pBit1 = reader.Read(1);
+		for (uint32 c = 0; c < 4; ++c)
+		{
+			endpoints[0][c] |= pBit0;
+			endpoints[1][c] |= pBit1;
+		}
+
+		for (uint32 i = 0; i < 16; ++i)
+		{
+			int32 weight = c_BC7Weights4[reader.Read(i == 0 ? 3 : 4)];
+			for (uint32 c = 0; c < 4; ++c)
+				outBlock.Pixels[i][c] = (uint8)InterpolateBC7(endpoints[0][c], endpoints[1][c], weight);
+		}
+
+		return true;
+	}
+
+	// Texture Compression -----------------------------------------------------------
+
+	void TextureCompression::Encode(ETextureFormat format, const uint8* pixels, uint32 width, uint32 height, uint8* outBlocks)
+	{
+		TRACE_FUNCTION();
+
+		ionassert(TextureDescription::IsBlockCompressed(format));
+		ionassert(pixels && outBlocks);
+		ionassert(width > 0 && height > 0);
+
+		uint32 blocksX = (width + 3) / 4;
+		uint32 blocksY = (height + 3) / 4;
+		uint32 blockSize = TextureDescription::GetBlockSize(format);
+
+		PixelBlock block;
+		for (uint32 blockY = 0; blockY < blocksY; ++blockY)
+		{
+			for (uint32 blockX = 0; blockX < blocksX; ++blockX)
+			{
+				LoadBlock(pixels, width, height, blockX, blockY, block);
+				uint8* out = outBlocks + ((size_t)blockY * blocksX + blockX) * blockSize;
+
+				switch (format)
+				{
+				case ETextureFormat::BC1:
+				{
+					EncodeColorBlock(block, true, false, out);
+					break;
+				}
+				case ETextureFormat::BC3:
+				{
+					uint8 alpha[16];
+					for (uint32 i = 0; i < 16; ++i)
+						alpha[i] = block.Pixels[i][3];
+
+					EncodeValueBlock(alpha, out);
+					EncodeColorBlock(block, false, true, out + 8);
+					break;
+				}
+				case ETextureFormat::BC5:
+				{
+					uint8 red[16];
+					uint8 green[16];
+					for (uint32 i = 0; i < 16; ++i)
+					{
+						red[i] = block.Pixels[i][0];
+						green[i] = block.Pixels[i][1];
+					}
+
+					EncodeValueBlock(red, out);
+					EncodeValueBlock(green, out + 8);
+					break;
+				}
+				case ETextureFormat::BC7:
+				{
+					EncodeBC7Block(block, out);
+					break;
+				}
+				}
+			}
+		}
+	}
+
+	bool TextureCompression::Decode(ETextureFormat format, const uint8* blocks, uint32 width, uint32 height, uint8* outPixels)
+	{
+		TRACE_FUNCTION();
+
+		ionassert(TextureDescription::IsBlockCompressed(format));
+		ionassert(blocks && outPixels);
+
+		uint32 blocksX = (width + 3) / 4;
+		uint32 blocksY = (height + 3) / 4;
+		uint32 blockSize = TextureDescription::GetBlockSize(format);
+
+		PixelBlock block;
+		for (uint32 blockY = 0; blockY < blocksY; ++blockY)
+		{
+			for (uint32 blockX = 0; blockX < blocksX; ++blockX)
+			{
+				const uint8* in = blocks + ((size_t)blockY * blocksX + blockX) * blockSize;
+
+				switch (format)
+				{
+				case ETextureFormat::BC1:
+				{
+					DecodeColorBlock(in, false, block);
+					break;
+				}
+				case ETextureFormat::BC3:
+				{
+					uint8 alpha[16];
+					DecodeValueBlock(in, alpha);
+					DecodeColorBlock(in + 8, true, block);
+					for (uint32 i = 0; i < 16; ++i)
+						block.Pixels[i][3] = alpha[i];
+					break;
+				}
+				case ETextureFormat::BC5:
+				{
+					uint8 red[16];
+					uint8 green[16];
+					DecodeValueBlock(in, red);
+					DecodeValueBlock(in + 8, green);
+					for (uint32 i = 0; i < 16; ++i)
+					{
+						block.Pixels[i][0] = red[i];
+						block.Pixels[i][1] = green[i];
+						block.Pixels[i][2] = 0;
+						block.Pixels[i][3] = 255;
+					}
+					break;
+				}
+				case ETextureFormat::BC7:
+				{
+					if (!DecodeBC7Block(in, block))
+						return false;
+					break;
+				}
+				}
+
+				StoreBlock(block, width, height, blockX, blockY, outPixels);
+			}
+		}
+
+		return true;
+	}
+}
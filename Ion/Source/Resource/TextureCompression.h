@@ -0,0 +1,39 @@
+#pragma once
+
+#include "RHI/Texture.h"
+
+namespace Ion
+{
+	/**
+	 * @brief CPU encoder and decoder of the block compressed texture formats.
+	 *
+	 * @details The encoders fit the endpoints of every 4x4 block along the principal axis
+	 * of its colors (BC1, BC3 color), or to the range of its values (BC3 alpha, BC5).
+	 * BC7 blocks are always encoded in mode 6 (a single RGBA subset, 4-bit indices),
+	 * so only the mode 6 blocks can be decoded.
+	 *
+	 * The decoders are used to verify the cooked textures and to load them
+	 * with an RHI that doesn't support the format (see RHI::SupportsTextureFormat).
+	 */
+	class ION_API TextureCompression
+	{
+	public:
+		/**
+		 * @brief Encodes an RGBA8 image into blocks of the format.
+		 * The edge blocks of an image that is not a multiple of 4 are padded with the edge pixels.
+		 *
+		 * @param pixels RGBA8 pixels, tightly packed
+		 * @param outBlocks Has to have space for CalcMipLineSize * CalcMipLineCount bytes (see TextureDescription)
+		 */
+		static void Encode(ETextureFormat format, const uint8* pixels, uint32 width, uint32 height, uint8* outBlocks);
+
+		/**
+		 * @brief Decodes the blocks into RGBA8 pixels.
+		 * BC5 is decoded into the red and green channels (blue is 0, alpha is 255).
+		 *
+		 * @param outPixels Has to have space for width * height * 4 bytes
+		 * @return false, if a block cannot be decoded (e.g. a BC7 block of a mode other than 6)
+		 */
+		static bool Decode(ETextureFormat format, const uint8* blocks, uint32 width, uint32 height, uint8* outPixels);
+	};
+}
@@ -0,0 +1,236 @@
+#include "IonPCH.h"
+
+#include "TextureCooker.h"
+#include "TextureStreamer.h"
+#include "TextureResource.h"
+
+#include "Asset/AssetRegistry.h"
+
+namespace Ion
+{
+	TextureCooker* TextureCooker::s_Instance = nullptr;
+
+	static const char* GetCookedFormatName(ETextureFormat format)
+	{
+		switch (format)
+		{
+		case ETextureFormat::BC1: return "BC1";
+		case ETextureFormat::BC3: return "BC3";
+		case ETextureFormat::BC5: return "BC5";
+		case ETextureFormat::BC7: return "BC7";
+		default:                  return "RGBA8";
+		}
+	}
+
+	TextureCooker::TextureCooker() :
+		m_MipFilter(ETextureMipFilter::Default)
+	{
+	}
+
+	TextureCookSettings TextureCooker::GetCookSettings(const Asset& asset)
+	{
+		ionassert(asset->GetType() == AT_ImageAssetType);
+
+		TSharedPtr<ImageAssetData> data = PtrCast<ImageAssetData>(asset->GetCustomData());
+
+		TextureCookSettings settings;
+		settings.Compression = data->Description.Properties.Compression;
+		settings.MipFilter = Get().m_MipFilter;
+		return settings;
+	}
+
+	bool TextureCooker::Cook(const Asset& asset, bool bForce, bool& bOutCooked)
+	{
+		TRACE_FUNCTION();
+
+		bOutCooked = false;
+
+		ionassert(asset->GetType() == AT_ImageAssetType);
+
+		File sourceFile(asset->GetImportPath());
+		if (!sourceFile.Open(EFileMode::Read))
+		{
+			ResourceLogger.Error("Cannot cook the texture \"{}\". The source file cannot be opened.", asset->GetVirtualPath());
+			return false;
+		}
+
+		TArray<uint8> sourceData((size_t)sourceFile.GetSize());
+		bool bRead = (bool)sourceFile.Read(sourceData.data(), sourceData.size());
+		sourceFile.Close();
+
+		if (!bRead)
+		{
+			ResourceLogger.Error("Cannot cook the texture \"{}\". The source file cannot be read.", asset->GetVirtualPath());
+			return false;
+		}
+
+		uint64 sourceHash = HashBytes(sourceData.data(), sourceData.size());
+		TextureCookSettings settings = GetCookSettings(asset);
+		FilePath path = TextureStreamer::GetMipChainPath(asset);
+
+		TextureMipChain mipChain;
+		if (!bForce && LoadCookedHeader(path, sourceHash, settings, mipChain))
+		{
+			ResourceLogger.Trace("Texture \"{}\" is up to date.", asset->GetVirtualPath());
+			return true;
+		}
+
+		// Non-owning, the data is freed with the array
+		std::shared_ptr<AssetFileMemoryBlock> source = std::make_shared<AssetFileMemoryBlock>(AssetFileMemoryBlock { sourceData.data(), sourceData.size() });
+		bool bSaved = false;
+		if (!CookSource(source, sourceHash, settings, path, mipChain, bSaved))
+		{
+			ResourceLogger.Error("Cannot cook the texture \"{}\". The source image cannot be decoded.", asset->GetVirtualPath());
+			return false;
+		}
+
+		bOutCooked = true;
+		return bSaved;
+	}
+
+	bool TextureCooker::Cook(const Asset& asset, bool bForce)
+	{
+		bool bCooked;
+		return Cook(asset, bForce, bCooked);
+	}
+
+	uint32 TextureCooker::CookAll(bool bForce)
+	{
+		TRACE_FUNCTION();
+
+		uint32 cookedCount = 0;
+		uint32 failedCount = 0;
+
+		for (const Asset& asset : AssetRegistry::GetAllRegisteredAssets(AT_ImageAssetType))
+		{
+			bool bCooked;
+			if (!Cook(asset, bForce, bCooked))
+				++failedCount;
+			else if (bCooked)
+				++cookedCount;
+		}
+
+		ResourceLogger.Info("Cooked {} textures ({} failed).", cookedCount, failedCount);
+
+		return cookedCount;
+	}
+
+	bool TextureCooker::CookSource(const std::shared_ptr<AssetFileMemoryBlock>& source, uint64 sourceHash, const TextureCookSettings& settings, const FilePath& path, TextureMipChain& outMipChain, bool& bOutSaved)
+	{
+		TRACE_FUNCTION();
+
+		std::shared_ptr<Image> image = AssetImporter::ImportImageAsset(source);
+		if (!image || !image->IsLoaded())
+			return false;
+
+		outMipChain = TextureMipChain::Generate(*image, sourceHash, settings);
+
+		if (TextureDescription::IsBlockCompressed(outMipChain.GetFormat()))
+		{
+			float psnr = 0.0f;
+			if (!Verify(outMipChain, *image, psnr))
+			{
+				ResourceLogger.Error("The cooked texture \"{}\" cannot be decoded.", path.ToString());
+			}
+			ResourceLogger.Info("Cooked texture \"{}\" - {} {}x{}, {} mips, PSNR {:.2f} dB.",
+				path.ToString(), GetCookedFormatName(outMipChain.GetFormat()), outMipChain.GetWidth(), outMipChain.GetHeight(), outMipChain.GetMipCount(), psnr);
+		}
+		else
+		{
+			ResourceLogger.Info("Cooked texture \"{}\" - RGBA8 {}x{}, {} mips.",
+				path.ToString(), outMipChain.GetWidth(), outMipChain.GetHeight(), outMipChain.GetMipCount());
+		}
+
+		bOutSaved = Get().SaveMipChain(outMipChain, path);
+		return true;
+	}
+
+	bool TextureCooker::LoadCookedHeader(const FilePath& path, uint64 sourceHash, const TextureCookSettings& settings, TextureMipChain& outMipChain)
+	{
+		TextureCooker& instance = Get();
+
+		ScopedLock lock(instance.m_FileMutex);
+		return outMipChain.LoadHeader(path) && IsUpToDate(outMipChain, sourceHash, settings);
+	}
+
+	bool TextureCooker::LoadCookedMips(const FilePath& path, TextureMipChain& mipChain, uint32 firstMip)
+	{
+		TextureCooker& instance = Get();
+
+		ScopedLock lock(instance.m_FileMutex);
+		return mipChain.LoadMips(path, firstMip);
+	}
+
+	bool TextureCooker::IsUpToDate(const TextureMipChain& mipChain, uint64 sourceHash, const TextureCookSettings& settings)
+	{
+		return
+			mipChain.IsValid() &&
+			mipChain.GetSourceHash() == sourceHash &&
+			mipChain.GetCookSettings() == settings;
+	}
+
+	bool TextureCooker::Verify(const TextureMipChain& mipChain, const Image& image, float& outPSNR)
+	{
+		TRACE_FUNCTION();
+
+		ionassert(mipChain.IsValid());
+		ionassert(image.GetWidth() == mipChain.GetWidth() && image.GetHeight() == mipChain.GetHeight());
+
+		TArray<uint8> decoded;
+		if (!mipChain.DecodeMip(0, decoded))
+			return false;
+
+		const uint8* pixels = image.GetPixelData();
+		// BC5 only stores the red and green channels
+		uint32 channelCount = mipChain.GetFormat() == ETextureFormat::BC5 ? 2 : 4;
+
+		double squaredError = 0.0;
+		size_t pixelCount = (size_t)image.GetWidth() * image.GetHeight();
+		for (size_t i = 0; i < pixelCount; ++i)
+		{
+			for (uint32 c = 0; c < channelCount; ++c)
+			{
+				double delta = (double)decoded[i * 4 + c] - (double)pixels[i * 4 + c];
+				squaredError += delta * delta;
+			}
+		}
+
+		double meanSquaredError = squaredError / (double)(pixelCount * channelCount);
+		outPSNR = meanSquaredError > 0.0 ?
+			(float)(10.0 * std::log10(255.0 * 255.0 / meanSquaredError)) :
+			std::numeric_limits<float>::infinity();
+
+		return true;
+	}
+
+	void TextureCooker::SetMipFilter(ETextureMipFilter filter)
+	{
+		Get().m_MipFilter = filter;
+	}
+
+	ETextureMipFilter TextureCooker::GetMipFilter()
+	{
+		return Get().m_MipFilter;
+	}
+
+	bool TextureCooker::SaveMipChain(const TextureMipChain& mipChain, const FilePath& path)
+	{
+		TRACE_FUNCTION();
+
+		ScopedLock lock(m_FileMutex);
+
+		FilePath cachePath = path;
+		cachePath.Back();
+		if (!cachePath.IsDirectory())
+		{
+			FilePath parent = cachePath;
+			if (!parent.Back().MkDir(cachePath.LastElement()))
+			{
+				ResourceLogger.Error("Cannot create the texture cache directory \"{}\".", cachePath.ToString());
+				return false;
+			}
+		}
+
+		return mipChain.Save(path);
+	}
+}
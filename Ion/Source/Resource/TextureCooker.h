@@ -0,0 +1,94 @@
+#pragma once
+
+#include "TextureMipChain.h"
+#include "Asset/Asset.h"
+
+namespace Ion
+{
+	/**
+	 * @brief Cooks the image assets into the mip chain files (see TextureMipChain),
+	 * so the textures can be loaded with a straight read and upload, without decoding
+	 * the source images or generating the mips at runtime.
+	 *
+	 * @details The files are stored in the texture cache (see TextureStreamer::GetMipChainPath).
+	 * A file is cooked again if the source image or the cook settings have changed.
+	 * The textures that haven't been cooked offline get cooked on their first import.
+	 *
+	 * Thread-safe, the files are accessed under a lock.
+	 */
+	class ION_API TextureCooker
+	{
+	public:
+		/* Compression from the asset properties, the mip filter is global (see SetMipFilter) */
+		static TextureCookSettings GetCookSettings(const Asset& asset);
+
+		/**
+		 * @brief Cooks the image asset, if its file is missing or stale.
+		 *
+		 * @param bForce Cook the asset even if the file is up to date
+		 * @param bOutCooked false, if the file was up to date
+		 * @return false, if the source cannot be read or decoded, or the file cannot be written
+		 */
+		static bool Cook(const Asset& asset, bool bForce, bool& bOutCooked);
+		static bool Cook(const Asset& asset, bool bForce = false);
+
+		/**
+		 * @brief Cooks all the registered image assets.
+		 *
+		 * @return Number of the assets that have been cooked (the ones that were up to date are skipped)
+		 */
+		static uint32 CookAll(bool bForce = false);
+
+		/**
+		 * @brief Decodes the source image, generates the mip chain and writes it to the file.
+		 *
+		 * @param source Source image file
+		 * @param outMipChain The mip chain with all the mips loaded
+		 * @param bOutSaved false, if the file cannot be written (the mip chain can still be used)
+		 * @return false, if the source image cannot be decoded
+		 */
+		static bool CookSource(const std::shared_ptr<AssetFileMemoryBlock>& source, uint64 sourceHash, const TextureCookSettings& settings, const FilePath& path, TextureMipChain& outMipChain, bool& bOutSaved);
+
+		/**
+		 * @brief Reads the header of the cooked file.
+		 *
+		 * @return false, if the file is missing, invalid or stale
+		 */
+		static bool LoadCookedHeader(const FilePath& path, uint64 sourceHash, const TextureCookSettings& settings, TextureMipChain& outMipChain);
+		/* Reads the mips [firstMip, MipCount) of the cooked file, call LoadCookedHeader first. */
+		static bool LoadCookedMips(const FilePath& path, TextureMipChain& mipChain, uint32 firstMip);
+
+		static bool IsUpToDate(const TextureMipChain& mipChain, uint64 sourceHash, const TextureCookSettings& settings);
+
+		/**
+		 * @brief Decodes the first mip of the cooked mip chain on the CPU and compares it with the source image.
+		 *
+		 * @param outPSNR Peak signal-to-noise ratio of the RGBA channels in dB (infinity, if the pixels are the same)
+		 * @return false, if the mip cannot be decoded
+		 */
+		static bool Verify(const TextureMipChain& mipChain, const Image& image, float& outPSNR);
+
+		static void SetMipFilter(ETextureMipFilter filter);
+		static ETextureMipFilter GetMipFilter();
+
+	private:
+		TextureCooker();
+
+		static TextureCooker& Get();
+
+		bool SaveMipChain(const TextureMipChain& mipChain, const FilePath& path);
+
+	private:
+		ETextureMipFilter m_MipFilter;
+
+		/* Held while the files are read or written */
+		Mutex m_FileMutex;
+
+		static TextureCooker* s_Instance;
+	};
+
+	inline TextureCooker& TextureCooker::Get()
+	{
+		return *(s_Instance ? s_Instance : s_Instance = new TextureCooker);
+	}
+}
@@ -0,0 +1,451 @@
+#include "IonPCH.h"
+
+#include "TextureMipChain.h"
+#include "TextureCompression.h"
+
+#include "Core/Math/MathKernels.h"
+
+#include <immintrin.h>
+
+namespace Ion
+{
+	TextureMipChain::TextureMipChain() :
+		m_Header({ })
+	{
+	}
+
+	// Mip filter ------------------------------------------------------------------------
+
+	/**
+	 * @brief Separable 2:1 downsampling kernel.
+	 * Output pixel x is filtered from the source pixels [2x + FirstTap, 2x + FirstTap + Weights.size()).
+	 */
+	struct MipFilterKernel
+	{
+		int32 FirstTap;
+		TArray<float> Weights;
+	};
+
+	/* Zeroth order modified Bessel function of the first kind */
+	static float BesselI0(float x)
+	{
+		float sum = 1.0f;
+		float term = 1.0f;
+		float halfX = x * 0.5f;
+		for (int32 k = 1; k < 32; ++k)
+		{
+			term *= (halfX / k) * (halfX / k);
+			sum += term;
+			if (term < sum * 1e-7f)
+				break;
+		}
+		return sum;
+	}
+
+	static MipFilterKernel MakeMipFilterKernel(ETextureMipFilter filter)
+	{
+		if (filter == ETextureMipFilter::Box)
+			return MipFilterKernel { 0, { 0.5f, 0.5f } };
+
+		// Kaiser windowed sinc, 3 destination pixels wide on each side
+		constexpr float Width = 3.0f;
+		constexpr float Alpha = 4.0f;
+		constexpr int32 TapCount = (int32)Width * 4;
+
+		MipFilterKernel kernel { 1 - TapCount / 2, { } };
+		kernel.Weights.resize(TapCount);
+
+		float sum = 0.0f;
+		for (int32 i = 0; i < TapCount; ++i)
+		{
+			// Distance of the source pixel center from the output pixel center in the destination pixels
+			float t = ((float)(kernel.FirstTap + i) - 0.5f) * 0.5f;
+			float angle = (float)Math::PI * t;
+			float sinc = angle == 0.0f ? 1.0f : std::sin(angle) / angle;
+			float x = t / Width;
+			float window = std::abs(x) < 1.0f ? BesselI0(Alpha * std::sqrt(1.0f - x * x)) / BesselI0(Alpha) : 0.0f;
+
+			kernel.Weights[i] = sinc * window;
+			sum += kernel.Weights[i];
+		}
+
+		for (float& weight : kernel.Weights)
+			weight /= sum;
+
+		return kernel;
+	}
+
+	/* Filters each row of RGBA float pixels (width -> outWidth) */
+	static void FilterRows_Scalar(const float* source, uint32 width, uint32 height, float* destination, uint32 outWidth, const MipFilterKernel& kernel)
+	{
+		for (uint32 y = 0; y < height; ++y)
+		{
+			const float* row = source + (size_t)y * width * 4;
+			float* out = destination + (size_t)y * outWidth * 4;
+
+			for (uint32 x = 0; x < outWidth; ++x)
+			{
+				float sum[4] = { };
+				for (size_t i = 0; i < kernel.Weights.size(); ++i)
+				{
+					// Clamp to the edge
+					int32 sourceX = std::clamp((int32)(x * 2) + kernel.FirstTap + (int32)i, 0, (int32)width - 1);
+					for (uint32 c = 0; c < 4; ++c)
+						sum[c] += row[sourceX * 4 + c] * kernel.Weights[i];
+				}
+				memcpy(out + x * 4, sum, sizeof(sum));
+			}
+		}
+	}
+
+	/* Filters each column of RGBA float pixels (height -> outHeight) */
+	static void FilterColumns_Scalar(const float* source, uint32 width, uint32 height, float* destination, uint32 outHeight, const MipFilterKernel& kernel)
+	{
+		size_t rowSize = (size_t)width * 4;
+		for (uint32 y = 0; y < outHeight; ++y)
+		{
+			float* out = destination + y * rowSize;
+			memset(out, 0, rowSize * sizeof(float));
+
+			// Accumulate whole rows, so the inner loop goes through contiguous memory
+			for (size_t i = 0; i < kernel.Weights.size(); ++i)
+			{
+				int32 sourceY = std::clamp((int32)(y * 2) + kernel.FirstTap + (int32)i, 0, (int32)height - 1);
+				const float* row = source + sourceY * rowSize;
+				float weight = kernel.Weights[i];
+
+				for (size_t x = 0; x < rowSize; ++x)
+					out[x] += row[x] * weight;
+			}
+		}
+	}
+
+	/* One pixel (RGBA) per register */
+	static void FilterRows_SSE(const float* source, uint32 width, uint32 height, float* destination, uint32 outWidth, const MipFilterKernel& kernel)
+	{
+		for (uint32 y = 0; y < height; ++y)
+		{
+			const float* row = source + (size_t)y * width * 4;
+			float* out = destination + (size_t)y * outWidth * 4;
+
+			for (uint32 x = 0; x < outWidth; ++x)
+			{
+				__m128 sum = _mm_setzero_ps();
+				for (size_t i = 0; i < kernel.Weights.size(); ++i)
+				{
+					int32 sourceX = std::clamp((int32)(x * 2) + kernel.FirstTap + (int32)i, 0, (int32)width - 1);
+					sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(row + sourceX * 4), _mm_set1_ps(kernel.Weights[i])));
+				}
+				_mm_storeu_ps(out + x * 4, sum);
+			}
+		}
+	}
+
+	static void FilterColumns_SSE(const float* source, uint32 width, uint32 height, float* destination, uint32 outHeight, const MipFilterKernel& kernel)
+	{
+		size_t rowSize = (size_t)width * 4;
+		for (uint32 y = 0; y < outHeight; ++y)
+		{
+			float* out = destination + y * rowSize;
+			memset(out, 0, rowSize * sizeof(float));
+
+			for (size_t i = 0; i < kernel.Weights.size(); ++i)
+			{
+				int32 sourceY = std::clamp((int32)(y * 2) + kernel.FirstTap + (int32)i, 0, (int32)height - 1);
+				const float* row = source + sourceY * rowSize;
+				__m128 weight = _mm_set1_ps(kernel.Weights[i]);
+
+				// A row is always a multiple of 4 floats
+				for (size_t x = 0; x < rowSize; x += 4)
+					_mm_storeu_ps(out + x, _mm_add_ps(_mm_loadu_ps(out + x), _mm_mul_ps(_mm_loadu_ps(row + x), weight)));
+			}
+		}
+	}
+
+	/* Converts float pixels [0, 255] to RGBA8, the negative lobes of the filter can overshoot. */
+	static void QuantizePixels(const float* source, size_t count, uint8* destination)
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			destination[i] = (uint8)(std::clamp(source[i], 0.0f, 255.0f) + 0.5f);
+		}
+	}
+
+	// Texture Mip Chain -----------------------------------------------------------------
+
+	ETextureFormat TextureMipChain::SelectFormat(const Image& image, ETextureCompression compression)
+	{
+		if (compression == ETextureCompression::None)
+			return ETextureFormat::RGBA8;
+
+		// Every mip that can become the top mip of a streamed texture would have to be a multiple of 4 too,
+		// see TextureStreamer::CalcMinResidentFirstMip.
+		if (image.GetWidth() % 4 != 0 || image.GetHeight() % 4 != 0)
+			return ETextureFormat::RGBA8;
+
+		switch (compression)
+		{
+		case ETextureCompression::BC1: return ETextureFormat::BC1;
+		case ETextureCompression::BC3: return ETextureFormat::BC3;
+		case ETextureCompression::BC5: return ETextureFormat::BC5;
+		case ETextureCompression::BC7: return ETextureFormat::BC7;
+		}
+
+		// Default - keep the alpha channel only if it's needed
+		const uint8* pixels = image.GetPixelData();
+		size_t pixelCount = (size_t)image.GetWidth() * image.GetHeight();
+		for (size_t i = 0; i < pixelCount; ++i)
+		{
+			if (pixels[i * 4 + 3] != 255)
+				return ETextureFormat::BC3;
+		}
+		return ETextureFormat::BC1;
+	}
+
+	TextureMipChain TextureMipChain::Generate(const Image& image, uint64 sourceHash, const TextureCookSettings& settings)
+	{
+		TRACE_FUNCTION();
+
+		ionassert(image.IsLoaded());
+		ionassert(image.GetChannelNum() == 4, "Only RGBA8 images are supported.");
+
+		TextureDimensions dimensions { (uint32)image.GetWidth(), (uint32)image.GetHeight() };
+		uint32 mipCount = TextureDescription::CalcMipLevelCount(dimensions);
+		ETextureFormat format = SelectFormat(image, settings.Compression);
+
+		TextureMipChain chain;
+		chain.m_Header.Magic = TextureMipChainHeader::MagicValue;
+		chain.m_Header.Version = FileVersion;
+		chain.m_Header.SourceHash = sourceHash;
+		chain.m_Header.Width = dimensions.Width;
+		chain.m_Header.Height = dimensions.Height;
+		chain.m_Header.MipCount = mipCount;
+		chain.m_Header.Format = (uint32)format;
+		chain.m_Header.Compression = (uint32)settings.Compression;
+		chain.m_Header.MipFilter = (uint32)settings.MipFilter;
+
+		chain.m_Mips.resize(mipCount);
+		chain.m_MipData.resize(mipCount);
+
+		MipFilterKernel kernel = MakeMipFilterKernel(settings.MipFilter);
+		bool bSSE = Math::GetSIMDLevel() >= ESIMDLevel::SSE;
+
+		// The mips are filtered from the previous mip, in float precision
+		TArray<float> mipPixels((size_t)dimensions.Width * dimensions.Height * 4);
+		TArray<float> filteredRows;
+		TArray<uint8> quantizedPixels(mipPixels.size());
+
+		const uint8* imagePixels = image.GetPixelData();
+		for (size_t i = 0; i < mipPixels.size(); ++i)
+			mipPixels[i] = (float)imagePixels[i];
+
+		uint64 offset = sizeof(TextureMipChainHeader) + sizeof(TextureMipChainMip) * mipCount;
+		for (uint32 mip = 0; mip < mipCount; ++mip)
+		{
+			TextureDimensions mipDimensions = TextureDescription::CalcMipDimensions(dimensions, mip);
+
+			if (mip > 0)
+			{
+				TextureDimensions sourceDimensions = TextureDescription::CalcMipDimensions(dimensions, mip - 1);
+
+				filteredRows.resize((size_t)mipDimensions.Width * sourceDimensions.Height * 4);
+				if (bSSE)
+				{
+					FilterRows_SSE(mipPixels.data(), sourceDimensions.Width, sourceDimensions.Height, filteredRows.data(), mipDimensions.Width, kernel);
+					FilterColumns_SSE(filteredRows.data(), mipDimensions.Width, sourceDimensions.Height, mipPixels.data(), mipDimensions.Height, kernel);
+				}
+				else
+				{
+					FilterRows_Scalar(mipPixels.data(), sourceDimensions.Width, sourceDimensions.Height, filteredRows.data(), mipDimensions.Width, kernel);
+					FilterColumns_Scalar(filteredRows.data(), mipDimensions.Width, sourceDimensions.Height, mipPixels.data(), mipDimensions.Height, kernel);
+				}
+			}
+
+			TextureMipChainMip& mipDesc = chain.m_Mips[mip];
+			mipDesc.Width = mipDimensions.Width;
+			mipDesc.Height = mipDimensions.Height;
+			mipDesc.LineSize = TextureDescription::CalcMipLineSize(format, mipDimensions.Width);
+			mipDesc.Size = (uint64)mipDesc.LineSize * TextureDescription::CalcMipLineCount(format, mipDimensions.Height);
+			mipDesc.Offset = offset;
+			offset += mipDesc.Size;
+
+			TArray<uint8>& data = chain.m_MipData[mip];
+			data.resize(mipDesc.Size);
+
+			size_t valueCount = (size_t)mipDimensions.Width * mipDimensions.Height * 4;
+			if (format == ETextureFormat::RGBA8)
+			{
+				QuantizePixels(mipPixels.data(), valueCount, data.data());
+			}
+			else
+			{
+				QuantizePixels(mipPixels.data(), valueCount, quantizedPixels.data());
+				TextureCompression::Encode(format, quantizedPixels.data(), mipDimensions.Width, mipDimensions.Height, data.data());
+			}
+		}
+
+		return chain;
+	}
+
+	bool TextureMipChain::LoadHeader(const FilePath& path)
+	{
+		TRACE_FUNCTION();
+
+		*this = TextureMipChain();
+
+		if (!path.IsFile())
+			return false;
+
+		File file(path);
+		if (!file.Open(EFileMode::Read))
+			return false;
+
+		TextureMipChainHeader header { };
+		bool bValid = file.Read((uint8*)&header, sizeof(header)) &&
+			header.Magic == TextureMipChainHeader::MagicValue &&
+			header.Version == FileVersion &&
+			(header.Format == (uint32)ETextureFormat::RGBA8 || TextureDescription::IsBlockCompressed((ETextureFormat)header.Format)) &&
+			header.MipCount > 0 &&
+			header.MipCount == TextureDescription::CalcMipLevelCount({ header.Width, header.Height });
+
+		TArray<TextureMipChainMip> mips;
+		if (bValid)
+		{
+			mips.resize(header.MipCount);
+			bValid = (bool)file.Read((uint8*)mips.data(), sizeof(TextureMipChainMip) * mips.size());
+		}
+
+		if (bValid)
+		{
+			uint64 fileSize = (uint64)file.GetSize();
+			for (const TextureMipChainMip& mip : mips)
+			{
+				ETextureFormat format = (ETextureFormat)header.Format;
+				bValid &=
+					mip.Offset + mip.Size <= fileSize &&
+					mip.LineSize == TextureDescription::CalcMipLineSize(format, mip.Width) &&
+					mip.Size == (uint64)mip.LineSize * TextureDescription::CalcMipLineCount(format, mip.Height);
+			}
+		}
+
+		file.Close();
+
+		if (!bValid)
+		{
+			ResourceLogger.Warn("Mip chain file \"{}\" is invalid.", path.ToString());
+			return false;
+		}
+
+		m_Header = header;
+		m_Mips = Move(mips);
+		m_MipData.resize(header.MipCount);
+
+		return true;
+	}
+
+	bool TextureMipChain::LoadMips(const FilePath& path, uint32 firstMip)
+	{
+		TRACE_FUNCTION();
+
+		ionassert(IsValid(), "Load the header first.");
+		ionassert(firstMip < GetMipCount());
+
+		File file(path);
+		if (!file.Open(EFileMode::Read))
+			return false;
+
+		bool bResult = true;
+		for (uint32 mip = firstMip; mip < GetMipCount() && bResult; ++mip)
+		{
+			const TextureMipChainMip& mipDesc = m_Mips[mip];
+			TArray<uint8>& data = m_MipData[mip];
+			data.resize(mipDesc.Size);
+
+			bResult =
+				file.SetOffset((int64)mipDesc.Offset) &&
+				file.Read(data.data(), mipDesc.Size);
+		}
+
+		file.Close();
+
+		if (!bResult)
+		{
+			ResourceLogger.Error("Cannot read the mips of \"{}\".", path.ToString());
+			FreeMips();
+		}
+
+		return bResult;
+	}
+
+	bool TextureMipChain::Save(const FilePath& path) const
+	{
+		TRACE_FUNCTION();
+
+		ionassert(IsValid());
+
+		File file(path);
+		if (!file.Open(EFileMode::Write | EFileMode::Reset | EFileMode::CreateNew))
+		{
+			ResourceLogger.Error("Cannot open the mip chain file \"{}\".", file.GetFullPath());
+			return false;
+		}
+
+		bool bResult =
+			file.Write((const uint8*)&m_Header, sizeof(m_Header)) &&
+			file.Write((const uint8*)m_Mips.data(), sizeof(TextureMipChainMip) * m_Mips.size());
+
+		for (uint32 mip = 0; mip < GetMipCount() && bResult; ++mip)
+		{
+			ionassert(m_MipData[mip].size() == m_Mips[mip].Size, "All the mips have to be loaded.");
+			bResult = (bool)file.Write(m_MipData[mip].data(), m_MipData[mip].size());
+		}
+
+		file.Close();
+
+		if (!bResult)
+		{
+			ResourceLogger.Error("Cannot write the mip chain file \"{}\".", file.GetFullPath());
+		}
+
+		return bResult;
+	}
+
+	void TextureMipChain::FreeMips()
+	{
+		for (TArray<uint8>& data : m_MipData)
+		{
+			data.clear();
+			data.shrink_to_fit();
+		}
+	}
+
+	bool TextureMipChain::DecodeMip(uint32 mip, TArray<uint8>& outPixels) const
+	{
+		TRACE_FUNCTION();
+
+		ionassert(mip < GetMipCount());
+
+		const TextureMipChainMip& mipDesc = m_Mips[mip];
+		const TArray<uint8>& data = m_MipData[mip];
+		ionassert(data.size() == mipDesc.Size, "The mip has not been loaded.");
+
+		if (GetFormat() == ETextureFormat::RGBA8)
+		{
+			outPixels = data;
+			return true;
+		}
+
+		outPixels.resize((size_t)mipDesc.Width * mipDesc.Height * 4);
+		return TextureCompression::Decode(GetFormat(), data.data(), mipDesc.Width, mipDesc.Height, outPixels.data());
+	}
+
+	uint64 TextureMipChain::GetMipsSize(uint32 firstMip) const
+	{
+		uint64 size = 0;
+		for (uint32 mip = firstMip; mip < GetMipCount(); ++mip)
+		{
+			size += m_Mips[mip].Size;
+		}
+		return size;
+	}
+}
@@ -0,0 +1,204 @@
+#pragma once
+
+#include "ResourceCommon.h"
+#include "RHI/Texture.h"
+
+namespace Ion
+{
+	enum class ETextureMipFilter : uint8
+	{
+		Box    = 0, // 2x2 average
+		Kaiser = 1, // Kaiser windowed sinc - sharper, less aliasing
+
+		Default = 1,
+	};
+
+	/**
+	 * @brief Format the texture is cooked into.
+	 * The block compressed formats require the dimensions to be a multiple of 4,
+	 * other textures are stored uncompressed.
+	 */
+	enum class ETextureCompression : uint8
+	{
+		Default = 0, // BC1, or BC3 if the image has transparent pixels
+		None,        // RGBA8
+		BC1,
+		BC3,
+		BC5,         // Red and green channels only (e.g. normal maps)
+		BC7,
+	};
+
+	template<>
+	struct TEnumParser<ETextureCompression>
+	{
+		ENUM_PARSER_TO_STRING_BEGIN(ETextureCompression)
+		ENUM_PARSER_TO_STRING_HELPER(Default)
+		ENUM_PARSER_TO_STRING_HELPER(None)
+		ENUM_PARSER_TO_STRING_HELPER(BC1)
+		ENUM_PARSER_TO_STRING_HELPER(BC3)
+		ENUM_PARSER_TO_STRING_HELPER(BC5)
+		ENUM_PARSER_TO_STRING_HELPER(BC7)
+		ENUM_PARSER_TO_STRING_END()
+
+		ENUM_PARSER_FROM_STRING_BEGIN(ETextureCompression)
+		ENUM_PARSER_FROM_STRING_HELPER(Default)
+		ENUM_PARSER_FROM_STRING_HELPER(None)
+		ENUM_PARSER_FROM_STRING_HELPER(BC1)
+		ENUM_PARSER_FROM_STRING_HELPER(BC3)
+		ENUM_PARSER_FROM_STRING_HELPER(BC5)
+		ENUM_PARSER_FROM_STRING_HELPER(BC7)
+		ENUM_PARSER_FROM_STRING_END()
+	};
+
+	struct TextureCookSettings
+	{
+		ETextureCompression Compression = ETextureCompression::Default;
+		ETextureMipFilter MipFilter = ETextureMipFilter::Default;
+
+		bool operator==(const TextureCookSettings& other) const
+		{
+			return Compression == other.Compression && MipFilter == other.MipFilter;
+		}
+	};
+
+	/* Written at the beginning of every mip chain file */
+	struct TextureMipChainHeader
+	{
+		static constexpr uint32 MagicValue = 0x5850494D; // "MIPX"
+
+		uint32 Magic;
+		uint32 Version;
+		/* Hash of the source image file the mips have been generated from */
+		uint64 SourceHash;
+		uint32 Width;
+		uint32 Height;
+		uint32 MipCount;
+		/* ETextureFormat of the pixels */
+		uint32 Format;
+		/* Settings the file has been cooked with (ETextureCompression, ETextureMipFilter) */
+		uint32 Compression;
+		uint32 MipFilter;
+	};
+
+	/* Mip table entry, the table follows the header */
+	struct TextureMipChainMip
+	{
+		/* Offset of the pixels from the beginning of the file */
+		uint64 Offset;
+		uint64 Size;
+		uint32 Width;
+		uint32 Height;
+		/* Size of a row of pixels (or 4x4 blocks) in bytes */
+		uint32 LineSize;
+		uint32 Padding;
+	};
+
+	/**
+	 * @brief Texture stored with all its mips in the GPU format, so any range
+	 * of the mips can be read from the file and uploaded without any decoding.
+	 *
+	 * @details File layout: header, mip table, pixels of each mip (mip 0 first).
+	 * The pixels are either RGBA8 or block compressed (BC1, BC3, BC5, BC7).
+	 */
+	class ION_API TextureMipChain
+	{
+	public:
+		/* Incremented when the file format changes, the old files get rejected. */
+		static constexpr uint32 FileVersion = 2;
+		static constexpr const char* FileExtension = ".mips";
+
+		TextureMipChain();
+
+		/**
+		 * @brief Generates the full mip chain of the image and encodes it in the cooked format.
+		 * The image has to be RGBA8. The mips are filtered from the previous mip in float precision.
+		 *
+		 * @param sourceHash Hash of the source file, stored in the header
+		 */
+		static TextureMipChain Generate(const Image& image, uint64 sourceHash, const TextureCookSettings& settings = TextureCookSettings());
+
+		/* Format the image gets cooked into with the compression */
+		static ETextureFormat SelectFormat(const Image& image, ETextureCompression compression);
+
+		/* Reads the header and the mip table. */
+		bool LoadHeader(const FilePath& path);
+		/* Reads the pixels of the mips in range [firstMip, MipCount). Call LoadHeader first. */
+		bool LoadMips(const FilePath& path, uint32 firstMip);
+		bool Save(const FilePath& path) const;
+
+		/* Frees the pixels of all the mips, the header is kept. */
+		void FreeMips();
+
+		/**
+		 * @brief Decodes a loaded mip into RGBA8 pixels (e.g. to verify a cooked texture,
+		 * or to upload it with an RHI that doesn't support the format).
+		 */
+		bool DecodeMip(uint32 mip, TArray<uint8>& outPixels) const;
+
+		uint32 GetWidth() const;
+		uint32 GetHeight() const;
+		uint32 GetMipCount() const;
+		uint64 GetSourceHash() const;
+		ETextureFormat GetFormat() const;
+		TextureCookSettings GetCookSettings() const;
+		bool IsValid() const;
+
+		const TextureMipChainMip& GetMip(uint32 mip) const;
+		/* Empty if the mip has not been loaded */
+		const TArray<uint8>& GetMipData(uint32 mip) const;
+		/* Size of the mips in range [firstMip, MipCount) in bytes */
+		uint64 GetMipsSize(uint32 firstMip) const;
+
+	private:
+		TextureMipChainHeader m_Header;
+		TArray<TextureMipChainMip> m_Mips;
+		TArray<TArray<uint8>> m_MipData;
+	};
+
+	inline uint32 TextureMipChain::GetWidth() const
+	{
+		return m_Header.Width;
+	}
+
+	inline uint32 TextureMipChain::GetHeight() const
+	{
+		return m_Header.Height;
+	}
+
+	inline uint32 TextureMipChain::GetMipCount() const
+	{
+		return m_Header.MipCount;
+	}
+
+	inline uint64 TextureMipChain::GetSourceHash() const
+	{
+		return m_Header.SourceHash;
+	}
+
+	inline ETextureFormat TextureMipChain::GetFormat() const
+	{
+		return (ETextureFormat)m_Header.Format;
+	}
+
+	inline TextureCookSettings TextureMipChain::GetCookSettings() const
+	{
+		return TextureCookSettings { (ETextureCompression)m_Header.Compression, (ETextureMipFilter)m_Header.MipFilter };
+	}
+
+	inline bool TextureMipChain::IsValid() const
+	{
+		return m_Header.MipCount > 0;
+	}
+
+	inline const TextureMipChainMip& TextureMipChain::GetMip(uint32 mip) const
+	{
+		ionassert(mip < m_Mips.size());
+		return m_Mips[mip];
+	}
+
+	inline const TArray<uint8>& TextureMipChain::GetMipData(uint32 mip) const
+	{
+		ionassert(mip < m_MipData.size());
+		return m_MipData[mip];
+	}
+}
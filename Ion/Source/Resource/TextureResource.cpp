@@ -3,6 +3,9 @@
 #include "TextureResource.h"
 #include "ResourceManager.h"
 
+#include "Renderer/RenderThread.h"
+#include "RHI/RHI.h"
+
 #include "Asset/AssetRegistry.h"
 #include "Asset/AssetParser.h"
 
@@ -49,6 +52,17 @@ namespace Ion
 				xmlAr.ExitNode(); // IASSET_NODE_Resource_Texture_Prop_Filter
 			}
 
+			ArchiveNode nodeCompression = ar.EnterNode(nodeProperties, "Compression", EArchiveNodeType::Value);
+
+			if (xmlAr.TryEnterNode(IASSET_NODE_Resource_Texture_Prop_Compression) || IS_YAML_AR(ar))
+			{
+				xmlAr.EnterAttribute(IASSET_ATTR_value);
+				nodeCompression &= data->Description.Properties.Compression;
+				xmlAr.ExitAttribute();
+
+				xmlAr.ExitNode(); // IASSET_NODE_Resource_Texture_Prop_Compression
+			}
+
 			xmlAr.ExitNode(); // IASSET_NODE_Properties
 		}
 
@@ -68,7 +82,101 @@ namespace Ion
 
 	bool TextureResource::IsLoaded() const
 	{
-		return m_RenderData.IsAvailable();
+		return m_bLoaded;
+	}
+
+	TextureResource::~TextureResource()
+	{
+		if (m_StreamingState.bRegistered)
+		{
+			TextureStreamer::Unregister(*this);
+		}
+	}
+
+	void TextureResource::InitRenderData(const TextureImportedMips& imported)
+	{
+		TRACE_FUNCTION();
+
+		ionassert(Platform::IsMainThread());
+		ionassert(!m_bLoaded);
+
+		const TextureMipChain& mipChain = imported.MipChain;
+
+		m_RenderData->Texture = CreateMipTexture(imported, m_Asset->GetVirtualPath(), m_Description.Properties.Filter);
+		m_bLoaded = true;
+
+		// The file is there and some mips have been left out
+		if (imported.FirstMip > 0)
+		{
+			m_StreamingState.MipChain = mipChain;
+			m_StreamingState.MipChain.FreeMips();
+			m_StreamingState.MipChainPath = TextureStreamer::GetMipChainPath(m_Asset);
+			m_StreamingState.ResidentFirstMip = imported.FirstMip;
+			m_StreamingState.MinResidentFirstMip = imported.FirstMip;
+
+			TextureStreamer::Register(*this);
+		}
+	}
+
+	void TextureResource::SwapTexture(const TextureImportedMips& streamed)
+	{
+		TRACE_FUNCTION();
+
+		ionassert(Platform::IsMainThread());
+
+		// Created and uploaded here, like in InitRenderData, the render thread only swaps it.
+		TRef<RHITexture> texture = CreateMipTexture(streamed, m_Asset->GetVirtualPath(), m_Description.Properties.Filter);
+
+		RenderThread::EnqueueCommand([renderData = m_RenderData, texture]
+		{
+			// The old texture gets released here, after the frames that use it have been rendered
+			renderData->Texture = texture;
+		});
+	}
+
+	TRef<RHITexture> TextureResource::CreateMipTexture(const TextureImportedMips& mips, const String& debugName, ETextureFilteringMethod filter)
+	{
+		TRACE_FUNCTION();
+
+		const TextureMipChain& mipChain = mips.MipChain;
+		uint32 firstMip = mips.FirstMip;
+
+		ionassert(firstMip < mipChain.GetMipCount());
+
+		const TextureMipChainMip& firstMipDesc = mipChain.GetMip(firstMip);
+
+		// Decoded on the import or streaming task (see TextureStreamer::DecodeMips)
+		bool bDecode = !mips.DecodedMips.empty();
+		ionassert(!bDecode || mips.DecodedMips.size() == mipChain.GetMipCount() - firstMip);
+
+		TextureDescription desc { };
+		desc.Format = bDecode ? ETextureFormat::RGBA8 : mipChain.GetFormat();
+		desc.Dimensions.Width = firstMipDesc.Width;
+		desc.Dimensions.Height = firstMipDesc.Height;
+		desc.MipLevels = mipChain.GetMipCount() - firstMip;
+		desc.bCreateSampler = true;
+		desc.DebugName = debugName;
+
+		desc.SetFilterAll(filter);
+
+		TRef<RHITexture> texture = RHITexture::Create(desc);
+
+		for (uint32 mip = firstMip; mip < mipChain.GetMipCount(); ++mip)
+		{
+			const TArray<uint8>& data = mipChain.GetMipData(mip);
+			ionassert(!data.empty(), "The mip has not been loaded.");
+
+			if (bDecode)
+			{
+				texture->UpdateSubresource(mip - firstMip, mips.DecodedMips[mip - firstMip].data(), mipChain.GetMip(mip).Width * 4);
+			}
+			else
+			{
+				texture->UpdateSubresource(mip - firstMip, data.data(), mipChain.GetMip(mip).LineSize);
+			}
+		}
+
+		return texture;
 	}
 
 	static ETextureFilteringMethod ParseFilterString(char* csFilter)
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "Resource.h"
+#include "TextureStreamer.h"
+#include "TextureCooker.h"
 #include "RHI/Texture.h"
 
 namespace Ion
@@ -15,6 +17,8 @@ namespace Ion
 	struct TextureResourceProperties
 	{
 		ETextureFilteringMethod Filter = ETextureFilteringMethod::Default;
+		/* Format of the cooked texture (see TextureCooker) */
+		ETextureCompression Compression = ETextureCompression::Default;
 	};
 
 	/**
@@ -95,16 +99,31 @@ namespace Ion
 		/**
 		 * @brief Get the resource render data, even if it hasn't been loaded yet.
 		 * 
+		 * @details If the texture is streamed, the render data texture
+		 * gets replaced on the render thread, when its mips change.
+		 * 
 		 * @return TextureResource render data
 		 */
 		const TextureResourceRenderData& GetRenderData() const;
 
+		/**
+		 * @brief Loads only the smallest mips of the texture and lets the
+		 * TextureStreamer load the rest, based on the screen size requests.
+		 * Call it before the first Take, it has no effect on a loaded texture.
+		 */
+		void EnableStreaming();
+		bool IsStreamingEnabled() const;
+
 		virtual bool IsLoaded() const override;
 
+		~TextureResource();
+
 	protected:
 		TextureResource(const Asset& asset) :
 			Resource(asset),
-			m_RenderData({ })
+			m_RenderData(MakeShared<TextureResourceRenderData>()),
+			m_bLoaded(false),
+			m_bStreamingEnabled(false)
 		{
 			ionassert(asset->GetType() == AT_ImageAssetType);
 			TSharedPtr<ImageAssetData> data = PtrCast<ImageAssetData>(asset->GetCustomData());
@@ -112,10 +131,23 @@ namespace Ion
 		}
 
 	private:
-		TextureResourceRenderData m_RenderData;
+		/* Creates the texture from the imported mips (main thread). */
+		void InitRenderData(const TextureImportedMips& imported);
+		/* Creates the texture from the streamed mips (main thread) and replaces the old one on the render thread. */
+		void SwapTexture(const TextureImportedMips& streamed);
+
+		static TRef<RHITexture> CreateMipTexture(const TextureImportedMips& mips, const String& debugName, ETextureFilteringMethod filter);
+
+	private:
+		/* Shared with the render commands that replace the streamed texture */
+		TSharedPtr<TextureResourceRenderData> m_RenderData;
 		TextureResourceDescription m_Description;
+		TextureStreamingState m_StreamingState;
+		TAtomic<bool> m_bLoaded;
+		bool m_bStreamingEnabled;
 
 		friend class Resource;
+		friend class TextureStreamer;
 		FRIEND_MAKE_SHARED;
 	};
 
@@ -128,7 +160,7 @@ namespace Ion
 
 		TSharedPtr<TextureResource> self = PtrCast<TextureResource>(SharedFromThis());
 
-		if (m_RenderData.IsAvailable())
+		if (m_bLoaded)
 		{
 			onTake(self);
 			return true;
@@ -136,32 +168,30 @@ namespace Ion
 
 		ResourceLogger.Trace("Texture Resource \"{}\" render data is unavailable.", m_Asset->GetVirtualPath());
 		m_Asset->Import(
-			[self](std::shared_ptr<AssetFileMemoryBlock> block)
+			[self, mipChainPath = TextureStreamer::GetMipChainPath(m_Asset), settings = TextureCooker::GetCookSettings(m_Asset), bStreamed = m_bStreamingEnabled && TextureStreamer::IsEnabled()](std::shared_ptr<AssetFileMemoryBlock> block)
 			{
 				ResourceLogger.Trace("Importing Texture Resource from Asset \"{}\"...", self->m_Asset->GetVirtualPath());
-				return AssetImporter::ImportImageAsset(block);
+				return TextureStreamer::ImportMips(block, mipChainPath, settings, bStreamed);
 			},
 			// Store the ref (self) so the resource doesn't get deleted before it's loaded
-			[this, self, onTake](std::shared_ptr<Image> image)
+			[this, self, onTake](std::shared_ptr<TextureImportedMips> imported)
 			{
+				if (!imported)
+				{
+					ResourceLogger.Error("Failed to import Texture Resource from Asset \"{}\". The image cannot be loaded.", m_Asset->GetVirtualPath());
+					return;
+				}
+
 				ResourceLogger.Info("Texture Resource from Asset \"{}\" has been imported successfully.", m_Asset->GetVirtualPath());
 
 				ionassert(m_Asset);
 				ionassert(m_Asset->GetType() == AT_ImageAssetType);
 
-				TextureDescription desc { };
-				desc.Dimensions.Width = image->GetWidth();
-				desc.Dimensions.Height = image->GetHeight();
-				desc.bGenerateMips = true;
-				desc.bCreateSampler = true;
-				desc.bUseAsRenderTarget = true;
-				desc.DebugName = m_Asset->GetVirtualPath();
-
-				desc.SetFilterAll(m_Description.Properties.Filter);
-
-				m_RenderData.Texture = RHITexture::Create(desc);
-
-				m_RenderData.Texture->UpdateSubresource(image.get());
+				// Another Take could have loaded it in the meantime
+				if (!m_bLoaded)
+				{
+					InitRenderData(*imported);
+				}
 
 				ResourceLogger.Trace("Texture Resource \"{}\" render data is now available.", m_Asset->GetVirtualPath());
 
@@ -174,6 +204,16 @@ namespace Ion
 
 	inline const TextureResourceRenderData& TextureResource::GetRenderData() const
 	{
-		return m_RenderData;
+		return *m_RenderData;
+	}
+
+	inline void TextureResource::EnableStreaming()
+	{
+		m_bStreamingEnabled = true;
+	}
+
+	inline bool TextureResource::IsStreamingEnabled() const
+	{
+		return m_bStreamingEnabled;
 	}
 }
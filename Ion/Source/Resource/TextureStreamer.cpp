@@ -0,0 +1,471 @@
+#include "IonPCH.h"
+
+#include "TextureStreamer.h"
+#include "TextureResource.h"
+#include "TextureCooker.h"
+
+#include "Material/MaterialInstance.h"
+#include "Renderer/RendererCore.h"
+#include "Renderer/Camera.h"
+#include "Renderer/RenderThread.h"
+#include "RHI/RHI.h"
+#include "Application/EnginePath.h"
+
+namespace Ion
+{
+	TextureStreamer* TextureStreamer::s_Instance = nullptr;
+
+	TextureStreamer::TextureStreamer() :
+		m_MemoryBudget(DefaultMemoryBudget),
+		m_FrameIndex(0),
+		m_ViewHeight(DefaultViewHeight),
+		m_PendingRequests(0),
+		m_CachePath(EnginePath::GetEnginePath() / "TextureCache"),
+		m_bEnabled(true)
+	{
+	}
+
+	void TextureStreamer::GatherRequests(const TArray<RPrimitiveRenderProxy>& primitives, const RCameraRenderProxy& camera, TArray<TextureStreamingRequest>& outRequests)
+	{
+		TRACE_FUNCTION();
+
+		// Called during the renderer data build, so it can't touch the streamer state.
+
+		// Screen size of a world unit at distance 1, relative to the view height (diameter in NDC times one half)
+		float viewScale = camera.ProjectionMatrix[1][1];
+
+		ScratchArena scratch;
+		// Largest screen size of each material instance
+		TScratchHashMap<const MaterialInstance*, float> instanceScreenSizes(scratch);
+
+		for (const RPrimitiveRenderProxy& primitive : primitives)
+		{
+			if (!primitive.MaterialInstance)
+				continue;
+
+			float screenSize = 1.0f;
+			if (primitive.Bounds.IsValid())
+			{
+				float radius = glm::length(primitive.Bounds.GetExtents());
+				float distance = glm::length(primitive.Bounds.GetCenter() - camera.Location) - radius;
+				// The camera is inside the bounds
+				if (distance > 0.01f)
+				{
+					screenSize = radius * viewScale / distance;
+				}
+			}
+
+			float& maxScreenSize = instanceScreenSizes[primitive.MaterialInstance];
+			maxScreenSize = std::max(maxScreenSize, screenSize);
+		}
+
+		for (auto& [materialInstance, screenSize] : instanceScreenSizes)
+		{
+			for (MaterialParameterInstanceTexture2D* textureParam : materialInstance->GetTextureParameterInstances())
+			{
+				if (const TSharedPtr<TextureResource>& texture = textureParam->GetTextureResource())
+				{
+					outRequests.push_back({ texture, screenSize });
+				}
+			}
+		}
+	}
+
+	void TextureStreamer::SubmitRequests(TArray<TextureStreamingRequest>&& requests)
+	{
+		TextureStreamer& instance = Get();
+
+		ScopedLock lock(instance.m_SubmittedRequestsMutex);
+
+		if (instance.m_SubmittedRequests.empty())
+		{
+			instance.m_SubmittedRequests = Move(requests);
+		}
+		else
+		{
+			instance.m_SubmittedRequests.insert(instance.m_SubmittedRequests.end(), std::make_move_iterator(requests.begin()), std::make_move_iterator(requests.end()));
+		}
+	}
+
+	void TextureStreamer::Request(TextureResource& texture, float screenSize)
+	{
+		ionassert(Platform::IsMainThread());
+
+		TextureStreamingState& state = texture.m_StreamingState;
+		if (!state.bRegistered || state.bFailed)
+			return;
+
+		TextureStreamer& instance = Get();
+
+		// The first request in this frame replaces the old one
+		if (state.LastRequestFrame != instance.m_FrameIndex)
+		{
+			state.RequestedScreenSize = screenSize;
+			state.LastRequestFrame = instance.m_FrameIndex;
+		}
+		else
+		{
+			state.RequestedScreenSize = std::max(state.RequestedScreenSize, screenSize);
+		}
+
+		state.RequestedFirstMip = std::min(CalcRequestedFirstMip(state.MipChain, state.RequestedScreenSize), state.MinResidentFirstMip);
+	}
+
+	void TextureStreamer::Update()
+	{
+		TRACE_FUNCTION();
+
+		ionassert(Platform::IsMainThread());
+
+		TextureStreamer& instance = Get();
+
+		// Apply the requests gathered during the last renderer data build
+		{
+			TArray<TextureStreamingRequest> requests;
+			{
+				ScopedLock lock(instance.m_SubmittedRequestsMutex);
+				requests.swap(instance.m_SubmittedRequests);
+			}
+
+			for (const TextureStreamingRequest& request : requests)
+			{
+				Request(*request.Texture, request.ScreenSize * (float)instance.m_ViewHeight);
+			}
+		}
+
+		TArray<TextureResource*> textures;
+		textures.reserve(instance.m_Textures.size());
+		for (TextureResource* texture : instance.m_Textures)
+		{
+			if (!texture->m_StreamingState.bFailed)
+				textures.push_back(texture);
+		}
+
+		instance.ResolveTargets(textures);
+
+		uint64 residentBytes = 0;
+		uint64 neededBytes = 0;
+		for (TextureResource* texture : textures)
+		{
+			const TextureStreamingState& state = texture->m_StreamingState;
+			residentBytes += state.MipChain.GetMipsSize(state.ResidentFirstMip);
+			if (state.TargetFirstMip < state.ResidentFirstMip)
+			{
+				neededBytes += state.MipChain.GetMipsSize(state.TargetFirstMip) - state.MipChain.GetMipsSize(state.ResidentFirstMip);
+			}
+		}
+
+		// Evict the lower priority textures first, but only if the higher priority ones need the memory,
+		// so the textures that are not needed anymore keep their mips while there's enough space.
+		for (auto it = textures.rbegin(); it != textures.rend() && residentBytes + neededBytes > instance.m_MemoryBudget; ++it)
+		{
+			TextureStreamingState& state = (*it)->m_StreamingState;
+			if (state.bStreaming || state.TargetFirstMip <= state.ResidentFirstMip)
+				continue;
+
+			residentBytes -= state.MipChain.GetMipsSize(state.ResidentFirstMip) - state.MipChain.GetMipsSize(state.TargetFirstMip);
+			instance.StreamMips(**it, state.TargetFirstMip);
+		}
+
+		for (TextureResource* texture : textures)
+		{
+			if (instance.m_PendingRequests >= MaxPendingRequests)
+				break;
+
+			TextureStreamingState& state = texture->m_StreamingState;
+			if (state.bStreaming || state.TargetFirstMip >= state.ResidentFirstMip)
+				continue;
+
+			instance.StreamMips(*texture, state.TargetFirstMip);
+		}
+
+		instance.m_Stats.ResidentBytes = residentBytes;
+		instance.m_Stats.StreamedTextures = (uint32)textures.size();
+		instance.m_Stats.PendingRequests = instance.m_PendingRequests;
+
+		++instance.m_FrameIndex;
+	}
+
+	void TextureStreamer::ResolveTargets(TArray<TextureResource*>& textures)
+	{
+		TRACE_FUNCTION();
+
+		auto isStale = [this](const TextureStreamingState& state)
+		{
+			return m_FrameIndex - state.LastRequestFrame > RequestTimeoutFrames;
+		};
+
+		// Higher screen size first
+		std::sort(textures.begin(), textures.end(), [&isStale](TextureResource* a, TextureResource* b)
+		{
+			const TextureStreamingState& stateA = a->m_StreamingState;
+			const TextureStreamingState& stateB = b->m_StreamingState;
+			float priorityA = isStale(stateA) ? 0.0f : stateA.RequestedScreenSize;
+			float priorityB = isStale(stateB) ? 0.0f : stateB.RequestedScreenSize;
+			return priorityA > priorityB;
+		});
+
+		// The tails are always resident
+		uint64 usedBytes = 0;
+		uint64 requestedBytes = 0;
+		for (TextureResource* texture : textures)
+		{
+			const TextureStreamingState& state = texture->m_StreamingState;
+			usedBytes += state.MipChain.GetMipsSize(state.MinResidentFirstMip);
+		}
+
+		for (TextureResource* texture : textures)
+		{
+			TextureStreamingState& state = texture->m_StreamingState;
+
+			uint32 wantedFirstMip = isStale(state) ? state.MinResidentFirstMip : state.RequestedFirstMip;
+			uint64 tailBytes = state.MipChain.GetMipsSize(state.MinResidentFirstMip);
+			requestedBytes += state.MipChain.GetMipsSize(wantedFirstMip);
+
+			// Lower the detail until the mips fit in the budget
+			uint32 targetFirstMip = wantedFirstMip;
+			while (targetFirstMip < state.MinResidentFirstMip &&
+				usedBytes + state.MipChain.GetMipsSize(targetFirstMip) - tailBytes > m_MemoryBudget)
+			{
+				++targetFirstMip;
+			}
+
+			usedBytes += state.MipChain.GetMipsSize(targetFirstMip) - tailBytes;
+			state.TargetFirstMip = targetFirstMip;
+		}
+
+		m_Stats.RequestedBytes = requestedBytes;
+	}
+
+	void TextureStreamer::StreamMips(TextureResource& texture, uint32 firstMip)
+	{
+		TextureStreamingState& state = texture.m_StreamingState;
+
+		ionassert(!state.bStreaming);
+		ionassert(firstMip <= state.MinResidentFirstMip);
+
+		state.bStreaming = true;
+		++m_PendingRequests;
+
+		TSharedPtr<TextureResource> self = PtrCast<TextureResource>(texture.SharedFromThis());
+		// Copy of the header and the mip table, the pixels are read and decoded on the task
+		std::shared_ptr<TextureImportedMips> mips = std::make_shared<TextureImportedMips>();
+		mips->MipChain = state.MipChain;
+		mips->FirstMip = firstMip;
+		FilePath path = state.MipChainPath;
+
+		AsyncTask task([self, mips, path](IMessageQueueProvider& queue)
+		{
+			bool bLoaded =
+				TextureCooker::LoadCookedMips(path, mips->MipChain, mips->FirstMip) &&
+				DecodeMips(*mips);
+
+			queue.PushMessage(FTaskMessage([self, mips, bLoaded]
+			{
+				Get().OnMipsLoaded(*self, mips, bLoaded);
+			}));
+		});
+		task.Schedule();
+	}
+
+	void TextureStreamer::OnMipsLoaded(TextureResource& texture, const std::shared_ptr<TextureImportedMips>& mips, bool bLoaded)
+	{
+		TRACE_FUNCTION();
+
+		TextureStreamingState& state = texture.m_StreamingState;
+
+		ionassert(state.bStreaming);
+		ionassert(m_PendingRequests > 0);
+
+		state.bStreaming = false;
+		--m_PendingRequests;
+
+		if (!bLoaded)
+		{
+			// Keep the resident mips, but don't try again
+			ResourceLogger.Error("Cannot stream the mips of Texture Resource \"{}\".", texture.GetAssetHandle()->GetVirtualPath());
+			state.bFailed = true;
+			return;
+		}
+
+		if (mips->FirstMip < state.ResidentFirstMip)
+			++m_Stats.StreamedIn;
+		else if (mips->FirstMip > state.ResidentFirstMip)
+			++m_Stats.Evicted;
+
+		state.ResidentFirstMip = mips->FirstMip;
+
+		texture.SwapTexture(*mips);
+	}
+
+	std::shared_ptr<TextureImportedMips> TextureStreamer::ImportMips(const std::shared_ptr<AssetFileMemoryBlock>& block, const FilePath& mipChainPath, const TextureCookSettings& settings, bool bStreamed)
+	{
+		TRACE_FUNCTION();
+
+		uint64 sourceHash = HashBytes(block->Ptr, block->Size());
+
+		std::shared_ptr<TextureImportedMips> imported = std::make_shared<TextureImportedMips>();
+		TextureMipChain& mipChain = imported->MipChain;
+
+		// Cooked offline, or on a previous import
+		if (TextureCooker::LoadCookedHeader(mipChainPath, sourceHash, settings, mipChain))
+		{
+			imported->FirstMip = bStreamed ? CalcMinResidentFirstMip(mipChain) : 0;
+			if (TextureCooker::LoadCookedMips(mipChainPath, mipChain, imported->FirstMip))
+				return DecodeMips(*imported) ? imported : nullptr;
+		}
+
+		bool bSaved = false;
+		if (!TextureCooker::CookSource(block, sourceHash, settings, mipChainPath, mipChain, bSaved))
+			return nullptr;
+
+		// The texture can be loaded anyway, but it can't be streamed without the file.
+		imported->FirstMip = bStreamed && bSaved ? CalcMinResidentFirstMip(mipChain) : 0;
+
+		return DecodeMips(*imported) ? imported : nullptr;
+	}
+
+	bool TextureStreamer::DecodeMips(TextureImportedMips& mips)
+	{
+		TRACE_FUNCTION();
+
+		const TextureMipChain& mipChain = mips.MipChain;
+
+		// Decode the blocks on the CPU, if the RHI doesn't support the format
+		if (RHI::Get()->SupportsTextureFormat(mipChain.GetFormat()))
+			return true;
+
+		mips.DecodedMips.resize(mipChain.GetMipCount() - mips.FirstMip);
+		for (uint32 mip = mips.FirstMip; mip < mipChain.GetMipCount(); ++mip)
+		{
+			if (!mipChain.DecodeMip(mip, mips.DecodedMips[mip - mips.FirstMip]))
+			{
+				ResourceLogger.Error("Cannot decode mip {} of the texture mip chain.", mip);
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void TextureStreamer::SetMemoryBudget(uint64 bytes)
+	{
+		Get().m_MemoryBudget = bytes;
+	}
+
+	uint64 TextureStreamer::GetMemoryBudget()
+	{
+		return Get().m_MemoryBudget;
+	}
+
+	void TextureStreamer::SetViewHeight(uint32 height)
+	{
+		ionassert(height > 0);
+
+		Get().m_ViewHeight = height;
+	}
+
+	uint32 TextureStreamer::GetViewHeight()
+	{
+		return Get().m_ViewHeight;
+	}
+
+	void TextureStreamer::SetEnabled(bool bEnabled)
+	{
+		Get().m_bEnabled = bEnabled;
+	}
+
+	bool TextureStreamer::IsEnabled()
+	{
+		return Get().m_bEnabled;
+	}
+
+	void TextureStreamer::SetCachePath(const FilePath& path)
+	{
+		TextureStreamer& instance = Get();
+
+		ScopedLock lock(instance.m_CachePathMutex);
+		instance.m_CachePath = path;
+	}
+
+	FilePath TextureStreamer::GetCachePath()
+	{
+		TextureStreamer& instance = Get();
+
+		ScopedLock lock(instance.m_CachePathMutex);
+		return instance.m_CachePath;
+	}
+
+	FilePath TextureStreamer::GetMipChainPath(const Asset& asset)
+	{
+		const String& virtualPath = asset->GetVirtualPath();
+		return GetCachePath() / fmt::format("{:016x}{}", HashBytes(virtualPath.data(), virtualPath.size()), TextureMipChain::FileExtension);
+	}
+
+	TextureStreamerStats TextureStreamer::GetStats()
+	{
+		return Get().m_Stats;
+	}
+
+	void TextureStreamer::ResetStats()
+	{
+		TextureStreamerStats& stats = Get().m_Stats;
+		stats.StreamedIn = 0;
+		stats.Evicted = 0;
+	}
+
+	uint32 TextureStreamer::CalcMinResidentFirstMip(const TextureMipChain& mipChain)
+	{
+		ionassert(mipChain.IsValid());
+
+		bool bBlockCompressed = TextureDescription::IsBlockCompressed(mipChain.GetFormat());
+
+		uint32 mip = 0;
+		while (mip + 1 < mipChain.GetMipCount() &&
+			std::max(mipChain.GetMip(mip).Width, mipChain.GetMip(mip).Height) > MinResidentMipSize)
+		{
+			const TextureMipChainMip& nextMip = mipChain.GetMip(mip + 1);
+			// The first mip of a block compressed texture has to be made of whole blocks
+			if (bBlockCompressed && (nextMip.Width % 4 || nextMip.Height % 4))
+				break;
+			++mip;
+		}
+		return mip;
+	}
+
+	uint32 TextureStreamer::CalcRequestedFirstMip(const TextureMipChain& mipChain, float screenSize)
+	{
+		ionassert(mipChain.IsValid());
+
+		uint32 maxDimension = std::max(mipChain.GetWidth(), mipChain.GetHeight());
+		if (screenSize >= (float)maxDimension)
+			return 0;
+
+		float mip = std::floor(std::log2((float)maxDimension / std::max(screenSize, 1.0f)));
+		return std::min((uint32)mip, mipChain.GetMipCount() - 1);
+	}
+
+	void TextureStreamer::Register(TextureResource& texture)
+	{
+		ionassert(Platform::IsMainThread());
+
+		TextureStreamer& instance = Get();
+
+		TextureStreamingState& state = texture.m_StreamingState;
+		state.bRegistered = true;
+		// Nothing has been requested yet
+		state.RequestedFirstMip = state.MinResidentFirstMip;
+		state.TargetFirstMip = state.MinResidentFirstMip;
+		state.LastRequestFrame = instance.m_FrameIndex;
+
+		instance.m_Textures.insert(&texture);
+	}
+
+	void TextureStreamer::Unregister(TextureResource& texture)
+	{
+		ionassert(Platform::IsMainThread());
+
+		texture.m_StreamingState.bRegistered = false;
+
+		Get().m_Textures.erase(&texture);
+	}
+}
@@ -0,0 +1,202 @@
+#pragma once
+
+#include "ResourceFwd.h"
+#include "TextureMipChain.h"
+#include "Asset/Asset.h"
+#include "Renderer/RendererFwd.h"
+#include "Material/MaterialFwd.h"
+
+namespace Ion
+{
+	/**
+	 * @brief Streaming state of a TextureResource.
+	 * Accessed only on the main thread.
+	 */
+	struct TextureStreamingState
+	{
+		/* Header and mip table of the mip chain file (no pixels) */
+		TextureMipChain MipChain;
+		FilePath MipChainPath;
+		/* First mip of the current RHI texture */
+		uint32 ResidentFirstMip = 0;
+		/* First mip of the tail that is always resident */
+		uint32 MinResidentFirstMip = 0;
+		/* First mip the texture should have, resolved within the memory budget */
+		uint32 TargetFirstMip = 0;
+		/* First mip needed for the largest screen size requested in the last frame */
+		uint32 RequestedFirstMip = 0;
+		float RequestedScreenSize = 0.0f;
+		uint64 LastRequestFrame = 0;
+		bool bRegistered = false;
+		/* The mips are being read on the Engine Task Queue */
+		bool bStreaming = false;
+		/* The mip chain file could not be read, the texture is not streamed anymore */
+		bool bFailed = false;
+	};
+
+	/* Mips read by the import and streaming tasks (see TextureStreamer::ImportMips) */
+	struct TextureImportedMips
+	{
+		TextureMipChain MipChain;
+		uint32 FirstMip;
+		/* RGBA8 pixels of the mips in range [FirstMip, MipCount), if the RHI doesn't support the cooked format */
+		TArray<TArray<uint8>> DecodedMips;
+	};
+
+	/* Mips requested for a texture by the renderer data build (see TextureStreamer::GatherRequests) */
+	struct TextureStreamingRequest
+	{
+		TSharedPtr<TextureResource> Texture;
+		/* Size of the texture on the screen, relative to the view height */
+		float ScreenSize;
+	};
+
+	struct TextureStreamerStats
+	{
+		uint64 ResidentBytes = 0;
+		/* Memory the requested mips would need, without the budget */
+		uint64 RequestedBytes = 0;
+		uint32 StreamedTextures = 0;
+		uint32 PendingRequests = 0;
+		/* Counted since the last ResetStats */
+		uint32 StreamedIn = 0;
+		uint32 Evicted = 0;
+	};
+
+	/**
+	 * @brief Keeps the streamed textures within a memory budget,
+	 * by loading only the mips that are needed for their size on the screen.
+	 *
+	 * @details The mips are read from the mip chain files (see TextureMipChain),
+	 * which are cooked offline or on the first import (see TextureCooker)
+	 * and stored in the texture cache directory.
+	 *
+	 * A streamed texture is loaded with its smallest mips only (MinResidentMipSize).
+	 * Each frame, the scene primitives request the mips of their material textures
+	 * based on their projected size (GatherRequests, during the renderer data build).
+	 * Update applies these requests, resolves them
+	 * by priority (the screen size) within the budget, reads the missing mips on
+	 * the Engine Task Queue and evicts the mips of the lower priority textures,
+	 * if there's not enough memory for the higher priority ones.
+	 *
+	 * The RHI textures are replaced on the render thread, so bind the streamed
+	 * textures through the resource (TextureResource::GetRenderData), instead of
+	 * keeping the references.
+	 *
+	 * Main thread only, except for ImportMips, GatherRequests and SubmitRequests.
+	 */
+	class ION_API TextureStreamer
+	{
+	public:
+		static constexpr uint64 DefaultMemoryBudget = 256ull << 20;
+		/* The mips with both dimensions not larger than this are always resident */
+		static constexpr uint32 MinResidentMipSize = 64;
+		/* Max number of the mip reads in flight */
+		static constexpr uint32 MaxPendingRequests = 4;
+		/* A texture that has not been requested for this many frames is the first to be evicted */
+		static constexpr uint32 RequestTimeoutFrames = 120;
+		static constexpr uint32 DefaultViewHeight = 1080;
+
+		/**
+		 * @brief Computes the requests for the mips of the material textures of the primitives,
+		 * based on the projected size of their bounds. Can be called on any thread.
+		 */
+		static void GatherRequests(const TArray<RPrimitiveRenderProxy>& primitives, const RCameraRenderProxy& camera, TArray<TextureStreamingRequest>& outRequests);
+
+		/**
+		 * @brief Queues the requests, which are applied at the start of the next Update.
+		 * Can be called on any thread.
+		 */
+		static void SubmitRequests(TArray<TextureStreamingRequest>&& requests);
+
+		/**
+		 * @brief Requests the mips needed to draw the texture at the specified size.
+		 * The largest size requested in a frame is used.
+		 *
+		 * @param screenSize Size of the texture on the screen in pixels
+		 */
+		static void Request(TextureResource& texture, float screenSize);
+
+		/**
+		 * @brief Resolves the requests and starts the streaming. Call it once a frame.
+		 */
+		static void Update();
+
+		/**
+		 * @brief Reads the mips of a texture from its cooked mip chain file, or cooks
+		 * the source image, if the file is missing or stale (see TextureCooker).
+		 * Called on the import task.
+		 *
+		 * @param block Source image file
+		 * @param settings The file is cooked again if they don't match
+		 * @param bStreamed If false, all the mips are read
+		 * @return Null, if the image cannot be imported or decoded
+		 */
+		static std::shared_ptr<TextureImportedMips> ImportMips(const std::shared_ptr<AssetFileMemoryBlock>& block, const FilePath& mipChainPath, const TextureCookSettings& settings, bool bStreamed);
+
+		static void SetMemoryBudget(uint64 bytes);
+		static uint64 GetMemoryBudget();
+
+		/* Height of the view in pixels, used to compute the screen size of the primitives */
+		static void SetViewHeight(uint32 height);
+		static uint32 GetViewHeight();
+
+		/* If disabled, the textures loaded from now on are not streamed. */
+		static void SetEnabled(bool bEnabled);
+		static bool IsEnabled();
+
+		/* Directory the mip chain files are stored in ({EnginePath}/TextureCache by default) */
+		static void SetCachePath(const FilePath& path);
+		static FilePath GetCachePath();
+		static FilePath GetMipChainPath(const Asset& asset);
+
+		static TextureStreamerStats GetStats();
+		static void ResetStats();
+
+		/* First mip of the tail that is always resident */
+		static uint32 CalcMinResidentFirstMip(const TextureMipChain& mipChain);
+		/* First mip needed to draw the texture at the specified size (1 texel per pixel) */
+		static uint32 CalcRequestedFirstMip(const TextureMipChain& mipChain, float screenSize);
+
+	private:
+		TextureStreamer();
+
+		static TextureStreamer& Get();
+
+		static void Register(TextureResource& texture);
+		static void Unregister(TextureResource& texture);
+
+		/* Decodes the read mips, if the RHI doesn't support their format. Called on the import and streaming tasks. */
+		static bool DecodeMips(TextureImportedMips& mips);
+
+		void ResolveTargets(TArray<TextureResource*>& textures);
+		void StreamMips(TextureResource& texture, uint32 firstMip);
+		void OnMipsLoaded(TextureResource& texture, const std::shared_ptr<TextureImportedMips>& mips, bool bLoaded);
+
+	private:
+		THashSet<TextureResource*> m_Textures;
+		/* Requests submitted since the last Update */
+		TArray<TextureStreamingRequest> m_SubmittedRequests;
+		Mutex m_SubmittedRequestsMutex;
+
+		uint64 m_MemoryBudget;
+		uint64 m_FrameIndex;
+		uint32 m_ViewHeight;
+		uint32 m_PendingRequests;
+		TextureStreamerStats m_Stats;
+		FilePath m_CachePath;
+		bool m_bEnabled;
+
+		/* Guards the cache path, which is read on the import tasks */
+		Mutex m_CachePathMutex;
+
+		static TextureStreamer* s_Instance;
+
+		friend class TextureResource;
+	};
+
+	inline TextureStreamer& TextureStreamer::Get()
+	{
+		return *(s_Instance ? s_Instance : s_Instance = new TextureStreamer);
+	}
+}
@@ -85,3 +85,64 @@ namespace ImGui
 		ImGui::PopStyleColor(4);
 	}
 }
+
+namespace Ion
+{
+	ImGuiDrawDataSnapshot::ImGuiDrawDataSnapshot()
+	{
+	}
+
+	ImGuiDrawDataSnapshot::~ImGuiDrawDataSnapshot()
+	{
+		Clear();
+	}
+
+	void ImGuiDrawDataSnapshot::Capture(const ImDrawData* drawData)
+	{
+		TRACE_FUNCTION();
+
+		Clear();
+
+		if (!drawData || !drawData->Valid)
+			return;
+
+		m_DrawData = *drawData;
+
+		// The draw lists are reused by ImGui in the next frame.
+#if IMGUI_VERSION_NUM >= 18980
+		m_DrawData.CmdLists.resize(0);
+		for (ImDrawList* cmdList : drawData->CmdLists)
+		{
+			m_DrawData.CmdLists.push_back(cmdList->CloneOutput());
+		}
+#else
+		for (int32 i = 0; i < drawData->CmdListsCount; ++i)
+		{
+			m_CmdLists.push_back(drawData->CmdLists[i]->CloneOutput());
+		}
+		m_DrawData.CmdLists = m_CmdLists.Data;
+#endif
+	}
+
+	void ImGuiDrawDataSnapshot::Clear()
+	{
+#if IMGUI_VERSION_NUM >= 18980
+		for (ImDrawList* cmdList : m_DrawData.CmdLists)
+		{
+			IM_DELETE(cmdList);
+		}
+#else
+		for (ImDrawList* cmdList : m_CmdLists)
+		{
+			IM_DELETE(cmdList);
+		}
+		m_CmdLists.resize(0);
+#endif
+		m_DrawData.Clear();
+	}
+
+	ImDrawData* ImGuiDrawDataSnapshot::GetDrawData()
+	{
+		return m_DrawData.Valid ? &m_DrawData : nullptr;
+	}
+}
@@ -68,3 +68,40 @@ namespace ImGui
 	IMGUI_API void PushDisabledStyle();
 	IMGUI_API void PopDisabledStyle();
 }
+
+namespace Ion
+{
+	/**
+	 * @brief Copy of the ImGui draw data, that can still be rendered
+	 * after the next ImGui frame has started (e.g. on the render thread).
+	 */
+	class ION_API ImGuiDrawDataSnapshot
+	{
+	public:
+		ImGuiDrawDataSnapshot();
+		~ImGuiDrawDataSnapshot();
+
+		/**
+		 * @brief Copy the draw data. Has to be called on the thread that uses ImGui.
+		 *
+		 * @param drawData Draw data returned by ImGui::GetDrawData
+		 */
+		void Capture(const ImDrawData* drawData);
+		void Clear();
+
+		/**
+		 * @return The captured draw data or nullptr if it's not valid.
+		 */
+		ImDrawData* GetDrawData();
+
+		ImGuiDrawDataSnapshot(const ImGuiDrawDataSnapshot&) = delete;
+		ImGuiDrawDataSnapshot& operator=(const ImGuiDrawDataSnapshot&) = delete;
+
+	private:
+		ImDrawData m_DrawData;
+#if IMGUI_VERSION_NUM < 18980
+		/* ImDrawData::CmdLists used to be a raw pointer. */
+		ImVector<ImDrawList*> m_CmdLists;
+#endif
+	};
+}
@@ -26,10 +26,14 @@
 #include "Core/GUID/GUID.h"
 #include "Core/Logging/Logger.h"
 #include "Core/Logging/LogManager.h"
+#include "Core/Math/Bounds.h"
 #include "Core/Math/Math.h"
+#include "Core/Math/MathKernels.h"
 #include "Core/Math/Random.h"
 #include "Core/Math/Rotator.h"
 #include "Core/Math/Transform.h"
+#include "Core/Memory/EngineAllocator.h"
+#include "Core/Memory/LinearAllocator.h"
 #include "Core/Memory/MemoryCore.h"
 #include "Core/Memory/MetaPointer.h"
 #include "Core/Memory/PoolAllocator.h"
@@ -46,6 +50,10 @@
 #include "Core/Task/EngineTaskQueue.h"
 #include "Core/Task/Task.h"
 #include "Core/Task/TaskFwd.h"
+#include "Core/Task/TaskGraph.h"
+#include "Core/Task/TaskHandle.h"
+#include "Core/Task/TaskJob.h"
 #include "Core/Task/TaskQueue.h"
+#include "Core/Task/WorkStealingQueue.h"
 #include "Core/Templates/StandardWrappers.h"
 #include "Core/Templates/Templates.h"
@@ -19,6 +19,18 @@ FORCEINLINE size_t CombineHashes(size_t lhs, size_t rhs)
 	return lhs;
 }
 
+/* 64-bit FNV-1a - the hash does not change between runs, so it can be stored in files. */
+FORCEINLINE uint64 HashBytes(const void* data, size_t size, uint64 hash = 0xcbf29ce484222325ull)
+{
+	const uint8* bytes = (const uint8*)data;
+	for (size_t i = 0; i < size; ++i)
+	{
+		hash ^= bytes[i];
+		hash *= 0x100000001b3ull;
+	}
+	return hash;
+}
+
 // Bitwise :
 
 NODISCARD constexpr uint32 Bitflag(uint8 bit) noexcept { return 1u << bit; }
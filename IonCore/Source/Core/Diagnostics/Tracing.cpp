@@ -111,7 +111,8 @@ namespace Ion
 
 		ScopedTracer dumpTracer;
 
-		String fileDumpTemp;
+		ScratchArena scratch;
+		ScratchString fileDumpTemp(scratch);
 		fileDumpTemp.reserve(ION_TRACE_DUMP_THRESHOLD * 100);
 
 		TraceResultsArray localResults;
@@ -174,8 +175,7 @@ namespace Ion
 			s_ThreadNameCache.emplace(tid, StringConverter::WStringToString(descStr));
 		}
 
-		String key = m_Name + ToString(m_StartTime);
-		s_TraceStarts.emplace(key, TraceStart { m_Name, m_StartTime, pid, tid });
+		s_TraceStarts.emplace(TraceStartKey { m_Name, m_StartTime }, TraceStart { m_Name, m_StartTime, pid, tid });
 	}
 
 	void DebugTracing::ScopedTracer::CacheResult(int64 endTime, double duration)
@@ -184,8 +184,7 @@ namespace Ion
 
 		UniqueLock lock(s_ResultsMutex);
 
-		String key = m_Name + ToString(m_StartTime);
-		s_TraceStarts.erase(key);
+		s_TraceStarts.erase(TraceStartKey { m_Name, m_StartTime });
 
 		// @TODO: Make this platform independent
 		int32 pid = Platform::GetCurrentProcessId();
@@ -203,7 +202,7 @@ namespace Ion
 		}
 	}
 
-	void DebugTracing::WriteBeginEvent(const char* name, int64 timestamp, int32 pid, const char* threadDesc, String& outString)
+	void DebugTracing::WriteBeginEvent(const char* name, int64 timestamp, int32 pid, const char* threadDesc, ScratchString& outString)
 	{
 		int32 charsWritten;
 		// 4096 for some crazy template magic
@@ -214,7 +213,7 @@ namespace Ion
 		outString += eventBuffer;
 	}
 
-	void DebugTracing::WriteEndEvent(int64 timestamp, int32 pid, const char* threadDesc, String& outString)
+	void DebugTracing::WriteEndEvent(int64 timestamp, int32 pid, const char* threadDesc, ScratchString& outString)
 	{
 		int32 charsWritten;
 		char eventBuffer[4096] = { 0 };
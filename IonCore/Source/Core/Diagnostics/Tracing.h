@@ -2,6 +2,7 @@
 
 #include "Core/Base.h"
 #include "Core/File/File.h"
+#include "Core/Memory/LinearAllocator.h"
 #include "Core/CoreConfig.h"
 
 #if (ION_DEBUG || ION_RELEASE && ION_RELEASE_TRACING) && !ION_NO_TRACING || ION_FORCE_TRACING
@@ -24,6 +25,25 @@ namespace Ion
 			int32 PID;
 			int32 TID;
 		};
+		/* Identifies the running tracer without building a string key */
+		struct TraceStartKey
+		{
+			const char* Name;
+			int64 Timestamp;
+
+			bool operator==(const TraceStartKey& other) const
+			{
+				return Name == other.Name && Timestamp == other.Timestamp;
+			}
+
+			struct Hasher
+			{
+				size_t operator()(const TraceStartKey& key) const
+				{
+					return THash<const char*>()(key.Name) ^ THash<int64>()(key.Timestamp);
+				}
+			};
+		};
 		struct TraceResult
 		{
 			const char* Name;
@@ -35,8 +55,8 @@ namespace Ion
 		};
 
 		using TraceResultsArray = TArray<TraceResult>;
-		using TraceStartMap = THashMap<String, TraceStart>;
-		using NamedTraceResultsMap = THashMap<String, TraceResult*>;
+		using TraceStartMap = THashMap<TraceStartKey, TraceStart, TraceStartKey::Hasher>;
+		using NamedTraceResultsMap = THashMap<StringView, TraceResult*>;
 		using ThreadNameCache = THashMap<int32, String>;
 
 		class ION_API ScopedTracer
@@ -81,8 +101,8 @@ namespace Ion
 		static int64 TimestampToMicroseconds(int64 timestamp);
 
 	private:
-		static void WriteBeginEvent(const char* name, int64 timestamp, int32 pid, const char* threadDesc, String& outString);
-		static void WriteEndEvent(int64 timestamp, int32 pid, const char* threadDesc, String& outString);
+		static void WriteBeginEvent(const char* name, int64 timestamp, int32 pid, const char* threadDesc, ScratchString& outString);
+		static void WriteEndEvent(int64 timestamp, int32 pid, const char* threadDesc, ScratchString& outString);
 
 	private:
 		static TraceResultsArray s_TraceResults;
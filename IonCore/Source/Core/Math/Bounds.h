@@ -0,0 +1,95 @@
+#pragma once
+
+#include "Core/Math/Math.h"
+
+namespace Ion
+{
+	/**
+	 * @brief Axis-aligned bounding box
+	 */
+	struct AABB
+	{
+		Vector3 Min = Vector3(0.0f);
+		Vector3 Max = Vector3(0.0f);
+
+		inline Vector3 GetCenter() const  { return (Min + Max) * 0.5f; }
+		inline Vector3 GetExtents() const { return (Max - Min) * 0.5f; }
+
+		inline bool IsValid() const
+		{
+			return Min.x <= Max.x && Min.y <= Max.y && Min.z <= Max.z;
+		}
+
+		/* Grows the box to contain the point. */
+		inline void Expand(const Vector3& point)
+		{
+			Min = glm::min(Min, point);
+			Max = glm::max(Max, point);
+		}
+
+		static inline AABB FromCenterExtents(const Vector3& center, const Vector3& extents)
+		{
+			return AABB { center - extents, center + extents };
+		}
+
+		/* Empty box, that can be expanded with points. Not valid until then. */
+		static inline AABB Invalid()
+		{
+			return AABB { Vector3(std::numeric_limits<float>::max()), Vector3(std::numeric_limits<float>::lowest()) };
+		}
+	};
+
+	/**
+	 * @brief Bounding sphere
+	 */
+	struct BoundingSphere
+	{
+		Vector3 Center = Vector3(0.0f);
+		float Radius = 0.0f;
+	};
+
+	/**
+	 * @brief Six planes (Left, Right, Bottom, Top, Near, Far),
+	 * with the normals pointing inside the frustum.
+	 *
+	 * @details A plane is stored as (normal, distance),
+	 * a point p is on the inner side if dot(normal, p) + distance >= 0.
+	 */
+	struct Frustum
+	{
+		Vector4 Planes[6];
+
+		/**
+		 * @brief Extracts the planes from a (view) projection matrix.
+		 *
+		 * @details The near plane is taken for the -1..1 clip space depth range,
+		 * which is also conservative for the 0..1 range.
+		 */
+		static inline Frustum FromMatrix(const Matrix4& matrix)
+		{
+			// The matrix is column-major
+			Vector4 row0(matrix[0][0], matrix[1][0], matrix[2][0], matrix[3][0]);
+			Vector4 row1(matrix[0][1], matrix[1][1], matrix[2][1], matrix[3][1]);
+			Vector4 row2(matrix[0][2], matrix[1][2], matrix[2][2], matrix[3][2]);
+			Vector4 row3(matrix[0][3], matrix[1][3], matrix[2][3], matrix[3][3]);
+
+			Frustum frustum;
+			frustum.Planes[0] = row3 + row0;
+			frustum.Planes[1] = row3 - row0;
+			frustum.Planes[2] = row3 + row1;
+			frustum.Planes[3] = row3 - row1;
+			frustum.Planes[4] = row3 + row2;
+			frustum.Planes[5] = row3 - row2;
+
+			for (Vector4& plane : frustum.Planes)
+			{
+				float length = glm::length(Vector3(plane));
+				if (length > 0.0f)
+				{
+					plane /= length;
+				}
+			}
+			return frustum;
+		}
+	};
+}
@@ -0,0 +1,687 @@
+#include "Core/CorePCH.h"
+
+#include "MathKernels.h"
+
+#if ION_PLATFORM_WINDOWS
+#include <intrin.h>
+#endif
+#include <immintrin.h>
+
+// MSVC compiles any intrinsic, GCC and Clang only the ones enabled for the function.
+#if ION_PLATFORM_WINDOWS
+#define ION_TARGET_AVX2
+#else
+#define ION_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#endif
+
+namespace Ion
+{
+	namespace Math
+	{
+		// Kernel table ------------------------------------------------------------------
+
+		// lhsStride / matrixStride is 0 if the same matrix is used for every element.
+		using TFuncMultiplyMatricesKernel = void(*)(const Matrix4* lhs, size_t lhsStride, const Matrix4* rhs, Matrix4* out, size_t count);
+		using TFuncComposeMatricesKernel  = void(*)(const Vector3* locations, const Quaternion* rotations, const Vector3* scales, Matrix4* out, size_t count);
+		using TFuncInverseTransposeKernel = void(*)(const Matrix4* matrices, Matrix4* out, size_t count);
+		using TFuncTransformAABBsKernel   = void(*)(const Matrix4* matrices, size_t matrixStride, const AABB* boxes, AABB* out, size_t count);
+		using TFuncTestFrustumAABBsKernel = size_t(*)(const Frustum& frustum, const AABB* boxes, size_t boxStride, uint8* outVisible, size_t count);
+
+		struct MathKernelTable
+		{
+			TFuncMultiplyMatricesKernel MultiplyMatrices;
+			TFuncComposeMatricesKernel ComposeMatrices;
+			TFuncInverseTransposeKernel InverseTransposeAffine;
+			TFuncTransformAABBsKernel TransformAABBs;
+			TFuncTestFrustumAABBsKernel TestFrustumAABBs;
+		};
+
+		FORCEINLINE static const float* Ptr(const Matrix4& matrix) { return &matrix[0][0]; }
+		FORCEINLINE static float* Ptr(Matrix4& matrix) { return &matrix[0][0]; }
+
+		FORCEINLINE static const AABB& GetBox(const AABB* boxes, size_t boxStride, size_t index)
+		{
+			return *(const AABB*)((const uint8*)boxes + index * boxStride);
+		}
+
+		// Scalar ------------------------------------------------------------------------
+
+		static void MultiplyMatrices_Scalar(const Matrix4* lhs, size_t lhsStride, const Matrix4* rhs, Matrix4* out, size_t count)
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				const float* a = Ptr(lhs[i * lhsStride]);
+				const float* b = Ptr(rhs[i]);
+
+				float result[16];
+				for (int32 col = 0; col < 4; ++col)
+				{
+					for (int32 row = 0; row < 4; ++row)
+					{
+						result[col * 4 + row] =
+							a[0 * 4 + row] * b[col * 4 + 0] +
+							a[1 * 4 + row] * b[col * 4 + 1] +
+							a[2 * 4 + row] * b[col * 4 + 2] +
+							a[3 * 4 + row] * b[col * 4 + 3];
+					}
+				}
+				memcpy(Ptr(out[i]), result, sizeof(result));
+			}
+		}
+
+		static void ComposeMatrices_Scalar(const Vector3* locations, const Quaternion* rotations, const Vector3* scales, Matrix4* out, size_t count)
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				const Quaternion& q = rotations[i];
+				const Vector3& s = scales[i];
+				const Vector3& t = locations[i];
+
+				float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+				float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+				float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+
+				float* m = Ptr(out[i]);
+				m[0]  = (1.0f - 2.0f * (yy + zz)) * s.x;
+				m[1]  = (2.0f * (xy + wz)) * s.x;
+				m[2]  = (2.0f * (xz - wy)) * s.x;
+				m[3]  = 0.0f;
+				m[4]  = (2.0f * (xy - wz)) * s.y;
+				m[5]  = (1.0f - 2.0f * (xx + zz)) * s.y;
+				m[6]  = (2.0f * (yz + wx)) * s.y;
+				m[7]  = 0.0f;
+				m[8]  = (2.0f * (xz + wy)) * s.z;
+				m[9]  = (2.0f * (yz - wx)) * s.z;
+				m[10] = (1.0f - 2.0f * (xx + yy)) * s.z;
+				m[11] = 0.0f;
+				m[12] = t.x;
+				m[13] = t.y;
+				m[14] = t.z;
+				m[15] = 1.0f;
+			}
+		}
+
+		static void InverseTransposeAffine_Scalar(const Matrix4* matrices, Matrix4* out, size_t count)
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				const float* m = Ptr(matrices[i]);
+				Vector3 c0(m[0], m[1], m[2]);
+				Vector3 c1(m[4], m[5], m[6]);
+				Vector3 c2(m[8], m[9], m[10]);
+				Vector3 t(m[12], m[13], m[14]);
+
+				// The columns of the inverse-transpose of the 3x3 part are the cofactors.
+				Vector3 r0 = glm::cross(c1, c2);
+				Vector3 r1 = glm::cross(c2, c0);
+				Vector3 r2 = glm::cross(c0, c1);
+				float invDet = 1.0f / glm::dot(c0, r0);
+				r0 *= invDet;
+				r1 *= invDet;
+				r2 *= invDet;
+
+				float* o = Ptr(out[i]);
+				o[0]  = r0.x; o[1]  = r0.y; o[2]  = r0.z; o[3]  = -glm::dot(r0, t);
+				o[4]  = r1.x; o[5]  = r1.y; o[6]  = r1.z; o[7]  = -glm::dot(r1, t);
+				o[8]  = r2.x; o[9]  = r2.y; o[10] = r2.z; o[11] = -glm::dot(r2, t);
+				o[12] = 0.0f; o[13] = 0.0f; o[14] = 0.0f; o[15] = 1.0f;
+			}
+		}
+
+		static void TransformAABBs_Scalar(const Matrix4* matrices, size_t matrixStride, const AABB* boxes, AABB* out, size_t count)
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				const float* m = Ptr(matrices[i * matrixStride]);
+				Vector3 center = boxes[i].GetCenter();
+				Vector3 extents = boxes[i].GetExtents();
+
+				Vector3 newCenter;
+				Vector3 newExtents;
+				for (int32 row = 0; row < 3; ++row)
+				{
+					newCenter[row] = m[0 + row] * center.x + m[4 + row] * center.y + m[8 + row] * center.z + m[12 + row];
+					newExtents[row] =
+						std::abs(m[0 + row]) * extents.x +
+						std::abs(m[4 + row]) * extents.y +
+						std::abs(m[8 + row]) * extents.z;
+				}
+				out[i] = AABB::FromCenterExtents(newCenter, newExtents);
+			}
+		}
+
+		static size_t TestFrustumAABBs_Scalar(const Frustum& frustum, const AABB* boxes, size_t boxStride, uint8* outVisible, size_t count)
+		{
+			size_t visibleCount = 0;
+			for (size_t i = 0; i < count; ++i)
+			{
+				const AABB& box = GetBox(boxes, boxStride, i);
+
+				bool bVisible = true;
+				if (box.IsValid())
+				{
+					Vector3 center = box.GetCenter();
+					Vector3 extents = box.GetExtents();
+					for (const Vector4& plane : frustum.Planes)
+					{
+						Vector3 normal(plane);
+						// Distance of the box corner that is the furthest along the normal
+						float distance = glm::dot(normal, center) + plane.w + glm::dot(glm::abs(normal), extents);
+						if (distance < 0.0f)
+						{
+							bVisible = false;
+							break;
+						}
+					}
+				}
+				outVisible[i] = bVisible;
+				visibleCount += bVisible;
+			}
+			return visibleCount;
+		}
+
+		// SSE ---------------------------------------------------------------------------
+
+		FORCEINLINE static __m128 Cross_SSE(__m128 a, __m128 b)
+		{
+			__m128 aYZX = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+			__m128 bYZX = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+			__m128 aZXY = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 1, 0, 2));
+			__m128 bZXY = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 1, 0, 2));
+			return _mm_sub_ps(_mm_mul_ps(aYZX, bZXY), _mm_mul_ps(aZXY, bYZX));
+		}
+
+		/* Sum of the 4 lanes, broadcast to every lane. */
+		FORCEINLINE static __m128 HorizontalSum_SSE(__m128 v)
+		{
+			__m128 sum = _mm_add_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+			return _mm_add_ps(sum, _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(1, 0, 3, 2)));
+		}
+
+		FORCEINLINE static __m128 LoadVector3_SSE(const Vector3& v, float w)
+		{
+			return _mm_set_ps(w, v.z, v.y, v.x);
+		}
+
+		FORCEINLINE static Vector3 StoreVector3_SSE(__m128 v)
+		{
+			alignas(16) float values[4];
+			_mm_store_ps(values, v);
+			return Vector3(values[0], values[1], values[2]);
+		}
+
+		static void MultiplyMatrices_SSE(const Matrix4* lhs, size_t lhsStride, const Matrix4* rhs, Matrix4* out, size_t count)
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				const float* a = Ptr(lhs[i * lhsStride]);
+				const float* b = Ptr(rhs[i]);
+				float* o = Ptr(out[i]);
+
+				__m128 a0 = _mm_loadu_ps(a + 0);
+				__m128 a1 = _mm_loadu_ps(a + 4);
+				__m128 a2 = _mm_loadu_ps(a + 8);
+				__m128 a3 = _mm_loadu_ps(a + 12);
+
+				// Each column of b is read before the same column of out is written.
+				for (int32 col = 0; col < 4; ++col)
+				{
+					const float* bCol = b + col * 4;
+					__m128 result = _mm_mul_ps(a0, _mm_set1_ps(bCol[0]));
+					result = _mm_add_ps(result, _mm_mul_ps(a1, _mm_set1_ps(bCol[1])));
+					result = _mm_add_ps(result, _mm_mul_ps(a2, _mm_set1_ps(bCol[2])));
+					result = _mm_add_ps(result, _mm_mul_ps(a3, _mm_set1_ps(bCol[3])));
+					_mm_storeu_ps(o + col * 4, result);
+				}
+			}
+		}
+
+		static void ComposeMatrices_SSE(const Vector3* locations, const Quaternion* rotations, const Vector3* scales, Matrix4* out, size_t count)
+		{
+			const __m128 one = _mm_set_ps(0.0f, 1.0f, 1.0f, 1.0f);
+			const __m128 two = _mm_set1_ps(2.0f);
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				const Quaternion& q = rotations[i];
+				const Vector3& s = scales[i];
+				float* o = Ptr(out[i]);
+
+				// (x, y, z, w) * (x, y, z, w) style products, computed 4 at a time.
+				__m128 quat = _mm_set_ps(q.w, q.z, q.y, q.x);
+				__m128 quat2 = _mm_mul_ps(quat, two);
+				// (2xx, 2yy, 2zz)
+				__m128 sq = _mm_mul_ps(quat, quat2);
+				// (2xy, 2yz, 2xz)
+				__m128 cross = _mm_mul_ps(quat, _mm_shuffle_ps(quat2, quat2, _MM_SHUFFLE(3, 0, 2, 1)));
+				// (2wx, 2wy, 2wz)
+				__m128 w = _mm_mul_ps(_mm_shuffle_ps(quat, quat, _MM_SHUFFLE(3, 3, 3, 3)), quat2);
+
+				alignas(16) float vSq[4], vCross[4], vW[4];
+				_mm_store_ps(vSq, sq);
+				_mm_store_ps(vCross, cross);
+				_mm_store_ps(vW, w);
+				float xx = vSq[0], yy = vSq[1], zz = vSq[2];
+				float xy = vCross[0], yz = vCross[1], xz = vCross[2];
+				float wx = vW[0], wy = vW[1], wz = vW[2];
+
+				__m128 diagonal = _mm_sub_ps(one, _mm_set_ps(0.0f, xx + yy, xx + zz, yy + zz));
+				alignas(16) float vDiag[4];
+				_mm_store_ps(vDiag, diagonal);
+
+				__m128 c0 = _mm_set_ps(0.0f, xz - wy, xy + wz, vDiag[0]);
+				__m128 c1 = _mm_set_ps(0.0f, yz + wx, vDiag[1], xy - wz);
+				__m128 c2 = _mm_set_ps(0.0f, vDiag[2], yz - wx, xz + wy);
+
+				_mm_storeu_ps(o + 0, _mm_mul_ps(c0, _mm_set1_ps(s.x)));
+				_mm_storeu_ps(o + 4, _mm_mul_ps(c1, _mm_set1_ps(s.y)));
+				_mm_storeu_ps(o + 8, _mm_mul_ps(c2, _mm_set1_ps(s.z)));
+				_mm_storeu_ps(o + 12, LoadVector3_SSE(locations[i], 1.0f));
+			}
+		}
+
+		static void InverseTransposeAffine_SSE(const Matrix4* matrices, Matrix4* out, size_t count)
+		{
+			const __m128 maskXYZ = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+			const __m128 lastColumn = _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f);
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				const float* m = Ptr(matrices[i]);
+				float* o = Ptr(out[i]);
+
+				__m128 c0 = _mm_and_ps(_mm_loadu_ps(m + 0), maskXYZ);
+				__m128 c1 = _mm_and_ps(_mm_loadu_ps(m + 4), maskXYZ);
+				__m128 c2 = _mm_and_ps(_mm_loadu_ps(m + 8), maskXYZ);
+				__m128 t  = _mm_and_ps(_mm_loadu_ps(m + 12), maskXYZ);
+
+				// The columns of the inverse-transpose of the 3x3 part are the cofactors.
+				__m128 r0 = Cross_SSE(c1, c2);
+				__m128 r1 = Cross_SSE(c2, c0);
+				__m128 r2 = Cross_SSE(c0, c1);
+
+				__m128 invDet = _mm_div_ps(_mm_set1_ps(1.0f), HorizontalSum_SSE(_mm_mul_ps(c0, r0)));
+				r0 = _mm_mul_ps(r0, invDet);
+				r1 = _mm_mul_ps(r1, invDet);
+				r2 = _mm_mul_ps(r2, invDet);
+
+				// 4th row = -(inverse rotation * translation)
+				__m128 d0 = HorizontalSum_SSE(_mm_mul_ps(r0, t));
+				__m128 d1 = HorizontalSum_SSE(_mm_mul_ps(r1, t));
+				__m128 d2 = HorizontalSum_SSE(_mm_mul_ps(r2, t));
+
+				alignas(16) float result[16];
+				_mm_store_ps(result + 0, r0);
+				_mm_store_ps(result + 4, r1);
+				_mm_store_ps(result + 8, r2);
+				_mm_store_ps(result + 12, lastColumn);
+				result[3]  = -_mm_cvtss_f32(d0);
+				result[7]  = -_mm_cvtss_f32(d1);
+				result[11] = -_mm_cvtss_f32(d2);
+
+				memcpy(o, result, sizeof(result));
+			}
+		}
+
+		static void TransformAABBs_SSE(const Matrix4* matrices, size_t matrixStride, const AABB* boxes, AABB* out, size_t count)
+		{
+			const __m128 half = _mm_set1_ps(0.5f);
+			const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				const float* m = Ptr(matrices[i * matrixStride]);
+
+				__m128 c0 = _mm_loadu_ps(m + 0);
+				__m128 c1 = _mm_loadu_ps(m + 4);
+				__m128 c2 = _mm_loadu_ps(m + 8);
+				__m128 c3 = _mm_loadu_ps(m + 12);
+
+				__m128 min = LoadVector3_SSE(boxes[i].Min, 0.0f);
+				__m128 max = LoadVector3_SSE(boxes[i].Max, 0.0f);
+				__m128 center = _mm_mul_ps(_mm_add_ps(min, max), half);
+				__m128 extents = _mm_mul_ps(_mm_sub_ps(max, min), half);
+
+				__m128 newCenter = _mm_mul_ps(c0, _mm_shuffle_ps(center, center, _MM_SHUFFLE(0, 0, 0, 0)));
+				newCenter = _mm_add_ps(newCenter, _mm_mul_ps(c1, _mm_shuffle_ps(center, center, _MM_SHUFFLE(1, 1, 1, 1))));
+				newCenter = _mm_add_ps(newCenter, _mm_mul_ps(c2, _mm_shuffle_ps(center, center, _MM_SHUFFLE(2, 2, 2, 2))));
+				newCenter = _mm_add_ps(newCenter, c3);
+
+				__m128 newExtents = _mm_mul_ps(_mm_and_ps(c0, absMask), _mm_shuffle_ps(extents, extents, _MM_SHUFFLE(0, 0, 0, 0)));
+				newExtents = _mm_add_ps(newExtents, _mm_mul_ps(_mm_and_ps(c1, absMask), _mm_shuffle_ps(extents, extents, _MM_SHUFFLE(1, 1, 1, 1))));
+				newExtents = _mm_add_ps(newExtents, _mm_mul_ps(_mm_and_ps(c2, absMask), _mm_shuffle_ps(extents, extents, _MM_SHUFFLE(2, 2, 2, 2))));
+
+				AABB box;
+				box.Min = StoreVector3_SSE(_mm_sub_ps(newCenter, newExtents));
+				box.Max = StoreVector3_SSE(_mm_add_ps(newCenter, newExtents));
+				out[i] = box;
+			}
+		}
+
+		/* Planes in SoA layout - the 6 planes padded to 8 with a copy of the first one. */
+		struct FrustumPlanesSoA
+		{
+			alignas(32) float NormalX[8];
+			alignas(32) float NormalY[8];
+			alignas(32) float NormalZ[8];
+			alignas(32) float Distance[8];
+
+			FrustumPlanesSoA(const Frustum& frustum)
+			{
+				for (int32 i = 0; i < 8; ++i)
+				{
+					const Vector4& plane = frustum.Planes[i < 6 ? i : 0];
+					NormalX[i] = plane.x;
+					NormalY[i] = plane.y;
+					NormalZ[i] = plane.z;
+					Distance[i] = plane.w;
+				}
+			}
+		};
+
+		FORCEINLINE static bool IsBoxInvalid_SSE(__m128 min, __m128 max)
+		{
+			return _mm_movemask_ps(_mm_cmpgt_ps(min, max)) & 0x7;
+		}
+
+		static size_t TestFrustumAABBs_SSE(const Frustum& frustum, const AABB* boxes, size_t boxStride, uint8* outVisible, size_t count)
+		{
+			const FrustumPlanesSoA planes(frustum);
+			const __m128 half = _mm_set1_ps(0.5f);
+			const __m128 zero = _mm_setzero_ps();
+			const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+
+			// Planes 0-3 and 4-7
+			__m128 nx[2], ny[2], nz[2], d[2], absNx[2], absNy[2], absNz[2];
+			for (int32 group = 0; group < 2; ++group)
+			{
+				nx[group] = _mm_load_ps(planes.NormalX + group * 4);
+				ny[group] = _mm_load_ps(planes.NormalY + group * 4);
+				nz[group] = _mm_load_ps(planes.NormalZ + group * 4);
+				d[group]  = _mm_load_ps(planes.Distance + group * 4);
+				absNx[group] = _mm_and_ps(nx[group], absMask);
+				absNy[group] = _mm_and_ps(ny[group], absMask);
+				absNz[group] = _mm_and_ps(nz[group], absMask);
+			}
+
+			size_t visibleCount = 0;
+			for (size_t i = 0; i < count; ++i)
+			{
+				const AABB& box = GetBox(boxes, boxStride, i);
+
+				__m128 min = LoadVector3_SSE(box.Min, 0.0f);
+				__m128 max = LoadVector3_SSE(box.Max, 0.0f);
+				if (IsBoxInvalid_SSE(min, max))
+				{
+					outVisible[i] = 1;
+					++visibleCount;
+					continue;
+				}
+
+				__m128 center = _mm_mul_ps(_mm_add_ps(min, max), half);
+				__m128 extents = _mm_mul_ps(_mm_sub_ps(max, min), half);
+				__m128 cx = _mm_shuffle_ps(center, center, _MM_SHUFFLE(0, 0, 0, 0));
+				__m128 cy = _mm_shuffle_ps(center, center, _MM_SHUFFLE(1, 1, 1, 1));
+				__m128 cz = _mm_shuffle_ps(center, center, _MM_SHUFFLE(2, 2, 2, 2));
+				__m128 ex = _mm_shuffle_ps(extents, extents, _MM_SHUFFLE(0, 0, 0, 0));
+				__m128 ey = _mm_shuffle_ps(extents, extents, _MM_SHUFFLE(1, 1, 1, 1));
+				__m128 ez = _mm_shuffle_ps(extents, extents, _MM_SHUFFLE(2, 2, 2, 2));
+
+				int32 outsideMask = 0;
+				for (int32 group = 0; group < 2; ++group)
+				{
+					// Distance of the box corner that is the furthest along each plane normal
+					__m128 distance = _mm_add_ps(d[group], _mm_mul_ps(nx[group], cx));
+					distance = _mm_add_ps(distance, _mm_mul_ps(ny[group], cy));
+					distance = _mm_add_ps(distance, _mm_mul_ps(nz[group], cz));
+					distance = _mm_add_ps(distance, _mm_mul_ps(absNx[group], ex));
+					distance = _mm_add_ps(distance, _mm_mul_ps(absNy[group], ey));
+					distance = _mm_add_ps(distance, _mm_mul_ps(absNz[group], ez));
+					outsideMask |= _mm_movemask_ps(_mm_cmplt_ps(distance, zero));
+				}
+
+				uint8 bVisible = outsideMask == 0;
+				outVisible[i] = bVisible;
+				visibleCount += bVisible;
+			}
+			return visibleCount;
+		}
+
+		// AVX2 --------------------------------------------------------------------------
+
+		/* Computes two columns of the result per instruction. */
+		ION_TARGET_AVX2 static void MultiplyMatrices_AVX2(const Matrix4* lhs, size_t lhsStride, const Matrix4* rhs, Matrix4* out, size_t count)
+		{
+			for (size_t i = 0; i < count; ++i)
+			{
+				const float* a = Ptr(lhs[i * lhsStride]);
+				const float* b = Ptr(rhs[i]);
+				float* o = Ptr(out[i]);
+
+				// Columns of a in both lanes
+				__m256 a0 = _mm256_broadcast_ps((const __m128*)(a + 0));
+				__m256 a1 = _mm256_broadcast_ps((const __m128*)(a + 4));
+				__m256 a2 = _mm256_broadcast_ps((const __m128*)(a + 8));
+				__m256 a3 = _mm256_broadcast_ps((const __m128*)(a + 12));
+
+				for (int32 col = 0; col < 4; col += 2)
+				{
+					// Columns col and col + 1 of b
+					__m256 bCols = _mm256_loadu_ps(b + col * 4);
+
+					__m256 result = _mm256_mul_ps(a0, _mm256_shuffle_ps(bCols, bCols, _MM_SHUFFLE(0, 0, 0, 0)));
+					result = _mm256_fmadd_ps(a1, _mm256_shuffle_ps(bCols, bCols, _MM_SHUFFLE(1, 1, 1, 1)), result);
+					result = _mm256_fmadd_ps(a2, _mm256_shuffle_ps(bCols, bCols, _MM_SHUFFLE(2, 2, 2, 2)), result);
+					result = _mm256_fmadd_ps(a3, _mm256_shuffle_ps(bCols, bCols, _MM_SHUFFLE(3, 3, 3, 3)), result);
+					_mm256_storeu_ps(o + col * 4, result);
+				}
+			}
+		}
+
+		/* Tests a box against all 8 (padded) planes at once. */
+		ION_TARGET_AVX2 static size_t TestFrustumAABBs_AVX2(const Frustum& frustum, const AABB* boxes, size_t boxStride, uint8* outVisible, size_t count)
+		{
+			const FrustumPlanesSoA planes(frustum);
+			const __m128 half = _mm_set1_ps(0.5f);
+			const __m256 zero = _mm256_setzero_ps();
+			const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+
+			__m256 nx = _mm256_load_ps(planes.NormalX);
+			__m256 ny = _mm256_load_ps(planes.NormalY);
+			__m256 nz = _mm256_load_ps(planes.NormalZ);
+			__m256 d  = _mm256_load_ps(planes.Distance);
+			__m256 absNx = _mm256_and_ps(nx, absMask);
+			__m256 absNy = _mm256_and_ps(ny, absMask);
+			__m256 absNz = _mm256_and_ps(nz, absMask);
+
+			size_t visibleCount = 0;
+			for (size_t i = 0; i < count; ++i)
+			{
+				const AABB& box = GetBox(boxes, boxStride, i);
+
+				__m128 min = LoadVector3_SSE(box.Min, 0.0f);
+				__m128 max = LoadVector3_SSE(box.Max, 0.0f);
+				if (IsBoxInvalid_SSE(min, max))
+				{
+					outVisible[i] = 1;
+					++visibleCount;
+					continue;
+				}
+
+				alignas(16) float center[4];
+				alignas(16) float extents[4];
+				_mm_store_ps(center, _mm_mul_ps(_mm_add_ps(min, max), half));
+				_mm_store_ps(extents, _mm_mul_ps(_mm_sub_ps(max, min), half));
+
+				// Distance of the box corner that is the furthest along each plane normal
+				__m256 distance = _mm256_fmadd_ps(nx, _mm256_set1_ps(center[0]), d);
+				distance = _mm256_fmadd_ps(ny, _mm256_set1_ps(center[1]), distance);
+				distance = _mm256_fmadd_ps(nz, _mm256_set1_ps(center[2]), distance);
+				distance = _mm256_fmadd_ps(absNx, _mm256_set1_ps(extents[0]), distance);
+				distance = _mm256_fmadd_ps(absNy, _mm256_set1_ps(extents[1]), distance);
+				distance = _mm256_fmadd_ps(absNz, _mm256_set1_ps(extents[2]), distance);
+
+				uint8 bVisible = _mm256_movemask_ps(_mm256_cmp_ps(distance, zero, _CMP_LT_OQ)) == 0;
+				outVisible[i] = bVisible;
+				visibleCount += bVisible;
+			}
+			return visibleCount;
+		}
+
+		// Dispatch ----------------------------------------------------------------------
+
+		static const MathKernelTable c_ScalarKernels = {
+			MultiplyMatrices_Scalar,
+			ComposeMatrices_Scalar,
+			InverseTransposeAffine_Scalar,
+			TransformAABBs_Scalar,
+			TestFrustumAABBs_Scalar,
+		};
+
+		static const MathKernelTable c_SSEKernels = {
+			MultiplyMatrices_SSE,
+			ComposeMatrices_SSE,
+			InverseTransposeAffine_SSE,
+			TransformAABBs_SSE,
+			TestFrustumAABBs_SSE,
+		};
+
+		// The per-element kernels don't benefit from the wider registers,
+		// only the matrix multiplication and the frustum test have an AVX2 version.
+		static const MathKernelTable c_AVX2Kernels = {
+			MultiplyMatrices_AVX2,
+			ComposeMatrices_SSE,
+			InverseTransposeAffine_SSE,
+			TransformAABBs_SSE,
+			TestFrustumAABBs_AVX2,
+		};
+
+		static ESIMDLevel DetectSIMDLevel()
+		{
+#if ION_PLATFORM_WINDOWS
+			int32 info[4];
+			__cpuid(info, 0);
+			int32 maxLeaf = info[0];
+
+			__cpuid(info, 1);
+			bool bSSE2    = info[3] & (1 << 26);
+			bool bFMA     = info[2] & (1 << 12);
+			bool bOSXSAVE = info[2] & (1 << 27);
+			bool bAVX     = info[2] & (1 << 28);
+
+			bool bAVX2 = false;
+			if (maxLeaf >= 7)
+			{
+				__cpuidex(info, 7, 0);
+				bAVX2 = info[1] & (1 << 5);
+			}
+
+			// The OS has to preserve the YMM registers.
+			bool bYMMEnabled = bOSXSAVE && (_xgetbv(0) & 0x6) == 0x6;
+
+			if (bAVX && bAVX2 && bFMA && bYMMEnabled)
+				return ESIMDLevel::AVX2;
+			if (bSSE2)
+				return ESIMDLevel::SSE;
+			return ESIMDLevel::Scalar;
+#else
+			if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+				return ESIMDLevel::AVX2;
+			if (__builtin_cpu_supports("sse2"))
+				return ESIMDLevel::SSE;
+			return ESIMDLevel::Scalar;
+#endif
+		}
+
+		static const MathKernelTable* GetKernelTable(ESIMDLevel level)
+		{
+			switch (level)
+			{
+			case ESIMDLevel::AVX2: return &c_AVX2Kernels;
+			case ESIMDLevel::SSE:  return &c_SSEKernels;
+			default:               return &c_ScalarKernels;
+			}
+		}
+
+		struct MathKernelDispatch
+		{
+			ESIMDLevel SupportedLevel;
+			ESIMDLevel Level;
+			const MathKernelTable* Kernels;
+
+			MathKernelDispatch() :
+				SupportedLevel(DetectSIMDLevel()),
+				Level(SupportedLevel),
+				Kernels(GetKernelTable(SupportedLevel))
+			{
+			}
+		};
+
+		static MathKernelDispatch& GetDispatch()
+		{
+			static MathKernelDispatch c_Dispatch;
+			return c_Dispatch;
+		}
+
+		FORCEINLINE static const MathKernelTable& Kernels()
+		{
+			return *GetDispatch().Kernels;
+		}
+
+		ESIMDLevel GetSupportedSIMDLevel()
+		{
+			return GetDispatch().SupportedLevel;
+		}
+
+		ESIMDLevel GetSIMDLevel()
+		{
+			return GetDispatch().Level;
+		}
+
+		void SetSIMDLevel(ESIMDLevel level)
+		{
+			MathKernelDispatch& dispatch = GetDispatch();
+			dispatch.Level = std::min(level, dispatch.SupportedLevel);
+			dispatch.Kernels = GetKernelTable(dispatch.Level);
+		}
+
+		// Kernels -----------------------------------------------------------------------
+
+		void MultiplyMatrices(const Matrix4* lhs, const Matrix4* rhs, Matrix4* out, size_t count)
+		{
+			Kernels().MultiplyMatrices(lhs, 1, rhs, out, count);
+		}
+
+		void MultiplyMatrices(const Matrix4& lhs, const Matrix4* rhs, Matrix4* out, size_t count)
+		{
+			// Copy, in case lhs is one of the output matrices.
+			Matrix4 lhsCopy = lhs;
+			Kernels().MultiplyMatrices(&lhsCopy, 0, rhs, out, count);
+		}
+
+		void ComposeMatrices(const Vector3* locations, const Quaternion* rotations, const Vector3* scales, Matrix4* out, size_t count)
+		{
+			Kernels().ComposeMatrices(locations, rotations, scales, out, count);
+		}
+
+		void InverseTransposeAffine(const Matrix4* matrices, Matrix4* out, size_t count)
+		{
+			Kernels().InverseTransposeAffine(matrices, out, count);
+		}
+
+		void TransformAABBs(const Matrix4* matrices, const AABB* boxes, AABB* out, size_t count)
+		{
+			Kernels().TransformAABBs(matrices, 1, boxes, out, count);
+		}
+
+		void TransformAABBs(const Matrix4& matrix, const AABB* boxes, AABB* out, size_t count)
+		{
+			Kernels().TransformAABBs(&matrix, 0, boxes, out, count);
+		}
+
+		size_t TestFrustumAABBs(const Frustum& frustum, const AABB* boxes, size_t boxStride, uint8* outVisible, size_t count)
+		{
+			return Kernels().TestFrustumAABBs(frustum, boxes, boxStride, outVisible, count);
+		}
+	}
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "Core/Math/Math.h"
+#include "Core/Math/Bounds.h"
+
+namespace Ion
+{
+	/**
+	 * @brief Instruction set used by the math kernels.
+	 */
+	enum class ESIMDLevel : uint8
+	{
+		Scalar,
+		SSE,
+		AVX2,
+	};
+
+	/**
+	 * @brief Batched math kernels
+	 *
+	 * @details Every kernel has a scalar, an SSE and an AVX2 (+FMA) version.
+	 * The best one supported by the CPU is selected at runtime, on first use.
+	 *
+	 * The matrices are column-major (like in glm).
+	 * Unless stated otherwise, the output array can be the same as one of the input arrays.
+	 */
+	namespace Math
+	{
+		/* The highest instruction set supported by the CPU and the OS. */
+		ION_API ESIMDLevel GetSupportedSIMDLevel();
+		/* The instruction set the kernels currently use. */
+		ION_API ESIMDLevel GetSIMDLevel();
+		/**
+		 * @brief Selects the kernels for the instruction set.
+		 * The level gets clamped to the supported one.
+		 * Not thread-safe, call it before using any kernel (e.g. at startup).
+		 */
+		ION_API void SetSIMDLevel(ESIMDLevel level);
+
+		/* out[i] = lhs[i] * rhs[i] */
+		ION_API void MultiplyMatrices(const Matrix4* lhs, const Matrix4* rhs, Matrix4* out, size_t count);
+		/* out[i] = lhs * rhs[i] */
+		ION_API void MultiplyMatrices(const Matrix4& lhs, const Matrix4* rhs, Matrix4* out, size_t count);
+
+		/* out[i] = Translate(locations[i]) * ToMat4(rotations[i]) * Scale(scales[i]) */
+		ION_API void ComposeMatrices(const Vector3* locations, const Quaternion* rotations, const Vector3* scales, Matrix4* out, size_t count);
+
+		/**
+		 * @brief Computes the normal matrices (inverse-transpose) of affine matrices.
+		 * The 4th row of the input matrices is assumed to be (0, 0, 0, 1).
+		 */
+		ION_API void InverseTransposeAffine(const Matrix4* matrices, Matrix4* out, size_t count);
+
+		/* out[i] = bounds of the boxes[i] transformed by the matrices[i] */
+		ION_API void TransformAABBs(const Matrix4* matrices, const AABB* boxes, AABB* out, size_t count);
+		/* out[i] = bounds of the boxes[i] transformed by the matrix */
+		ION_API void TransformAABBs(const Matrix4& matrix, const AABB* boxes, AABB* out, size_t count);
+
+		/**
+		 * @brief Tests the boxes against the frustum.
+		 *
+		 * @details Invalid boxes (see AABB::IsValid) are always visible.
+		 *
+		 * @param boxStride Distance in bytes between two consecutive boxes,
+		 * so the boxes can be read straight from an array of structs.
+		 * @param outVisible 1 if the box intersects the frustum, else 0
+		 *
+		 * @return The number of visible boxes
+		 */
+		ION_API size_t TestFrustumAABBs(const Frustum& frustum, const AABB* boxes, size_t boxStride, uint8* outVisible, size_t count);
+
+		// Single element helpers
+
+		FORCEINLINE Matrix4 MultiplyMatrix(const Matrix4& lhs, const Matrix4& rhs)
+		{
+			Matrix4 out;
+			MultiplyMatrices(lhs, &rhs, &out, 1);
+			return out;
+		}
+
+		FORCEINLINE Matrix4 InverseTransposeAffine(const Matrix4& matrix)
+		{
+			Matrix4 out;
+			InverseTransposeAffine(&matrix, &out, 1);
+			return out;
+		}
+
+		FORCEINLINE AABB TransformAABB(const Matrix4& matrix, const AABB& box)
+		{
+			AABB out;
+			TransformAABBs(matrix, &box, &out, 1);
+			return out;
+		}
+	}
+}
@@ -1,70 +1,106 @@
 #pragma once
 
 #include "Core/Math/Math.h"
+#include "Core/Math/MathKernels.h"
 #include "Rotator.h"
 
 namespace Ion
 {
+	/**
+	 * @brief Location, rotation and scale, and the matrix built from them.
+	 *
+	 * @details A transform created from a matrix (or composed with another one)
+	 * only stores the matrix and the location. The rotation and the scale
+	 * are derived from the matrix the first time they are accessed.
+	 * Because of that, reading the rotation or the scale of such a transform
+	 * is not thread-safe until it has been resolved (see ResolveRotationScale).
+	 */
 	class Transform
 	{
 	public:
 		Transform(const Vector3& location = Vector3(0.0f), const Rotator& rotation = Rotator(), const Vector3 scale = Vector3(1.0f)) :
 			m_Location(location),
 			m_Rotation(rotation),
-			m_Scale(scale)
+			m_Scale(scale),
+			m_bRotationScaleDirty(false)
 		{
 			RebuildMatrix();
 		}
 
-		Transform(const Matrix4& matrix)
+		Transform(const Matrix4& matrix) :
+			m_Location(matrix[3]),
+			m_Matrix(matrix),
+			m_bRotationScaleDirty(true)
 		{
-			Quaternion rotation;
-			Vector3 skew;
-			Vector4 perspective;
-			glm::decompose(matrix, m_Scale, rotation, m_Location, skew, perspective);
-			m_Rotation = Rotator(rotation);
-
-			RebuildMatrix();
 		}
 
 		void SetLocation(const Vector3& location)
 		{
 			m_Location = location;
-			RebuildMatrix();
+			m_Matrix[3] = Vector4(location, 1.0f);
 		}
 		void SetRotation(const Rotator& rotation)
 		{
+			ResolveRotationScale();
 			m_Rotation = rotation;
 			RebuildMatrix();
 		}
 		void SetScale(const Vector3& scale)
 		{
+			ResolveRotationScale();
 			m_Scale = scale;
 			RebuildMatrix();
 		}
 
 		inline const Vector3& GetLocation() const { return m_Location; }
-		inline const Rotator& GetRotation() const { return m_Rotation; }
-		inline const Vector3& GetScale() const    { return m_Scale; }
+		inline const Rotator& GetRotation() const { ResolveRotationScale(); return m_Rotation; }
+		inline const Vector3& GetScale() const    { ResolveRotationScale(); return m_Scale; }
 
 		inline const Matrix4& GetMatrix() const   { return m_Matrix; }
 
-		inline Vector3 GetForwardVector() const   { return m_Rotation.Forward(); }
-		inline Vector3 GetRightVector() const     { return m_Rotation.Right(); }
-		inline Vector3 GetUpVector() const        { return m_Rotation.Up(); }
+		inline Vector3 GetForwardVector() const   { return GetRotation().Forward(); }
+		inline Vector3 GetRightVector() const     { return GetRotation().Right(); }
+		inline Vector3 GetUpVector() const        { return GetRotation().Up(); }
+
+		/**
+		 * @brief Derives the rotation and the scale from the matrix,
+		 * if they haven't been derived yet.
+		 */
+		void ResolveRotationScale() const
+		{
+			if (!m_bRotationScaleDirty)
+				return;
+
+			Vector3 axisX(m_Matrix[0]);
+			Vector3 axisY(m_Matrix[1]);
+			Vector3 axisZ(m_Matrix[2]);
+
+			m_Scale = Vector3(glm::length(axisX), glm::length(axisY), glm::length(axisZ));
+			// Mirrored basis
+			if (glm::dot(glm::cross(axisX, axisY), axisZ) < 0.0f)
+			{
+				m_Scale.x = -m_Scale.x;
+			}
+
+			Vector3 invScale = Vector3(
+				m_Scale.x != 0.0f ? 1.0f / m_Scale.x : 0.0f,
+				m_Scale.y != 0.0f ? 1.0f / m_Scale.y : 0.0f,
+				m_Scale.z != 0.0f ? 1.0f / m_Scale.z : 0.0f);
+
+			Matrix3 rotation = Matrix3(axisX * invScale.x, axisY * invScale.y, axisZ * invScale.z);
+			m_Rotation = Rotator(glm::quat_cast(rotation));
+
+			m_bRotationScaleDirty = false;
+		}
 
 		// Transform operators
 
+		/* Composes the matrices, the rotation and the scale are derived lazily. */
 		Transform& operator*=(const Transform& other)
 		{
-			m_Matrix = other.GetMatrix() * m_Matrix;
-
-			Quaternion rotation;
-			Vector3 skew;
-			Vector4 perspective;
-			glm::decompose(m_Matrix, m_Scale, rotation, m_Location, skew, perspective);
-
-			m_Rotation = Rotator(rotation);
+			m_Matrix = Math::MultiplyMatrix(other.GetMatrix(), m_Matrix);
+			m_Location = Vector3(m_Matrix[3]);
+			m_bRotationScaleDirty = true;
 
 			return *this;
 		}
@@ -79,8 +115,7 @@ namespace Ion
 
 		Transform& operator+=(const Vector3& location)
 		{
-			m_Location += location;
-			RebuildMatrix();
+			SetLocation(m_Location + location);
 
 			return *this;
 		}
@@ -95,6 +130,7 @@ namespace Ion
 
 		Transform& operator+=(const Rotator& rotator)
 		{
+			ResolveRotationScale();
 			m_Rotation += rotator;
 			RebuildMatrix();
 
@@ -111,6 +147,7 @@ namespace Ion
 
 		Transform& operator*=(const Vector3& scale)
 		{
+			ResolveRotationScale();
 			m_Scale *= scale;
 			RebuildMatrix();
 
@@ -129,8 +166,8 @@ namespace Ion
 		{
 			return 
 				m_Location == other.m_Location && 
-				m_Rotation == other.m_Rotation && 
-				m_Scale == other.m_Scale;
+				GetRotation() == other.GetRotation() && 
+				GetScale() == other.GetScale();
 		}
 
 		bool operator!=(const Transform& other) const
@@ -141,17 +178,17 @@ namespace Ion
 	private:
 		void RebuildMatrix()
 		{
-			m_Matrix = Matrix4(1.0f);
-			m_Matrix *= Math::Translate(m_Location);
-			m_Matrix *= Math::ToMat4(m_Rotation.Quat());
-			m_Matrix *= Math::Scale(m_Scale);
+			Quaternion rotation = m_Rotation.Quat();
+			Math::ComposeMatrices(&m_Location, &rotation, &m_Scale, &m_Matrix, 1);
 		}
 
 	private:
 		Vector3 m_Location;
-		Rotator m_Rotation;
-		Vector3 m_Scale;
+		mutable Rotator m_Rotation;
+		mutable Vector3 m_Scale;
 
 		Matrix4 m_Matrix;
+
+		mutable bool m_bRotationScaleDirty;
 	};
 }
@@ -0,0 +1,578 @@
+#include "Core/CorePCH.h"
+
+#include "EngineAllocator.h"
+#include "Core/Platform/Platform.h"
+
+namespace Ion
+{
+	static constexpr uint32 EngineTagCount = (uint32)EMemoryTag::_Count;
+
+	static constexpr uint32 EngineSizeClasses[] = {
+		16,   32,   48,   64,   80,   96,   112,  128,
+		160,  192,  224,  256,  320,  384,  448,  512,
+		640,  768,  896,  1024, 1280, 1536, 1792, 2048,
+		2560, 3072, 3584, 4096, 5120, 6144, 7168, 8192,
+	};
+	static constexpr uint32 EngineSizeClassCount = sizeof(EngineSizeClasses) / sizeof(uint32);
+	static constexpr uint8 EngineLargeSizeClass = 0xFF;
+
+	static_assert(EngineSizeClasses[EngineSizeClassCount - 1] == EngineAllocator::MaxSmallSize);
+
+	/* Size class index by (size + 15) / 16 */
+	struct EngineSizeClassTable
+	{
+		uint8 ClassBySize[EngineAllocator::MaxSmallSize / EngineAllocator::Alignment + 1];
+
+		constexpr EngineSizeClassTable() :
+			ClassBySize()
+		{
+			uint32 sizeClass = 0;
+			for (uint32 i = 0; i < sizeof(ClassBySize); ++i)
+			{
+				while (EngineSizeClasses[sizeClass] < i * EngineAllocator::Alignment)
+					++sizeClass;
+				ClassBySize[i] = (uint8)sizeClass;
+			}
+		}
+	};
+	static constexpr EngineSizeClassTable c_EngineSizeClassTable;
+
+	static FORCEINLINE uint32 GetEngineSizeClass(size_t size)
+	{
+		return c_EngineSizeClassTable.ClassBySize[(size + EngineAllocator::Alignment - 1) / EngineAllocator::Alignment];
+	}
+
+	/* Max number of the blocks in a thread cache of a size class, half of them are exchanged at once. */
+	static FORCEINLINE uint32 GetEngineThreadCacheLimit(uint32 sizeClass)
+	{
+		return std::clamp<uint32>((32 << 10) / EngineSizeClasses[sizeClass], 4, 256);
+	}
+
+	/**
+	 * @brief Header at the start of every page.
+	 */
+	struct alignas(64) EnginePage
+	{
+		/* Pages with free blocks of the bin */
+		EnginePage* Next;
+		EnginePage* Prev;
+		/* Blocks that have been freed */
+		void* FreeList;
+		/* Blocks that have never been used start here */
+		uint8* Unused;
+		/* Blocks taken by the thread caches (including the allocated ones) */
+		uint32 UsedCount;
+		uint32 Capacity;
+		uint32 BlockSize;
+		uint8 SizeClass;
+		EMemoryTag Tag;
+		bool bInPartialList;
+		/* Size of the pages of a large allocation */
+		size_t LargeSize;
+
+		static FORCEINLINE EnginePage* FromPtr(const void* ptr)
+		{
+			return (EnginePage*)((uintptr_t)ptr & ~(uintptr_t)(EngineAllocator::PageSize - 1));
+		}
+
+		FORCEINLINE uint8* GetData()
+		{
+			return (uint8*)this + sizeof(EnginePage);
+		}
+
+		FORCEINLINE void* TakeBlock()
+		{
+			ionassert(UsedCount < Capacity);
+
+			void* block;
+			if (FreeList)
+			{
+				block = FreeList;
+				FreeList = *(void**)block;
+			}
+			else
+			{
+				block = Unused;
+				Unused += BlockSize;
+			}
+			++UsedCount;
+			return block;
+		}
+	};
+
+	/**
+	 * @brief Pages of a single tag and size class.
+	 */
+	struct EngineBin
+	{
+		Mutex Lock;
+		/* Pages with free blocks */
+		EnginePage* Partial = nullptr;
+		/* A page with no blocks in use, kept to avoid allocating a new one right away */
+		EnginePage* Spare = nullptr;
+	};
+
+	/**
+	 * @brief Live allocation counters of a thread, written by the owning thread only.
+	 * The counters of the allocations freed on another thread can be negative.
+	 */
+	struct EngineTagCounters
+	{
+		TAtomic<int64> AllocatedBytes { 0 };
+		TAtomic<int64> AllocationCount { 0 };
+		TAtomic<uint64> TotalAllocations { 0 };
+
+		FORCEINLINE void Add(int64 bytes, int64 count)
+		{
+			AllocatedBytes.store(AllocatedBytes.load(std::memory_order_relaxed) + bytes, std::memory_order_relaxed);
+			AllocationCount.store(AllocationCount.load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
+			if (count > 0)
+				TotalAllocations.store(TotalAllocations.load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
+		}
+	};
+
+	struct EngineThreadCache;
+
+	struct EngineAllocatorState
+	{
+		EngineBin Bins[EngineTagCount][EngineSizeClassCount];
+		TAtomic<uint64> PageBytes[EngineTagCount] = { };
+
+		/* Registered thread caches, for the stats */
+		TArray<EngineThreadCache*> ThreadCaches;
+		Mutex ThreadCachesLock;
+
+		/* Counters of the exited threads and the allocations made without a cache (atomic) */
+		TAtomic<int64> RetiredBytes[EngineTagCount] = { };
+		TAtomic<int64> RetiredCount[EngineTagCount] = { };
+		TAtomic<uint64> RetiredTotal[EngineTagCount] = { };
+	};
+
+	// Never destroyed, the objects can be freed during the static destruction.
+	static EngineAllocatorState& GetEngineAllocatorState()
+	{
+		static EngineAllocatorState* c_State = new EngineAllocatorState;
+		return *c_State;
+	}
+
+	static void AddRetiredCounters(EMemoryTag tag, int64 bytes, int64 count)
+	{
+		EngineAllocatorState& state = GetEngineAllocatorState();
+		state.RetiredBytes[(uint32)tag].fetch_add(bytes, std::memory_order_relaxed);
+		state.RetiredCount[(uint32)tag].fetch_add(count, std::memory_order_relaxed);
+		if (count > 0)
+			state.RetiredTotal[(uint32)tag].fetch_add(count, std::memory_order_relaxed);
+	}
+
+	// Bin -------------------------------------------------------------------------
+
+	static EnginePage* AllocateEnginePage(EMemoryTag tag, uint32 sizeClass)
+	{
+		ionassert(Platform::GetPageAllocationGranularity() % EngineAllocator::PageSize == 0);
+
+		EnginePage* page = (EnginePage*)Platform::AllocatePages(EngineAllocator::PageSize);
+		ionverify(page, "Out of memory.");
+
+		page->Next = nullptr;
+		page->Prev = nullptr;
+		page->FreeList = nullptr;
+		page->Unused = page->GetData();
+		page->UsedCount = 0;
+		page->BlockSize = EngineSizeClasses[sizeClass];
+		page->Capacity = (uint32)((EngineAllocator::PageSize - sizeof(EnginePage)) / page->BlockSize);
+		page->SizeClass = (uint8)sizeClass;
+		page->Tag = tag;
+		page->bInPartialList = false;
+		page->LargeSize = 0;
+
+		GetEngineAllocatorState().PageBytes[(uint32)tag].fetch_add(EngineAllocator::PageSize, std::memory_order_relaxed);
+
+		return page;
+	}
+
+	static void ReleaseEnginePage(EnginePage* page)
+	{
+		GetEngineAllocatorState().PageBytes[(uint32)page->Tag].fetch_sub(EngineAllocator::PageSize, std::memory_order_relaxed);
+
+		Platform::FreePages(page);
+	}
+
+	static void LinkPartialPage(EngineBin& bin, EnginePage* page)
+	{
+		ionassert(!page->bInPartialList);
+
+		page->Prev = nullptr;
+		page->Next = bin.Partial;
+		if (bin.Partial)
+			bin.Partial->Prev = page;
+		bin.Partial = page;
+		page->bInPartialList = true;
+	}
+
+	static void UnlinkPartialPage(EngineBin& bin, EnginePage* page)
+	{
+		ionassert(page->bInPartialList);
+
+		if (page->Prev)
+			page->Prev->Next = page->Next;
+		else
+			bin.Partial = page->Next;
+		if (page->Next)
+			page->Next->Prev = page->Prev;
+		page->Next = nullptr;
+		page->Prev = nullptr;
+		page->bInPartialList = false;
+	}
+
+	/* Takes count blocks from the pages of the bin and links them together. Call under the bin lock. */
+	static void* TakeBinBlocks(EngineBin& bin, EMemoryTag tag, uint32 sizeClass, uint32 count)
+	{
+		void* head = nullptr;
+		for (uint32 i = 0; i < count; ++i)
+		{
+			EnginePage* page = bin.Partial;
+			if (!page)
+			{
+				if (bin.Spare)
+				{
+					page = bin.Spare;
+					bin.Spare = nullptr;
+				}
+				else
+				{
+					page = AllocateEnginePage(tag, sizeClass);
+				}
+				LinkPartialPage(bin, page);
+			}
+
+			void* block = page->TakeBlock();
+			*(void**)block = head;
+			head = block;
+
+			if (page->UsedCount == page->Capacity)
+				UnlinkPartialPage(bin, page);
+		}
+		return head;
+	}
+
+	/* Returns a block to its page. Call under the bin lock. */
+	static void ReturnBinBlock(EngineBin& bin, void* block)
+	{
+		EnginePage* page = EnginePage::FromPtr(block);
+		ionassert(page->UsedCount > 0);
+
+		*(void**)block = page->FreeList;
+		page->FreeList = block;
+
+		if (!page->bInPartialList)
+			LinkPartialPage(bin, page);
+
+		if (--page->UsedCount == 0)
+		{
+			UnlinkPartialPage(bin, page);
+			if (!bin.Spare)
+			{
+				bin.Spare = page;
+			}
+			else
+			{
+				ReleaseEnginePage(page);
+			}
+		}
+	}
+
+	// Thread cache ----------------------------------------------------------------
+
+	struct EngineThreadCache
+	{
+		struct Bin
+		{
+			void* Head = nullptr;
+			uint32 Count = 0;
+		};
+
+		Bin Bins[EngineTagCount][EngineSizeClassCount];
+		EngineTagCounters Counters[EngineTagCount];
+
+		EngineThreadCache()
+		{
+			EngineAllocatorState& state = GetEngineAllocatorState();
+
+			ScopedLock lock(state.ThreadCachesLock);
+			state.ThreadCaches.push_back(this);
+		}
+
+		~EngineThreadCache();
+
+		void Refill(EMemoryTag tag, uint32 sizeClass)
+		{
+			Bin& cacheBin = Bins[(uint32)tag][sizeClass];
+			ionassert(!cacheBin.Head);
+
+			uint32 count = GetEngineThreadCacheLimit(sizeClass) / 2;
+
+			EngineBin& bin = GetEngineAllocatorState().Bins[(uint32)tag][sizeClass];
+			ScopedLock lock(bin.Lock);
+			cacheBin.Head = TakeBinBlocks(bin, tag, sizeClass, count);
+			cacheBin.Count = count;
+		}
+
+		/* Returns count blocks, or all of them if count is 0 */
+		void Return(EMemoryTag tag, uint32 sizeClass, uint32 count)
+		{
+			Bin& cacheBin = Bins[(uint32)tag][sizeClass];
+			if (!cacheBin.Head)
+				return;
+
+			if (!count || count > cacheBin.Count)
+				count = cacheBin.Count;
+
+			EngineBin& bin = GetEngineAllocatorState().Bins[(uint32)tag][sizeClass];
+			ScopedLock lock(bin.Lock);
+			for (uint32 i = 0; i < count; ++i)
+			{
+				void* block = cacheBin.Head;
+				cacheBin.Head = *(void**)block;
+				ReturnBinBlock(bin, block);
+			}
+			cacheBin.Count -= count;
+		}
+
+		void ReturnAll()
+		{
+			for (uint32 tag = 0; tag < EngineTagCount; ++tag)
+			{
+				for (uint32 sizeClass = 0; sizeClass < EngineSizeClassCount; ++sizeClass)
+				{
+					Return((EMemoryTag)tag, sizeClass, 0);
+				}
+			}
+		}
+	};
+
+	static thread_local EngineThreadCache t_EngineThreadCache;
+	// Set when the cache is destroyed, the thread-local objects destroyed later can still free their memory.
+	static thread_local bool t_bEngineThreadCacheDestroyed = false;
+
+	EngineThreadCache::~EngineThreadCache()
+	{
+		ReturnAll();
+
+		EngineAllocatorState& state = GetEngineAllocatorState();
+
+		ScopedLock lock(state.ThreadCachesLock);
+		for (uint32 tag = 0; tag < EngineTagCount; ++tag)
+		{
+			const EngineTagCounters& counters = Counters[tag];
+			state.RetiredBytes[tag].fetch_add(counters.AllocatedBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			state.RetiredCount[tag].fetch_add(counters.AllocationCount.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			state.RetiredTotal[tag].fetch_add(counters.TotalAllocations.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		}
+		state.ThreadCaches.erase(std::find(state.ThreadCaches.begin(), state.ThreadCaches.end(), this));
+
+		t_bEngineThreadCacheDestroyed = true;
+	}
+
+	// Large allocations -----------------------------------------------------------
+
+	static void* AllocateLarge(size_t size, EMemoryTag tag)
+	{
+		size_t pagesSize = AlignAs(sizeof(EnginePage) + size, EngineAllocator::PageSize);
+
+		EnginePage* page = (EnginePage*)Platform::AllocatePages(pagesSize);
+		ionverify(page, "Out of memory.");
+
+		page->SizeClass = EngineLargeSizeClass;
+		page->Tag = tag;
+		page->LargeSize = pagesSize;
+
+		GetEngineAllocatorState().PageBytes[(uint32)tag].fetch_add(pagesSize, std::memory_order_relaxed);
+
+		return page->GetData();
+	}
+
+	static void FreeLarge(EnginePage* page)
+	{
+		GetEngineAllocatorState().PageBytes[(uint32)page->Tag].fetch_sub(page->LargeSize, std::memory_order_relaxed);
+
+		Platform::FreePages(page);
+	}
+
+	// EngineAllocator -------------------------------------------------------------
+
+	void* EngineAllocator::Allocate(size_t size, EMemoryTag tag)
+	{
+		ionassert(tag < EMemoryTag::_Count);
+
+		if (size > MaxSmallSize)
+		{
+			void* ptr = AllocateLarge(size, tag);
+			int64 bytes = (int64)(EnginePage::FromPtr(ptr)->LargeSize - sizeof(EnginePage));
+			if (!t_bEngineThreadCacheDestroyed)
+				t_EngineThreadCache.Counters[(uint32)tag].Add(bytes, 1);
+			else
+				AddRetiredCounters(tag, bytes, 1);
+			return ptr;
+		}
+
+		uint32 sizeClass = GetEngineSizeClass(size);
+
+		if (t_bEngineThreadCacheDestroyed)
+		{
+			EngineBin& bin = GetEngineAllocatorState().Bins[(uint32)tag][sizeClass];
+			void* block;
+			{
+				ScopedLock lock(bin.Lock);
+				block = TakeBinBlocks(bin, tag, sizeClass, 1);
+			}
+			AddRetiredCounters(tag, EngineSizeClasses[sizeClass], 1);
+			return block;
+		}
+
+		EngineThreadCache& cache = t_EngineThreadCache;
+		EngineThreadCache::Bin& cacheBin = cache.Bins[(uint32)tag][sizeClass];
+		if (!cacheBin.Head)
+			cache.Refill(tag, sizeClass);
+
+		void* block = cacheBin.Head;
+		cacheBin.Head = *(void**)block;
+		--cacheBin.Count;
+
+		cache.Counters[(uint32)tag].Add(EngineSizeClasses[sizeClass], 1);
+
+		return block;
+	}
+
+	void EngineAllocator::Free(void* ptr)
+	{
+		if (!ptr)
+			return;
+
+		EnginePage* page = EnginePage::FromPtr(ptr);
+		EMemoryTag tag = page->Tag;
+
+		if (page->SizeClass == EngineLargeSizeClass)
+		{
+			int64 bytes = (int64)(page->LargeSize - sizeof(EnginePage));
+			if (!t_bEngineThreadCacheDestroyed)
+				t_EngineThreadCache.Counters[(uint32)tag].Add(-bytes, -1);
+			else
+				AddRetiredCounters(tag, -bytes, -1);
+
+			FreeLarge(page);
+			return;
+		}
+
+		uint32 sizeClass = page->SizeClass;
+		ionassert(sizeClass < EngineSizeClassCount);
+		ionassert(((uint8*)ptr - page->GetData()) % page->BlockSize == 0, "The pointer has not been allocated by the EngineAllocator.");
+
+		if (t_bEngineThreadCacheDestroyed)
+		{
+			EngineBin& bin = GetEngineAllocatorState().Bins[(uint32)tag][sizeClass];
+			{
+				ScopedLock lock(bin.Lock);
+				ReturnBinBlock(bin, ptr);
+			}
+			AddRetiredCounters(tag, -(int64)EngineSizeClasses[sizeClass], -1);
+			return;
+		}
+
+		EngineThreadCache& cache = t_EngineThreadCache;
+		EngineThreadCache::Bin& cacheBin = cache.Bins[(uint32)tag][sizeClass];
+
+		*(void**)ptr = cacheBin.Head;
+		cacheBin.Head = ptr;
+		++cacheBin.Count;
+
+		cache.Counters[(uint32)tag].Add(-(int64)EngineSizeClasses[sizeClass], -1);
+
+		uint32 limit = GetEngineThreadCacheLimit(sizeClass);
+		if (cacheBin.Count > limit)
+			cache.Return(tag, sizeClass, limit / 2);
+	}
+
+	size_t EngineAllocator::GetAllocationSize(const void* ptr)
+	{
+		ionassert(ptr);
+
+		EnginePage* page = EnginePage::FromPtr(ptr);
+		if (page->SizeClass == EngineLargeSizeClass)
+			return page->LargeSize - sizeof(EnginePage);
+
+		return page->BlockSize;
+	}
+
+	EngineAllocatorTagStats EngineAllocator::GetTagStats(EMemoryTag tag)
+	{
+		ionassert(tag < EMemoryTag::_Count);
+
+		EngineAllocatorState& state = GetEngineAllocatorState();
+
+		EngineAllocatorTagStats stats { };
+
+		ScopedLock lock(state.ThreadCachesLock);
+
+		stats.AllocatedBytes = state.RetiredBytes[(uint32)tag].load(std::memory_order_relaxed);
+		stats.AllocationCount = state.RetiredCount[(uint32)tag].load(std::memory_order_relaxed);
+		stats.TotalAllocations = state.RetiredTotal[(uint32)tag].load(std::memory_order_relaxed);
+		for (EngineThreadCache* cache : state.ThreadCaches)
+		{
+			const EngineTagCounters& counters = cache->Counters[(uint32)tag];
+			stats.AllocatedBytes += counters.AllocatedBytes.load(std::memory_order_relaxed);
+			stats.AllocationCount += counters.AllocationCount.load(std::memory_order_relaxed);
+			stats.TotalAllocations += counters.TotalAllocations.load(std::memory_order_relaxed);
+		}
+		stats.PageBytes = state.PageBytes[(uint32)tag].load(std::memory_order_relaxed);
+
+		return stats;
+	}
+
+	const char* EngineAllocator::GetTagName(EMemoryTag tag)
+	{
+		switch (tag)
+		{
+		case EMemoryTag::Untagged: return "Untagged";
+		case EMemoryTag::Engine:   return "Engine";
+		case EMemoryTag::Renderer: return "Renderer";
+		case EMemoryTag::Asset:    return "Asset";
+		default:                   return "Unknown";
+		}
+	}
+
+	void EngineAllocator::PrintStats()
+	{
+		for (uint32 tag = 0; tag < EngineTagCount; ++tag)
+		{
+			EngineAllocatorTagStats stats = GetTagStats((EMemoryTag)tag);
+			MemoryLogger.Info("EngineAllocator [{}] - {} allocations, {} bytes allocated, {} bytes in pages, {} allocations in total.",
+				GetTagName((EMemoryTag)tag), stats.AllocationCount, stats.AllocatedBytes, stats.PageBytes, stats.TotalAllocations);
+		}
+	}
+
+	void EngineAllocator::FlushThreadCache()
+	{
+		if (!t_bEngineThreadCacheDestroyed)
+			t_EngineThreadCache.ReturnAll();
+	}
+
+	void EngineAllocator::ReleaseEmptyPages()
+	{
+		EngineAllocatorState& state = GetEngineAllocatorState();
+
+		for (uint32 tag = 0; tag < EngineTagCount; ++tag)
+		{
+			for (uint32 sizeClass = 0; sizeClass < EngineSizeClassCount; ++sizeClass)
+			{
+				EngineBin& bin = state.Bins[tag][sizeClass];
+
+				ScopedLock lock(bin.Lock);
+				if (bin.Spare)
+				{
+					ReleaseEnginePage(bin.Spare);
+					bin.Spare = nullptr;
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "MemoryCore.h"
+
+namespace Ion
+{
+	/**
+	 * @brief Tag of the EngineAllocator allocations, the stats are tracked per tag.
+	 */
+	enum class EMemoryTag : uint8
+	{
+		Untagged = 0,
+		Engine,
+		Renderer,
+		Asset,
+		_Count
+	};
+
+	struct EngineAllocatorTagStats
+	{
+		/* Bytes of the live allocations (rounded up to their size classes) */
+		int64 AllocatedBytes;
+		/* Number of the live allocations */
+		int64 AllocationCount;
+		/* Number of all the allocations made so far */
+		uint64 TotalAllocations;
+		/* Bytes of the pages owned by the tag, including the free blocks */
+		uint64 PageBytes;
+	};
+
+	/**
+	 * @brief General-purpose allocator with size classes, per-thread caches and page-level reclaim.
+	 *
+	 * @details The small allocations (up to MaxSmallSize) are made from 64 KB pages,
+	 * which are split into blocks of a single size class and tag.
+	 * Each thread allocates from and frees to its own cache of free blocks, without any locks.
+	 * The caches exchange the blocks with the pages in batches, under a lock per size class.
+	 * A page that has no blocks in use is released to the system, except for a single spare per size class.
+	 * The large allocations get their own pages.
+	 *
+	 * The block of a pointer is found from the page header at the page aligned address,
+	 * so any pointer can be freed on any thread without the tag or the size.
+	 *
+	 * The classes opt in with ENGINE_ALLOCATED, which also makes the TSharedPtr control blocks
+	 * (MakeShared, MClass::Instantiate) and the TRef objects (MakeRef) use the allocator.
+	 */
+	class ION_API EngineAllocator
+	{
+	public:
+		static constexpr size_t Alignment = 16;
+		static constexpr size_t PageSize = 64 << 10;
+		/* The larger allocations get their own pages */
+		static constexpr size_t MaxSmallSize = 8 << 10;
+
+		NODISCARD static void* Allocate(size_t size, EMemoryTag tag = EMemoryTag::Untagged);
+		static void Free(void* ptr);
+
+		/* @return Usable size of the allocation (size of its class) */
+		static size_t GetAllocationSize(const void* ptr);
+
+		static EngineAllocatorTagStats GetTagStats(EMemoryTag tag);
+		static const char* GetTagName(EMemoryTag tag);
+		/* Logs the stats of all the tags */
+		static void PrintStats();
+
+		/* Returns the blocks cached by the calling thread to the pages. */
+		static void FlushThreadCache();
+		/* Releases the spare empty pages to the system. */
+		static void ReleaseEmptyPages();
+	};
+
+	template<typename T, typename = void>
+	struct TIsEngineAllocated : TBool<false> { };
+	template<typename T>
+	struct TIsEngineAllocated<T, std::void_t<decltype(T::EngineMemoryTag)>> : TBool<true> { };
+
+	template<typename T>
+	static constexpr bool TIsEngineAllocatedV = TIsEngineAllocated<T>::value;
+
+	/**
+	 * @brief Makes the class and the classes derived from it allocate with EngineAllocator.
+	 * Put it in a public section of the class.
+	 *
+	 * Over-aligned objects are allocated with the global aligned new.
+	 */
+#define ENGINE_ALLOCATED(tag) \
+	static constexpr ::Ion::EMemoryTag EngineMemoryTag = tag; \
+	FORCEINLINE static void* operator new(size_t size) { return ::Ion::EngineAllocator::Allocate(size, tag); } \
+	FORCEINLINE static void* operator new(size_t size, std::align_val_t alignment) { return ::operator new(size, alignment); } \
+	FORCEINLINE static void* operator new(size_t, void* where) noexcept { return where; } \
+	FORCEINLINE static void operator delete(void* ptr) noexcept { ::Ion::EngineAllocator::Free(ptr); } \
+	FORCEINLINE static void operator delete(void* ptr, std::align_val_t alignment) noexcept { ::operator delete(ptr, alignment); } \
+	FORCEINLINE static void operator delete(void*, void*) noexcept { }
+}
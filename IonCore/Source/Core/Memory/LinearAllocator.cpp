@@ -0,0 +1,391 @@
+#include "Core/CorePCH.h"
+
+#include "LinearAllocator.h"
+#include "Core/Platform/Platform.h"
+#include "Core/Diagnostics/Tracing.h"
+
+namespace Ion
+{
+	// LinearAllocator -------------------------------------------------------------
+
+	struct alignas(LinearAllocator::DefaultAlignment) LinearAllocator::Chunk
+	{
+		Chunk* Next;
+		/* Size of the data after the header */
+		size_t Size;
+
+		FORCEINLINE uint8* GetData()
+		{
+			return (uint8*)this + sizeof(Chunk);
+		}
+
+		FORCEINLINE uint8* GetEnd()
+		{
+			return GetData() + Size;
+		}
+	};
+
+	static LinearAllocator::Chunk* AllocateLinearChunk(size_t dataSize)
+	{
+		size_t size = AlignAs(dataSize + sizeof(LinearAllocator::Chunk), Platform::GetPageAllocationGranularity());
+
+		LinearAllocator::Chunk* chunk = (LinearAllocator::Chunk*)Platform::AllocatePages(size);
+		ionverify(chunk, "Out of memory.");
+
+		chunk->Next = nullptr;
+		chunk->Size = size - sizeof(LinearAllocator::Chunk);
+
+		return chunk;
+	}
+
+	LinearAllocator::LinearAllocator(size_t chunkSize) :
+		m_FirstChunk(nullptr),
+		m_CurrentChunk(nullptr),
+		m_Cursor(nullptr),
+		m_End(nullptr),
+		m_ChunkSize(chunkSize)
+	{
+	}
+
+	LinearAllocator::~LinearAllocator()
+	{
+		FreeChunks();
+	}
+
+	void* LinearAllocator::AllocateSlow(size_t size, size_t alignment)
+	{
+		// Reuse the chunks kept from before the last rewind first.
+		Chunk* chunk = m_CurrentChunk ? m_CurrentChunk->Next : nullptr;
+		while (chunk && AlignAs((uintptr_t)chunk->GetData(), alignment) + size > (uintptr_t)chunk->GetEnd())
+		{
+			chunk = chunk->Next;
+		}
+
+		if (!chunk)
+		{
+			chunk = AllocateLinearChunk(std::max(m_ChunkSize, size + alignment));
+			if (m_CurrentChunk)
+			{
+				chunk->Next = m_CurrentChunk->Next;
+				m_CurrentChunk->Next = chunk;
+			}
+			else
+			{
+				ionassert(!m_FirstChunk);
+				m_FirstChunk = chunk;
+			}
+
+			MemoryLogger.Trace("LinearAllocator has allocated a new chunk of {} bytes.", chunk->Size);
+		}
+
+		m_CurrentChunk = chunk;
+		m_End = chunk->GetEnd();
+
+		uint8* ptr = (uint8*)AlignAs((uintptr_t)chunk->GetData(), alignment);
+		m_Cursor = ptr + size;
+		return ptr;
+	}
+
+	void LinearAllocator::Rewind(const Marker& marker)
+	{
+		if (!marker.CurrentChunk)
+		{
+			// The marker has been taken before the first allocation
+			if (!m_FirstChunk)
+				return;
+
+			m_CurrentChunk = m_FirstChunk;
+			m_Cursor = m_FirstChunk->GetData();
+		}
+		else
+		{
+			m_CurrentChunk = marker.CurrentChunk;
+			m_Cursor = marker.Cursor;
+		}
+		m_End = m_CurrentChunk->GetEnd();
+	}
+
+	void LinearAllocator::Reset()
+	{
+		if (!m_FirstChunk)
+			return;
+
+		// Next time all the allocations will fit in a single chunk.
+		if (m_FirstChunk->Next)
+		{
+			size_t capacity = GetCapacity();
+			FreeChunks();
+			m_FirstChunk = AllocateLinearChunk(capacity);
+		}
+
+		m_CurrentChunk = m_FirstChunk;
+		m_Cursor = m_FirstChunk->GetData();
+		m_End = m_FirstChunk->GetEnd();
+	}
+
+	size_t LinearAllocator::GetUsedBytes() const
+	{
+		if (!m_CurrentChunk)
+			return 0;
+
+		size_t used = 0;
+		for (Chunk* chunk = m_FirstChunk; chunk != m_CurrentChunk; chunk = chunk->Next)
+		{
+			used += chunk->Size;
+		}
+		return used + (m_Cursor - m_CurrentChunk->GetData());
+	}
+
+	size_t LinearAllocator::GetCapacity() const
+	{
+		size_t capacity = 0;
+		for (Chunk* chunk = m_FirstChunk; chunk; chunk = chunk->Next)
+		{
+			capacity += chunk->Size;
+		}
+		return capacity;
+	}
+
+	void LinearAllocator::FreeChunks()
+	{
+		Chunk* chunk = m_FirstChunk;
+		while (chunk)
+		{
+			Chunk* next = chunk->Next;
+			Platform::FreePages(chunk);
+			chunk = next;
+		}
+
+		m_FirstChunk = nullptr;
+		m_CurrentChunk = nullptr;
+		m_Cursor = nullptr;
+		m_End = nullptr;
+	}
+
+	// FrameAllocator --------------------------------------------------------------
+
+	static constexpr size_t FrameChunkSize = 1 << 20;
+
+	struct alignas(FrameAllocator::DefaultAlignment) FrameChunk
+	{
+		/* Can exceed the Size, if the last allocations didn't fit */
+		TAtomic<size_t> Offset;
+		/* Size of the data after the header */
+		size_t Size;
+		FrameChunk* Next;
+
+		FORCEINLINE uint8* GetData()
+		{
+			return (uint8*)this + sizeof(FrameChunk);
+		}
+	};
+
+	struct FrameBuffer
+	{
+		/* Chunk the allocations are made from */
+		TAtomic<FrameChunk*> Current { nullptr };
+		/* All the chunks of the buffer */
+		FrameChunk* Chunks = nullptr;
+		Mutex GrowLock;
+	};
+
+	struct FrameAllocatorState
+	{
+		FrameBuffer Buffers[FrameAllocator::BufferCount];
+		TAtomic<uint32> CurrentBuffer { 0 };
+		uint64 FrameIndex = 0;
+	};
+
+	// Never destroyed, the frame data can be destroyed during the static destruction.
+	static FrameAllocatorState& GetFrameAllocatorState()
+	{
+		static FrameAllocatorState* c_State = new FrameAllocatorState;
+		return *c_State;
+	}
+
+	static FrameChunk* AllocateFrameChunk(size_t dataSize)
+	{
+		size_t size = AlignAs(dataSize + sizeof(FrameChunk), Platform::GetPageAllocationGranularity());
+
+		FrameChunk* chunk = (FrameChunk*)Platform::AllocatePages(size);
+		ionverify(chunk, "Out of memory.");
+
+		new(&chunk->Offset) TAtomic<size_t>(0);
+		chunk->Size = size - sizeof(FrameChunk);
+		chunk->Next = nullptr;
+
+		return chunk;
+	}
+
+	static void FreeFrameChunks(FrameBuffer& buffer)
+	{
+		FrameChunk* chunk = buffer.Chunks;
+		while (chunk)
+		{
+			FrameChunk* next = chunk->Next;
+			Platform::FreePages(chunk);
+			chunk = next;
+		}
+		buffer.Chunks = nullptr;
+	}
+
+	/* @return The chunk that replaced the full one */
+	static FrameChunk* GrowFrameBuffer(FrameBuffer& buffer, FrameChunk* fullChunk, size_t paddedSize)
+	{
+		ScopedLock lock(buffer.GrowLock);
+
+		// Another thread has grown the buffer already
+		FrameChunk* current = buffer.Current.load(std::memory_order_relaxed);
+		if (current != fullChunk)
+			return current;
+
+		FrameChunk* chunk = AllocateFrameChunk(std::max(FrameChunkSize, paddedSize));
+		chunk->Next = buffer.Chunks;
+		buffer.Chunks = chunk;
+
+		buffer.Current.store(chunk, std::memory_order_release);
+
+		MemoryLogger.Trace("FrameAllocator has allocated a new chunk of {} bytes.", chunk->Size);
+
+		return chunk;
+	}
+
+	void* FrameAllocator::Allocate(size_t size, size_t alignment)
+	{
+		ionassert(alignment && (alignment & (alignment - 1)) == 0, "The alignment has to be a power of 2.");
+
+		FrameAllocatorState& state = GetFrameAllocatorState();
+		FrameBuffer& buffer = state.Buffers[state.CurrentBuffer.load(std::memory_order_acquire)];
+
+		size_t paddedSize = size + alignment - 1;
+
+		FrameChunk* chunk = buffer.Current.load(std::memory_order_acquire);
+		while (true)
+		{
+			if (chunk)
+			{
+				size_t offset = chunk->Offset.fetch_add(paddedSize, std::memory_order_relaxed);
+				if (offset + paddedSize <= chunk->Size)
+				{
+					return (void*)AlignAs((uintptr_t)(chunk->GetData() + offset), alignment);
+				}
+			}
+			chunk = GrowFrameBuffer(buffer, chunk, paddedSize);
+		}
+	}
+
+	void FrameAllocator::BeginFrame()
+	{
+		TRACE_FUNCTION();
+
+		ionassert(Platform::IsMainThread());
+
+		FrameAllocatorState& state = GetFrameAllocatorState();
+
+		uint32 bufferIndex = (state.CurrentBuffer.load(std::memory_order_relaxed) + 1) % BufferCount;
+		FrameBuffer& buffer = state.Buffers[bufferIndex];
+
+		// Merge the chunks, so the next frames fit in one.
+		if (buffer.Chunks && buffer.Chunks->Next)
+		{
+			size_t capacity = 0;
+			for (FrameChunk* chunk = buffer.Chunks; chunk; chunk = chunk->Next)
+			{
+				capacity += chunk->Size;
+			}
+			FreeFrameChunks(buffer);
+			buffer.Chunks = AllocateFrameChunk(capacity);
+		}
+
+		if (buffer.Chunks)
+			buffer.Chunks->Offset.store(0, std::memory_order_relaxed);
+
+		buffer.Current.store(buffer.Chunks, std::memory_order_relaxed);
+		state.CurrentBuffer.store(bufferIndex, std::memory_order_release);
+
+		++state.FrameIndex;
+	}
+
+	uint64 FrameAllocator::GetFrameIndex()
+	{
+		return GetFrameAllocatorState().FrameIndex;
+	}
+
+	size_t FrameAllocator::GetUsedBytes()
+	{
+		FrameAllocatorState& state = GetFrameAllocatorState();
+		FrameBuffer& buffer = state.Buffers[state.CurrentBuffer.load(std::memory_order_acquire)];
+
+		ScopedLock lock(buffer.GrowLock);
+
+		size_t used = 0;
+		for (FrameChunk* chunk = buffer.Chunks; chunk; chunk = chunk->Next)
+		{
+			used += std::min(chunk->Offset.load(std::memory_order_relaxed), chunk->Size);
+		}
+		return used;
+	}
+
+	size_t FrameAllocator::GetCapacity()
+	{
+		FrameAllocatorState& state = GetFrameAllocatorState();
+
+		size_t capacity = 0;
+		for (FrameBuffer& buffer : state.Buffers)
+		{
+			ScopedLock lock(buffer.GrowLock);
+			for (FrameChunk* chunk = buffer.Chunks; chunk; chunk = chunk->Next)
+			{
+				capacity += chunk->Size;
+			}
+		}
+		return capacity;
+	}
+
+	// ScratchArena ----------------------------------------------------------------
+
+	static constexpr size_t ScratchChunkSize = 256 << 10;
+
+	static thread_local LinearAllocator t_ScratchAllocator(ScratchChunkSize);
+	static thread_local ScratchArena* t_CurrentScratchArena = nullptr;
+
+	ScratchArena::ScratchArena() :
+		m_Allocator(t_ScratchAllocator),
+		m_Marker(t_ScratchAllocator.GetMarker()),
+		m_Parent(t_CurrentScratchArena)
+	{
+		t_CurrentScratchArena = this;
+	}
+
+	ScratchArena::~ScratchArena()
+	{
+		ionassert(t_CurrentScratchArena == this, "The ScratchArena scopes have to end in the reverse order.");
+
+		// The outermost scope frees everything, the chunks can be merged.
+		if (m_Parent)
+			m_Allocator.Rewind(m_Marker);
+		else
+			m_Allocator.Reset();
+
+		t_CurrentScratchArena = m_Parent;
+	}
+
+	void* ScratchArena::Allocate(size_t size, size_t alignment)
+	{
+		ionassert(t_CurrentScratchArena == this,
+			"Only the innermost ScratchArena of the calling thread can allocate.");
+
+		return m_Allocator.Allocate(size, alignment);
+	}
+
+	void ScratchArena::Free(void* ptr, size_t size)
+	{
+		if (t_CurrentScratchArena == this)
+			m_Allocator.Free(ptr, size);
+	}
+
+	size_t ScratchArena::GetThreadUsedBytes()
+	{
+		return t_ScratchAllocator.GetUsedBytes();
+	}
+}
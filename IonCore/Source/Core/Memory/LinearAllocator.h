@@ -0,0 +1,254 @@
+#pragma once
+
+#include "MemoryCore.h"
+
+namespace Ion
+{
+	/**
+	 * @brief Bump allocator that frees everything at once, by rewinding to a marker.
+	 *
+	 * @details The memory is allocated in chunks, which are kept after a rewind,
+	 * so a steady workload stops allocating from the system after a few uses.
+	 * Only the last allocation can be freed individually.
+	 *
+	 * Not thread-safe, see FrameAllocator and ScratchArena for the shared ones.
+	 */
+	class ION_API LinearAllocator
+	{
+	public:
+		static constexpr size_t DefaultAlignment = 16;
+		static constexpr size_t DefaultChunkSize = 64 << 10;
+
+		struct Chunk;
+
+		struct Marker
+		{
+			Chunk* CurrentChunk;
+			uint8* Cursor;
+		};
+
+		explicit LinearAllocator(size_t chunkSize = DefaultChunkSize);
+		~LinearAllocator();
+
+		NODISCARD void* Allocate(size_t size, size_t alignment = DefaultAlignment);
+		/* Frees the memory if it's the last allocation, otherwise does nothing. */
+		void Free(void* ptr, size_t size);
+
+		Marker GetMarker() const;
+		/* Frees all the memory allocated after the marker has been taken. */
+		void Rewind(const Marker& marker);
+		/* Frees all the memory, and merges the chunks into one, if the allocations didn't fit in the first one. */
+		void Reset();
+
+		/* Bytes allocated since the last Reset (including the alignment padding) */
+		size_t GetUsedBytes() const;
+		/* Bytes of all the chunks */
+		size_t GetCapacity() const;
+
+		LinearAllocator(const LinearAllocator&) = delete;
+		LinearAllocator& operator=(const LinearAllocator&) = delete;
+
+	private:
+		void* AllocateSlow(size_t size, size_t alignment);
+		void FreeChunks();
+
+	private:
+		/* Chunks in the order they are used */
+		Chunk* m_FirstChunk;
+		Chunk* m_CurrentChunk;
+		uint8* m_Cursor;
+		uint8* m_End;
+		size_t m_ChunkSize;
+	};
+
+	/**
+	 * @brief Double-buffered linear allocator for the data that lives for a frame.
+	 *
+	 * @details The memory allocated in a frame stays valid until the end of the next frame,
+	 * so the data produced in a frame can be consumed by the next one (e.g. the deferred events).
+	 * BeginFrame reuses the buffer of the frame before the previous one.
+	 *
+	 * Allocate is thread-safe and lock-free, unless the buffer has to grow.
+	 * The memory doesn't have to be freed. The destructors are not called,
+	 * the objects that own other memory have to be destroyed explicitly.
+	 */
+	class ION_API FrameAllocator
+	{
+	public:
+		static constexpr size_t DefaultAlignment = 16;
+		static constexpr uint32 BufferCount = 2;
+
+		NODISCARD static void* Allocate(size_t size, size_t alignment = DefaultAlignment);
+
+		template<typename T, typename... Args>
+		NODISCARD static T* New(Args&&... args);
+
+		/**
+		 * @brief Starts a new frame and frees the memory allocated two frames ago.
+		 * Has to be called on the main thread, while no other thread is allocating.
+		 */
+		static void BeginFrame();
+
+		/* Number of BeginFrame calls */
+		static uint64 GetFrameIndex();
+		/* Bytes allocated in the current frame */
+		static size_t GetUsedBytes();
+		/* Bytes of all the buffers */
+		static size_t GetCapacity();
+	};
+
+	/**
+	 * @brief Scope of the thread-local scratch allocator, for the temporary data of a function.
+	 *
+	 * @details All the memory allocated in the scope is freed when it ends.
+	 * The scopes can be nested, but only the innermost one can allocate.
+	 * The containers using the scratch memory have to be declared after the ScratchArena.
+	 *
+	 * @code
+	 * ScratchArena scratch;
+	 * TScratchArray<GUID> guids(scratch);
+	 * @endcode
+	 */
+	class ION_API ScratchArena
+	{
+	public:
+		ScratchArena();
+		~ScratchArena();
+
+		NODISCARD void* Allocate(size_t size, size_t alignment = LinearAllocator::DefaultAlignment);
+		void Free(void* ptr, size_t size);
+
+		/* Bytes allocated by the calling thread in all the active scopes */
+		static size_t GetThreadUsedBytes();
+
+		ScratchArena(const ScratchArena&) = delete;
+		ScratchArena& operator=(const ScratchArena&) = delete;
+
+	private:
+		LinearAllocator& m_Allocator;
+		LinearAllocator::Marker m_Marker;
+		ScratchArena* m_Parent;
+	};
+
+	/**
+	 * @brief STL allocator using the FrameAllocator.
+	 * The containers must not outlive the next frame.
+	 */
+	template<typename T>
+	class TFrameAllocatorAdaptor
+	{
+	public:
+		using value_type = T;
+
+		TFrameAllocatorAdaptor() noexcept = default;
+		template<typename U>
+		TFrameAllocatorAdaptor(const TFrameAllocatorAdaptor<U>&) noexcept { }
+
+		NODISCARD T* allocate(size_t count)
+		{
+			return (T*)FrameAllocator::Allocate(count * sizeof(T), std::max(alignof(T), FrameAllocator::DefaultAlignment));
+		}
+
+		void deallocate(T*, size_t) noexcept
+		{
+		}
+
+		template<typename U>
+		bool operator==(const TFrameAllocatorAdaptor<U>&) const noexcept { return true; }
+		template<typename U>
+		bool operator!=(const TFrameAllocatorAdaptor<U>&) const noexcept { return false; }
+	};
+
+	/**
+	 * @brief STL allocator using a ScratchArena.
+	 * The containers must not outlive the arena.
+	 */
+	template<typename T>
+	class TScratchAllocatorAdaptor
+	{
+	public:
+		using value_type = T;
+
+		TScratchAllocatorAdaptor(ScratchArena& arena) noexcept :
+			m_Arena(&arena)
+		{
+		}
+
+		template<typename U>
+		TScratchAllocatorAdaptor(const TScratchAllocatorAdaptor<U>& other) noexcept :
+			m_Arena(other.m_Arena)
+		{
+		}
+
+		NODISCARD T* allocate(size_t count)
+		{
+			return (T*)m_Arena->Allocate(count * sizeof(T), std::max(alignof(T), LinearAllocator::DefaultAlignment));
+		}
+
+		void deallocate(T* ptr, size_t count) noexcept
+		{
+			m_Arena->Free(ptr, count * sizeof(T));
+		}
+
+		template<typename U>
+		bool operator==(const TScratchAllocatorAdaptor<U>& other) const noexcept { return m_Arena == other.m_Arena; }
+		template<typename U>
+		bool operator!=(const TScratchAllocatorAdaptor<U>& other) const noexcept { return m_Arena != other.m_Arena; }
+
+	private:
+		ScratchArena* m_Arena;
+
+		template<typename U>
+		friend class TScratchAllocatorAdaptor;
+	};
+
+	template<typename T>
+	using TFrameArray = TArray<T, TFrameAllocatorAdaptor<T>>;
+
+	template<typename T, typename U, typename Hasher = THash<T>>
+	using TFrameHashMap = THashMap<T, U, Hasher, TFrameAllocatorAdaptor<std::pair<const T, U>>>;
+
+	template<typename T>
+	using TScratchArray = TArray<T, TScratchAllocatorAdaptor<T>>;
+
+	template<typename T, typename U, typename Hasher = THash<T>>
+	using TScratchHashMap = THashMap<T, U, Hasher, TScratchAllocatorAdaptor<std::pair<const T, U>>>;
+
+	using ScratchString = std::basic_string<char, std::char_traits<char>, TScratchAllocatorAdaptor<char>>;
+
+	// LinearAllocator Implementation ---------------------------------------------
+
+	FORCEINLINE void* LinearAllocator::Allocate(size_t size, size_t alignment)
+	{
+		ionassert(alignment && (alignment & (alignment - 1)) == 0, "The alignment has to be a power of 2.");
+
+		uint8* ptr = (uint8*)AlignAs((uintptr_t)m_Cursor, alignment);
+		if (m_Cursor && ptr + size <= m_End)
+		{
+			m_Cursor = ptr + size;
+			return ptr;
+		}
+		return AllocateSlow(size, alignment);
+	}
+
+	FORCEINLINE void LinearAllocator::Free(void* ptr, size_t size)
+	{
+		if ((uint8*)ptr + size == m_Cursor)
+		{
+			m_Cursor = (uint8*)ptr;
+		}
+	}
+
+	FORCEINLINE LinearAllocator::Marker LinearAllocator::GetMarker() const
+	{
+		return Marker { m_CurrentChunk, m_Cursor };
+	}
+
+	// FrameAllocator Implementation ---------------------------------------------
+
+	template<typename T, typename... Args>
+	inline T* FrameAllocator::New(Args&&... args)
+	{
+		return new(Allocate(sizeof(T), std::max(alignof(T), DefaultAlignment))) T(Forward<Args>(args)...);
+	}
+}
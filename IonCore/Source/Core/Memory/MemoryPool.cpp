@@ -2,30 +2,516 @@
 
 #include "MemoryPool.h"
 
+#include <intrin.h>
+
 namespace Ion
 {
+	// TLSF ------------------------------------------------------------------------
+
+	/* Second level lists per power of 2 */
+	static constexpr uint32 PoolSLBits = 4;
+	static constexpr uint32 PoolSLCount = 1 << PoolSLBits;
+	/* Enough for shards up to 2^47 bytes */
+	static constexpr uint32 PoolFLCount = 40;
+
+	static constexpr size_t PoolNullOffset = ~(size_t)0;
+	static constexpr size_t PoolBlockFreeFlag = 1;
+
+	/**
+	 * @brief Header in front of every block, and the sentinel at the end of a shard (with zero size).
+	 */
+	struct PoolBlockHeader
+	{
+		/* Size of the whole block, including the header */
+		size_t SizeAndFlags;
+		/* Offset of the block before this one in the shard */
+		size_t PrevPhysical;
+
+		FORCEINLINE size_t GetSize() const
+		{
+			return SizeAndFlags & ~PoolBlockFreeFlag;
+		}
+
+		FORCEINLINE bool IsFree() const
+		{
+			return SizeAndFlags & PoolBlockFreeFlag;
+		}
+	};
+	static constexpr size_t PoolHeaderSize = sizeof(PoolBlockHeader);
+
+	/**
+	 * @brief Free list links, stored after the header of a free block.
+	 */
+	struct PoolFreeLinks
+	{
+		size_t Next;
+		size_t Prev;
+	};
+
+	static FORCEINLINE uint32 FindFirstSet(uint64 value)
+	{
+		unsigned long index;
+		_BitScanForward64(&index, value);
+		return (uint32)index;
+	}
+
+	static FORCEINLINE uint32 FindLastSet(uint64 value)
+	{
+		unsigned long index;
+		_BitScanReverse64(&index, value);
+		return (uint32)index;
+	}
+
+	/**
+	 * @brief TLSF allocator of a part of the pool.
+	 *
+	 * @details The blocks are addressed with offsets from the shard base,
+	 * so the shard can be moved with a memcpy. The user pointers are aligned
+	 * to the granularity, so the headers start 16 bytes before the aligned addresses.
+	 * There are never two free blocks next to each other.
+	 */
+	struct alignas(64) MemoryPool::Shard
+	{
+		Mutex Lock;
+
+		uint8* Base;
+		size_t SentinelOffset;
+		size_t Granularity;
+		uint32 GranularityShift;
+
+		uint64 FLBitmap;
+		uint32 SLBitmaps[PoolFLCount];
+		size_t FreeHeads[PoolFLCount][PoolSLCount];
+
+		size_t FreeBlockCount;
+		size_t AllocCount;
+		/* A block start, all the blocks before it are in use */
+		size_t DefragCursor;
+
+		/* Blocks freed while the lock was held by another thread (linked through the user data) */
+		TAtomic<void*> DeferredFrees { nullptr };
+
+		FORCEINLINE size_t GetFirstOffset() const
+		{
+			return Granularity - PoolHeaderSize;
+		}
+
+		FORCEINLINE PoolBlockHeader& Header(size_t offset) const
+		{
+			return *(PoolBlockHeader*)(Base + offset);
+		}
+
+		FORCEINLINE PoolFreeLinks& Links(size_t offset) const
+		{
+			return *(PoolFreeLinks*)(Base + offset + PoolHeaderSize);
+		}
+
+		FORCEINLINE void* GetUserPtr(size_t offset) const
+		{
+			return Base + offset + PoolHeaderSize;
+		}
+
+		FORCEINLINE size_t GetOffset(const void* userPtr) const
+		{
+			return (const uint8*)userPtr - Base - PoolHeaderSize;
+		}
+
+		FORCEINLINE size_t GetBlockSize(size_t userSize) const
+		{
+			// The granularity is at least 32, enough for the header and the links.
+			return AlignAs(userSize + PoolHeaderSize, Granularity);
+		}
+
+		void Init(uint8* base, size_t size, size_t granularity)
+		{
+			Base = base;
+			Granularity = granularity;
+			GranularityShift = FindFirstSet(granularity);
+			SentinelOffset = size - PoolHeaderSize;
+
+			FLBitmap = 0;
+			memset(SLBitmaps, 0, sizeof(SLBitmaps));
+			std::fill_n(&FreeHeads[0][0], PoolFLCount * PoolSLCount, PoolNullOffset);
+
+			FreeBlockCount = 0;
+			AllocCount = 0;
+			DefragCursor = GetFirstOffset();
+
+			size_t first = GetFirstOffset();
+			Header(first).SizeAndFlags = SentinelOffset - first;
+			Header(first).PrevPhysical = PoolNullOffset;
+			Header(SentinelOffset).SizeAndFlags = 0;
+			Header(SentinelOffset).PrevPhysical = first;
+			InsertFree(first);
+		}
+
+		FORCEINLINE void MappingInsert(size_t size, uint32& outFL, uint32& outSL) const
+		{
+			if (size < (Granularity << PoolSLBits))
+			{
+				outFL = 0;
+				outSL = (uint32)(size >> GranularityShift);
+			}
+			else
+			{
+				uint32 bit = FindLastSet(size);
+				outSL = (uint32)(size >> (bit - PoolSLBits)) ^ PoolSLCount;
+				outFL = bit - (GranularityShift + PoolSLBits) + 1;
+			}
+			ionassert(outFL < PoolFLCount);
+		}
+
+		/* Rounds the size up to the next list, so any block in the list is large enough. */
+		FORCEINLINE void MappingSearch(size_t size, uint32& outFL, uint32& outSL) const
+		{
+			if (size >= (Granularity << PoolSLBits))
+			{
+				size += ((size_t)1 << (FindLastSet(size) - PoolSLBits)) - 1;
+			}
+			MappingInsert(size, outFL, outSL);
+		}
+
+		FORCEINLINE size_t FindFree(size_t size) const
+		{
+			uint32 fl, sl;
+			MappingSearch(size, fl, sl);
+
+			uint32 slMap = SLBitmaps[fl] & (~0u << sl);
+			if (!slMap)
+			{
+				uint64 flMap = FLBitmap & (~0ull << (fl + 1));
+				if (!flMap)
+				{
+					// The first block of the list the size itself maps to can still be large enough.
+					MappingInsert(size, fl, sl);
+					size_t head = FreeHeads[fl][sl];
+					return head != PoolNullOffset && Header(head).GetSize() >= size ? head : PoolNullOffset;
+				}
+
+				fl = FindFirstSet(flMap);
+				slMap = SLBitmaps[fl];
+			}
+			sl = FindFirstSet(slMap);
+			return FreeHeads[fl][sl];
+		}
+
+		void InsertFree(size_t offset)
+		{
+			PoolBlockHeader& header = Header(offset);
+			header.SizeAndFlags |= PoolBlockFreeFlag;
+
+			uint32 fl, sl;
+			MappingInsert(header.GetSize(), fl, sl);
+
+			size_t head = FreeHeads[fl][sl];
+			Links(offset).Next = head;
+			Links(offset).Prev = PoolNullOffset;
+			if (head != PoolNullOffset)
+				Links(head).Prev = offset;
+
+			FreeHeads[fl][sl] = offset;
+			SLBitmaps[fl] |= 1u << sl;
+			FLBitmap |= 1ull << fl;
+
+			++FreeBlockCount;
+		}
+
+		void RemoveFree(size_t offset)
+		{
+			PoolBlockHeader& header = Header(offset);
+			ionassert(header.IsFree());
+
+			uint32 fl, sl;
+			MappingInsert(header.GetSize(), fl, sl);
+
+			PoolFreeLinks& links = Links(offset);
+			if (links.Next != PoolNullOffset)
+				Links(links.Next).Prev = links.Prev;
+			if (links.Prev != PoolNullOffset)
+				Links(links.Prev).Next = links.Next;
+
+			if (FreeHeads[fl][sl] == offset)
+			{
+				FreeHeads[fl][sl] = links.Next;
+				if (links.Next == PoolNullOffset)
+				{
+					SLBitmaps[fl] &= ~(1u << sl);
+					if (!SLBitmaps[fl])
+						FLBitmap &= ~(1ull << fl);
+				}
+			}
+
+			header.SizeAndFlags &= ~PoolBlockFreeFlag;
+			--FreeBlockCount;
+		}
+
+		/* @return Offset of the block or PoolNullOffset */
+		size_t Allocate(size_t blockSize)
+		{
+			size_t offset = FindFree(blockSize);
+			if (offset == PoolNullOffset)
+				return PoolNullOffset;
+
+			RemoveFree(offset);
+
+			PoolBlockHeader& header = Header(offset);
+			size_t remainder = header.GetSize() - blockSize;
+			if (remainder)
+			{
+				// Split, the block after it is in use, so the remainder doesn't have to be coalesced.
+				size_t remainderOffset = offset + blockSize;
+				Header(remainderOffset).SizeAndFlags = remainder;
+				Header(remainderOffset).PrevPhysical = offset;
+				Header(remainderOffset + remainder).PrevPhysical = remainderOffset;
+				InsertFree(remainderOffset);
+
+				header.SizeAndFlags = blockSize;
+			}
+
+			++AllocCount;
+			return offset;
+		}
+
+		/* @return Size of the freed block */
+		size_t FreeBlock(size_t offset)
+		{
+			PoolBlockHeader& header = Header(offset);
+			ionverify(!header.IsFree() && header.GetSize(), "The block has been freed already or has not been allocated from the pool.");
+
+			size_t freedSize = header.GetSize();
+			size_t size = freedSize;
+
+			size_t next = offset + size;
+			if (Header(next).IsFree())
+			{
+				size += Header(next).GetSize();
+				RemoveFree(next);
+			}
+
+			size_t prev = header.PrevPhysical;
+			if (prev != PoolNullOffset && Header(prev).IsFree())
+			{
+				size += Header(prev).GetSize();
+				RemoveFree(prev);
+				offset = prev;
+			}
+
+			Header(offset).SizeAndFlags = size;
+			Header(offset + size).PrevPhysical = offset;
+			InsertFree(offset);
+
+			DefragCursor = std::min(DefragCursor, offset);
+
+			--AllocCount;
+			return freedSize;
+		}
+
+		/* @return Bytes of the freed blocks */
+		size_t DrainDeferredFrees()
+		{
+			void* ptr = DeferredFrees.exchange(nullptr, std::memory_order_acquire);
+
+			size_t freedBytes = 0;
+			while (ptr)
+			{
+				void* next = *(void**)ptr;
+				freedBytes += FreeBlock(GetOffset(ptr));
+				ptr = next;
+			}
+			return freedBytes;
+		}
+
+		void PushDeferredFree(void* ptr)
+		{
+			void* head = DeferredFrees.load(std::memory_order_relaxed);
+			do
+			{
+				*(void**)ptr = head;
+			}
+			while (!DeferredFrees.compare_exchange_weak(head, ptr, std::memory_order_release, std::memory_order_relaxed));
+		}
+
+		FORCEINLINE size_t GetLastOffset() const
+		{
+			return Header(SentinelOffset).PrevPhysical;
+		}
+
+		bool IsFragmented() const
+		{
+			return FreeBlockCount > 1 || (FreeBlockCount == 1 && !Header(GetLastOffset()).IsFree());
+		}
+
+		/**
+		 * @brief Moves the used blocks into the free blocks before them.
+		 *
+		 * @return true, if the shard is not fragmented anymore
+		 */
+		bool Defragment(size_t& inOutMovedBytes, size_t maxMoveBytes, const OnBlockReallocCallback& onBlockRealloc)
+		{
+			size_t offset = DefragCursor;
+			while (true)
+			{
+				while (offset != SentinelOffset && !Header(offset).IsFree())
+				{
+					offset += Header(offset).GetSize();
+				}
+				DefragCursor = offset;
+
+				if (offset == SentinelOffset)
+					return true;
+
+				size_t freeSize = Header(offset).GetSize();
+				size_t used = offset + freeSize;
+				// Only the free space at the end is left
+				if (used == SentinelOffset)
+					return true;
+
+				size_t usedSize = Header(used).GetSize();
+				if (inOutMovedBytes && inOutMovedBytes + usedSize > maxMoveBytes)
+					return false;
+
+				size_t prevPhysical = Header(offset).PrevPhysical;
+				RemoveFree(offset);
+
+				void* oldPtr = GetUserPtr(used);
+				memmove(Base + offset, Base + used, usedSize);
+				Header(offset).PrevPhysical = prevPhysical;
+
+				// The free block is now after the moved one, it can be coalesced with the next one.
+				size_t hole = offset + usedSize;
+				size_t next = hole + freeSize;
+				if (Header(next).IsFree())
+				{
+					size_t nextSize = Header(next).GetSize();
+					RemoveFree(next);
+					freeSize += nextSize;
+					next += nextSize;
+				}
+				Header(hole).SizeAndFlags = freeSize;
+				Header(hole).PrevPhysical = offset;
+				Header(next).PrevPhysical = hole;
+				InsertFree(hole);
+
+				if (onBlockRealloc)
+					onBlockRealloc(oldPtr, GetUserPtr(offset));
+
+				inOutMovedBytes += usedSize;
+				offset = hole;
+			}
+		}
+
+		/* @return Min size the shard can be shrunk to */
+		size_t GetMinSize() const
+		{
+			size_t last = GetLastOffset();
+			const PoolBlockHeader& header = Header(last);
+			return (header.IsFree() ? last + Granularity : last + header.GetSize()) + PoolHeaderSize;
+		}
+
+		/**
+		 * @brief Moves the sentinel after the data has been copied to the new base.
+		 *
+		 * @param lastOffset Offset of the last block, before the shard has been copied.
+		 */
+		void Resize(uint8* base, size_t size, size_t lastOffset)
+		{
+			Base = base;
+
+			size_t newSentinel = size - PoolHeaderSize;
+
+			size_t start;
+			size_t prev;
+			if (Header(lastOffset).IsFree())
+			{
+				RemoveFree(lastOffset);
+				start = lastOffset;
+				prev = Header(lastOffset).PrevPhysical;
+			}
+			else
+			{
+				start = lastOffset + Header(lastOffset).GetSize();
+				prev = lastOffset;
+			}
+
+			SentinelOffset = newSentinel;
+
+			if (newSentinel > start)
+			{
+				Header(start).SizeAndFlags = newSentinel - start;
+				Header(start).PrevPhysical = prev;
+				InsertFree(start);
+				prev = start;
+			}
+			Header(newSentinel).SizeAndFlags = 0;
+			Header(newSentinel).PrevPhysical = prev;
+
+			DefragCursor = std::min(DefragCursor, start);
+		}
+	};
+
+	static TAtomic<uint32> g_NextPoolThreadIndex { 0 };
+
+	/* Index of the shard the calling thread allocates from first (modulo the shard count) */
+	static uint32 GetPoolThreadIndex()
+	{
+		static thread_local uint32 t_Index = g_NextPoolThreadIndex.fetch_add(1, std::memory_order_relaxed);
+		return t_Index;
+	}
+
+	// MemoryPool ------------------------------------------------------------------
+
 	MemoryPool::MemoryPool() :
+		m_ShardCount(0),
+		m_ShardSize(0),
 		m_PoolBlock({ 0 }),
 		m_Alignment(0),
-		m_CurrentPtr(nullptr),
-		m_UsedBytes(0)
+		m_Granularity(0),
+		m_UsedBytes(0),
+		m_ErrorDetails(),
+		m_LastErrorType(EMemoryPoolError::Null)
 	{
 	}
 
-	void MemoryPool::AllocPool(size_t size, size_t alignment)
+	MemoryPool::~MemoryPool()
+	{
+		if (m_Data)
+			FreePool();
+	}
+
+	void MemoryPool::AllocPool(size_t size, size_t alignment, uint32 shardCount)
 	{
 		TRACE_FUNCTION();
 
 		ionassert(!m_Data);
 		ionassert(size);
 		ionassert(Math::IsPowerOfTwo(alignment));
+		ionassert(shardCount <= MaxShards);
 
-		size = AlignAs(size, alignment);
+		if (!shardCount)
+		{
+			shardCount = std::clamp<uint32>(std::thread::hardware_concurrency(), 1, MaxShards);
+			while (shardCount > 1 && size / shardCount < MinShardSize)
+				--shardCount;
+		}
 
-		m_Data = _aligned_malloc(size, alignment);
-		m_Size = size;
 		m_Alignment = alignment;
-		m_CurrentPtr = (uint8*)m_Data;
+		m_Granularity = std::max<size_t>(alignment, 32);
+
+		// The first block starts one granule in, minus the header, and the sentinel takes the last header.
+		m_ShardSize = AlignAs(std::max(size / shardCount, m_Granularity * 2), m_Granularity);
+		m_ShardCount = shardCount;
+
+		m_Size = m_ShardSize * m_ShardCount;
+		m_Data = _aligned_malloc(m_Size, m_Granularity);
+		ionverify(m_Data, "Out of memory.");
+
+		m_Shards = std::make_unique<Shard[]>(m_ShardCount);
+		for (uint32 i = 0; i < m_ShardCount; ++i)
+		{
+			m_Shards[i].Init((uint8*)m_Data + i * m_ShardSize, m_ShardSize, m_Granularity);
+		}
+
+		m_UsedBytes.store(0, std::memory_order_relaxed);
 	}
 
 	void MemoryPool::FreePool()
@@ -34,143 +520,229 @@ namespace Ion
 
 		ionassert(m_Data);
 
+		m_Shards.reset();
+
 		_aligned_free(m_Data);
 		m_Data = nullptr;
-		m_CurrentPtr = nullptr;
 		m_Size = 0;
+		m_ShardSize = 0;
+		m_ShardCount = 0;
 		m_Alignment = 0;
-		m_UsedBytes = 0;
+		m_Granularity = 0;
+		m_UsedBytes.store(0, std::memory_order_relaxed);
 	}
 
-	void* MemoryPool::Alloc(size_t size)
+	void MemoryPool::ReallocPoolImpl(size_t newSize, const OnBlockReallocCallback& onBlockRealloc)
 	{
 		TRACE_FUNCTION();
 
 		ionassert(m_Data);
-		ionassert(size);
-
-		Memory::AllocError_Details& errorDetails = *(Memory::AllocError_Details*)m_ErrorDetails;
+		ionassert(newSize);
 
-		// Round up to m_Alignment
-		size_t alignedSize = AlignAs(size, m_Alignment);
+		size_t newShardSize = AlignAs(std::max(newSize / m_ShardCount, m_Granularity * 2), m_Granularity);
 
-		if (alignedSize > m_Size)
+		for (uint32 i = 0; i < m_ShardCount; ++i)
 		{
-			m_LastErrorType = EMemoryPoolError::AllocError;
+			m_Shards[i].Lock.lock();
+			m_UsedBytes.fetch_sub(m_Shards[i].DrainDeferredFrees(), std::memory_order_relaxed);
+		}
 
-			MemoryLogger.Warn("Tried to allocate a block larger than the entire memory pool.\n"
-				"Pool Size = {0} B | Block Size (after alignment) = {1} B\n"
-				"If there is a need for large blocks, try allocating a bigger pool beforehand.", m_Size, size);
+		auto unlockAll = [this]
+		{
+			for (uint32 i = 0; i < m_ShardCount; ++i)
+				m_Shards[i].Lock.unlock();
+		};
 
-			errorDetails.FailedAllocSize = size;
-			errorDetails.bPoolOutOfMemory = true;
-			errorDetails.bAllocSizeGreaterThanPoolSize = true;
-			errorDetails.bPoolFragmented = _IsFragmented();
-			return nullptr;
+		TArray<size_t> lastOffsets(m_ShardCount);
+		for (uint32 i = 0; i < m_ShardCount; ++i)
+		{
+			if (newShardSize < m_Shards[i].GetMinSize())
+			{
+				MemoryLogger.Error("Cannot shrink the memory pool to {} B, the blocks at the end of the shards have to be freed first.", newSize);
+				ionassert(false);
+				unlockAll();
+				return;
+			}
+			lastOffsets[i] = m_Shards[i].GetLastOffset();
 		}
 
-		UniqueLock lock(m_PoolMutex);
+		size_t size = newShardSize * m_ShardCount;
+		uint8* data = (uint8*)_aligned_malloc(size, m_Granularity);
+		ionverify(data, "Out of memory.");
 
-		if (alignedSize > m_Size - m_UsedBytes)
+		for (uint32 i = 0; i < m_ShardCount; ++i)
 		{
-			m_LastErrorType = EMemoryPoolError::AllocError;
+			Shard& shard = m_Shards[i];
 
-			errorDetails.FailedAllocSize = size;
-			errorDetails.bPoolOutOfMemory = true;
-			errorDetails.bPoolFragmented = _IsFragmented();
-			return nullptr;
+			uint8* oldBase = shard.Base;
+			uint8* newBase = data + i * newShardSize;
+
+			memcpy(newBase, oldBase, std::min(m_ShardSize, newShardSize));
+			shard.Resize(newBase, newShardSize, lastOffsets[i]);
+
+			if (onBlockRealloc)
+			{
+				for (size_t offset = shard.GetFirstOffset(); offset != shard.SentinelOffset; offset += shard.Header(offset).GetSize())
+				{
+					if (!shard.Header(offset).IsFree())
+						onBlockRealloc(oldBase + offset + PoolHeaderSize, shard.GetUserPtr(offset));
+				}
+			}
 		}
 
-		uint8* allocPtr = m_CurrentPtr;
+		_aligned_free(m_Data);
+		m_Data = data;
+		m_Size = size;
+		m_ShardSize = newShardSize;
+
+		unlockAll();
+	}
+
+	bool MemoryPool::DefragmentPoolImpl(size_t maxMoveBytes, const OnBlockReallocCallback& onBlockRealloc)
+	{
+		TRACE_FUNCTION();
+
+		ionassert(m_Data);
 
-		if (allocPtr + alignedSize > m_PoolBlock.End())
+		size_t movedBytes = 0;
+		for (uint32 i = 0; i < m_ShardCount; ++i)
 		{
-			m_LastErrorType = EMemoryPoolError::AllocError;
+			Shard& shard = m_Shards[i];
 
-			errorDetails.FailedAllocSize = size;
-			// The pool must be fragmented, if the block should fit but it doesn't.
-			errorDetails.bPoolFragmented = true;
-			return nullptr;
-		}
+			UniqueLock lock(shard.Lock);
+			m_UsedBytes.fetch_sub(shard.DrainDeferredFrees(), std::memory_order_relaxed);
 
-		m_CurrentPtr += alignedSize;
-		m_UsedBytes += alignedSize;
+			if (!shard.Defragment(movedBytes, maxMoveBytes, onBlockRealloc))
+				return false;
+		}
+		return true;
+	}
 
-		// Save the sub-block
-		MemoryPoolAllocData allocData { };
-		allocData.Ptr = allocPtr;
-		allocData.Size = alignedSize;
-		allocData.SequentialIndex = m_AllocData.size();
+	MemoryPool::Shard& MemoryPool::GetShardOf(const void* ptr) const
+	{
+		ionassert(ptr >= m_Data && ptr < m_PoolBlock.End(), "The pointer is not in the pool.");
 
-		m_AllocDataByPtr.emplace(allocPtr, allocData.SequentialIndex);
-		m_AllocData.emplace_back(Move(allocData));
+		return m_Shards[((const uint8*)ptr - (const uint8*)m_Data) / m_ShardSize];
+	}
 
-		return allocPtr;
+	size_t MemoryPool::GetMaxAllocSize() const
+	{
+		// The whole shard is a single free block at first.
+		return m_ShardSize - m_Granularity - PoolHeaderSize;
 	}
 
-	void MemoryPool::Free(void* data)
+	void* MemoryPool::Alloc(size_t size)
 	{
 		TRACE_FUNCTION();
 
 		ionassert(m_Data);
-		ionassert(data);
-
-		UniqueLock lock(m_PoolMutex);
+		ionassert(size);
 
-		auto& it = m_AllocDataByPtr.find(data);
-		ionverify(it != m_AllocDataByPtr.end());
+		Memory::AllocError_Details& errorDetails = *(Memory::AllocError_Details*)m_ErrorDetails;
 
-		size_t deleteIndex = it->second;
+		if (size > GetMaxAllocSize())
+		{
+			m_LastErrorType = EMemoryPoolError::AllocError;
 
-		MemoryPoolAllocData& allocData = m_AllocData[deleteIndex];
-		m_UsedBytes -= allocData.Size;
+			MemoryLogger.Warn("Tried to allocate a block larger than a memory pool shard.\n"
+				"Shard Size = {0} B | Block Size = {1} B\n"
+				"If there is a need for large blocks, try allocating a bigger pool or less shards beforehand.", m_ShardSize, size);
 
-		m_AllocData.erase(m_AllocData.begin() + deleteIndex);
-		m_AllocDataByPtr.erase(it);
+			errorDetails.FailedAllocSize = size;
+			errorDetails.Flags = 0;
+			errorDetails.bPoolOutOfMemory = true;
+			errorDetails.bAllocSizeGreaterThanPoolSize = true;
+			return nullptr;
+		}
 
-		// Fix indices
-		for (auto seqIt = m_AllocData.begin() + deleteIndex; seqIt != m_AllocData.end(); ++seqIt)
+		// Own shard first, then the others
+		uint32 firstShard = GetPoolThreadIndex() % m_ShardCount;
+		for (uint32 i = 0; i < m_ShardCount; ++i)
 		{
-			seqIt->SequentialIndex--;
-			m_AllocDataByPtr[seqIt->Ptr]--;
+			Shard& shard = m_Shards[(firstShard + i) % m_ShardCount];
+			size_t blockSize = shard.GetBlockSize(size);
+
+			UniqueLock lock(shard.Lock);
+			m_UsedBytes.fetch_sub(shard.DrainDeferredFrees(), std::memory_order_relaxed);
+
+			size_t offset = shard.Allocate(blockSize);
+			if (offset != PoolNullOffset)
+			{
+				m_UsedBytes.fetch_add(blockSize, std::memory_order_relaxed);
+				return shard.GetUserPtr(offset);
+			}
 		}
 
-		// Set the current pointer to the first free spot
-		m_CurrentPtr = !m_AllocData.empty() ? (uint8*)m_AllocData.back().Block.End() : (uint8*)m_Data;
+		m_LastErrorType = EMemoryPoolError::AllocError;
+
+		errorDetails.FailedAllocSize = size;
+		errorDetails.Flags = 0;
+		// The block would fit, if the free space was contiguous.
+		if (AlignAs(size + PoolHeaderSize, m_Granularity) <= GetFreeBytes())
+			errorDetails.bPoolFragmented = true;
+		else
+			errorDetails.bPoolOutOfMemory = true;
+		return nullptr;
 	}
 
-	bool MemoryPool::_IsFragmented() const
+	void MemoryPool::Free(void* data)
 	{
 		TRACE_FUNCTION();
 
 		ionassert(m_Data);
+		ionassert(data);
+
+		Shard& shard = GetShardOf(data);
 
-		void* expectedPtr = m_Data;
-		for (const MemoryPoolAllocData& allocData : m_AllocData)
+		UniqueLock lock(shard.Lock, std::try_to_lock);
+		if (lock)
 		{
-			// Memory is non-contiguous if the next data block
-			// does not start at the end of the previous one
-			if (allocData.Ptr != expectedPtr)
-			{
-				return true;
-			}
-			expectedPtr = allocData.Block.End();
+			size_t freedBytes = shard.FreeBlock(shard.GetOffset(data));
+			freedBytes += shard.DrainDeferredFrees();
+			m_UsedBytes.fetch_sub(freedBytes, std::memory_order_relaxed);
+		}
+		else
+		{
+			// Don't wait, the block will be freed by the thread that locks the shard next.
+			shard.PushDeferredFree(data);
 		}
-		return false;
 	}
 
 	bool MemoryPool::IsFragmented() const
 	{
 		TRACE_FUNCTION();
 
-		UniqueLock lock(m_PoolMutex);
-		return _IsFragmented();
+		ionassert(m_Data);
+
+		for (uint32 i = 0; i < m_ShardCount; ++i)
+		{
+			Shard& shard = m_Shards[i];
+
+			UniqueLock lock(shard.Lock);
+			m_UsedBytes.fetch_sub(shard.DrainDeferredFrees(), std::memory_order_relaxed);
+
+			if (shard.IsFragmented())
+				return true;
+		}
+		return false;
 	}
 
 	bool MemoryPool::CanAlloc(size_t size) const
 	{
-		UniqueLock lock(m_PoolMutex);
-		return AlignAs(size, m_Alignment) <= GetFreeBytes();
+		if (!m_Data || !size || size > GetMaxAllocSize())
+			return false;
+
+		for (uint32 i = 0; i < m_ShardCount; ++i)
+		{
+			Shard& shard = m_Shards[i];
+
+			UniqueLock lock(shard.Lock);
+			m_UsedBytes.fetch_sub(shard.DrainDeferredFrees(), std::memory_order_relaxed);
+
+			if (shard.FindFree(shard.GetBlockSize(size)) != PoolNullOffset)
+				return true;
+		}
+		return false;
 	}
 
 	std::shared_ptr<MemoryPoolDebugInfo> MemoryPool::GetDebugInfo() const
@@ -179,14 +751,41 @@ namespace Ion
 
 		std::shared_ptr<MemoryPoolDebugInfo> info = std::make_shared<MemoryPoolDebugInfo>();
 
-		UniqueLock lock(m_PoolMutex);
-
 		info->PoolPtr = m_Data;
 		info->PoolSize = m_Size;
-		info->AllocCount = m_AllocData.size();
-		info->BytesFree = GetFreeBytes();
+		info->ShardCount = m_ShardCount;
+		info->AllocCount = 0;
+
+		for (uint32 i = 0; i < m_ShardCount; ++i)
+		{
+			Shard& shard = m_Shards[i];
+
+			UniqueLock lock(shard.Lock);
+			m_UsedBytes.fetch_sub(shard.DrainDeferredFrees(), std::memory_order_relaxed);
+
+			info->AllocCount += shard.AllocCount;
+
+			size_t last = shard.GetLastOffset();
+			for (size_t offset = shard.GetFirstOffset(); offset != shard.SentinelOffset; offset += shard.Header(offset).GetSize())
+			{
+				const PoolBlockHeader& header = shard.Header(offset);
+				if (header.IsFree())
+				{
+					if (offset != last)
+						info->Holes.push_back(MemoryBlock { shard.Base + offset, header.GetSize() });
+					continue;
+				}
+
+				MemoryPoolAllocData allocData { };
+				allocData.Ptr = shard.GetUserPtr(offset);
+				allocData.Size = header.GetSize() - PoolHeaderSize;
+				allocData.SequentialIndex = info->AllocData.size();
+				info->AllocData.emplace_back(Move(allocData));
+			}
+		}
+
 		info->BytesUsed = GetUsedBytes();
-		info->AllocData = m_AllocData;
+		info->BytesFree = GetFreeBytes();
 		return info;
 	}
 
@@ -196,24 +795,20 @@ namespace Ion
 
 		std::shared_ptr<MemoryPoolDebugInfo> info = GetDebugInfo();
 
-		MemoryLogger.Debug("Used: {0} B ({1:.2f} MB) | Free: {2} B ({3:.2f} MB) | Alloc count: {4}",
+		MemoryLogger.Debug("Used: {0} B ({1:.2f} MB) | Free: {2} B ({3:.2f} MB) | Alloc count: {4} | Shards: {5}",
 			info->BytesUsed, info->BytesUsed / (float)(1 << 20),
 			info->BytesFree, info->BytesFree / (float)(1 << 20),
-			info->AllocCount);
+			info->AllocCount, info->ShardCount);
 		MemoryLogger.Debug("----------------------------------------------------------------------------------");
 
-		void* expectedPtr = info->PoolPtr;
+		for (const MemoryBlock& hole : info->Holes)
+		{
+			MemoryLogger.Error("Noncontiguous memory from [{0}] to [{1}]", hole.Ptr, hole.End());
+			MemoryLogger.Error("Size: {0} B ({1:.2f} MB)", hole.Size, hole.Size / (float)(1 << 20));
+		}
 
 		for (const MemoryPoolAllocData& allocData : info->AllocData)
 		{
-			if (allocData.Ptr != expectedPtr)
-			{
-				MemoryLogger.Error("Noncontiguous memory from [{0}] to [{1}]", expectedPtr, allocData.Ptr);
-				size_t size = (uint8*)allocData.Ptr - (uint8*)expectedPtr;
-				MemoryLogger.Error("Size: {0} B ({1:.2f} MB)", size, size / (float)(1 << 20));
-			}
-			expectedPtr = (uint8*)allocData.Ptr + allocData.Size;
-
 			MemoryLogger.Debug("{0:<8d} | Ptr: [{1}] | Size: {2:20d} B ({3:.2f} MB)",
 				allocData.SequentialIndex, allocData.Ptr, allocData.Size, allocData.Size / (float)(1 << 20));
 		}
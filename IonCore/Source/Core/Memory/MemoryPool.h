@@ -29,7 +29,11 @@ namespace Ion
 		size_t BytesUsed;
 		size_t BytesFree;
 		size_t AllocCount;
+		uint32 ShardCount;
+		/* In the address order, Size is the usable size of the block */
 		TArray<MemoryPoolAllocData> AllocData;
+		/* Free blocks between the allocations, which DefragmentPool gets rid of */
+		TArray<MemoryBlock> Holes;
 	};
 
 	using OnBlockReallocCallback = TFunction<void(void* oldPtr, void* newPtr)>;
@@ -40,22 +44,56 @@ namespace Ion
 		AllocError
 	};
 
+	/**
+	 * @brief Thread-safe pool of variable sized blocks, which can be defragmented.
+	 *
+	 * @details The pool is split into shards, each managed by a TLSF (two-level segregated fit)
+	 * allocator, so Alloc and Free are O(1) and the adjacent free blocks are coalesced right away.
+	 * Each thread allocates from its own shard first, so the shard locks are rarely contended.
+	 * Free never waits - if the shard is locked, the block is queued (lock-free)
+	 * and freed by the next thread that locks the shard.
+	 *
+	 * A single allocation can't be larger than a shard (see GetMaxAllocSize).
+	 *
+	 * Each block has a 16 byte header before the returned pointer.
+	 * The blocks can only be moved by ReallocPool and DefragmentPool, which report
+	 * the new pointers with the onBlockRealloc callback (void(void* oldPtr, void* newPtr)).
+	 * The moved blocks must not be accessed by other threads in the meantime.
+	 */
 	class ION_API MemoryPool
 	{
 	public:
 		using MemoryPoolErrorTypes = TTypePack<Memory::AllocError_Details>;
 
-		using AllocDataArray = TArray<MemoryPoolAllocData>;
-		using AllocDataByPtrMap = THashMap<void*, size_t>;
+		static constexpr uint32 MaxShards = 16;
+		/* Min shard size, if the shard count is chosen automatically */
+		static constexpr size_t MinShardSize = 1 << 20;
 
 		MemoryPool();
+		~MemoryPool();
 
-		void AllocPool(size_t size, size_t alignment);
+		/**
+		 * @param shardCount Number of the shards, 0 - one per hardware thread
+		 * (up to MaxShards, as long as they are not smaller than MinShardSize)
+		 */
+		void AllocPool(size_t size, size_t alignment, uint32 shardCount = 0);
 		void FreePool();
+		/**
+		 * @brief Resizes the pool, which moves all the blocks.
+		 * The pool can only shrink as far as the free space at the end of each shard.
+		 */
 		template<typename Lambda>
 		void ReallocPool(size_t newSize, Lambda onBlockRealloc);
+		/**
+		 * @brief Moves the blocks towards the start of their shards, so the free space is contiguous.
+		 *
+		 * @details Incremental, stops before moving more than maxMoveBytes (but always moves at least one block),
+		 * the next call continues from where the last one has stopped.
+		 *
+		 * @return true, if the pool is not fragmented anymore
+		 */
 		template<typename Lambda>
-		void DefragmentPool(Lambda onBlockRealloc);
+		bool DefragmentPool(Lambda onBlockRealloc, size_t maxMoveBytes = std::numeric_limits<size_t>::max());
 
 		void* Alloc(size_t size);
 		void Free(void* data);
@@ -66,8 +104,12 @@ namespace Ion
 		size_t GetSize() const { return m_Size; }
 		size_t GetAlignment() const { return m_Alignment; }
 
-		size_t GetUsedBytes() const { return m_UsedBytes; }
-		size_t GetFreeBytes() const { return m_Size - m_UsedBytes; }
+		/* Includes the block headers and padding, the blocks that are queued to be freed are still used */
+		size_t GetUsedBytes() const { return m_UsedBytes.load(std::memory_order_relaxed); }
+		size_t GetFreeBytes() const { return m_Size - GetUsedBytes(); }
+
+		uint32 GetShardCount() const { return m_ShardCount; }
+		size_t GetMaxAllocSize() const;
 
 		EMemoryPoolError GetLastError() const { return m_LastErrorType; }
 		template<typename T>
@@ -81,30 +123,27 @@ namespace Ion
 		MemoryPool& operator=(const MemoryPool&) = delete;
 		MemoryPool& operator=(MemoryPool&&) noexcept = delete;
 
-		~MemoryPool() { }
-
 	private:
-		inline size_t GetCurrentOffset() const
-		{
-			return m_CurrentPtr - (uint8*)m_Data;
-		}
+		struct Shard;
 
-		template<typename Lambda>
-		void UpdateAllocData(ptrdiff_t offset, AllocDataArray::iterator start, AllocDataArray::iterator end, Lambda onBlockRealloc);
+		void ReallocPoolImpl(size_t newSize, const OnBlockReallocCallback& onBlockRealloc);
+		bool DefragmentPoolImpl(size_t maxMoveBytes, const OnBlockReallocCallback& onBlockRealloc);
 
-		bool _IsFragmented() const; // Non-locking
+		Shard& GetShardOf(const void* ptr) const;
 
 	private:
-		AllocDataArray m_AllocData;
-		AllocDataByPtrMap m_AllocDataByPtr;
+		std::unique_ptr<Shard[]> m_Shards;
+		uint32 m_ShardCount;
+		size_t m_ShardSize;
 
 		MEMORYBLOCK_FIELD_NAMED(m_PoolBlock, m_Data, m_Size);
-		uint8* m_CurrentPtr;
 
 		size_t m_Alignment;
-		size_t m_UsedBytes;
+		/* Block size granularity, max(m_Alignment, 32) */
+		size_t m_Granularity;
 
-		mutable Mutex m_PoolMutex;
+		/* The deferred frees are drained in the const functions too */
+		mutable TAtomic<size_t> m_UsedBytes;
 
 		uint8 m_ErrorDetails[TTypeSize<MemoryPoolErrorTypes>::Max];
 		EMemoryPoolError m_LastErrorType;
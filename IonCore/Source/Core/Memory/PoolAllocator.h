@@ -20,9 +20,16 @@ namespace Ion
 	{
 		using ThisType = TPoolChunk<T, Alignment>;
 
-		uint8 Data[sizeof(T)];
-		/* The MS bit indicates if the chunk is allocated,
-		   the rest is the pointer to the next chunk.
+		static_assert(Alignment >= alignof(void*));
+
+		/* While the chunk is free, the data holds the pointer to its block
+		   and the pointer to the next batch (see TConcurrentPoolAllocator). */
+		static constexpr size_t DataSize = sizeof(T) > 2 * sizeof(void*) ? sizeof(T) : 2 * sizeof(void*);
+
+		uint8 Data[DataSize];
+		/* The MS bit indicates if the chunk is allocated.
+		   If it is, the rest is the pointer to the block of the chunk,
+		   otherwise it's the pointer to the next free chunk.
 		   This is only possible, because pointers would not
 		   normally use this bit as their value is too small. */
 		uint64 Meta;
@@ -42,6 +49,42 @@ namespace Ion
 			return GET_POOL_META_ALLOC_FLAG(Meta);
 		}
 
+		/* Free chunks only */
+		inline void SetFreeBlock(void* block)
+		{
+			((void**)Data)[0] = block;
+		}
+
+		/* Allocated chunks only */
+		inline void* GetBlock() const
+		{
+			return GET_POOL_META_POINTER(Meta);
+		}
+
+		/* Free chunks only */
+		inline void SetNextBatch(ThisType* batch)
+		{
+			((void**)Data)[1] = batch;
+		}
+
+		inline ThisType* NextBatch() const
+		{
+			return (ThisType*)((void* const*)Data)[1];
+		}
+
+		/* Moves the block pointer from the data to the meta. */
+		inline void MarkAllocated()
+		{
+			Meta = POOL_META_ALLOC_FLAG_MASK | (uint64)((void* const*)Data)[0];
+		}
+
+		/* Moves the block pointer from the meta to the data. */
+		inline void MarkFree(ThisType* next)
+		{
+			SetFreeBlock(GetBlock());
+			Meta = (uint64)next;
+		}
+
 		TPoolChunk() :
 			Data(),
 			Meta(0)
@@ -54,30 +97,46 @@ namespace Ion
 	{
 		using ThisType  = TPoolBlock<T, ChunkCount, Alignment>;
 		using ChunkType = TPoolChunk<T, Alignment>;
-		static constexpr size_t ChunksSize = sizeof(ChunkType) * ChunkCount;
 
 		ChunkType Chunks[ChunkCount];
 		ThisType* NextBlock;
+		/* Allocator that has created the block */
+		const void* Owner;
 
-		TPoolBlock() :
+		TPoolBlock(const void* owner) :
+			Chunks(),
 			NextBlock(nullptr),
-			Chunks()
+			Owner(owner)
 		{
 			ChunkType* chunk = Chunks;
-			// Don't set the last chunk's next
-			for (size_t i = 0; i < ChunkCount - 1; ++i, ++chunk)
+			for (size_t i = 0; i < ChunkCount; ++i, ++chunk)
 			{
-				chunk->SetNext(chunk + 1);
+				chunk->SetFreeBlock(this);
+				// Don't set the last chunk's next
+				if (i < ChunkCount - 1)
+					chunk->SetNext(chunk + 1);
 			}
 		}
 
-		~TPoolBlock()
+		/* Deletes the block and all the blocks linked after it. */
+		static void DeleteChain(ThisType* block)
 		{
-			// Chain delete all the blocks
-			checked_delete(NextBlock);
+			while (block)
+			{
+				ThisType* next = block->NextBlock;
+				delete block;
+				block = next;
+			}
 		}
 	};
 
+	/**
+	 * @brief Allocates the objects in fixed size chunks, from blocks of ChunksInBlock chunks.
+	 * Allocate and Free are O(1), the block of a chunk is stored in the chunk itself.
+	 * The memory is released when the allocator is destroyed.
+	 *
+	 * Not thread-safe (see TConcurrentPoolAllocator).
+	 */
 	template<typename T, size_t ChunksInBlock = 256, size_t Alignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__>
 	class TPoolAllocator
 	{
@@ -92,48 +151,46 @@ namespace Ion
 			// If the next chunk is null (there are no free chunks), we have to create a new block.
 			if (!m_NextChunkPtr)
 			{
-				m_FreeBlockPtr = AllocateNewBlockAfter(m_FreeBlockPtr);
-				m_NextChunkPtr = m_FreeBlockPtr->Chunks;
+				m_LastBlock = AllocateNewBlockAfter(m_LastBlock);
+				m_NextChunkPtr = m_LastBlock->Chunks;
 			}
 
 			ChunkType* chunk = m_NextChunkPtr;
-			chunk->Meta |= POOL_META_ALLOC_FLAG_MASK;
-
 			m_NextChunkPtr = chunk->Next();
-		
+
+			chunk->MarkAllocated();
+
 			return (T*)chunk->Data;
 		}
 
 		inline void Free(void* ptr)
 		{
-			BlockType* block = FindBlockByPtr(ptr);
-			ionverify(block, "The pointer has not been allocated by this allocator.");
-
 			ChunkType* chunk = (ChunkType*)ptr;
 			ionverify(chunk->IsAllocated(), "The chunk has not been allocated.");
+			ionverify(((BlockType*)chunk->GetBlock())->Owner == this, "The pointer has not been allocated by this allocator.");
+
+			chunk->MarkFree(m_NextChunkPtr);
 
-			chunk->Meta = (uint64)GET_POOL_META_POINTER((uint64)m_NextChunkPtr);
-		
-			m_FreeBlockPtr = block;
 			m_NextChunkPtr = chunk;
 		}
 
 		TPoolAllocator()
 		{
 			m_FirstBlock = AllocateBlock();
-			m_FreeBlockPtr = m_FirstBlock;
-			m_NextChunkPtr = m_FreeBlockPtr->Chunks;
+			m_LastBlock = m_FirstBlock;
+			m_NextChunkPtr = m_FirstBlock->Chunks;
 		}
 
 		~TPoolAllocator()
 		{
-			delete m_FirstBlock;
+			BlockType::DeleteChain(m_FirstBlock);
 		}
 
 	private:
 		inline BlockType* AllocateNewBlockAfter(BlockType* block)
 		{
 			ionassert(block);
+			ionassert(!block->NextBlock);
 
 			BlockType* newBlock = AllocateBlock();
 			// Link the blocks.
@@ -142,30 +199,270 @@ namespace Ion
 			return newBlock;
 		}
 
-		inline BlockType* FindBlockByPtr(void* ptr)
+		inline BlockType* AllocateBlock()
+		{
+			return new BlockType(this);
+		}
+
+	private:
+		BlockType* m_FirstBlock;
+		BlockType* m_LastBlock;
+		ChunkType* m_NextChunkPtr;
+	};
+
+	/**
+	 * @brief Thread-safe version of TPoolAllocator.
+	 *
+	 * @details Each thread allocates from and frees to its own cache of free chunks, without any synchronization.
+	 * A cache that gets more than 2 * BatchSize chunks returns a batch of BatchSize chunks to a shared lock-free list,
+	 * an empty cache takes a batch from the list, or allocates a new block, if the list is empty.
+	 * A chunk can be freed on any thread.
+	 *
+	 * A thread can have caches of MaxThreadCaches allocators of the same type at once,
+	 * the other ones share a single cache guarded by a mutex.
+	 * The chunks left in the cache of a thread that has exited are released with the allocator,
+	 * call FlushThreadCache before the thread exits to make them available to the other threads.
+	 */
+	template<typename T, size_t ChunksInBlock = 256, size_t Alignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__, size_t BatchSize = 32>
+	class TConcurrentPoolAllocator
+	{
+	public:
+		static_assert(ChunksInBlock != 0);
+		static_assert(BatchSize != 0);
+
+		using ThisType  = TConcurrentPoolAllocator<T, ChunksInBlock, Alignment, BatchSize>;
+		using BlockType = TPoolBlock<T, ChunksInBlock, Alignment>;
+		using ChunkType = TPoolChunk<T, Alignment>;
+
+		static constexpr size_t MaxThreadCaches = 4;
+
+		NODISCARD inline ALLOCATOR T* Allocate()
+		{
+			if (ThreadCache* cache = FindThreadCache())
+				return AllocateFromCache(*cache);
+
+			ScopedLock lock(m_SharedCacheMutex);
+			return AllocateFromCache(m_SharedCache);
+		}
+
+		inline void Free(void* ptr)
+		{
+			ChunkType* chunk = (ChunkType*)ptr;
+			ionverify(chunk->IsAllocated(), "The chunk has not been allocated.");
+			ionverify(((BlockType*)chunk->GetBlock())->Owner == this, "The pointer has not been allocated by this allocator.");
+
+			if (ThreadCache* cache = FindThreadCache())
+			{
+				FreeToCache(*cache, chunk);
+				return;
+			}
+
+			ScopedLock lock(m_SharedCacheMutex);
+			FreeToCache(m_SharedCache, chunk);
+		}
+
+		/* Returns all the chunks cached by the calling thread to the shared list. */
+		void FlushThreadCache()
 		{
-			BlockType* block = m_FirstBlock;
-			while (block && !IsPtrInBlockBounds((uint8*)ptr, block))
+			for (ThreadCache& cache : t_ThreadCaches)
 			{
-				block = block->NextBlock;
+				if (cache.OwnerId == m_Id)
+				{
+					if (cache.Head)
+						PushBatch(cache.Head);
+					cache = ThreadCache { };
+					return;
+				}
 			}
-			return block;
 		}
 
-		inline static bool IsPtrInBlockBounds(uint8* ptr, BlockType* block)
+		TConcurrentPoolAllocator() :
+			m_Id(s_NextId.fetch_add(1, std::memory_order_relaxed)),
+			m_FirstBlock(nullptr),
+			m_SharedBatches(0),
+			m_SharedCache()
 		{
-			return ptr >= (uint8*)block && ptr < (uint8*)block + BlockType::ChunksSize;
+			ScopedLock lock(s_LiveIdsMutex);
+			s_LiveIds.insert(m_Id);
 		}
 
-		inline static BlockType* AllocateBlock()
+		~TConcurrentPoolAllocator()
 		{
-			return new BlockType;
+			{
+				ScopedLock lock(s_LiveIdsMutex);
+				s_LiveIds.erase(m_Id);
+			}
+
+			// The caches of the other threads are reclaimed in FindThreadCache
+			for (ThreadCache& cache : t_ThreadCaches)
+			{
+				if (cache.OwnerId == m_Id)
+					cache = ThreadCache { };
+			}
+
+			BlockType::DeleteChain(m_FirstBlock);
 		}
 
+		TConcurrentPoolAllocator(const TConcurrentPoolAllocator&) = delete;
+		TConcurrentPoolAllocator& operator=(const TConcurrentPoolAllocator&) = delete;
+
 	private:
+		struct ThreadCache
+		{
+			uint64 OwnerId = 0;
+			ChunkType* Head = nullptr;
+			size_t Count = 0;
+		};
+
+		/* Upper 16 bits of the shared list head are the ABA tag */
+		static constexpr uint64 HeadPointerMask = 0x0000FFFFFFFFFFFF;
+		static constexpr uint64 HeadTagOne      = 0x0001000000000000;
+
+		inline T* AllocateFromCache(ThreadCache& cache)
+		{
+			if (!cache.Head)
+				Refill(cache);
+
+			ChunkType* chunk = cache.Head;
+			cache.Head = chunk->Next();
+			--cache.Count;
+
+			chunk->MarkAllocated();
+
+			return (T*)chunk->Data;
+		}
+
+		inline void FreeToCache(ThreadCache& cache, ChunkType* chunk)
+		{
+			chunk->MarkFree(cache.Head);
+
+			cache.Head = chunk;
+			++cache.Count;
+
+			if (cache.Count >= 2 * BatchSize)
+			{
+				// Detach the first BatchSize chunks
+				ChunkType* batch = cache.Head;
+				ChunkType* tail = batch;
+				for (size_t i = 1; i < BatchSize; ++i)
+					tail = tail->Next();
+
+				cache.Head = tail->Next();
+				cache.Count -= BatchSize;
+				tail->SetNext(nullptr);
+
+				PushBatch(batch);
+			}
+		}
+
+		void Refill(ThreadCache& cache)
+		{
+			ionassert(!cache.Head);
+
+			if (ChunkType* batch = PopBatch())
+			{
+				size_t count = 0;
+				for (ChunkType* chunk = batch; chunk; chunk = chunk->Next())
+					++count;
+
+				cache.Head = batch;
+				cache.Count = count;
+				return;
+			}
+
+			BlockType* block = new BlockType(this);
+			{
+				ScopedLock lock(m_BlockMutex);
+				block->NextBlock = m_FirstBlock;
+				m_FirstBlock = block;
+			}
+
+			cache.Head = block->Chunks;
+			cache.Count = ChunksInBlock;
+		}
+
+		void PushBatch(ChunkType* batch)
+		{
+			ionassert(!((uint64)batch & ~HeadPointerMask));
+
+			uint64 head = m_SharedBatches.load(std::memory_order_relaxed);
+			while (true)
+			{
+				batch->SetNextBatch((ChunkType*)(head & HeadPointerMask));
+				uint64 newHead = ((head & ~HeadPointerMask) + HeadTagOne) | (uint64)batch;
+
+				if (m_SharedBatches.compare_exchange_weak(head, newHead, std::memory_order_release, std::memory_order_relaxed))
+					return;
+			}
+		}
+
+		ChunkType* PopBatch()
+		{
+			uint64 head = m_SharedBatches.load(std::memory_order_acquire);
+			while (true)
+			{
+				ChunkType* batch = (ChunkType*)(head & HeadPointerMask);
+				if (!batch)
+					return nullptr;
+
+				// The batch can be taken by another thread in the meantime, the tag makes the exchange fail then.
+				uint64 newHead = ((head & ~HeadPointerMask) + HeadTagOne) | (uint64)batch->NextBatch();
+
+				if (m_SharedBatches.compare_exchange_weak(head, newHead, std::memory_order_acq_rel, std::memory_order_acquire))
+					return batch;
+			}
+		}
+
+		/* @return Null, if the thread has no free cache slots */
+		ThreadCache* FindThreadCache()
+		{
+			ThreadCache* freeCache = nullptr;
+			for (ThreadCache& cache : t_ThreadCaches)
+			{
+				if (cache.OwnerId == m_Id)
+					return &cache;
+				if (!freeCache && !cache.OwnerId)
+					freeCache = &cache;
+			}
+
+			if (!freeCache)
+			{
+				// Reclaim the caches of the allocators that have been destroyed
+				ScopedLock lock(s_LiveIdsMutex);
+				for (ThreadCache& cache : t_ThreadCaches)
+				{
+					if (s_LiveIds.find(cache.OwnerId) == s_LiveIds.end())
+					{
+						freeCache = &cache;
+						break;
+					}
+				}
+				if (!freeCache)
+					return nullptr;
+			}
+
+			*freeCache = ThreadCache { };
+			freeCache->OwnerId = m_Id;
+			return freeCache;
+		}
+
+	private:
+		uint64 m_Id;
+
 		BlockType* m_FirstBlock;
-		BlockType* m_FreeBlockPtr;
-		ChunkType* m_NextChunkPtr;
+		Mutex m_BlockMutex;
+
+		/* Tagged pointer to the first chunk of the first batch */
+		TAtomic<uint64> m_SharedBatches;
+
+		ThreadCache m_SharedCache;
+		Mutex m_SharedCacheMutex;
+
+		inline static thread_local ThreadCache t_ThreadCaches[MaxThreadCaches];
+
+		inline static TAtomic<uint64> s_NextId { 1 };
+		inline static THashSet<uint64> s_LiveIds;
+		inline static Mutex s_LiveIdsMutex;
 	};
 
 	//template<typename T, size_t ChunksInBlock = 256>
@@ -240,6 +537,71 @@ namespace Ion
 			(void)test;
 			MemoryLogger.Info("{0} allocations - {1:.6f}ms", nAllocs, timer.GetTime(EDebugTimerTimeUnit::Millisecond));
 		}
+		MemoryLogger.Info("TPoolAllocator (Free):");
+		for (int32 j = 0; j < 10; ++j)
+		{
+			TPoolAllocator<A, 256> pool2;
+			size_t nAllocs = 65536;
+			TArray<A*> ptrs(nAllocs);
+			for (int32 i = 0; i < nAllocs; ++i)
+			{
+				ptrs[i] = pool2.Allocate();
+			}
+			DebugTimer timer;
+			// Free the last blocks first
+			for (int32 i = (int32)nAllocs - 1; i >= 0; --i)
+			{
+				pool2.Free(ptrs[i]);
+			}
+			timer.Stop();
+			MemoryLogger.Info("{0} frees - {1:.6f}ms", nAllocs, timer.GetTime(EDebugTimerTimeUnit::Millisecond));
+		}
+		// Each thread allocates and frees the chunks in batches of 256, all threads use the same pool.
+		auto runThreads = [](int32 nThreads, size_t nAllocs, auto allocateChunk, auto freeChunk)
+		{
+			TArray<Thread> threads;
+			threads.reserve(nThreads);
+			DebugTimer timer;
+			for (int32 t = 0; t < nThreads; ++t)
+			{
+				threads.emplace_back([=]
+				{
+					A* batch[256];
+					for (size_t i = 0; i < nAllocs / 256; ++i)
+					{
+						for (A*& ptr : batch)
+							ptr = allocateChunk();
+						for (A* ptr : batch)
+							freeChunk(ptr);
+					}
+				});
+			}
+			for (Thread& thread : threads)
+			{
+				thread.join();
+			}
+			timer.Stop();
+			return timer.GetTime(EDebugTimerTimeUnit::Millisecond);
+		};
+		MemoryLogger.Info("TPoolAllocator + Mutex vs TConcurrentPoolAllocator (concurrent):");
+		for (int32 nThreads : { 1, 4, 8 })
+		{
+			size_t nAllocs = 1 << 20;
+
+			TPoolAllocator<A, 256> lockedPool;
+			Mutex lockedPoolMutex;
+			double lockedTime = runThreads(nThreads, nAllocs,
+				[&]() { ScopedLock lock(lockedPoolMutex); return lockedPool.Allocate(); },
+				[&](A* ptr) { ScopedLock lock(lockedPoolMutex); lockedPool.Free(ptr); });
+
+			TConcurrentPoolAllocator<A, 256> concurrentPool;
+			double concurrentTime = runThreads(nThreads, nAllocs,
+				[&]() { return concurrentPool.Allocate(); },
+				[&](A* ptr) { concurrentPool.Free(ptr); });
+
+			MemoryLogger.Info("{0} threads x {1} allocations + frees - {2:.6f}ms vs {3:.6f}ms",
+				nThreads, nAllocs, lockedTime, concurrentTime);
+		}
 		MemoryLogger.Info("Malloc:");
 		for (int32 j = 0; j < 10; ++j)
 		{
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "MemoryCore.h"
+#include "EngineAllocator.h"
 #include "Core/Error/Error.h"
 
 namespace Ion
@@ -833,6 +834,39 @@ namespace Ion
 
 #pragma endregion
 
+#pragma region Ref count block allocation
+
+	namespace _Memory_Detail
+	{
+		/* The control blocks of the engine allocated types are allocated with the same tag (see ENGINE_ALLOCATED). */
+		template<typename T>
+		FORCEINLINE void* AllocateRefCountBlock(size_t size)
+		{
+			if constexpr (TIsEngineAllocatedV<T>)
+				return EngineAllocator::Allocate(size, T::EngineMemoryTag);
+			else
+				return ::operator new(size);
+		}
+
+		template<typename T>
+		FORCEINLINE void FreeRefCountBlock(void* ptr) noexcept
+		{
+			if constexpr (TIsEngineAllocatedV<T>)
+				EngineAllocator::Free(ptr);
+			else
+				::operator delete(ptr);
+		}
+	}
+
+	/* Over-aligned blocks are allocated with the global aligned new. */
+	#define REF_COUNT_BLOCK_ALLOCATOR(T) \
+	FORCEINLINE static void* operator new(size_t size) { return _Memory_Detail::AllocateRefCountBlock<T>(size); } \
+	FORCEINLINE static void* operator new(size_t size, std::align_val_t alignment) { return ::operator new(size, alignment); } \
+	FORCEINLINE static void operator delete(void* ptr) noexcept { _Memory_Detail::FreeRefCountBlock<T>(ptr); } \
+	FORCEINLINE static void operator delete(void* ptr, std::align_val_t alignment) noexcept { ::operator delete(ptr, alignment); }
+
+#pragma endregion
+
 #pragma region TPtrRefCountBlock
 
 	template<typename T, ERCMode RC>
@@ -841,6 +875,8 @@ namespace Ion
 	public:
 		static_assert(!TIsReferenceV<T>);
 
+		REF_COUNT_BLOCK_ALLOCATOR(T)
+
 		/**
 		 * @brief Construct a new RefCount object that owns the pointer
 		 * 
@@ -888,6 +924,8 @@ namespace Ion
 	public:
 		static_assert(!TIsReferenceV<T>);
 
+		REF_COUNT_BLOCK_ALLOCATOR(T)
+
 		/**
 		 * @brief Construct a ref count block with a custom deleter.
 		 * 
@@ -946,6 +984,8 @@ namespace Ion
 	public:
 		static_assert(!TIsReferenceV<T>);
 
+		REF_COUNT_BLOCK_ALLOCATOR(T)
+
 		/**
 		 * @brief Create a ref counter that has the element constructed in place.
 		 */
@@ -997,6 +1037,8 @@ namespace Ion
 	public:
 		static_assert(!TIsReferenceV<T>);
 
+		REF_COUNT_BLOCK_ALLOCATOR(T)
+
 		/**
 		 * @brief Create a ref counter that has the element constructed in place
 		 * and has a destroy callback function.
@@ -2066,6 +2108,136 @@ namespace Ion
 		return TSharedPtr<T, RC>(ptr, deleter);
 	}
 
+#pragma endregion
+
+#pragma region TBorrowedPtr
+
+	/**
+	 * @brief Non-owning view of an object owned by a TSharedPtr or a TRef.
+	 *
+	 * @details Copying and destroying it doesn't touch the ref count,
+	 * so it's meant for iterating over and passing around objects,
+	 * which are kept alive by their owner for the whole time the view is used.
+	 * Use a TWeakPtr if the owner can release the object in the meantime.
+	 *
+	 * @tparam T Element type
+	 */
+	template<typename T>
+	class TBorrowedPtr
+	{
+	public:
+		using TElement = T;
+
+		/**
+		 * @brief Construct a null pointer
+		 */
+		FORCEINLINE TBorrowedPtr() noexcept :
+			m_Ptr(nullptr)
+		{
+		}
+
+		/**
+		 * @brief Construct a null pointer
+		 */
+		FORCEINLINE TBorrowedPtr(nullptr_t) noexcept :
+			m_Ptr(nullptr)
+		{
+		}
+
+		/**
+		 * @brief Borrow a raw pointer
+		 */
+		template<typename T0, TEnableIfT<TIsPtrCompatibleV<T0, T>>* = 0>
+		FORCEINLINE TBorrowedPtr(T0* ptr) noexcept :
+			m_Ptr(ptr)
+		{
+		}
+
+		/**
+		 * @brief Borrow the object owned by a shared pointer
+		 */
+		template<typename T0, ERCMode RC, TEnableIfT<TIsPtrCompatibleV<T0, T>>* = 0>
+		FORCEINLINE TBorrowedPtr(const TSharedPtr<T0, RC>& ptr) noexcept :
+			m_Ptr(ptr.Raw())
+		{
+		}
+
+		/**
+		 * @brief Borrow the object owned by an intrusive ref
+		 */
+		template<typename T0, TEnableIfT<TIsRefCompatibleV<T0, T>>* = 0>
+		FORCEINLINE TBorrowedPtr(const TRef<T0>& ref) noexcept :
+			m_Ptr(ref.Raw())
+		{
+		}
+
+		/**
+		 * @brief Copy a view of a compatible type
+		 */
+		template<typename T0, TEnableIfT<TIsPtrCompatibleV<T0, T>>* = 0>
+		FORCEINLINE TBorrowedPtr(const TBorrowedPtr<T0>& other) noexcept :
+			m_Ptr(other.Raw())
+		{
+		}
+
+		/**
+		 * @brief Get the Raw pointer
+		 */
+		FORCEINLINE T* Raw() const noexcept
+		{
+			return m_Ptr;
+		}
+
+		/**
+		 * @brief Access the pointer
+		 */
+		FORCEINLINE T* operator->() const
+		{
+			ionassert(m_Ptr);
+			return m_Ptr;
+		}
+
+		/**
+		 * @brief Dereference the pointer
+		 */
+		FORCEINLINE T& operator*() const
+		{
+			ionassert(m_Ptr);
+			return *m_Ptr;
+		}
+
+		/**
+		 * @brief Check if this pointer is not null.
+		 */
+		FORCEINLINE bool IsValid() const noexcept
+		{
+			return m_Ptr;
+		}
+
+		/**
+		 * @see IsValid()
+		 */
+		FORCEINLINE operator bool() const noexcept
+		{
+			return IsValid();
+		}
+
+		template<typename T0>
+		FORCEINLINE bool operator==(const TBorrowedPtr<T0>& other) const noexcept
+		{
+			return m_Ptr == other.Raw();
+		}
+
+		template<typename T0>
+		FORCEINLINE bool operator!=(const TBorrowedPtr<T0>& other) const noexcept
+		{
+			return m_Ptr != other.Raw();
+		}
+
+	private:
+		T* m_Ptr;
+	};
+
 #pragma endregion
 
 	int RefCountPtrTest();
@@ -397,6 +397,30 @@ namespace Ion
 		TWeakPtr<PtrTest> wptr2 = sptr0;
 		ionassert(wptr2);
 
+		// Borrowed pointer ----------------------------------------------------
+
+		{
+			TSharedPtr<PtrTest2> bPtr0 = MakeShared<PtrTest2>("Text", "Text2");
+			TBorrowedPtr<PtrTest2> bPtr1 = bPtr0;
+			ionassert(bPtr1);
+			ionassert(bPtr1.Raw() == bPtr0.Raw());
+			ionassert(bPtr0.RefCount() == 1);
+
+			TBorrowedPtr<PtrTest> bPtr2 = bPtr1;
+			ionassert(bPtr2 == bPtr1);
+			ionassert(bPtr2->Text == "Text");
+			ionassert(bPtr0.RefCount() == 1);
+
+			TRef<RefTest> bRef0 = MakeRef<RefTest>("Text");
+			TBorrowedPtr<RefTest> bRef1 = bRef0;
+			ionassert(bRef1->Text == "Text");
+			ionassert(bRef0.RefCount() == 1);
+
+			TBorrowedPtr<PtrTest> bPtr3;
+			ionassert(!bPtr3);
+			ionassert(bPtr3 != bPtr2);
+		}
+
 		// Concurrency ---------------------------------------------------------
 
 		if (0)
@@ -486,6 +510,63 @@ namespace Ion
 			ionbreak();
 		}
 
+		// Copy / destroy throughput -------------------------------------------
+
+		if (0)
+		{
+			static constexpr uint32 PtrCount = 1024;
+			static constexpr uint32 Iterations = 10000;
+
+			// Copies all the pointers and destroys the copies, like iterating over a map of objects by value.
+			auto fBenchmark = [](const char* name, const auto& source)
+			{
+				using TPtr = typename TRemoveConstRef<decltype(source)>::value_type;
+
+				TArray<TPtr> copies;
+				copies.reserve(PtrCount);
+
+				DebugTimer timer;
+				for (uint32 i = 0; i < Iterations; ++i)
+				{
+					copies.assign(source.begin(), source.end());
+					copies.clear();
+				}
+				timer.Stop();
+
+				double time = timer.GetTime(EDebugTimerTimeUnit::Millisecond);
+				double copiesPerSecond = (double)PtrCount * Iterations / (time / 1000.0);
+
+				CoreLogger.Debug("{:<28} Time: {:.5}ms, {:.4}M copies per second", name, time, copiesPerSecond / 1000000.0);
+			};
+
+			TArray<TSharedPtr<PtrTest>> sharedPtrs;
+			TArray<TSharedPtr<PtrTest, ERCMode::NonThreadSafe>> nonThreadSafePtrs;
+			TArray<TRef<RefTest>> refs;
+			TArray<TBorrowedPtr<PtrTest>> borrowedPtrs;
+			for (uint32 i = 0; i < PtrCount; ++i)
+			{
+				sharedPtrs.emplace_back(MakeShared<PtrTest>("Text"));
+				nonThreadSafePtrs.emplace_back(MakeShared<PtrTest, ERCMode::NonThreadSafe>("Text"));
+				refs.emplace_back(MakeRef<RefTest>("Text"));
+				borrowedPtrs.emplace_back(sharedPtrs.back());
+			}
+
+			fBenchmark("TSharedPtr (ThreadSafe)", sharedPtrs);
+			fBenchmark("TSharedPtr (NonThreadSafe)", nonThreadSafePtrs);
+			fBenchmark("TRef", refs);
+			fBenchmark("TBorrowedPtr", borrowedPtrs);
+
+			for (uint32 i = 0; i < PtrCount; ++i)
+			{
+				ionverify(sharedPtrs[i].RefCount() == 1);
+				ionverify(nonThreadSafePtrs[i].RefCount() == 1);
+				ionverify(refs[i].RefCount() == 1);
+				ionverify(borrowedPtrs[i] == TBorrowedPtr<PtrTest>(sharedPtrs[i]));
+			}
+
+			ionbreak();
+		}
+
 		return 0;
 	}
 
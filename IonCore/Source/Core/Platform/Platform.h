@@ -37,6 +37,12 @@ namespace Ion::Platform
 
 	WString GetSystemDefaultFontPath();
 
+	/* Reserves and commits the memory pages, the address is aligned to the allocation granularity. */
+	void* AllocatePages(size_t size);
+	void FreePages(void* ptr);
+	/* Alignment of the addresses returned by AllocatePages */
+	size_t GetPageAllocationGranularity();
+
 	namespace Internal
 	{
 		void SetMainThreadId();
@@ -86,6 +86,23 @@ namespace Ion::Platform
 		return L"";
 	}
 
+	void* AllocatePages(size_t size)
+	{
+		return ::VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+	}
+
+	void FreePages(void* ptr)
+	{
+		::VirtualFree(ptr, 0, MEM_RELEASE);
+	}
+
+	size_t GetPageAllocationGranularity()
+	{
+		SYSTEM_INFO info;
+		::GetSystemInfo(&info);
+		return info.dwAllocationGranularity;
+	}
+
 	namespace Internal
 	{
 		void SetMainThreadId()
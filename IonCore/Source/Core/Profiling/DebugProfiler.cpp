@@ -31,6 +31,13 @@ namespace Performance
 		m_CounterData.m_Time = (m_EndTime - m_StartTime).count();
 	}
 
+	// ----------------------
+	// Value Counter --------
+
+	ValueCounter::ValueCounter(String&& name)
+		: m_Name(std::move(name)), m_Value(0)
+	{ }
+
 	// -----------------------
 	// Debug Profiler --------
 
@@ -71,6 +78,34 @@ namespace Performance
 		return instance->m_RegisteredCounters.find(id) != instance->m_RegisteredCounters.end();
 	}
 
+	ValueCounter* DebugProfiler::RegisterValueCounter(String&& id, String&& name)
+	{
+		DebugProfiler* instance = Get();
+		auto it = instance->m_RegisteredValueCounters.find(id);
+		if (it != instance->m_RegisteredValueCounters.end())
+			return it->second;
+
+		ValueCounter* counter = new ValueCounter(std::move(name));
+		instance->m_RegisteredValueCounters[id] = counter;
+		instance->m_ValueCounters.push_back(counter);
+		return counter;
+	}
+
+	ValueCounter* DebugProfiler::FindValueCounter(const String& id)
+	{
+		DebugProfiler* instance = Get();
+		auto it = instance->m_RegisteredValueCounters.find(id);
+		if (it != instance->m_RegisteredValueCounters.end())
+			return it->second;
+
+		return nullptr;
+	}
+
+	const TArray<ValueCounter*>& DebugProfiler::GetValueCounters()
+	{
+		return Get()->m_ValueCounters;
+	}
+
 	// -----------------------
 	// Scoped Counter --------
 
@@ -24,6 +24,14 @@ std::shared_ptr<Ion::Performance::ManualCounter> id = std::make_shared<Ion::Perf
 #define COUNTER_TIME_DATA(varName, counterId) \
 Ion::Performance::PerformanceCounterData varName = Ion::Performance::DebugProfiler::FindCounter(counterId)->GetData()
 
+/* Used to declare and register a debug value counter (e.g. a number of objects processed in the last frame) */
+#define DECLARE_VALUE_COUNTER(id, name) \
+Ion::Performance::ValueCounter* DebugValue_##id = Ion::Performance::DebugProfiler::RegisterValueCounter(#id, name)
+
+/* Sets the value of an already declared value counter. Can be called from any thread. */
+#define SET_VALUE_COUNTER(id, value) \
+DebugValue_##id->Set(value)
+
 namespace Ion
 {
 namespace Performance
@@ -69,6 +77,24 @@ namespace Performance
 		std::chrono::steady_clock::time_point m_EndTime;
 	};
 
+	/* Use the DECLARE_VALUE_COUNTER and SET_VALUE_COUNTER macros to use this counter */
+	class ION_API ValueCounter
+	{
+		friend class DebugProfiler;
+
+	public:
+		FORCEINLINE const String& GetName() const { return m_Name; }
+
+		FORCEINLINE int64 Get() const { return m_Value.load(std::memory_order_relaxed); }
+		FORCEINLINE void Set(int64 value) { m_Value.store(value, std::memory_order_relaxed); }
+
+	private:
+		ValueCounter(String&& name);
+
+		String m_Name;
+		TAtomic<int64> m_Value;
+	};
+
 	class ION_API DebugProfiler
 	{
 	public:
@@ -76,11 +102,18 @@ namespace Performance
 		static DebugCounter* FindCounter(const String& id);
 		static bool IsCounterRegistered(const String& id);
 
+		static ValueCounter* RegisterValueCounter(String&& id, String&& name);
+		static ValueCounter* FindValueCounter(const String& id);
+		/* Value counters in the registration order */
+		static const TArray<ValueCounter*>& GetValueCounters();
+
 		static DebugProfiler* Get();
 
 	private:
 		static DebugProfiler* s_Instance;
 		THashMap<String, DebugCounter*> m_RegisteredCounters;
+		THashMap<String, ValueCounter*> m_RegisteredValueCounters;
+		TArray<ValueCounter*> m_ValueCounters;
 	};
 
 	/* Use the SCOPED_PERFORMANCE_COUNTER macro to use this counter */
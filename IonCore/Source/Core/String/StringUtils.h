@@ -27,6 +27,11 @@ inline static uint64 tstrlen(const T* s) { return 0; }
 template<> inline static uint64 tstrlen<char>(const char* s)  { return strlen(s); }
 template<> inline static uint64 tstrlen<wchar>(const wchar* s) { return wcslen(s); }
 
+template<typename T>
+inline static uint64 tstrtoul(const T* s, int32 base = 10) { return 0; }
+template<> inline static uint64 tstrtoul<char>(const char* s, int32 base)   { return strtoull(s, nullptr, base); }
+template<> inline static uint64 tstrtoul<wchar>(const wchar* s, int32 base) { return wcstoull(s, nullptr, base); }
+
 FORCEINLINE constexpr const char* BoolStr(bool value) { return value ? "true" : "false"; }
 FORCEINLINE constexpr const wchar* BoolWStr(bool value) { return value ? L"true" : L"false"; }
 
@@ -15,6 +15,18 @@ namespace Ion
 			g_EngineTaskQueue->Schedule(work);
 		}
 
+		void Wait(const TaskCounter& counter)
+		{
+			ionassert(g_EngineTaskQueue, "The Engine Task Queue has not been initialized yet.");
+			g_EngineTaskQueue->Wait(counter);
+		}
+
+		void Wait(const TaskHandle& handle)
+		{
+			ionassert(g_EngineTaskQueue, "The Engine Task Queue has not been initialized yet.");
+			g_EngineTaskQueue->Wait(handle);
+		}
+
 		void Init()
 		{
 			ionassert(!g_EngineTaskQueue, "The Engine Task Queue has already been initialized.");
@@ -48,6 +48,70 @@ namespace Ion
 		 */
 		void Schedule(const std::shared_ptr<FTaskWork>& work);
 
+		/**
+		 * @brief Add a job to the Engine Task Queue, which will be executed
+		 * by a free worker thread. Doesn't allocate for small functors.
+		 * 
+		 * @see TaskQueue::ScheduleJob(F&& execute)
+		 *
+		 * @tparam F Callable with a void(IMessageQueueProvider&) signature
+		 * @param execute Function to execute on the worker thread
+		 */
+		template<typename F>
+		void ScheduleJob(F&& execute);
+
+		/**
+		 * @brief Add a job to the Engine Task Queue and increment the counter.
+		 * The counter is decremented after the job has been executed.
+		 * 
+		 * @see TaskQueue::ScheduleJob(F&& execute, TaskCounter& counter)
+		 */
+		template<typename F>
+		void ScheduleJob(F&& execute, TaskCounter& counter);
+
+		/**
+		 * @brief Add a job to the Engine Task Queue, that will be executed
+		 * after all the dependencies have finished.
+		 * 
+		 * @see TaskQueue::ScheduleTask(F&& execute, TInitializerList<TaskHandle> dependencies)
+		 */
+		template<typename F>
+		TaskHandle ScheduleTask(F&& execute, TInitializerList<TaskHandle> dependencies = { });
+
+		/**
+		 * @brief Wait for the counter to reach zero, while executing
+		 * the Engine Task Queue jobs on the calling thread.
+		 * 
+		 * @see TaskQueue::Wait(const TaskCounter& counter)
+		 */
+		void Wait(const TaskCounter& counter);
+
+		/**
+		 * @brief Wait for the task to finish, while executing
+		 * the Engine Task Queue jobs on the calling thread.
+		 * 
+		 * @see TaskQueue::Wait(const TaskHandle& handle)
+		 */
+		void Wait(const TaskHandle& handle);
+
+		/**
+		 * @brief Execute the function for each chunk of the range
+		 * on the Engine Task Queue workers and the calling thread.
+		 * 
+		 * @see TaskQueue::ParallelForRange(int64 begin, int64 end, int64 grain, F&& func)
+		 */
+		template<typename F>
+		void ParallelForRange(int64 begin, int64 end, int64 grain, F&& func);
+
+		/**
+		 * @brief Execute the function for each index of the range
+		 * on the Engine Task Queue workers and the calling thread.
+		 * 
+		 * @see TaskQueue::ParallelFor(int64 begin, int64 end, int64 grain, F&& func)
+		 */
+		template<typename F>
+		void ParallelFor(int64 begin, int64 end, int64 grain, F&& func);
+
 		/**
 		 * @brief Creates the Engine Task Queue object, which will then be
 		 * available in the g_EngineTaskQueue global variable.
@@ -91,5 +155,40 @@ namespace Ion
 			ionassert(g_EngineTaskQueue, "The Engine Task Queue has not been initialized yet.");
 			g_EngineTaskQueue->Schedule(work);
 		}
+
+		template<typename F>
+		inline void ScheduleJob(F&& execute)
+		{
+			ionassert(g_EngineTaskQueue, "The Engine Task Queue has not been initialized yet.");
+			g_EngineTaskQueue->ScheduleJob(Forward<F>(execute));
+		}
+
+		template<typename F>
+		inline void ScheduleJob(F&& execute, TaskCounter& counter)
+		{
+			ionassert(g_EngineTaskQueue, "The Engine Task Queue has not been initialized yet.");
+			g_EngineTaskQueue->ScheduleJob(Forward<F>(execute), counter);
+		}
+
+		template<typename F>
+		inline TaskHandle ScheduleTask(F&& execute, TInitializerList<TaskHandle> dependencies)
+		{
+			ionassert(g_EngineTaskQueue, "The Engine Task Queue has not been initialized yet.");
+			return g_EngineTaskQueue->ScheduleTask(Forward<F>(execute), dependencies);
+		}
+
+		template<typename F>
+		inline void ParallelForRange(int64 begin, int64 end, int64 grain, F&& func)
+		{
+			ionassert(g_EngineTaskQueue, "The Engine Task Queue has not been initialized yet.");
+			g_EngineTaskQueue->ParallelForRange(begin, end, grain, Forward<F>(func));
+		}
+
+		template<typename F>
+		inline void ParallelFor(int64 begin, int64 end, int64 grain, F&& func)
+		{
+			ionassert(g_EngineTaskQueue, "The Engine Task Queue has not been initialized yet.");
+			g_EngineTaskQueue->ParallelFor(begin, end, grain, Forward<F>(func));
+		}
 	}
 }
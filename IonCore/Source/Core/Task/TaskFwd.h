@@ -8,6 +8,23 @@ namespace Ion
 	struct FTaskMessage;
 	class TaskWorker;
 	class TaskQueue;
+	// TaskJob.h
+	template<typename TSignature, size_t InlineSize>
+	class TInlineFunction;
+	struct FTaskJob;
+	class TaskJobPool;
+	// TaskHandle.h
+	class TaskCounter;
+	class TaskHandleState;
+	class TaskHandle;
+	// TaskGraph.h
+	enum class ETaskGraphThread : uint8;
+	class TaskGraph;
+	// WorkStealingQueue.h
+	template<typename T, size_t Capacity>
+	class TWorkStealingQueue;
+	template<typename T, size_t Capacity>
+	class TBoundedMPMCQueue;
 	// Task.h
 	class AsyncTask;
 }
@@ -0,0 +1,177 @@
+#include "Core/CorePCH.h"
+
+#include "TaskGraph.h"
+#include "TaskQueue.h"
+#include "Core/Error/Error.h"
+#include "Core/Diagnostics/Tracing.h"
+
+namespace Ion
+{
+	TaskGraph::TaskGraph(TaskQueue& queue, uint32 maxFramesInFlight) :
+		m_Queue(queue),
+		m_FrameIndex(0),
+		m_MaxFramesInFlight(1)
+	{
+		SetMaxFramesInFlight(maxFramesInFlight);
+	}
+
+	TaskGraph::~TaskGraph()
+	{
+		Flush();
+	}
+
+	TaskGraph::StageIndex TaskGraph::AddStage(const char* name, ETaskGraphThread thread, const TFuncStageExecute& execute,
+		TInitializerList<StageIndex> dependencies,
+		TInitializerList<StageIndex> previousFrameDependencies)
+	{
+		ionassert(name);
+		ionassert(execute);
+
+		// The running stages reference the stage array
+		Flush();
+
+		StageIndex index = (StageIndex)m_Stages.size();
+
+		Stage& stage = m_Stages.emplace_back();
+		stage.Name = name;
+		stage.Thread = thread;
+		stage.Execute = execute;
+		stage.Dependencies = dependencies;
+		stage.PreviousFrameDependencies = previousFrameDependencies;
+
+		for (StageIndex dependency : stage.Dependencies)
+		{
+			// This also makes the declaration order a valid execution order.
+			ionassert(dependency < index, "Stage {} can only depend on the stages declared before it.", name);
+		}
+		for (StageIndex dependency : stage.PreviousFrameDependencies)
+		{
+			ionassert(dependency <= index, "Stage {} depends on a stage that has not been declared.", name);
+		}
+
+		return index;
+	}
+
+	void TaskGraph::AddPreviousFrameDependency(StageIndex stage, StageIndex previousFrameStage)
+	{
+		ionassert(stage < m_Stages.size());
+		ionassert(previousFrameStage < m_Stages.size());
+
+		Flush();
+
+		m_Stages[stage].PreviousFrameDependencies.push_back(previousFrameStage);
+	}
+
+	void TaskGraph::RunFrame()
+	{
+		TRACE_FUNCTION();
+
+		uint64 frameIndex = m_FrameIndex++;
+
+		// The slot has been used by a frame that has already finished,
+		// because MaxFramesInFlight <= MaxSupportedFramesInFlight.
+		TArray<TaskHandle>& handles = GetFrameHandles(frameIndex);
+		const TArray<TaskHandle>* previousHandles = frameIndex ? &GetFrameHandles(frameIndex - 1) : nullptr;
+
+		handles.clear();
+		handles.resize(m_Stages.size());
+
+		auto gatherDependencies = [&](const Stage& stage, TArray<TaskHandle>& outDependencies)
+		{
+			outDependencies.clear();
+			for (StageIndex dependency : stage.Dependencies)
+			{
+				outDependencies.push_back(handles[dependency]);
+			}
+			if (previousHandles)
+			{
+				for (StageIndex dependency : stage.PreviousFrameDependencies)
+				{
+					// The stage might have been added after the previous frame
+					if (dependency < previousHandles->size())
+						outDependencies.push_back((*previousHandles)[dependency]);
+				}
+			}
+		};
+
+		TArray<TaskHandle> dependencies;
+
+		// Schedule the whole frame first, so the worker stages
+		// can start as soon as the main thread stages they depend on finish.
+		for (StageIndex i = 0; i < m_Stages.size(); ++i)
+		{
+			const Stage& stage = m_Stages[i];
+			if (stage.Thread == ETaskGraphThread::Main)
+			{
+				handles[i] = TaskHandle::CreatePending();
+				continue;
+			}
+
+			gatherDependencies(stage, dependencies);
+			handles[i] = m_Queue.ScheduleTask([&stage](IMessageQueueProvider&)
+			{
+				TRACE_SCOPE(stage.Name);
+				stage.Execute();
+			}, dependencies);
+		}
+
+		for (StageIndex i = 0; i < m_Stages.size(); ++i)
+		{
+			const Stage& stage = m_Stages[i];
+			if (stage.Thread != ETaskGraphThread::Main)
+				continue;
+
+			gatherDependencies(stage, dependencies);
+			for (const TaskHandle& dependency : dependencies)
+			{
+				m_Queue.Wait(dependency);
+			}
+
+			{
+				TRACE_SCOPE(stage.Name);
+				stage.Execute();
+			}
+			handles[i].Complete();
+		}
+
+		if (frameIndex + 1 >= m_MaxFramesInFlight)
+		{
+			WaitForFrame(frameIndex + 1 - m_MaxFramesInFlight);
+		}
+	}
+
+	void TaskGraph::Flush()
+	{
+		uint64 framesInFlight = std::min<uint64>(m_FrameIndex, m_MaxFramesInFlight);
+		for (uint64 frameIndex = m_FrameIndex - framesInFlight; frameIndex < m_FrameIndex; ++frameIndex)
+		{
+			WaitForFrame(frameIndex);
+		}
+	}
+
+	void TaskGraph::SetMaxFramesInFlight(uint32 maxFramesInFlight)
+	{
+		ionassert(maxFramesInFlight >= 1 && maxFramesInFlight <= MaxSupportedFramesInFlight,
+			"Max frames in flight has to be between 1 and {}.", MaxSupportedFramesInFlight);
+
+		Flush();
+
+		m_MaxFramesInFlight = std::clamp<uint32>(maxFramesInFlight, 1, MaxSupportedFramesInFlight);
+	}
+
+	const char* TaskGraph::GetStageName(StageIndex stage) const
+	{
+		ionassert(stage < m_Stages.size());
+		return m_Stages[stage].Name;
+	}
+
+	void TaskGraph::WaitForFrame(uint64 frameIndex)
+	{
+		TRACE_FUNCTION();
+
+		for (const TaskHandle& handle : GetFrameHandles(frameIndex))
+		{
+			m_Queue.Wait(handle);
+		}
+	}
+}
@@ -0,0 +1,157 @@
+#pragma once
+
+#include "Core/Base.h"
+#include "TaskFwd.h"
+#include "TaskHandle.h"
+
+namespace Ion
+{
+	/**
+	 * @brief Thread a TaskGraph stage is executed on.
+	 */
+	enum class ETaskGraphThread : uint8
+	{
+		/* The thread that calls TaskGraph::RunFrame */
+		Main,
+		/* Any thread that executes the TaskQueue jobs */
+		Worker,
+	};
+
+	/**
+	 * @brief Per-frame graph of stages with declared dependencies.
+	 *
+	 * @details The stages are declared once and then run every frame
+	 * with RunFrame. A stage can depend on the stages declared before it
+	 * in the same frame, and on any stage of the previous frame.
+	 * Worker stages are scheduled on the TaskQueue as soon as their
+	 * dependencies finish, so the stages that don't depend on each other
+	 * run at the same time. Main thread stages are executed by the thread
+	 * that calls RunFrame in the declaration order; while it waits for
+	 * their dependencies, it helps executing the queued jobs.
+	 *
+	 * Up to MaxFramesInFlight frames can be running at the same time.
+	 * RunFrame only waits for the frame that would exceed the limit,
+	 * so the worker stages of a frame can overlap with the next one,
+	 * as long as the previous frame dependencies allow it.
+	 */
+	class ION_API TaskGraph
+	{
+	public:
+		using StageIndex = uint32;
+
+		using TFuncStageExecute = TFunction<void()>;
+
+		static constexpr uint32 MaxSupportedFramesInFlight = 4;
+
+		/**
+		 * @brief Construct a new Task Graph object
+		 *
+		 * @param queue Queue to run the worker stages on
+		 * @param maxFramesInFlight Max number of frames that can run at the same time
+		 */
+		TaskGraph(TaskQueue& queue, uint32 maxFramesInFlight = 1);
+		~TaskGraph();
+
+		/**
+		 * @brief Declare a new stage. Can't be called while a frame is running.
+		 *
+		 * @param name Stage name used for tracing (has to outlive the graph)
+		 * @param thread Thread the stage is executed on
+		 * @param execute Stage function
+		 * @param dependencies Stages of the same frame that have to finish first
+		 * (they have to be declared before this stage)
+		 * @param previousFrameDependencies Stages of the previous frame that have to finish first
+		 * @return Index of the stage
+		 */
+		StageIndex AddStage(const char* name, ETaskGraphThread thread, const TFuncStageExecute& execute,
+			TInitializerList<StageIndex> dependencies = { },
+			TInitializerList<StageIndex> previousFrameDependencies = { });
+
+		/**
+		 * @brief Add a dependency on a stage of the previous frame after the stage
+		 * has been declared. Useful for stages that are declared later.
+		 */
+		void AddPreviousFrameDependency(StageIndex stage, StageIndex previousFrameStage);
+
+		/**
+		 * @brief Run all the stages of the next frame.
+		 *
+		 * @details Returns after all the main thread stages of the frame
+		 * have been executed and there are less than MaxFramesInFlight
+		 * frames still running.
+		 */
+		void RunFrame();
+
+		/**
+		 * @brief Wait until all the running frames finish.
+		 */
+		void Flush();
+
+		/**
+		 * @brief Set how many frames can run at the same time.
+		 * Flushes the graph.
+		 *
+		 * @param maxFramesInFlight 1 to MaxSupportedFramesInFlight
+		 */
+		void SetMaxFramesInFlight(uint32 maxFramesInFlight);
+		uint32 GetMaxFramesInFlight() const;
+
+		/**
+		 * @brief Index of the frame that will run in the next RunFrame call.
+		 */
+		uint64 GetFrameIndex() const;
+
+		uint32 GetStageCount() const;
+		const char* GetStageName(StageIndex stage) const;
+
+		TaskGraph(const TaskGraph&) = delete;
+		TaskGraph& operator=(const TaskGraph&) = delete;
+
+	private:
+		void WaitForFrame(uint64 frameIndex);
+
+		TArray<TaskHandle>& GetFrameHandles(uint64 frameIndex);
+
+	private:
+		struct Stage
+		{
+			const char* Name;
+			ETaskGraphThread Thread;
+			TFuncStageExecute Execute;
+			TArray<StageIndex> Dependencies;
+			TArray<StageIndex> PreviousFrameDependencies;
+		};
+
+		TaskQueue& m_Queue;
+
+		TArray<Stage> m_Stages;
+
+		/* Stage handles of the running frames, indexed with frameIndex % MaxSupportedFramesInFlight */
+		TArray<TaskHandle> m_FrameHandles[MaxSupportedFramesInFlight];
+
+		uint64 m_FrameIndex;
+		uint32 m_MaxFramesInFlight;
+	};
+
+	// TaskGraph Implementation ---------------------------------------------
+
+	FORCEINLINE uint32 TaskGraph::GetMaxFramesInFlight() const
+	{
+		return m_MaxFramesInFlight;
+	}
+
+	FORCEINLINE uint64 TaskGraph::GetFrameIndex() const
+	{
+		return m_FrameIndex;
+	}
+
+	FORCEINLINE uint32 TaskGraph::GetStageCount() const
+	{
+		return (uint32)m_Stages.size();
+	}
+
+	FORCEINLINE TArray<TaskHandle>& TaskGraph::GetFrameHandles(uint64 frameIndex)
+	{
+		return m_FrameHandles[frameIndex % MaxSupportedFramesInFlight];
+	}
+}
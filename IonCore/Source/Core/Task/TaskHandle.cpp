@@ -0,0 +1,77 @@
+#include "Core/CorePCH.h"
+
+#include "TaskHandle.h"
+#include "TaskQueue.h"
+
+namespace Ion
+{
+	TaskHandleState::TaskHandleState(int32 initialValue) :
+		m_Value(initialValue)
+	{
+	}
+
+	void TaskHandleState::Decrement()
+	{
+		int32 previous = m_Value.fetch_sub(1, std::memory_order_acq_rel);
+		ionassert(previous > 0);
+
+		if (previous != 1)
+			return;
+
+		// Take the dependents and release them outside of the lock,
+		// because releasing them can decrement other states.
+		TArray<Dependent> dependents;
+		{
+			UniqueLock lock(m_DependentsMutex);
+			dependents.swap(m_Dependents);
+		}
+
+		for (Dependent& dependent : dependents)
+		{
+			Release(dependent);
+		}
+	}
+
+	void TaskHandleState::AddDependent(TaskQueue* queue, FTaskJob* job)
+	{
+		ionassert(queue);
+		ionassert(job);
+
+		AddDependent(Dependent { queue, job, nullptr });
+	}
+
+	void TaskHandleState::AddDependent(const std::shared_ptr<TaskHandleState>& state)
+	{
+		ionassert(state);
+		ionassert(state.get() != this);
+
+		AddDependent(Dependent { nullptr, nullptr, state });
+	}
+
+	void TaskHandleState::AddDependent(Dependent&& dependent)
+	{
+		{
+			UniqueLock lock(m_DependentsMutex);
+			// Decrement will take the dependent once the counter reaches zero
+			if (!IsDone())
+			{
+				m_Dependents.emplace_back(Move(dependent));
+				return;
+			}
+		}
+		// Already done
+		Release(dependent);
+	}
+
+	void TaskHandleState::Release(Dependent& dependent)
+	{
+		if (dependent.Job)
+		{
+			dependent.Queue->PushJob(dependent.Job);
+		}
+		if (dependent.State)
+		{
+			dependent.State->Decrement();
+		}
+	}
+}
@@ -0,0 +1,191 @@
+#pragma once
+
+#include "Core/Base.h"
+#include "Core/Error/Error.h"
+#include "TaskFwd.h"
+
+namespace Ion
+{
+	/**
+	 * @brief Atomic counter of jobs that haven't finished yet.
+	 *
+	 * @details The counter is incremented when a job is scheduled with it
+	 * and decremented when the job finishes. Use TaskQueue::Wait to
+	 * block until it reaches zero.
+	 * Decrement is the last access of the counter made by a job,
+	 * so it's safe to keep the counter on the stack of the waiting thread.
+	 *
+	 * @see TaskQueue::ScheduleJob(F&& execute, TaskCounter& counter)
+	 */
+	class ION_API TaskCounter
+	{
+	public:
+		TaskCounter(int32 initialValue = 0);
+
+		void Increment(int32 count = 1);
+		void Decrement(int32 count = 1);
+
+		/**
+		 * @brief Checks if all the jobs associated with the counter have finished.
+		 */
+		bool IsDone() const;
+		int32 GetValue() const;
+
+		TaskCounter(const TaskCounter&) = delete;
+		TaskCounter& operator=(const TaskCounter&) = delete;
+
+	private:
+		TAtomic<int32> m_Value;
+	};
+
+	/**
+	 * @brief Shared state of a TaskHandle. Stores the jobs and handles
+	 * that depend on the task and releases them when it finishes.
+	 */
+	class ION_API TaskHandleState
+	{
+	public:
+		TaskHandleState(int32 initialValue);
+
+		bool IsDone() const;
+
+		/**
+		 * @brief Decrement the counter and release the dependents
+		 * if it has reached zero.
+		 */
+		void Decrement();
+
+		/**
+		 * @brief Schedule the job in the queue once the counter reaches zero.
+		 * Schedules it immediately if the counter is already zero.
+		 */
+		void AddDependent(TaskQueue* queue, FTaskJob* job);
+		/**
+		 * @brief Decrement the state once the counter reaches zero.
+		 * Decrements it immediately if the counter is already zero.
+		 */
+		void AddDependent(const std::shared_ptr<TaskHandleState>& state);
+
+	private:
+		struct Dependent
+		{
+			TaskQueue* Queue;
+			FTaskJob* Job;
+			std::shared_ptr<TaskHandleState> State;
+		};
+
+		void AddDependent(Dependent&& dependent);
+		static void Release(Dependent& dependent);
+
+	private:
+		TAtomic<int32> m_Value;
+
+		Mutex m_DependentsMutex;
+		TArray<Dependent> m_Dependents;
+	};
+
+	/**
+	 * @brief Handle to a job scheduled with TaskQueue::ScheduleTask.
+	 *
+	 * @details Can be passed as a dependency to other tasks, so they are
+	 * only executed after this one has finished, or waited on with
+	 * TaskQueue::Wait. A default constructed handle is invalid and
+	 * counts as done.
+	 */
+	class ION_API TaskHandle
+	{
+	public:
+		TaskHandle() = default;
+
+		/**
+		 * @brief Create a handle that isn't associated with any job
+		 * and has to be finished manually with Complete.
+		 *
+		 * @details Lets the tasks depend on work that is done outside
+		 * of the TaskQueue, e.g. on the main thread.
+		 */
+		static TaskHandle CreatePending();
+
+		/**
+		 * @brief Finish a handle created with CreatePending
+		 * and release the tasks that depend on it.
+		 * Has to be called exactly once.
+		 */
+		void Complete() const;
+
+		bool IsValid() const;
+		bool IsDone() const;
+
+	private:
+		TaskHandle(const std::shared_ptr<TaskHandleState>& state);
+
+	private:
+		std::shared_ptr<TaskHandleState> m_State;
+
+		friend class TaskQueue;
+	};
+
+	// TaskCounter Implementation ---------------------------------------------
+
+	inline TaskCounter::TaskCounter(int32 initialValue) :
+		m_Value(initialValue)
+	{
+	}
+
+	FORCEINLINE void TaskCounter::Increment(int32 count)
+	{
+		m_Value.fetch_add(count, std::memory_order_relaxed);
+	}
+
+	FORCEINLINE void TaskCounter::Decrement(int32 count)
+	{
+		// Don't touch the counter after this, the waiting thread might destroy it.
+		int32 previous = m_Value.fetch_sub(count, std::memory_order_acq_rel);
+		ionassert(previous >= count);
+	}
+
+	FORCEINLINE bool TaskCounter::IsDone() const
+	{
+		return m_Value.load(std::memory_order_acquire) == 0;
+	}
+
+	FORCEINLINE int32 TaskCounter::GetValue() const
+	{
+		return m_Value.load(std::memory_order_acquire);
+	}
+
+	// TaskHandleState Implementation ---------------------------------------------
+
+	FORCEINLINE bool TaskHandleState::IsDone() const
+	{
+		return m_Value.load(std::memory_order_acquire) == 0;
+	}
+
+	// TaskHandle Implementation ---------------------------------------------
+
+	inline TaskHandle::TaskHandle(const std::shared_ptr<TaskHandleState>& state) :
+		m_State(state)
+	{
+	}
+
+	inline TaskHandle TaskHandle::CreatePending()
+	{
+		return TaskHandle(std::make_shared<TaskHandleState>(1));
+	}
+
+	inline void TaskHandle::Complete() const
+	{
+		ionassert(m_State);
+		m_State->Decrement();
+	}
+
+	FORCEINLINE bool TaskHandle::IsValid() const
+	{
+		return (bool)m_State;
+	}
+
+	FORCEINLINE bool TaskHandle::IsDone() const
+	{
+		return !m_State || m_State->IsDone();
+	}
+}
@@ -0,0 +1,77 @@
+#include "Core/CorePCH.h"
+
+#include "TaskJob.h"
+
+namespace Ion
+{
+	TaskJobPool::TaskJobPool(uint32 capacity) :
+		m_Jobs(std::make_unique<FTaskJob[]>(capacity)),
+		m_Capacity(capacity),
+		m_FreeHead(0)
+	{
+		ionassert(capacity < TNumericLimits<uint32>::max());
+
+		// Link all the jobs together
+		for (uint32 i = 0; i < capacity; ++i)
+		{
+			FTaskJob& job = m_Jobs[i];
+			job.m_NextFree.store(i + 1 < capacity ? i + 2 : 0, std::memory_order_relaxed);
+			job.m_bPooled = true;
+		}
+		m_FreeHead.store(capacity ? 1 : 0, std::memory_order_release);
+	}
+
+	TaskJobPool::~TaskJobPool()
+	{
+	}
+
+	void TaskJobPool::Release(FTaskJob* job)
+	{
+		ionassert(job);
+
+		job->Execute.Reset();
+
+		if (!job->m_bPooled)
+		{
+			delete job;
+			return;
+		}
+
+		PushFree(job);
+	}
+
+	FTaskJob* TaskJobPool::PopFree()
+	{
+		uint64 head = m_FreeHead.load(std::memory_order_acquire);
+		while (true)
+		{
+			uint32 index = (uint32)head;
+			if (!index)
+				return nullptr;
+
+			FTaskJob& job = m_Jobs[index - 1];
+			uint32 next = job.m_NextFree.load(std::memory_order_relaxed);
+			uint64 newHead = (((head >> 32) + 1) << 32) | next;
+
+			if (m_FreeHead.compare_exchange_weak(head, newHead, std::memory_order_acq_rel, std::memory_order_acquire))
+				return &job;
+		}
+	}
+
+	void TaskJobPool::PushFree(FTaskJob* job)
+	{
+		ionassert(job >= m_Jobs.get() && job < m_Jobs.get() + m_Capacity, "The job does not belong to this pool.");
+
+		uint32 index = (uint32)(job - m_Jobs.get()) + 1;
+
+		uint64 head = m_FreeHead.load(std::memory_order_relaxed);
+		while (true)
+		{
+			job->m_NextFree.store((uint32)head, std::memory_order_relaxed);
+			uint64 newHead = (((head >> 32) + 1) << 32) | index;
+
+			if (m_FreeHead.compare_exchange_weak(head, newHead, std::memory_order_release, std::memory_order_relaxed))
+				return;
+		}
+	}
+}
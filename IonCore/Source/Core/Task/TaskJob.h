@@ -0,0 +1,313 @@
+#pragma once
+
+#include "Core/Base.h"
+#include "Core/Error/Error.h"
+#include "TaskFwd.h"
+
+namespace Ion
+{
+	/**
+	 * @brief Type-erased callable, similar to TFunction, but with
+	 * an inline buffer. Functors that fit in the buffer are stored
+	 * in place, so creating the function doesn't allocate.
+	 *
+	 * @details Bigger functors are allocated on the heap.
+	 * The function is move-only.
+	 *
+	 * @tparam TSignature Function signature, e.g. void(int32)
+	 * @tparam InlineSize Size of the inline buffer in bytes
+	 */
+	template<typename TSignature, size_t InlineSize>
+	class TInlineFunction;
+
+	template<typename R, typename... Args, size_t InlineSize>
+	class TInlineFunction<R(Args...), InlineSize>
+	{
+	public:
+		static_assert(InlineSize >= sizeof(void*));
+
+		template<typename F>
+		static constexpr bool IsStoredInline = sizeof(F) <= InlineSize && alignof(F) <= alignof(std::max_align_t);
+
+		TInlineFunction() noexcept;
+		TInlineFunction(nullptr_t) noexcept;
+
+		template<typename F, TEnableIfT<!TIsSameV<std::decay_t<F>, TInlineFunction>>* = nullptr>
+		TInlineFunction(F&& func) :
+			TInlineFunction()
+		{
+			Assign(Forward<F>(func));
+		}
+
+		TInlineFunction(TInlineFunction&& other) noexcept;
+		TInlineFunction& operator=(TInlineFunction&& other) noexcept;
+
+		TInlineFunction(const TInlineFunction&) = delete;
+		TInlineFunction& operator=(const TInlineFunction&) = delete;
+
+		~TInlineFunction();
+
+		R operator()(Args... args);
+
+		/**
+		 * @brief Destroys the stored functor.
+		 */
+		void Reset() noexcept;
+
+		bool IsBound() const noexcept;
+		explicit operator bool() const noexcept;
+
+	private:
+		enum class EManageOp : uint8
+		{
+			MoveTo,
+			Destroy,
+		};
+
+		using FInvoke = R(*)(void* storage, Args&&... args);
+		using FManage = void(*)(EManageOp op, void* storage, void* otherStorage);
+
+		template<typename F>
+		void Assign(F&& func);
+
+		void MoveFrom(TInlineFunction& other) noexcept;
+
+	private:
+		alignas(std::max_align_t) uint8 m_Storage[InlineSize];
+		FInvoke m_Invoke;
+		FManage m_Manage;
+	};
+
+	/**
+	 * @brief Size of the inline buffer in FTaskJob::Execute.
+	 * Chosen so the whole job takes up two cache lines, also where
+	 * std::max_align_t is 16 bytes (the buffer is padded to it).
+	 */
+	inline constexpr size_t TaskJobInlineSize = 96;
+
+	using TFuncJobExecute = TInlineFunction<void(IMessageQueueProvider&), TaskJobInlineSize>;
+
+	/**
+	 * @brief The unit of work that the TaskQueue workers pass around.
+	 *
+	 * @details Jobs are acquired from a TaskJobPool, so scheduling a small
+	 * lambda doesn't allocate any memory.
+	 *
+	 * @see TaskQueue::ScheduleJob
+	 */
+	struct alignas(64) FTaskJob
+	{
+		TFuncJobExecute Execute;
+
+	private:
+		/* Index + 1 of the next free job in the pool. */
+		TAtomic<uint32> m_NextFree;
+		/* False if the job has been allocated on the heap,
+		   because the pool was exhausted. */
+		bool m_bPooled;
+
+		friend class TaskJobPool;
+	};
+
+	static_assert(sizeof(FTaskJob) == 128, "FTaskJob should take up exactly two cache lines.");
+
+	/**
+	 * @brief Fixed-size, lock-free pool of FTaskJob objects.
+	 *
+	 * @details Acquire and Release can be called from any thread.
+	 * If the pool runs out of jobs, they are allocated on the heap.
+	 */
+	class ION_API TaskJobPool
+	{
+	public:
+		/**
+		 * @brief Construct a new Task Job Pool object
+		 *
+		 * @param capacity Number of preallocated jobs (max 2^32 - 2)
+		 */
+		TaskJobPool(uint32 capacity);
+		~TaskJobPool();
+
+		/**
+		 * @brief Get a free job from the pool and bind the functor to it.
+		 *
+		 * @param execute Function to execute on the worker thread
+		 * @return Job pointer, never null
+		 */
+		template<typename F>
+		FTaskJob* Acquire(F&& execute);
+
+		/**
+		 * @brief Destroy the job's functor and return it to the pool.
+		 *
+		 * @param job Job acquired from this pool
+		 */
+		void Release(FTaskJob* job);
+
+		uint32 GetCapacity() const;
+
+		TaskJobPool(const TaskJobPool&) = delete;
+		TaskJobPool& operator=(const TaskJobPool&) = delete;
+
+	private:
+		FTaskJob* PopFree();
+		void PushFree(FTaskJob* job);
+
+	private:
+		std::unique_ptr<FTaskJob[]> m_Jobs;
+		uint32 m_Capacity;
+
+		/* Lower 32 bits - index + 1 of the first free job (0 if none),
+		   upper 32 bits - ABA tag incremented on every change. */
+		TAtomic<uint64> m_FreeHead;
+	};
+
+	// TInlineFunction Implementation ---------------------------------------------
+
+	template<typename R, typename... Args, size_t InlineSize>
+	inline TInlineFunction<R(Args...), InlineSize>::TInlineFunction() noexcept :
+		m_Invoke(nullptr),
+		m_Manage(nullptr)
+	{
+	}
+
+	template<typename R, typename... Args, size_t InlineSize>
+	inline TInlineFunction<R(Args...), InlineSize>::TInlineFunction(nullptr_t) noexcept :
+		TInlineFunction()
+	{
+	}
+
+	template<typename R, typename... Args, size_t InlineSize>
+	inline TInlineFunction<R(Args...), InlineSize>::TInlineFunction(TInlineFunction&& other) noexcept :
+		TInlineFunction()
+	{
+		MoveFrom(other);
+	}
+
+	template<typename R, typename... Args, size_t InlineSize>
+	inline TInlineFunction<R(Args...), InlineSize>& TInlineFunction<R(Args...), InlineSize>::operator=(TInlineFunction&& other) noexcept
+	{
+		if (this != &other)
+		{
+			Reset();
+			MoveFrom(other);
+		}
+		return *this;
+	}
+
+	template<typename R, typename... Args, size_t InlineSize>
+	inline TInlineFunction<R(Args...), InlineSize>::~TInlineFunction()
+	{
+		Reset();
+	}
+
+	template<typename R, typename... Args, size_t InlineSize>
+	FORCEINLINE R TInlineFunction<R(Args...), InlineSize>::operator()(Args... args)
+	{
+		ionassert(m_Invoke, "The function is not bound.");
+		return m_Invoke(m_Storage, Forward<Args>(args)...);
+	}
+
+	template<typename R, typename... Args, size_t InlineSize>
+	inline void TInlineFunction<R(Args...), InlineSize>::Reset() noexcept
+	{
+		if (m_Manage)
+		{
+			m_Manage(EManageOp::Destroy, m_Storage, nullptr);
+		}
+		m_Invoke = nullptr;
+		m_Manage = nullptr;
+	}
+
+	template<typename R, typename... Args, size_t InlineSize>
+	FORCEINLINE bool TInlineFunction<R(Args...), InlineSize>::IsBound() const noexcept
+	{
+		return m_Invoke;
+	}
+
+	template<typename R, typename... Args, size_t InlineSize>
+	FORCEINLINE TInlineFunction<R(Args...), InlineSize>::operator bool() const noexcept
+	{
+		return IsBound();
+	}
+
+	template<typename R, typename... Args, size_t InlineSize>
+	template<typename F>
+	inline void TInlineFunction<R(Args...), InlineSize>::Assign(F&& func)
+	{
+		using FuncT = std::decay_t<F>;
+
+		if constexpr (IsStoredInline<FuncT>)
+		{
+			new (m_Storage) FuncT(Forward<F>(func));
+
+			m_Invoke = [](void* storage, Args&&... args) -> R
+			{
+				return (*(FuncT*)storage)(Forward<Args>(args)...);
+			};
+			m_Manage = [](EManageOp op, void* storage, void* otherStorage)
+			{
+				FuncT* funcPtr = (FuncT*)storage;
+				if (op == EManageOp::MoveTo)
+				{
+					new (otherStorage) FuncT(Move(*funcPtr));
+				}
+				funcPtr->~FuncT();
+			};
+		}
+		else
+		{
+			// Only the pointer is stored in the buffer
+			*(FuncT**)m_Storage = new FuncT(Forward<F>(func));
+
+			m_Invoke = [](void* storage, Args&&... args) -> R
+			{
+				return (**(FuncT**)storage)(Forward<Args>(args)...);
+			};
+			m_Manage = [](EManageOp op, void* storage, void* otherStorage)
+			{
+				FuncT* funcPtr = *(FuncT**)storage;
+				if (op == EManageOp::MoveTo)
+				{
+					*(FuncT**)otherStorage = funcPtr;
+					return;
+				}
+				delete funcPtr;
+			};
+		}
+	}
+
+	template<typename R, typename... Args, size_t InlineSize>
+	inline void TInlineFunction<R(Args...), InlineSize>::MoveFrom(TInlineFunction& other) noexcept
+	{
+		if (other.m_Manage)
+		{
+			other.m_Manage(EManageOp::MoveTo, other.m_Storage, m_Storage);
+		}
+		m_Invoke = other.m_Invoke;
+		m_Manage = other.m_Manage;
+
+		other.m_Invoke = nullptr;
+		other.m_Manage = nullptr;
+	}
+
+	// TaskJobPool Implementation ---------------------------------------------
+
+	template<typename F>
+	inline FTaskJob* TaskJobPool::Acquire(F&& execute)
+	{
+		FTaskJob* job = PopFree();
+		if (!job)
+		{
+			job = new FTaskJob;
+			job->m_bPooled = false;
+		}
+		job->Execute = TFuncJobExecute(Forward<F>(execute));
+		return job;
+	}
+
+	FORCEINLINE uint32 TaskJobPool::GetCapacity() const
+	{
+		return m_Capacity;
+	}
+}
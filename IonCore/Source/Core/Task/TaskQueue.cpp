@@ -5,22 +5,33 @@
 
 namespace Ion
 {
+	/* Worker that runs on the current thread (null on non-worker threads). */
+	static thread_local TaskWorker* t_CurrentWorker = nullptr;
+	/* Steal index used when a non-worker thread helps executing the jobs. */
+	static thread_local uint32 t_ExternalStealIndex = 0;
+	/* False on the threads that only wait in Wait. */
+	static thread_local bool t_bExecuteJobsWhileWaiting = true;
+
 	// TaskWorker ---------------------------------------------------
 
 	TaskWorker::TaskWorker() :
 		m_bExit(false),
-		m_Owner(nullptr)
+		m_Owner(nullptr),
+		m_Index(0),
+		m_StealIndex(0)
 	{
 	}
 
-	void TaskWorker::Start()
+	void TaskWorker::Start(uint32 index)
 	{
+		m_Index = index;
+		m_StealIndex = index + 1;
 		m_Thread = Thread(&TaskWorker::WorkerProc, this);
 	}
 
 	void TaskWorker::Exit()
 	{
-		m_bExit = true;
+		m_bExit.store(true, std::memory_order_relaxed);
 	}
 
 	void TaskWorker::SetOwner(TaskQueue* owner)
@@ -33,32 +44,58 @@ namespace Ion
 	{
 		ionverify(m_Owner);
 
-		Platform::SetCurrentThreadDescription(L"AssetWorker");
+		Platform::SetCurrentThreadDescription(fmt::format(L"TaskWorker_{}", m_Index));
+
+		t_CurrentWorker = this;
 
-		TQueue<std::shared_ptr<FTaskWork>>& queue = m_Owner->m_WorkQueue;
+		// How many times the worker looks for a job before going to sleep
+		constexpr uint32 SpinCount = 64;
 
-		while (!m_bExit)
+		while (!m_bExit.load(std::memory_order_relaxed))
 		{
+			FTaskJob* job = FindJob();
+			for (uint32 spin = 0; !job && spin < SpinCount; ++spin)
+			{
+				std::this_thread::yield();
+				job = FindJob();
+			}
+
+			if (job)
+			{
+				m_Owner->ExecuteJob(job);
+				continue;
+			}
+
 			// Wait for the work
 			{
-				UniqueLock lock(m_Owner->m_WorkQueueMutex);
+				UniqueLock lock(m_Owner->m_SleepMutex);
 
-				m_Owner->m_WorkQueueWorkersCV.wait(lock, [this, &queue]
+				m_Owner->m_SleepingWorkers.fetch_add(1, std::memory_order_seq_cst);
+				m_Owner->m_WorkersCV.wait(lock, [this]
 				{
 					// Don't wait if there is any work available
 					// or the threads needs to exit
-					return queue.size() || m_bExit;
+					return m_Owner->m_PendingJobs.load(std::memory_order_seq_cst) > 0 || m_bExit.load(std::memory_order_relaxed);
 				});
-				if (m_bExit)
-					break;
-
-				m_CurrentWork = queue.front();
-				queue.pop();
+				m_Owner->m_SleepingWorkers.fetch_sub(1, std::memory_order_relaxed);
 			}
-
-			m_CurrentWork->Execute(*m_Owner);
-			m_CurrentWork.reset();
 		}
+
+		t_CurrentWorker = nullptr;
+	}
+
+	FTaskJob* TaskWorker::FindJob()
+	{
+		FTaskJob* job = m_LocalQueue.Pop();
+		if (!job)
+			job = m_Owner->PopInjectedJob();
+		if (!job)
+			job = m_Owner->StealJob(m_StealIndex, m_Index);
+
+		if (job)
+			m_Owner->m_PendingJobs.fetch_sub(1, std::memory_order_relaxed);
+
+		return job;
 	}
 
 	// TaskQueue ---------------------------------------------------
@@ -69,23 +106,205 @@ namespace Ion
 	}
 
 	TaskQueue::TaskQueue(int32 nThreads) :
-		m_Workers(nThreads)
+		m_JobPool(JobPoolCapacity),
+		m_InjectionQueue(std::make_unique<InjectionQueue>()),
+		m_OverflowCount(0),
+		m_PendingJobs(0),
+		m_SleepingWorkers(0)
 	{
-		for (TaskWorker& worker : m_Workers)
+		ionassert(nThreads > 0);
+
+		// Create all the workers first, so they can steal from each other
+		m_Workers.reserve(nThreads);
+		for (int32 i = 0; i < nThreads; ++i)
+		{
+			m_Workers.emplace_back(std::make_unique<TaskWorker>())->SetOwner(this);
+		}
+
+		uint32 index = 0;
+		for (std::unique_ptr<TaskWorker>& worker : m_Workers)
 		{
-			worker.m_Owner = this;
-			worker.Start();
+			worker->Start(index++);
 		}
 	}
 
 	void TaskQueue::Schedule(const std::shared_ptr<FTaskWork>& work)
 	{
-		// Lock the queue, notify a free worker
+		ScheduleJob([work](IMessageQueueProvider& queue)
+		{
+			work->Execute(queue);
+		});
+	}
+
+	void TaskQueue::Wait(const TaskCounter& counter)
+	{
+		while (!counter.IsDone())
+		{
+			if (!t_bExecuteJobsWhileWaiting || !TryExecuteJob())
+				std::this_thread::yield();
+		}
+	}
+
+	void TaskQueue::Wait(const TaskHandle& handle)
+	{
+		while (!handle.IsDone())
+		{
+			if (!t_bExecuteJobsWhileWaiting || !TryExecuteJob())
+				std::this_thread::yield();
+		}
+	}
+
+	void TaskQueue::SetExecuteJobsWhileWaiting(bool bExecute)
+	{
+		t_bExecuteJobsWhileWaiting = bExecute;
+	}
+
+	bool TaskQueue::TryExecuteJob()
+	{
+		FTaskJob* job = nullptr;
+
+		TaskWorker* worker = t_CurrentWorker;
+		if (worker && worker->m_Owner == this)
+		{
+			job = worker->FindJob();
+		}
+		else
+		{
+			job = PopInjectedJob();
+			if (!job)
+				job = StealJob(t_ExternalStealIndex, TNumericLimits<uint32>::max());
+
+			if (job)
+				m_PendingJobs.fetch_sub(1, std::memory_order_relaxed);
+		}
+
+		if (!job)
+			return false;
+
+		ExecuteJob(job);
+		return true;
+	}
+
+	void TaskQueue::PushJobAfter(FTaskJob* job, const TaskHandle* dependencies, size_t dependencyCount)
+	{
+		ionassert(job);
+		ionassert(dependencies || !dependencyCount);
+
+		const TaskHandle* unfinished = nullptr;
+		size_t unfinishedCount = 0;
+		size_t validCount = 0;
+		for (size_t i = 0; i < dependencyCount; ++i)
+		{
+			const TaskHandle& dependency = dependencies[i];
+			validCount += dependency.IsValid();
+			if (!dependency.IsDone())
+			{
+				unfinished = &dependency;
+				++unfinishedCount;
+			}
+		}
+
+		// A finished task never goes back to unfinished,
+		// so the counts can only get lower from now on.
+		if (unfinishedCount == 0)
+		{
+			PushJob(job);
+			return;
+		}
+
+		if (unfinishedCount == 1)
+		{
+			unfinished->m_State->AddDependent(this, job);
+			return;
+		}
+
+		// Join the dependencies with an intermediate state
+		std::shared_ptr<TaskHandleState> joinState = std::make_shared<TaskHandleState>((int32)validCount);
+		joinState->AddDependent(this, job);
+		for (size_t i = 0; i < dependencyCount; ++i)
+		{
+			const TaskHandle& dependency = dependencies[i];
+			if (dependency.IsValid())
+			{
+				dependency.m_State->AddDependent(joinState);
+			}
+		}
+	}
+
+	void TaskQueue::PushJob(FTaskJob* job)
+	{
+		ionassert(job);
+
+		TaskWorker* worker = t_CurrentWorker;
+		bool bPushedLocally = worker && worker->m_Owner == this && worker->m_LocalQueue.Push(job);
+
+		if (!bPushedLocally && !m_InjectionQueue->Push(job))
+		{
+			UniqueLock lock(m_OverflowQueueMutex);
+			m_OverflowQueue.push_back(job);
+			m_OverflowCount.fetch_add(1, std::memory_order_release);
+		}
+
+		m_PendingJobs.fetch_add(1, std::memory_order_seq_cst);
+		WakeWorker();
+	}
+
+	FTaskJob* TaskQueue::PopInjectedJob()
+	{
+		FTaskJob* job = nullptr;
+		if (m_InjectionQueue->Pop(job))
+			return job;
+
+		if (m_OverflowCount.load(std::memory_order_acquire))
+		{
+			UniqueLock lock(m_OverflowQueueMutex);
+			if (!m_OverflowQueue.empty())
+			{
+				job = m_OverflowQueue.front();
+				m_OverflowQueue.pop_front();
+				m_OverflowCount.fetch_sub(1, std::memory_order_relaxed);
+				return job;
+			}
+		}
+		return nullptr;
+	}
+
+	FTaskJob* TaskQueue::StealJob(uint32& stealIndex, uint32 thiefIndex)
+	{
+		uint32 workerCount = (uint32)m_Workers.size();
+
+		// Start from a different victim each time, so the workers
+		// don't all try to steal from the same one.
+		for (uint32 i = 0; i < workerCount; ++i)
+		{
+			uint32 victimIndex = stealIndex++ % workerCount;
+			if (victimIndex == thiefIndex)
+				continue;
+
+			if (FTaskJob* job = m_Workers[victimIndex]->m_LocalQueue.Steal())
+				return job;
+		}
+		return nullptr;
+	}
+
+	void TaskQueue::ExecuteJob(FTaskJob* job)
+	{
+		job->Execute(*this);
+		m_JobPool.Release(job);
+	}
+
+	void TaskQueue::WakeWorker()
+	{
+		// Only touch the mutex if anyone is actually sleeping.
+		if (m_SleepingWorkers.load(std::memory_order_seq_cst) > 0)
 		{
-			UniqueLock lock(m_WorkQueueMutex);
-			m_WorkQueue.emplace(work);
+			// Make sure the worker is either waiting already or
+			// hasn't checked the predicate yet, so the notification is not lost.
+			{
+				UniqueLock lock(m_SleepMutex);
+			}
+			m_WorkersCV.notify_one();
 		}
-		m_WorkQueueWorkersCV.notify_one();
 	}
 
 	void TaskQueue::DispatchMessages()
@@ -109,18 +328,35 @@ namespace Ion
 
 	void TaskQueue::Shutdown()
 	{
-		for (TaskWorker& worker : m_Workers)
+		for (std::unique_ptr<TaskWorker>& worker : m_Workers)
 		{
-			worker.Exit();
+			worker->Exit();
 		}
 		// Make sure the free workers stop waiting
-		m_WorkQueueWorkersCV.notify_all();
+		{
+			UniqueLock lock(m_SleepMutex);
+		}
+		m_WorkersCV.notify_all();
 
-		for (TaskWorker& worker : m_Workers)
+		for (std::unique_ptr<TaskWorker>& worker : m_Workers)
+		{
+			if (worker->m_Thread.joinable())
+				worker->m_Thread.join();
+		}
+
+		// Release the jobs that haven't been executed
+		for (std::unique_ptr<TaskWorker>& worker : m_Workers)
+		{
+			while (FTaskJob* job = worker->m_LocalQueue.Pop())
+			{
+				m_JobPool.Release(job);
+			}
+		}
+		while (FTaskJob* job = PopInjectedJob())
 		{
-			if (worker.m_Thread.joinable())
-				worker.m_Thread.join();
+			m_JobPool.Release(job);
 		}
+		m_PendingJobs.store(0, std::memory_order_relaxed);
 
 		m_Workers.clear();
 	}
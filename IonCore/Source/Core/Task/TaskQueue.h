@@ -2,6 +2,9 @@
 
 #include "Core/Base.h"
 #include "TaskFwd.h"
+#include "TaskJob.h"
+#include "TaskHandle.h"
+#include "WorkStealingQueue.h"
 
 namespace Ion
 {
@@ -103,8 +106,14 @@ namespace Ion
 	public:
 		TaskWorker();
 
+		/**
+		 * @brief Max number of jobs in the worker's local queue.
+		 * If the queue is full, new jobs go to the owner's injection queue.
+		 */
+		static constexpr size_t LocalQueueCapacity = 1024;
+
 	private:
-		void Start();
+		void Start(uint32 index);
 		void Exit();
 
 		void SetOwner(TaskQueue* owner);
@@ -113,12 +122,26 @@ namespace Ion
 
 		void WorkerProc();
 
+		/**
+		 * @brief Find a job in the local queue, then in the owner's
+		 * injection queue, and if there are none, steal one from
+		 * another worker.
+		 * 
+		 * @return Job pointer or nullptr if there is no work available.
+		 */
+		FTaskJob* FindJob();
+
 	private:
+		using LocalQueue = TWorkStealingQueue<FTaskJob*, LocalQueueCapacity>;
+
+		LocalQueue m_LocalQueue;
+
 		Thread m_Thread;
-		std::shared_ptr<FTaskWork> m_CurrentWork;
 		TaskQueue* m_Owner;
+		uint32 m_Index;
+		uint32 m_StealIndex;
 
-		bool m_bExit;
+		TAtomic<bool> m_bExit;
 
 		friend class TaskQueue;
 	};
@@ -166,6 +189,126 @@ namespace Ion
 		 */
 		void Schedule(const std::shared_ptr<FTaskWork>& work);
 
+		/**
+		 * @brief Add a job to the queue, which will be executed
+		 * by a free worker thread.
+		 * 
+		 * @details If called on one of this queue's worker threads,
+		 * the job is pushed to the worker's local queue, otherwise
+		 * it goes to the shared injection queue. Idle workers steal
+		 * jobs from each other.
+		 * The functor is stored inline in a pooled job if it's small
+		 * enough (TaskJobInlineSize), so this doesn't allocate.
+		 * 
+		 * @tparam F Callable with a void(IMessageQueueProvider&) signature
+		 * @param execute Function to execute on the worker thread
+		 */
+		template<typename F>
+		void ScheduleJob(F&& execute);
+
+		/**
+		 * @brief Same as ScheduleJob(F&& execute), but increments the counter
+		 * and decrements it after the job has been executed.
+		 * 
+		 * @details Use Wait(TaskCounter&) to join the jobs scheduled with the counter.
+		 * 
+		 * @param execute Function to execute on the worker thread
+		 * @param counter Counter of the unfinished jobs
+		 */
+		template<typename F>
+		void ScheduleJob(F&& execute, TaskCounter& counter);
+
+		/**
+		 * @brief Add a job to the queue, that will be executed only after
+		 * all the dependencies have finished.
+		 * 
+		 * @details The job is not put in the queue until then, so it doesn't
+		 * block any worker. Invalid dependency handles are ignored.
+		 * 
+		 * @param execute Function to execute on the worker thread
+		 * @param dependencies Tasks that have to finish first
+		 * @return Handle that can be used as a dependency of other tasks or waited on.
+		 */
+		template<typename F>
+		TaskHandle ScheduleTask(F&& execute, TInitializerList<TaskHandle> dependencies = { });
+
+		/**
+		 * @see ScheduleTask(F&& execute, TInitializerList<TaskHandle> dependencies)
+		 */
+		template<typename F>
+		TaskHandle ScheduleTask(F&& execute, const TArray<TaskHandle>& dependencies);
+
+		/**
+		 * @brief Wait until the counter reaches zero.
+		 * 
+		 * @details The calling thread doesn't sleep, it executes the queued jobs
+		 * in the meantime. This means any job can be executed on the calling thread,
+		 * so don't wait on the main thread if the queue is busy with long jobs.
+		 * The threads that must not run unrelated jobs only wait
+		 * (see SetExecuteJobsWhileWaiting).
+		 * 
+		 * @param counter Counter to wait for
+		 */
+		void Wait(const TaskCounter& counter);
+
+		/**
+		 * @brief Wait until the task has finished. Executes other jobs in the meantime.
+		 * 
+		 * @see Wait(const TaskCounter& counter)
+		 * 
+		 * @param handle Task to wait for
+		 */
+		void Wait(const TaskHandle& handle);
+
+		/**
+		 * @brief Execute one of the queued jobs on the calling thread.
+		 * 
+		 * @return false if there was no job available.
+		 */
+		bool TryExecuteJob();
+
+		/**
+		 * @brief Set if Wait executes the queued jobs on the calling thread
+		 * or only waits (enabled by default).
+		 * 
+		 * @details Disable it on the threads that must not run unrelated
+		 * jobs, e.g. the render thread, which would stall its frame
+		 * on a game job that happens to be in the queue.
+		 * 
+		 * @param bExecute Whether the calling thread executes jobs in Wait
+		 */
+		static void SetExecuteJobsWhileWaiting(bool bExecute);
+
+		/**
+		 * @brief Split the [begin, end) range into chunks and execute
+		 * them in parallel. Returns after all the chunks have been executed.
+		 * 
+		 * @details The chunks are claimed one by one by the calling thread
+		 * and the helper jobs scheduled on the workers. The calling thread
+		 * only executes the chunks of this loop - it never picks up other jobs
+		 * while waiting, so it can be called on threads that must not run
+		 * unrelated work (e.g. the render thread).
+		 * The chunks are never smaller than grain (apart from the last one).
+		 * 
+		 * @tparam F Callable with a void(int64 first, int64 last) signature
+		 * @param begin First index
+		 * @param end One past the last index
+		 * @param grain Min number of indices in a chunk
+		 * @param func Function called for each chunk [first, last)
+		 */
+		template<typename F>
+		void ParallelForRange(int64 begin, int64 end, int64 grain, F&& func);
+
+		/**
+		 * @brief Same as ParallelForRange, but calls the function for each index.
+		 * 
+		 * @see ParallelForRange(int64 begin, int64 end, int64 grain, F&& func)
+		 * 
+		 * @tparam F Callable with a void(int64 index) signature
+		 */
+		template<typename F>
+		void ParallelFor(int64 begin, int64 end, int64 grain, F&& func);
+
 		/**
 		 * @brief Dispach all the messages, which are currently in
 		 * the message queue. This should be called at the beginning
@@ -198,20 +341,65 @@ namespace Ion
 
 		// End of IMessageQueueProvider overrides
 
+		/**
+		 * @brief Get the number of worker threads.
+		 */
+		uint32 GetWorkerCount() const;
+
 		~TaskQueue();
 
+		/**
+		 * @brief Number of preallocated jobs in the job pool.
+		 */
+		static constexpr uint32 JobPoolCapacity = 4096;
+		/**
+		 * @brief Capacity of the lock-free injection queue.
+		 * If it gets full, the jobs are pushed to a locked overflow queue.
+		 */
+		static constexpr size_t InjectionQueueCapacity = 4096;
+
+		/**
+		 * @brief Max number of chunks per thread that ParallelForRange
+		 * splits the range into. More chunks balance the load better.
+		 */
+		static constexpr int64 ParallelForChunksPerThread = 4;
+
+	private:
+		template<typename F>
+		TaskHandle ScheduleTask(F&& execute, const TaskHandle* dependencies, size_t dependencyCount);
+
+		void PushJobAfter(FTaskJob* job, const TaskHandle* dependencies, size_t dependencyCount);
+		void PushJob(FTaskJob* job);
+		FTaskJob* PopInjectedJob();
+		FTaskJob* StealJob(uint32& stealIndex, uint32 thiefIndex);
+		void ExecuteJob(FTaskJob* job);
+		void WakeWorker();
+
 	private:
-		TArray<TaskWorker> m_Workers;
+		using InjectionQueue = TBoundedMPMCQueue<FTaskJob*, InjectionQueueCapacity>;
+
+		TArray<std::unique_ptr<TaskWorker>> m_Workers;
+
+		TaskJobPool m_JobPool;
+
+		std::unique_ptr<InjectionQueue> m_InjectionQueue;
+
+		TDeque<FTaskJob*> m_OverflowQueue;
+		Mutex m_OverflowQueueMutex;
+		TAtomic<uint32> m_OverflowCount;
 
-		TQueue<std::shared_ptr<FTaskWork>> m_WorkQueue;
-		Mutex m_WorkQueueMutex;
-		ConditionVariable m_WorkQueueWorkersCV;
+		/* Jobs that have been scheduled, but not picked up yet. */
+		TAtomic<int32> m_PendingJobs;
+		TAtomic<int32> m_SleepingWorkers;
+		Mutex m_SleepMutex;
+		ConditionVariable m_WorkersCV;
 
 		TQueue<FTaskMessage> m_MessageQueue;
 		Mutex m_MessageQueueMutex;
 		ConditionVariable m_MessageQueueCV;
 
 		friend class TaskWorker;
+		friend class TaskHandleState;
 	};
 
 	template<typename T, TEnableIfT<!TIsSharedV<TRemoveConstRef<T>>>*>
@@ -219,7 +407,142 @@ namespace Ion
 	{
 		static_assert(TIsBaseOfV<FTaskWork, T>);
 
-		std::shared_ptr<T> workPtr = std::make_shared<T>(Move(work));
-		Schedule(workPtr);
+		ScheduleJob([work = Move(work)](IMessageQueueProvider& queue) mutable
+		{
+			work.Execute(queue);
+		});
+	}
+
+	template<typename F>
+	inline void TaskQueue::ScheduleJob(F&& execute)
+	{
+		static_assert(std::is_invocable_v<std::decay_t<F>&, IMessageQueueProvider&>);
+
+		PushJob(m_JobPool.Acquire(Forward<F>(execute)));
+	}
+
+	template<typename F>
+	inline void TaskQueue::ScheduleJob(F&& execute, TaskCounter& counter)
+	{
+		counter.Increment();
+		ScheduleJob([execute = Forward<F>(execute), &counter](IMessageQueueProvider& queue) mutable
+		{
+			execute(queue);
+			counter.Decrement();
+		});
+	}
+
+	template<typename F>
+	inline TaskHandle TaskQueue::ScheduleTask(F&& execute, TInitializerList<TaskHandle> dependencies)
+	{
+		return ScheduleTask(Forward<F>(execute), dependencies.begin(), dependencies.size());
+	}
+
+	template<typename F>
+	inline TaskHandle TaskQueue::ScheduleTask(F&& execute, const TArray<TaskHandle>& dependencies)
+	{
+		return ScheduleTask(Forward<F>(execute), dependencies.data(), dependencies.size());
+	}
+
+	template<typename F>
+	inline TaskHandle TaskQueue::ScheduleTask(F&& execute, const TaskHandle* dependencies, size_t dependencyCount)
+	{
+		static_assert(std::is_invocable_v<std::decay_t<F>&, IMessageQueueProvider&>);
+
+		std::shared_ptr<TaskHandleState> state = std::make_shared<TaskHandleState>(1);
+
+		FTaskJob* job = m_JobPool.Acquire([execute = Forward<F>(execute), state](IMessageQueueProvider& queue) mutable
+		{
+			execute(queue);
+			state->Decrement();
+		});
+		PushJobAfter(job, dependencies, dependencyCount);
+
+		return TaskHandle(state);
+	}
+
+	template<typename F>
+	inline void TaskQueue::ParallelForRange(int64 begin, int64 end, int64 grain, F&& func)
+	{
+		ionassert(grain > 0);
+
+		if (begin >= end)
+			return;
+
+		int64 count = end - begin;
+		int64 maxChunks = ((int64)GetWorkerCount() + 1) * ParallelForChunksPerThread;
+		int64 chunkSize = std::max(grain, (count + maxChunks - 1) / maxChunks);
+
+		// Not worth splitting
+		if (chunkSize >= count)
+		{
+			func(begin, end);
+			return;
+		}
+
+		// Shared with the helper jobs, which can start after the loop has returned.
+		// They only touch the function if they manage to claim a chunk.
+		struct ParallelForState
+		{
+			std::remove_reference_t<F>* Func;
+			int64 Begin;
+			int64 End;
+			int64 ChunkSize;
+			int64 ChunkCount;
+			TAtomic<int64> NextChunk = 0;
+			TAtomic<int64> FinishedChunks = 0;
+
+			void ExecuteChunks()
+			{
+				for (int64 chunk = NextChunk.fetch_add(1, std::memory_order_relaxed); chunk < ChunkCount;
+					chunk = NextChunk.fetch_add(1, std::memory_order_relaxed))
+				{
+					int64 first = Begin + chunk * ChunkSize;
+					(*Func)(first, std::min(first + ChunkSize, End));
+					FinishedChunks.fetch_add(1, std::memory_order_release);
+				}
+			}
+		};
+
+		std::shared_ptr<ParallelForState> state = std::make_shared<ParallelForState>();
+		state->Func = &func;
+		state->Begin = begin;
+		state->End = end;
+		state->ChunkSize = chunkSize;
+		state->ChunkCount = (count + chunkSize - 1) / chunkSize;
+
+		int64 helperCount = std::min<int64>(GetWorkerCount(), state->ChunkCount - 1);
+		for (int64 i = 0; i < helperCount; ++i)
+		{
+			ScheduleJob([state](IMessageQueueProvider&)
+			{
+				state->ExecuteChunks();
+			});
+		}
+
+		state->ExecuteChunks();
+
+		// Only the chunks that are still being executed by the workers are left.
+		while (state->FinishedChunks.load(std::memory_order_acquire) < state->ChunkCount)
+		{
+			std::this_thread::yield();
+		}
+	}
+
+	template<typename F>
+	inline void TaskQueue::ParallelFor(int64 begin, int64 end, int64 grain, F&& func)
+	{
+		ParallelForRange(begin, end, grain, [&func](int64 first, int64 last)
+		{
+			for (int64 i = first; i < last; ++i)
+			{
+				func(i);
+			}
+		});
+	}
+
+	FORCEINLINE uint32 TaskQueue::GetWorkerCount() const
+	{
+		return (uint32)m_Workers.size();
 	}
 }
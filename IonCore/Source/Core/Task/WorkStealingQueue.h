@@ -0,0 +1,276 @@
+#pragma once
+
+#include "Core/Base.h"
+
+namespace Ion
+{
+	/**
+	 * @brief Fixed-capacity Chase-Lev work-stealing deque.
+	 *
+	 * @details The owner thread pushes and pops items at the bottom (LIFO),
+	 * any other thread can steal items from the top (FIFO).
+	 * Push, Pop and Steal are lock-free.
+	 *
+	 * @tparam T Item type, must be a pointer
+	 * @tparam Capacity Max number of items, must be a power of two
+	 */
+	template<typename T, size_t Capacity>
+	class TWorkStealingQueue
+	{
+	public:
+		static_assert(TIsPointerV<T>);
+		static_assert(Capacity && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two.");
+
+		TWorkStealingQueue();
+
+		/**
+		 * @brief Push an item to the bottom of the queue.
+		 * Can only be called by the owner thread.
+		 *
+		 * @param item Item to push
+		 * @return false if the queue is full
+		 */
+		bool Push(T item);
+
+		/**
+		 * @brief Pop an item from the bottom of the queue.
+		 * Can only be called by the owner thread.
+		 *
+		 * @return The item or nullptr if the queue is empty.
+		 */
+		T Pop();
+
+		/**
+		 * @brief Steal an item from the top of the queue.
+		 * Can be called by any thread.
+		 *
+		 * @return The item or nullptr if the queue is empty
+		 * or another thread has taken the item first.
+		 */
+		T Steal();
+
+		/**
+		 * @brief Approximate number of items in the queue.
+		 */
+		size_t GetCount() const;
+
+		TWorkStealingQueue(const TWorkStealingQueue&) = delete;
+		TWorkStealingQueue& operator=(const TWorkStealingQueue&) = delete;
+
+	private:
+		static constexpr int64 Mask = (int64)Capacity - 1;
+
+		alignas(64) TAtomic<int64> m_Top;
+		alignas(64) TAtomic<int64> m_Bottom;
+		alignas(64) TAtomic<T> m_Items[Capacity];
+	};
+
+	/**
+	 * @brief Fixed-capacity, multi-producer multi-consumer lock-free queue.
+	 * (Dmitry Vyukov's bounded MPMC queue)
+	 *
+	 * @tparam T Item type, must be trivially copyable
+	 * @tparam Capacity Max number of items, must be a power of two
+	 */
+	template<typename T, size_t Capacity>
+	class TBoundedMPMCQueue
+	{
+	public:
+		static_assert(std::is_trivially_copyable_v<T>);
+		static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two.");
+
+		TBoundedMPMCQueue();
+
+		/**
+		 * @brief Push an item to the queue.
+		 *
+		 * @param item Item to push
+		 * @return false if the queue is full
+		 */
+		bool Push(const T& item);
+
+		/**
+		 * @brief Pop an item from the queue.
+		 *
+		 * @param outItem Popped item
+		 * @return false if the queue is empty
+		 */
+		bool Pop(T& outItem);
+
+		TBoundedMPMCQueue(const TBoundedMPMCQueue&) = delete;
+		TBoundedMPMCQueue& operator=(const TBoundedMPMCQueue&) = delete;
+
+	private:
+		static constexpr size_t Mask = Capacity - 1;
+
+		struct Cell
+		{
+			TAtomic<size_t> Sequence;
+			T Data;
+		};
+
+		alignas(64) TAtomic<size_t> m_EnqueuePos;
+		alignas(64) TAtomic<size_t> m_DequeuePos;
+		alignas(64) Cell m_Cells[Capacity];
+	};
+
+	// TWorkStealingQueue Implementation ------------------------------------------------
+
+	template<typename T, size_t Capacity>
+	inline TWorkStealingQueue<T, Capacity>::TWorkStealingQueue() :
+		m_Top(0),
+		m_Bottom(0)
+	{
+		for (TAtomic<T>& item : m_Items)
+		{
+			item.store(nullptr, std::memory_order_relaxed);
+		}
+	}
+
+	template<typename T, size_t Capacity>
+	inline bool TWorkStealingQueue<T, Capacity>::Push(T item)
+	{
+		int64 bottom = m_Bottom.load(std::memory_order_relaxed);
+		int64 top = m_Top.load(std::memory_order_acquire);
+
+		if (bottom - top >= (int64)Capacity)
+			return false;
+
+		m_Items[bottom & Mask].store(item, std::memory_order_relaxed);
+		// Publish the item to the thieves
+		m_Bottom.store(bottom + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	template<typename T, size_t Capacity>
+	inline T TWorkStealingQueue<T, Capacity>::Pop()
+	{
+		int64 bottom = m_Bottom.load(std::memory_order_relaxed) - 1;
+		m_Bottom.store(bottom, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64 top = m_Top.load(std::memory_order_relaxed);
+
+		// Empty
+		if (top > bottom)
+		{
+			m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+			return nullptr;
+		}
+
+		T item = m_Items[bottom & Mask].load(std::memory_order_relaxed);
+
+		// Last item - race against the thieves
+		if (top == bottom)
+		{
+			if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+			{
+				item = nullptr;
+			}
+			m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+		}
+		return item;
+	}
+
+	template<typename T, size_t Capacity>
+	inline T TWorkStealingQueue<T, Capacity>::Steal()
+	{
+		int64 top = m_Top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64 bottom = m_Bottom.load(std::memory_order_acquire);
+
+		if (top >= bottom)
+			return nullptr;
+
+		T item = m_Items[top & Mask].load(std::memory_order_relaxed);
+		if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+			return nullptr;
+
+		return item;
+	}
+
+	template<typename T, size_t Capacity>
+	inline size_t TWorkStealingQueue<T, Capacity>::GetCount() const
+	{
+		int64 bottom = m_Bottom.load(std::memory_order_relaxed);
+		int64 top = m_Top.load(std::memory_order_relaxed);
+		return bottom > top ? (size_t)(bottom - top) : 0;
+	}
+
+	// TBoundedMPMCQueue Implementation ------------------------------------------------
+
+	template<typename T, size_t Capacity>
+	inline TBoundedMPMCQueue<T, Capacity>::TBoundedMPMCQueue() :
+		m_EnqueuePos(0),
+		m_DequeuePos(0)
+	{
+		for (size_t i = 0; i < Capacity; ++i)
+		{
+			m_Cells[i].Sequence.store(i, std::memory_order_relaxed);
+		}
+	}
+
+	template<typename T, size_t Capacity>
+	inline bool TBoundedMPMCQueue<T, Capacity>::Push(const T& item)
+	{
+		Cell* cell;
+		size_t pos = m_EnqueuePos.load(std::memory_order_relaxed);
+		while (true)
+		{
+			cell = &m_Cells[pos & Mask];
+			size_t sequence = cell->Sequence.load(std::memory_order_acquire);
+			ptrdiff_t diff = (ptrdiff_t)sequence - (ptrdiff_t)pos;
+
+			if (diff == 0)
+			{
+				if (m_EnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					break;
+			}
+			else if (diff < 0)
+			{
+				// Full
+				return false;
+			}
+			else
+			{
+				pos = m_EnqueuePos.load(std::memory_order_relaxed);
+			}
+		}
+
+		cell->Data = item;
+		cell->Sequence.store(pos + 1, std::memory_order_release);
+		return true;
+	}
+
+	template<typename T, size_t Capacity>
+	inline bool TBoundedMPMCQueue<T, Capacity>::Pop(T& outItem)
+	{
+		Cell* cell;
+		size_t pos = m_DequeuePos.load(std::memory_order_relaxed);
+		while (true)
+		{
+			cell = &m_Cells[pos & Mask];
+			size_t sequence = cell->Sequence.load(std::memory_order_acquire);
+			ptrdiff_t diff = (ptrdiff_t)sequence - (ptrdiff_t)(pos + 1);
+
+			if (diff == 0)
+			{
+				if (m_DequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					break;
+			}
+			else if (diff < 0)
+			{
+				// Empty
+				return false;
+			}
+			else
+			{
+				pos = m_DequeuePos.load(std::memory_order_relaxed);
+			}
+		}
+
+		outItem = cell->Data;
+		cell->Sequence.store(pos + Mask + 1, std::memory_order_release);
+		return true;
+	}
+}
@@ -124,6 +124,15 @@ namespace Ion::Editor
 			nullEntity->GetRootComponent()->Attach(sceneComponent);
 		}
 
+		// Components are moved in memory when other ones get destroyed.
+		m_EditorMainWorld->GetComponentRegistry().AddOnComponentRelocated([this](ComponentOld* oldAddress, ComponentOld* component)
+		{
+			if (m_SelectedComponent == oldAddress)
+			{
+				m_SelectedComponent = component;
+			}
+		});
+
 		// Unicode test
 		{
 			EditorLogger.Info("UTF8: {}", u8"żółw");
@@ -174,6 +183,7 @@ namespace Ion::Editor
 		RefCountPtrTest();
 
 		Test::ArchiveTest();
+		Test::EntityTransformTest();
 
 		MObjectPtr testObject = MObject::New<MObject>();
 		TObjectPtr<MComponent> testComponent = MObject::New<MComponent>();
@@ -17,6 +17,7 @@
 #include "UserInterface/ImGui.h"
 
 #include "Resource/ResourceManager.h"
+#include "Resource/TextureCooker.h"
 
 #include "ExampleModels.h"
 
@@ -210,6 +211,17 @@ namespace Ion::Editor
 
 				ImGui::Separator();
 
+				if (ImGui::MenuItem("Cook Textures"))
+				{
+					TextureCooker::CookAll();
+				}
+				if (ImGui::MenuItem("Recook All Textures"))
+				{
+					TextureCooker::CookAll(true);
+				}
+
+				ImGui::Separator();
+
 				ImGui::MenuItem("ImGui Metrics", nullptr, &m_bImGuiMetricsOpen);
 				ImGui::MenuItem("ImGui Demo", nullptr, &m_bImGuiDemoOpen);
 
@@ -1093,6 +1105,29 @@ namespace Ion::Editor
 				TRACE_RECORD_STOP();
 			}
 
+			ImGui::Separator();
+
+			for (const Performance::ValueCounter* counter : Performance::DebugProfiler::GetValueCounters())
+			{
+				ImGui::Text("%s: %lld", counter->GetName().c_str(), (long long)counter->Get());
+			}
+
+			ImGui::Separator();
+
+			for (uint32 tag = 0; tag < (uint32)EMemoryTag::_Count; ++tag)
+			{
+				EngineAllocatorTagStats stats = EngineAllocator::GetTagStats((EMemoryTag)tag);
+				ImGui::Text("Memory [%s]: %lld allocations, %.2f / %.2f MB",
+					EngineAllocator::GetTagName((EMemoryTag)tag),
+					(long long)stats.AllocationCount,
+					(double)stats.AllocatedBytes / (1 << 20),
+					(double)stats.PageBytes / (1 << 20));
+			}
+
+			ImGui::Text("Memory [Frame]: %.2f / %.2f MB",
+				(double)FrameAllocator::GetUsedBytes() / (1 << 20),
+				(double)FrameAllocator::GetCapacity() / (1 << 20));
+
 			ImGui::End();
 		}
 	}